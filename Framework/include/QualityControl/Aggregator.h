@@ -66,6 +66,16 @@ class Aggregator
 
   o2::quality_control::core::QualityObjectsType aggregate(core::QualityObjectsMapType& qoMap);
 
+  /**
+   * \brief Aggregates the QualityObjects which were already selected with isSource().
+   * It avoids filtering the whole map when the caller keeps the sources of each aggregator apart.
+   * The map is not modified, it is copied only if the AggregatorInterface does not implement the const overload.
+   */
+  o2::quality_control::core::QualityObjectsType aggregateSources(const core::QualityObjectsMapType& sourceQOs);
+
+  /// \brief Tells whether the QualityObject is to be aggregated by this aggregator.
+  bool isSource(const std::string& qoName, const core::QualityObject& qo) const;
+
   const std::string& getName() const;
   UpdatePolicyType getUpdatePolicyType() const;
   std::vector<std::string> getObjectsNames() const;
@@ -83,6 +93,7 @@ class Aggregator
    * @return
    */
   core::QualityObjectsMapType filter(core::QualityObjectsMapType& qoMap);
+  core::QualityObjectsType makeQualityObjects(const std::map<std::string, core::Quality>& qualities) const;
 
   AggregatorConfig mAggregatorConfig;
   AggregatorInterface* mAggregatorInterface = nullptr;
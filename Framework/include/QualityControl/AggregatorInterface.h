@@ -53,6 +53,19 @@ class AggregatorInterface
   /// @return The new qualities, associated with a name.
   virtual std::map<std::string, o2::quality_control::core::Quality> aggregate(std::map<std::string, std::shared_ptr<const o2::quality_control::core::QualityObject>>& qoMap) = 0;
 
+  /// \brief Returns new qualities based on the input qualities, without modifying the map.
+  ///
+  /// The AggregatorRunner calls this method with the map it keeps for the aggregator, so that it does not have to copy
+  /// it at each call. Override it if the aggregator only reads the map. By default, the map is copied and given to the
+  /// method above, which is allowed to modify it.
+  /// @param qoMap A map of the the QualityObjects to aggregate and their full names.
+  /// @return The new qualities, associated with a name.
+  virtual std::map<std::string, o2::quality_control::core::Quality> aggregate(const std::map<std::string, std::shared_ptr<const o2::quality_control::core::QualityObject>>& qoMap)
+  {
+    auto copy = qoMap;
+    return aggregate(copy);
+  }
+
   /// \brief Set the custom parameters for this aggregator.
   /// Set the custom parameters for this aggregator. It is usually the ones defined in the configuration.
   /// \param parameters
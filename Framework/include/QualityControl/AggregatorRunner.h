@@ -17,6 +17,8 @@
 #ifndef QC_CHECKER_AGGREGATORRUNNER_H
 #define QC_CHECKER_AGGREGATORRUNNER_H
 
+// std
+#include <unordered_map>
 // O2
 #include <Framework/Task.h>
 #include <Framework/DataProcessorSpec.h>
@@ -55,6 +57,7 @@ namespace o2::quality_control
 namespace core
 {
 class ServiceDiscovery;
+class WorkerPool;
 }
 namespace checker
 {
@@ -107,6 +110,7 @@ class AggregatorRunner : public framework::Task
   framework::Inputs getInputs() { return mInputs; }
   std::string getDeviceName() { return mDeviceName; }
   const std::vector<std::shared_ptr<Aggregator>>& getAggregators() const { return mAggregators; }
+  const std::vector<std::vector<std::shared_ptr<Aggregator>>>& getAggregatorLevels() const { return mAggregatorLevels; }
 
   static framework::DataProcessorLabel getLabel() { return { "qc-aggregator" }; }
   static std::string createAggregatorRunnerIdString() { return "QC-AGGREGATOR-RUNNER"; };
@@ -118,16 +122,29 @@ class AggregatorRunner : public framework::Task
   /// If all checks belong to the same detector we use it, otherwise we use "MANY"
   static std::string getDetectorName(std::vector<std::shared_ptr<Aggregator>> aggregators);
 
- private:
+  // Public for testing purpose. run() calls receive() for each QualityObject and then aggregate().
   /**
    * \brief For each aggregator, check if the data is ready and, if so, call its own aggregation method.
    *
    * For each aggregator, evaluate if data is ready (i.e. if its policy is fulfilled) and, if so,
    * call its `aggregate()` method.
+   * The aggregators are run level by level of the dependency graph (see mAggregatorLevels). The ready aggregators of
+   * one level run concurrently on mWorkerPool, their outputs are taken into account before running the next level.
    * This method is usually called upon reception of fresh inputs data.
    */
   core::QualityObjectsType aggregate();
 
+  /**
+   * \brief Keep a QualityObject received from a CheckRunner until it is replaced by a newer one.
+   */
+  void receive(const std::string& name, std::shared_ptr<const core::QualityObject> qo);
+
+ private:
+  /**
+   * \brief Keep a QualityObject, received or produced, and pass it to the sources of the aggregators which use it.
+   */
+  void cacheQualityObject(const std::string& name, std::shared_ptr<const core::QualityObject> qo);
+
   /**
    * \brief Store the QualityObjects in the database.
    *
@@ -150,7 +167,7 @@ class AggregatorRunner : public framework::Task
   void initAggregators();
 
   /**
-   * Reorder the aggregators stored in mAggregators.
+   * Reorder the aggregators stored in mAggregators and group them in mAggregatorLevels.
    */
   void reorderAggregators();
 
@@ -185,6 +202,13 @@ class AggregatorRunner : public framework::Task
   std::vector<AggregatorConfig> mAggregatorsConfig;
   core::QualityObjectsMapType mQualityObjects; // where we cache the incoming quality objects and the output of the aggregators
   UpdatePolicyManager updatePolicyManager;
+  // mAggregators grouped by their depth in the dependency graph. An aggregator depends only on the previous levels.
+  std::vector<std::vector<std::shared_ptr<Aggregator>>> mAggregatorLevels;
+  // the subset of mQualityObjects used by each aggregator, kept up to date so that it does not have to be filtered
+  std::unordered_map<std::string, core::QualityObjectsMapType> mAggregatorsSources;
+  // for each QO name, the entries of mAggregatorsSources it belongs to
+  std::unordered_map<std::string, std::vector<core::QualityObjectsMapType*>> mSourcesOfQualityObject;
+  std::shared_ptr<core::WorkerPool> mWorkerPool;
 
   // DPL
   o2::framework::Inputs mInputs;
@@ -196,6 +220,12 @@ class AggregatorRunner : public framework::Task
   int mTotalNumberObjectsReceived;
   int mTotalNumberAggregatorExecuted;
   int mTotalNumberObjectsProduced;
+  struct AggregatorLatency {
+    double sum = 0;
+    double max = 0;
+    size_t count = 0;
+  };
+  std::unordered_map<std::string, AggregatorLatency> mAggregatorsLatencies; // since the last monitoring report
 
   // Service discovery
   std::shared_ptr<core::ServiceDiscovery> mServiceDiscovery;
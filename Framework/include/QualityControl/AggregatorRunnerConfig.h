@@ -34,6 +34,7 @@ struct AggregatorRunnerConfig {
   std::string fallbackPeriodName{};
   std::string fallbackPassName{};
   std::string fallbackProvenance{};
+  size_t workers = 1; // number of threads running independent aggregators concurrently
   framework::Options options{};
 };
 
@@ -0,0 +1,90 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   BackgroundSerializer.h
+///
+
+#ifndef QC_CORE_BACKGROUNDSERIALIZER_H
+#define QC_CORE_BACKGROUNDSERIALIZER_H
+
+#include "QualityControl/MonitorObjectCollection.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class TMessage;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Serializes the MonitorObjects of a task on a background thread, while the task keeps filling them.
+///
+/// push() copies the live objects into a shadow set, which is then ROOT-serialized on the background thread, in the
+/// same format as a DPL snapshot of a MonitorObjectCollection. take() returns the serialized set, so that the processing
+/// thread only has to send it. There is at most one shadow set at a time: the previous one must be taken before
+/// pushing the next one. The copy is still done with Clone() on the calling thread, which is cheap for histograms but
+/// not for every object, e.g. trees.
+class BackgroundSerializer
+{
+ public:
+  /// Called on the background thread once a shadow set is serialized, e.g. to save it to a file.
+  using Callback = std::function<void(const MonitorObjectCollection& shadow)>;
+
+  explicit BackgroundSerializer(Callback afterSerialization = nullptr);
+  ~BackgroundSerializer();
+  BackgroundSerializer(const BackgroundSerializer&) = delete;
+  BackgroundSerializer& operator=(const BackgroundSerializer&) = delete;
+
+  /// \brief Copies the objects into the shadow set and starts serializing it.
+  /// \throw std::logic_error if the previous shadow set was not taken yet.
+  void push(const MonitorObjectCollection& objects);
+  /// \brief Returns the serialized shadow set and releases it.
+  ///
+  /// Returns nullptr if nothing was pushed, or if the serialization is not done yet and wait is false.
+  /// If the serialization has thrown, the exception is rethrown.
+  std::unique_ptr<TMessage> take(bool wait);
+  /// \brief True if a shadow set was pushed and not taken yet.
+  bool isPending();
+
+  /// \brief Duration of the last serialization, in seconds.
+  double getLastSerializationDuration();
+
+  /// \brief Returns an owning deep copy of the MonitorObjects.
+  static std::unique_ptr<MonitorObjectCollection> copy(const MonitorObjectCollection& objects);
+
+ private:
+  void serializerLoop();
+
+  enum class State {
+    Idle,
+    Serializing,
+    Done
+  };
+
+  Callback mAfterSerialization;
+  std::thread mThread;
+  std::mutex mMutex;
+  std::condition_variable mStateChanged;
+  State mState = State::Idle;
+  bool mStopping = false;
+  std::unique_ptr<MonitorObjectCollection> mShadow;
+  std::unique_ptr<TMessage> mSerialized;
+  std::exception_ptr mException;
+  double mLastSerializationDuration = 0;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_BACKGROUNDSERIALIZER_H
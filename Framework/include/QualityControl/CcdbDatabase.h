@@ -21,6 +21,7 @@
 
 #include "QualityControl/DatabaseInterface.h"
 #include <Common/Timer.h>
+#include <functional>
 
 namespace o2::quality_control::repository
 {
@@ -74,9 +75,13 @@ class CcdbDatabase : public DatabaseInterface
   std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string objectPath, std::string objectName, long timestamp = -1, const core::Activity& activity = {}) override;
   // retrieval - QO - deprecated
   std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = -1, const core::Activity& activity = {}) override;
+  std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>> retrieveQOs(const std::string& qoPath, const std::vector<long>& timestamps, const core::Activity& activity = {}) override;
   std::shared_ptr<o2::quality_control::TimeRangeFlagCollection> retrieveTRFC(const std::string& name, const std::string& detector, int runNumber = 0,
                                                                              const string& passName = "", const string& periodName = "",
                                                                              const std::string& provenance = "", long timestamp = -1) override;
+  std::vector<std::shared_ptr<o2::quality_control::TimeRangeFlagCollection>> retrieveTRFCs(const std::string& name, const std::string& detector, const std::vector<int>& runNumbers,
+                                                                                           const std::string& passName = "", const std::string& periodName = "",
+                                                                                           const std::string& provenance = "", long timestamp = -1) override;
 
   // retrieval - general
   std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
@@ -112,6 +117,18 @@ class CcdbDatabase : public DatabaseInterface
 
   void setMaxObjectSize(size_t maxObjectSize) override;
 
+  /**
+   * \brief Sets for how long no objects are stored after a failure to store one.
+   * \param seconds The delay in seconds, 0 to attempt storing each object.
+   */
+  void setFailureDelay(int seconds) { mFailureDelay = seconds; }
+
+  /**
+   * \brief Tells if the last object could not be stored because of a connection or server failure.
+   * It is also the case if the object was skipped because of a previous failure, see setFailureDelay.
+   */
+  bool isStorageInFailure() const { return mDatabaseFailure; }
+
  private:
   /**
    * \brief Load StreamerInfos from a ROOT file.
@@ -144,10 +161,23 @@ class CcdbDatabase : public DatabaseInterface
    */
   bool isDbInFailure();
 
+  /**
+   * Runs the task for each index in [0, count) with at most mMaxConcurrentRequests of them at the same time.
+   * Each concurrent worker passes its own CcdbApi to the task.
+   */
+  void runConcurrently(size_t count, const std::function<void(o2::ccdb::CcdbApi&, size_t)>& task);
+
+  // the retrieval methods above, with the CcdbApi to use, so that they can be run concurrently
+  TObject* retrieveTObject(o2::ccdb::CcdbApi& api, const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers);
+  std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(o2::ccdb::CcdbApi& api, const std::string& qoPath, long timestamp, const core::Activity& activity);
+  std::shared_ptr<o2::quality_control::TimeRangeFlagCollection> retrieveTRFC(o2::ccdb::CcdbApi& api, const std::string& name, const std::string& detector, int runNumber,
+                                                                             const std::string& passName, const std::string& periodName, const std::string& provenance, long timestamp);
+
   o2::ccdb::CcdbApi ccdbApi;
   std::string mUrl;
-  size_t mMaxObjectSize = 2097152; // 2MB by default
-  int mFailureDelay = 60;          // 60 seconds delay between attempts to store things in the database
+  size_t mMaxObjectSize = 2097152;   // 2MB by default
+  size_t mMaxConcurrentRequests = 8; // max number of requests sent in parallel by the batch retrievals
+  int mFailureDelay = 60;            // 60 seconds delay between attempts to store things in the database
   bool mDatabaseFailure = false;
   AliceO2::Common::Timer mFailureTimer;
 };
@@ -24,6 +24,7 @@
 #include "QualityControl/Quality.h"
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectsView.h"
 #include "QualityControl/CheckInterface.h"
 #include "QualityControl/CheckConfig.h"
 #include "QualityControl/CommonSpec.h"
@@ -81,10 +82,11 @@ class Check
   static framework::OutputSpec createOutputSpec(const std::string& checkName);
 
  private:
-  void beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, Quality quality);
+  void beautify(const MonitorObjectsView& moView, Quality quality);
 
   CheckConfig mCheckConfig;
   CheckInterface* mCheckInterface = nullptr;
+  std::vector<const MonitorObjectsView::value_type*> mSelection; // reused in each check() to avoid allocations
 };
 
 } // namespace o2::quality_control::checker
@@ -20,6 +20,7 @@
 #include <unordered_map>
 
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectsView.h"
 #include "QualityControl/Quality.h"
 
 using namespace o2::quality_control::core;
@@ -40,6 +41,19 @@ class CheckInterface
 
   /// \brief Returns the quality associated with these objects.
   ///
+  /// This is the method called by the framework. The default implementation copies the view into a map and calls
+  /// the map-based check(), so that the existing checks keep working. Checks should override it to avoid that copy.
+  /// It has its own name so that overriding one of the methods does not hide the other.
+  ///
+  /// @param moView A view on the MonitorObjects to check, sorted by their full names.
+  /// @return The quality associated with these objects.
+  virtual Quality checkView(const MonitorObjectsView& moView);
+
+  /// \brief Returns the quality associated with these objects.
+  ///
+  /// It must be implemented by every check, so that a check implementing none of the methods does not compile.
+  /// The checks which override checkView() implement it by returning checkWithView(moMap).
+  ///
   /// @param moMap A map of the the MonitorObjects to check and their full names.
   /// @return The quality associated with these objects.
   virtual Quality check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap) = 0;
@@ -55,6 +69,12 @@ class CheckInterface
   ///                    parameter is to be used to pass the result of the check of the same class.
   virtual void beautify(std::shared_ptr<MonitorObject> mo, Quality checkResult) = 0;
 
+  /// \brief Modify the aspect of the plots.
+  ///
+  /// Called by the framework with the objects which have been checked. The default implementation calls
+  /// beautify(mo, checkResult) for each of them.
+  virtual void beautifyView(const MonitorObjectsView& moView, Quality checkResult);
+
   /// \brief Returns the name of the class that can be treated by this check.
   ///
   /// The name of the class returned by this method will be checked against the MonitorObject's encapsulated
@@ -74,6 +94,9 @@ class CheckInterface
   /// \brief Called each time mCustomParameters is updated.
   virtual void configure() = 0;
 
+  /// \brief Calls checkView() with a view on the map, for the checks which override checkView().
+  Quality checkWithView(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap);
+
   std::unordered_map<std::string, std::string> mCustomParameters;
 
   ClassDef(CheckInterface, 3)
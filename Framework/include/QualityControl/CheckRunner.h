@@ -157,6 +157,11 @@ class CheckRunner : public framework::Task
    */
   void send(QualityObjectsType& qualityObjects, framework::DataAllocator& allocator);
 
+  /**
+   * \brief Send the QualityObjects encoded with QualityObjectCodec, one message per Check output.
+   */
+  void sendCompact(QualityObjectsType& qualityObjects, framework::DataAllocator& allocator);
+
   /**
    * \brief Collect input specs from Checks
    *
@@ -33,6 +33,7 @@ struct CheckRunnerConfig {
   std::string fallbackPeriodName{};
   std::string fallbackPassName{};
   std::string fallbackProvenance{};
+  bool compactQualityObjects = false; // QualityObjects are sent encoded with QualityObjectCodec instead of ROOT
   framework::Options options{};
 };
 
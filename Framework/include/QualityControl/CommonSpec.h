@@ -40,6 +40,8 @@ struct CommonSpec {
   bool infologgerFilterDiscardDebug = false;
   int infologgerDiscardLevel = 21;
   double postprocessingPeriod = 10.0;
+  bool compactQualityObjects = false;
+  size_t aggregatorRunnerWorkers = 1;
 };
 
 } // namespace o2::quality_control::core
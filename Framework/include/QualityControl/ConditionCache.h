@@ -0,0 +1,135 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ConditionCache.h
+///
+
+#ifndef QC_CORE_CONDITIONCACHE_H
+#define QC_CORE_CONDITIONCACHE_H
+
+#include <CCDB/CcdbApi.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Caches the conditions of a task together with their validity, and fetches them on a background thread.
+///
+/// A condition is identified by its path, its metadata and the type it is retrieved as. Once retrieved, it is served
+/// from the cache without blocking for as long as the requested timestamp is within its validity. The conditions
+/// retrieved for the current time (timestamp -1) are refreshed in the background when their validity ends, in the
+/// meantime the previous object is served. Only the first retrieval of a condition, or a retrieval for a timestamp
+/// outside the validity of the cached object, waits for the CCDB.
+///
+/// The conditions can be declared in advance, so that prefetch() (called at the start of each activity) retrieves them
+/// before the first data arrives. Any condition retrieved once is also prefetched at the next activity.
+///
+/// All the accesses to the CCDB are done by the background thread with its own CcdbApi. The thread is started when the
+/// first condition is declared or retrieved, so that tasks which do not use the cache do not pay for it. Since the
+/// objects are deserialized by ROOT on that thread, the ROOT thread safety is enabled when it starts. The class is
+/// thread-safe.
+class ConditionCache
+{
+ public:
+  /// Retrieves the object valid at the timestamp and fills the headers with its metadata, returns nullptr if none.
+  using Fetcher = std::function<std::shared_ptr<void>(o2::ccdb::CcdbApi& api, const std::string& path,
+                                                      const std::map<std::string, std::string>& metadata, long timestamp,
+                                                      std::map<std::string, std::string>& headers)>;
+
+  explicit ConditionCache(const std::string& url);
+  ~ConditionCache();
+  ConditionCache(const ConditionCache&) = delete;
+  ConditionCache& operator=(const ConditionCache&) = delete;
+
+  /// \brief Declares a condition to be retrieved by the next prefetch().
+  template <typename T>
+  void declare(const std::string& path, const std::map<std::string, std::string>& metadata = {})
+  {
+    declare(path, metadata, typeid(T), makeFetcher<T>());
+  }
+  /// \brief Returns the condition valid at the timestamp (now if -1), or nullptr if it could not be retrieved.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& path, const std::map<std::string, std::string>& metadata = {}, long timestamp = -1)
+  {
+    return std::static_pointer_cast<const T>(get(path, metadata, timestamp, typeid(T), makeFetcher<T>()));
+  }
+
+  void declare(const std::string& path, const std::map<std::string, std::string>& metadata, std::type_index type, Fetcher fetcher);
+  std::shared_ptr<const void> get(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp,
+                                  std::type_index type, Fetcher fetcher);
+
+  /// \brief Starts retrieving the current version of all the known conditions in the background, it does not block.
+  void prefetch();
+
+  /// \brief Sets how long an object is considered valid if the CCDB does not say, and the delay before retrying a failed retrieval.
+  void setDefaultValidity(long milliseconds);
+  void setRetryDelay(long milliseconds);
+
+  /// \brief Number of retrievals served without waiting and with waiting for the CCDB.
+  size_t getHits() const;
+  size_t getMisses() const;
+
+  template <typename T>
+  static Fetcher makeFetcher()
+  {
+    return [](o2::ccdb::CcdbApi& api, const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp,
+              std::map<std::string, std::string>& headers) -> std::shared_ptr<void> {
+      return std::shared_ptr<T>(api.retrieveFromTFileAny<T>(path, metadata, timestamp, &headers));
+    };
+  }
+
+ private:
+  struct Entry {
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    Fetcher fetcher;
+    std::shared_ptr<void> object;
+    long timestamp = -1; // timestamp to retrieve the object for, -1 for the current time
+    long validFrom = 0;
+    long validUntil = 0;
+    long nextRefresh = 0; // only for the current conditions
+    bool pending = false; // queued or being retrieved
+  };
+
+  Entry& findOrCreate(const std::string& path, const std::map<std::string, std::string>& metadata, std::type_index type, Fetcher& fetcher);
+  void startLocked();
+  void enqueueLocked(const std::string& key, Entry& entry);
+  void fetcherLoop();
+  void fetch(const std::string& key);
+
+  std::string mUrl;
+  o2::ccdb::CcdbApi mCcdbApi; // used only by the background thread
+  std::map<std::string, Entry> mEntries;
+  std::deque<std::string> mQueue;
+  long mDefaultValidity = 10 * 60 * 1000;
+  long mRetryDelay = 10 * 1000;
+  size_t mHits = 0;
+  size_t mMisses = 0;
+  bool mStopping = false;
+  mutable std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mFetched;
+  std::thread mThread;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_CONDITIONCACHE_H
@@ -0,0 +1,55 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CycleClock.h
+///
+
+#ifndef QC_CORE_CYCLECLOCK_H
+#define QC_CORE_CYCLECLOCK_H
+
+#include <chrono>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Deadlines of the cycles of a task.
+///
+/// The TaskRunner checks the clock at each input, including the ticks of its timer input, so that a cycle ends at most
+/// one tick after its deadline. The deadlines follow each other regularly, whatever the phase of the timer.
+class CycleClock
+{
+ public:
+  using time_point = std::chrono::steady_clock::time_point;
+  using duration = std::chrono::steady_clock::duration;
+
+  /// \brief Starts the clock, the first cycle ends one cycle duration after now.
+  void start(time_point now, duration cycleDuration);
+  /// \brief Returns true if the current cycle should have ended at the time now.
+  bool isCycleOver(time_point now) const { return now >= mDeadline; }
+  /// \brief Ends the current cycle and schedules the end of the next one.
+  ///
+  /// The next deadline is one cycle duration after the current one, unless the cycle ends more than a whole cycle late.
+  /// Then it is one cycle duration after now, so that the late cycles are not ended one after the other.
+  /// \return The delay between the deadline of the cycle and its end.
+  duration endCycle(time_point now);
+
+  time_point getDeadline() const { return mDeadline; }
+  duration getCycleDuration() const { return mCycleDuration; }
+
+ private:
+  duration mCycleDuration{};
+  time_point mDeadline{};
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_CYCLECLOCK_H
@@ -18,39 +18,71 @@
 #define QUALITYCONTROL_DATAPRODUCER_H
 
 #include <Framework/DataProcessorSpec.h>
+#include <random>
+#include <vector>
 
 namespace o2::quality_control::core
 {
 
+/// \brief Fills data messages with pseudo-random content at memory bandwidth.
+///
+/// A buffer of random bytes is generated once and the messages are filled by copying its fragments starting at random
+/// offsets, so the content varies between messages without generating each byte. If the page size is not zero,
+/// the payload is split into pages which start with a RAWDataHeader v6, as the raw data coming from the readout.
+class PayloadGenerator
+{
+ public:
+  /// \param maxSize   Maximum size of a message in bytes
+  /// \param pageSize  Size of RDH pages in bytes, 0 for no pages
+  /// \param seed      Seed of the random number generator
+  PayloadGenerator(size_t maxSize, size_t pageSize = 0, uint32_t seed = 0);
+
+  /// \brief Fills the buffer with pseudo-random data, or with RDH pages if the page size was set.
+  void fill(char* data, size_t length);
+  /// \brief Returns a random message size between minSize and maxSize.
+  size_t generateSize(size_t minSize, size_t maxSize);
+
+ private:
+  void fillFromTemplate(char* data, size_t length);
+
+  std::vector<char> mTemplate;
+  std::default_random_engine mGenerator;
+  size_t mPageSize;
+  uint32_t mOrbit = 0;
+};
+
 /// \brief Returns a random data producer specification which publishes on {"TST", "RAWDATA", <index>}
 ///
 /// \param minSize  Minimum size of a message in bytes
 /// \param maxSize  Maximum size of a message in bytes
-/// \param rate     How much messages to produce in one second
+/// \param rate     How much messages to produce in one second, 0 or less for no limit
 /// \param amount   How many messages should be produce in total (0 for inf). EndOfStream is sent at the end.
 /// \param index    SubSpecification of the data producer (useful when more than one needed)
 /// \param monitoringUrl Where monitoring metrics should be sent
 /// \param fill     Should it fill messages with random data
+/// \param timepipeline How many copies of the producer should run in parallel
+/// \param pageSize Size of RDH pages in the messages, 0 for no pages
 ///
 /// \return         A random data producer specification
 framework::DataProcessorSpec
   getDataProducerSpec(size_t minSize, size_t maxSize, double rate, uint64_t amount = 0, size_t index = 0,
-                      std::string monitoringUrl = "", bool fill = true, size_t timepipeline = 1);
+                      std::string monitoringUrl = "", bool fill = true, size_t timepipeline = 1, size_t pageSize = 0);
 
 /// \brief Returns an algorithm generating random messages
 ///
 /// \param output   Origin, Description and SubSpecification of data to be produced
 /// \param minSize  Minimum size of a message in bytes
 /// \param maxSize  Maximum size of a message in bytes
-/// \param rate     How much messages to produce in one second
+/// \param rate     How much messages to produce in one second, 0 or less for no limit
 /// \param amount   How many messages should be produce in total (0 for inf). EndOfStream is sent at the end.
 /// \param monitoringUrl Where monitoring metrics should be sent
 /// \param fill     Should it fill messages with random data
+/// \param pageSize Size of RDH pages in the messages, 0 for no pages
 ///
 /// \return         A random data producer algorithm
 framework::AlgorithmSpec
   getDataProducerAlgorithm(framework::ConcreteDataMatcher output, size_t minSize, size_t maxSize, double rate,
-                           uint64_t amount = 0, std::string monitoringUrl = "", bool fill = true);
+                           uint64_t amount = 0, std::string monitoringUrl = "", bool fill = true, size_t pageSize = 0);
 
 } // namespace o2::quality_control::core
 
@@ -150,6 +150,20 @@ class DatabaseInterface
    * @deprecated
    */
   virtual std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = -1, const core::Activity& activity = {}) = 0;
+  /**
+   * \brief Look up several versions of a quality object.
+   * The results are returned in the same order as the timestamps, with nullptr for the ones which were not found.
+   * The default implementation retrieves them one after another, implementations may do it concurrently.
+   */
+  virtual std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>> retrieveQOs(const std::string& qoPath, const std::vector<long>& timestamps, const core::Activity& activity = {})
+  {
+    std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>> results;
+    results.reserve(timestamps.size());
+    for (auto timestamp : timestamps) {
+      results.push_back(retrieveQO(qoPath, timestamp, activity));
+    }
+    return results;
+  }
   /**
    * \brief Look up a TimeRangeFlagCollection object and return it.
    * Look up a TimeRangeFlagCollection and return it if found or nullptr if not.
@@ -157,6 +171,23 @@ class DatabaseInterface
   virtual std::shared_ptr<o2::quality_control::TimeRangeFlagCollection> retrieveTRFC(const std::string& name, const std::string& detector, int runNumber = 0,
                                                                                      const std::string& passName = "", const std::string& periodName = "",
                                                                                      const std::string& provenance = "", long timestamp = -1) = 0;
+
+  /**
+   * \brief Look up TimeRangeFlagCollections for several runs.
+   * The results are returned in the same order as the run numbers, with nullptr for the ones which were not found.
+   * The default implementation retrieves them one after another, implementations may do it concurrently.
+   */
+  virtual std::vector<std::shared_ptr<o2::quality_control::TimeRangeFlagCollection>> retrieveTRFCs(const std::string& name, const std::string& detector, const std::vector<int>& runNumbers,
+                                                                                                   const std::string& passName = "", const std::string& periodName = "",
+                                                                                                   const std::string& provenance = "", long timestamp = -1)
+  {
+    std::vector<std::shared_ptr<o2::quality_control::TimeRangeFlagCollection>> results;
+    results.reserve(runNumbers.size());
+    for (auto runNumber : runNumbers) {
+      results.push_back(retrieveTRFC(name, detector, runNumber, passName, periodName, provenance, timestamp));
+    }
+    return results;
+  }
   /**
    * \brief Look up an object and return it.
    * Look up an object and return it if found or nullptr if not. It is a raw pointer because we might need it to build a MO.
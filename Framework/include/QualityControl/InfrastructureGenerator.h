@@ -132,7 +132,7 @@ class InfrastructureGenerator
   ///
   /// \param workflow - existing workflow where QC infrastructure should be placed
   /// \param configurationTree - full QC config ptree
-  /// \param sourceFilePath - path to the input file
+  /// \param sourceFilePath - path to the input file, or a comma-separated list of paths
   static void generateRemoteBatchInfrastructure(framework::WorkflowSpec& workflow, const boost::property_tree::ptree& configurationTree, std::string sourceFilePath);
 
   /// \brief Generates the remote batch part of the QC infrastructure.
@@ -140,7 +140,7 @@ class InfrastructureGenerator
   /// Generates the remote batch part of the QC infrastructure - file reader, check runners, aggregator runners.
   ///
   /// \param configurationTree - full QC config ptree
-  /// \param sourceFilePath - path to the input file
+  /// \param sourceFilePath - path to the input file, or a comma-separated list of paths
   /// \return generated remote batch QC workflow
   static framework::WorkflowSpec generateRemoteBatchInfrastructure(const boost::property_tree::ptree& configurationTree, std::string sourceFilePath);
 
@@ -159,6 +159,16 @@ class InfrastructureGenerator
 
   static void printVersion();
 
+  /// \brief Computes the number of Mergers in each layer of the topology which merges the results of a local task.
+  ///
+  /// An explicit "mergersPerLayer" in the task configuration takes precedence. Otherwise, if "mergerReductionFactor"
+  /// is set, layers are added until no Merger has more inputs than the reduction factor. By default, one Merger is used.
+  ///
+  /// \param numberOfInputs - number of local task instances producing objects to merge
+  /// \param taskSpec - specification of the local task
+  /// \return number of Mergers in each layer, starting from the one closest to the tasks
+  static std::vector<size_t> computeMergersPerLayer(size_t numberOfInputs, const TaskSpec& taskSpec);
+
  private:
   // Dedicated methods for creating each QC component to hide implementation details.
 
@@ -194,7 +204,8 @@ class InfrastructureGenerator
   static void generateMergers(framework::WorkflowSpec& workflow,
                               std::string taskName,
                               size_t numberOfLocalMachines,
-                              double cycleDurationSeconds,
+                              const std::vector<size_t>& mergersPerLayer,
+                              const std::vector<double>& cycleDurationsSeconds,
                               std::string mergingMode,
                               size_t resetAfterCycles,
                               std::string monitoringUrl,
@@ -0,0 +1,126 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectsView.h
+///
+
+#ifndef QC_CORE_MONITOROBJECTSVIEW_H
+#define QC_CORE_MONITOROBJECTSVIEW_H
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace o2::quality_control::core
+{
+
+class MonitorObject;
+
+/// \brief Non-owning, read-only view on a selection of MonitorObjects.
+///
+/// It refers to a span of pointers to the entries of a map of MonitorObjects, sorted by name. Checks receive it instead
+/// of a copy of the map, so that selecting the objects to check costs neither node allocations nor reference counting.
+/// The view is only valid during the call it is passed to.
+class MonitorObjectsView
+{
+ public:
+  using MonitorObjectsMap = std::map<std::string, std::shared_ptr<MonitorObject>>;
+  using value_type = MonitorObjectsMap::value_type;
+
+  class const_iterator
+  {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = MonitorObjectsView::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+    explicit const_iterator(const value_type* const* position) : mPosition(position) {}
+
+    reference operator*() const { return **mPosition; }
+    pointer operator->() const { return *mPosition; }
+    reference operator[](difference_type n) const { return *mPosition[n]; }
+    const_iterator& operator++()
+    {
+      ++mPosition;
+      return *this;
+    }
+    const_iterator operator++(int) { return const_iterator(mPosition++); }
+    const_iterator& operator--()
+    {
+      --mPosition;
+      return *this;
+    }
+    const_iterator operator--(int) { return const_iterator(mPosition--); }
+    const_iterator& operator+=(difference_type n)
+    {
+      mPosition += n;
+      return *this;
+    }
+    const_iterator operator+(difference_type n) const { return const_iterator(mPosition + n); }
+    const_iterator operator-(difference_type n) const { return const_iterator(mPosition - n); }
+    difference_type operator-(const const_iterator& other) const { return mPosition - other.mPosition; }
+    bool operator==(const const_iterator& other) const { return mPosition == other.mPosition; }
+    bool operator!=(const const_iterator& other) const { return mPosition != other.mPosition; }
+    bool operator<(const const_iterator& other) const { return mPosition < other.mPosition; }
+
+   private:
+    const value_type* const* mPosition = nullptr;
+  };
+  using iterator = const_iterator;
+
+  MonitorObjectsView() = default;
+  /// \brief Creates a view on the entries pointed by [begin, end), which must be sorted by name.
+  MonitorObjectsView(const value_type* const* begin, const value_type* const* end) : mBegin(begin), mEnd(end) {}
+
+  const_iterator begin() const { return const_iterator(mBegin); }
+  const_iterator end() const { return const_iterator(mEnd); }
+  size_t size() const { return mEnd - mBegin; }
+  bool empty() const { return mBegin == mEnd; }
+
+  /// \brief Finds the entry with the given name by binary search, returns end() if it is not in the view.
+  const_iterator find(const std::string& name) const
+  {
+    auto position = std::lower_bound(mBegin, mEnd, name, [](const value_type* entry, const std::string& n) { return entry->first < n; });
+    return (position != mEnd && (*position)->first == name) ? const_iterator(position) : end();
+  }
+  size_t count(const std::string& name) const { return find(name) == end() ? 0 : 1; }
+
+  /// \brief Returns the MonitorObject with the given name or nullptr if it is not in the view.
+  MonitorObject* get(const std::string& name) const
+  {
+    auto it = find(name);
+    return it == end() ? nullptr : it->second.get();
+  }
+
+  /// \brief Copies the view into a map, e.g. for the checks which still implement the map-based interface.
+  MonitorObjectsMap toMap() const
+  {
+    MonitorObjectsMap map;
+    for (const auto& entry : *this) {
+      map.emplace_hint(map.end(), entry);
+    }
+    return map;
+  }
+
+ private:
+  const value_type* const* mBegin = nullptr;
+  const value_type* const* mEnd = nullptr;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_MONITOROBJECTSVIEW_H
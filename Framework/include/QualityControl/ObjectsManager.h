@@ -23,9 +23,12 @@
 // stl
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 class TObject;
 class TObjArray;
+class TH1;
 
 namespace o2::quality_control::core
 {
@@ -64,6 +67,43 @@ class ObjectsManager
    */
   void startPublishing(TObject* obj);
 
+  /**
+   * Start publishing the histogram and declare it as sharded, so that it can be filled by several threads.
+   * Each worker of the task gets its own copy of the histogram (a shard) with getShard(), the worker 0 fills the
+   * published histogram itself. The shards are merged into the published histogram at the end of each cycle.
+   * The ownership remains to the caller.
+   * @param histogram The histogram to publish.
+   * @throws DuplicateObjectError
+   */
+  void startPublishingSharded(TH1* histogram);
+
+  /**
+   * Returns the shard of a sharded histogram which the given worker should fill.
+   * It does not allocate and it can be called concurrently by the workers, but the result should be kept for the
+   * duration of a loop rather than looked up for each entry.
+   * @param histogram The published histogram.
+   * @param worker Index of the worker, as passed by TaskInterface::parallelFor.
+   * @throw ObjectNotFoundError if the histogram is not sharded or the worker does not exist.
+   */
+  template <typename T>
+  T* getShard(T* histogram, size_t worker)
+  {
+    return static_cast<T*>(getShardImpl(histogram, worker));
+  }
+
+  /**
+   * Sets the number of shards of each sharded histogram, i.e. the number of workers of the task.
+   * It must not be called while the workers fill the shards, their content is merged before they are resized.
+   */
+  void setNumberOfShards(size_t shards);
+  size_t getNumberOfShards() const;
+
+  /**
+   * Adds the content of the shards to the published histograms and resets the shards.
+   * It is called by the framework before each publication.
+   */
+  void mergeShards();
+
   /**
    * Stop publishing this object
    * @param obj
@@ -178,6 +218,9 @@ class ObjectsManager
   void setActivity(const Activity& activity);
 
  private:
+  TH1* getShardImpl(TH1* histogram, size_t worker);
+  std::vector<std::unique_ptr<TH1>> createShards(TH1* histogram) const;
+
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
   std::string mTaskName;
   std::string mTaskClass;
@@ -185,6 +228,9 @@ class ObjectsManager
   std::unique_ptr<ServiceDiscovery> mServiceDiscovery;
   bool mUpdateServiceDiscovery;
   Activity mActivity;
+  size_t mNumberOfShards = 1;
+  // the shards of the workers 1..n-1 of each sharded histogram, the worker 0 fills the published histogram
+  std::unordered_map<TH1*, std::vector<std::unique_ptr<TH1>>> mShards;
 };
 
 } // namespace o2::quality_control::core
@@ -20,6 +20,11 @@
 #include <InfoLogger/InfoLogger.hxx>
 #include <InfoLogger/InfoLoggerMacros.hxx>
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
 
 typedef AliceO2::InfoLogger::InfoLogger infologger; // not to have to type the full stuff each time
 typedef AliceO2::InfoLogger::InfoLoggerContext infoContext;
@@ -39,6 +44,12 @@ namespace o2::quality_control::core
 ///                     << "fatal message with extra fields" << ENDM; // complex version
 ///           ILOG(Info, Ops) << "Test message with severity Info and level Ops, see InfoLoggerMacros.hxx" << ENDM;
 ///
+/// In the data processing path, use rather the asynchronous versions, which do not format the message at all if it is
+/// discarded and hand it over to a background thread otherwise, so that the caller never waits for InfoLogger:
+///           ILOG_ASYNC(Warning, Support) << "message which is sent by the background thread" << ENDM;
+///           ILOG_RATE_LIMITED(Info, Support, 10) << "at most one message every 10 seconds from here" << ENDM;
+/// The number of messages suppressed by the rate limiting of each call site is reported periodically.
+///
 /// \author Barthelemy von Haller
 class QcInfoLogger
 {
@@ -58,6 +69,8 @@ class QcInfoLogger
   static void setDetector(const std::string& detector);
   static void setRun(int run);
   static void setPartition(const std::string& partitionName);
+  /// \brief Sets how often the numbers of suppressed and dropped asynchronous messages are reported, in seconds.
+  static void setSuppressedMessagesReportPeriod(double seconds);
   static void init(const std::string& facility,
                    bool discardDebug = false,
                    int discardFromLevel = 21 /* Discard Trace */,
@@ -72,6 +85,23 @@ class QcInfoLogger
                    int run = -1,
                    std::string partitionName = "");
 
+  /// \brief True if a message would be thrown away by the discard filters set in init().
+  static bool isDiscarded(AliceO2::InfoLogger::InfoLogger::Severity severity, int level)
+  {
+    return (severity == AliceO2::InfoLogger::InfoLogger::Severity::Debug && mDiscardDebug.load(std::memory_order_relaxed)) ||
+           level >= mDiscardFromLevel.load(std::memory_order_relaxed);
+  }
+  /// \brief Queues a formatted message for the background sink thread. It never blocks on InfoLogger.
+  ///
+  /// If the queue is full, the message is dropped and counted.
+  static void pushAsync(const AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption& option, const char* message, size_t length);
+  /// \brief Blocks until all the queued asynchronous messages are sent.
+  static void flushAsync();
+  /// \brief Registers a rate limiter, so that its suppressed messages are reported. Call sites do it once.
+  static void registerRateLimiter(class LogRateLimiter* limiter);
+  /// \brief Stops reporting the suppressed messages of a rate limiter, which is being destroyed.
+  static void unregisterRateLimiter(class LogRateLimiter* limiter);
+
   // build a default infologger
   static class _init
   {
@@ -91,6 +121,91 @@ class QcInfoLogger
   // if we keep the default infologger it will any ways be valid till the end of the process.
   static AliceO2::InfoLogger::InfoLogger* instance;
   static AliceO2::InfoLogger::InfoLoggerContext* mContext;
+  static std::atomic<bool> mDiscardDebug;
+  static std::atomic<int> mDiscardFromLevel;
+};
+
+/// \brief Lets through at most one message per interval from a call site, and counts the other ones.
+///
+/// It is meant to be a static object at the call site, as created by ILOG_RATE_LIMITED. allow() does not lock.
+class LogRateLimiter
+{
+ public:
+  LogRateLimiter(double intervalSeconds, const char* file, int line);
+  ~LogRateLimiter();
+  LogRateLimiter(const LogRateLimiter&) = delete;
+  LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+
+  /// \brief Returns true if a message may be logged now, otherwise counts it as suppressed.
+  bool allow();
+  /// \brief Returns the number of suppressed messages since the last call.
+  uint64_t takeSuppressed()
+  {
+    return mSuppressed.exchange(0, std::memory_order_relaxed);
+  }
+  const char* getFile() const { return mFile; }
+  int getLine() const { return mLine; }
+
+ private:
+  const int64_t mIntervalNs;
+  const char* mFile;
+  const int mLine;
+  std::atomic<int64_t> mNextAllowedNs{ 0 };
+  std::atomic<uint64_t> mSuppressed{ 0 };
+};
+
+/// \brief Message formatted into a fixed-size buffer, without allocations, and queued for the sink thread at ENDM.
+///
+/// Longer messages are truncated.
+class QcLogMessage
+{
+ public:
+  static constexpr size_t maxLength = 1024;
+
+  explicit QcLogMessage(const AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption& option)
+    : mStream(&mBuffer), mOption(option)
+  {
+  }
+
+  template <typename T>
+  QcLogMessage& operator<<(const T& value)
+  {
+    mStream << value;
+    return *this;
+  }
+  QcLogMessage& operator<<(std::ostream& (*manipulator)(std::ostream&))
+  {
+    mStream << manipulator;
+    return *this;
+  }
+  QcLogMessage& operator<<(const AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption& option)
+  {
+    mOption = option;
+    return *this;
+  }
+  void operator<<(AliceO2::InfoLogger::InfoLogger::StreamOps)
+  {
+    QcInfoLogger::pushAsync(mOption, mBuffer.data(), mBuffer.size());
+  }
+
+ private:
+  class FixedBuffer : public std::streambuf
+  {
+   public:
+    FixedBuffer() { setp(mData.data(), mData.data() + mData.size()); }
+    const char* data() const { return pbase(); }
+    size_t size() const { return pptr() - pbase(); }
+
+   protected:
+    int_type overflow(int_type) override { return traits_type::eof(); }
+
+   private:
+    std::array<char, maxLength> mData;
+  };
+
+  FixedBuffer mBuffer;
+  std::ostream mStream;
+  AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption mOption;
 };
 
 } // namespace o2::quality_control::core
@@ -121,4 +236,19 @@ class QcInfoLogger
 #define ILOG2(s, t, severity, level) \
   ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
 
+#define ILOG_OPTION(severity, level) \
+  AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+// The message is neither formatted nor queued if it is discarded, the stream expression is not even evaluated.
+#define ILOG_ASYNC(severity, level)                                                                                                                               \
+  if (o2::quality_control::core::QcInfoLogger::isDiscarded(AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level)) { \
+  } else                                                                                                                                                          \
+    o2::quality_control::core::QcLogMessage(ILOG_OPTION(severity, level))
+// Each call site gets its own limiter, which lets through at most one message per intervalSeconds.
+#define ILOG_RATE_LIMITED(severity, level, intervalSeconds)                                                                                                       \
+  if (static o2::quality_control::core::LogRateLimiter qcLogRateLimiter(intervalSeconds, __FILE__, __LINE__);                                                     \
+      o2::quality_control::core::QcInfoLogger::isDiscarded(AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level) || \
+      !qcLogRateLimiter.allow()) {                                                                                                                                \
+  } else                                                                                                                                                          \
+    o2::quality_control::core::QcLogMessage(ILOG_OPTION(severity, level))
+
 #endif // QC_CORE_QCINFOLOGGER_H
@@ -77,7 +77,7 @@ class QualityObject : public TObject
   /// @return the quality of the object
   ///
   void updateQuality(Quality quality);
-  Quality getQuality() const;
+  const Quality& getQuality() const;
 
   /**
    * Use o2::framework::DataSpecUtils::describe(input) to get string
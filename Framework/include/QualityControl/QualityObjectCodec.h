@@ -0,0 +1,142 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   QualityObjectCodec.h
+///
+
+#ifndef QC_CORE_QUALITYOBJECTCODEC_H
+#define QC_CORE_QUALITYOBJECTCODEC_H
+
+#include "QualityControl/QualityObject.h"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Compact binary encoding of batches of QualityObjects, an alternative to ROOT streaming.
+///
+/// A batch starts with a header (magic number, format version, number of objects), followed by one record per object.
+/// Each record is prefixed with its size, so that it can be skipped without being decoded. Integers are little-endian,
+/// strings are stored with a 32-bit length prefix and without the null character. Records contain, in this order:
+/// quality level and name, check name, detector name, policy name, monitor objects names, inputs, activity,
+/// flag reasons with their comments and metadata. The flag reasons provided by FlagReasonFactory are stored with their
+/// ID, name and flag and are recreated by the factory, any other reason is also streamed with ROOT.
+///
+/// The encoding is meant for the data sent between QC devices, it is not a persistent storage format.
+class QualityObjectCodec
+{
+ public:
+  static constexpr uint32_t magic = 0x4f514351; // "QCQO" when read as bytes
+  static constexpr uint16_t version = 2;
+  static constexpr size_t headerSize = 12;
+
+  /// \brief Returns the number of bytes needed to encode the objects.
+  static size_t getEncodedSize(const QualityObjectsType& qualityObjects);
+  /// \brief Encodes the objects in the buffer, which should be at least getEncodedSize() long.
+  /// \return The number of bytes written.
+  /// \throw FatalException if the buffer is too small.
+  static size_t encode(const QualityObjectsType& qualityObjects, char* buffer, size_t bufferSize);
+  static std::vector<char> encode(const QualityObjectsType& qualityObjects);
+  /// \brief Tells whether the buffer starts with the header of a batch of any version.
+  static bool isEncodedBatch(const char* data, size_t size);
+};
+
+/// \brief Read-only access to a QualityObject encoded by QualityObjectCodec.
+///
+/// The view does not own the data, the buffer must outlive it. The strings it returns point directly to the buffer.
+class QualityObjectView
+{
+ public:
+  /// \throw FatalException if the record is truncated.
+  QualityObjectView(const char* record, size_t size);
+
+  unsigned int getLevel() const { return mLevel; }
+  std::string_view getQualityName() const { return mQualityName; }
+  std::string_view getCheckName() const { return mCheckName; }
+  std::string_view getDetectorName() const { return mDetectorName; }
+  std::string_view getPolicyName() const { return mPolicyName; }
+  size_t getNumberOfMonitorObjects() const { return mNumberOfMonitorObjects; }
+  /// \brief Returns the same as QualityObject::getName() of the decoded object.
+  std::string getName() const;
+
+  /// \brief Decodes the complete object.
+  std::shared_ptr<QualityObject> toQualityObject() const;
+
+ private:
+  const char* mRecord;
+  size_t mSize;
+  unsigned int mLevel;
+  std::string_view mQualityName;
+  std::string_view mCheckName;
+  std::string_view mDetectorName;
+  std::string_view mPolicyName;
+  size_t mNumberOfMonitorObjects;
+  std::string_view mFirstMonitorObjectName;
+};
+
+/// \brief Read-only access to a batch of QualityObjects encoded by QualityObjectCodec.
+///
+/// The header is validated in the constructor, the records are checked when they are accessed.
+/// The batch does not own the data, the buffer must outlive it and the views it returns.
+class QualityObjectsBatchView
+{
+ public:
+  /// \throw FatalException if the buffer does not contain a batch of a supported version.
+  QualityObjectsBatchView(const char* data, size_t size);
+
+  size_t size() const { return mNumberOfObjects; }
+
+  class iterator
+  {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = QualityObjectView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const QualityObjectView*;
+    using reference = QualityObjectView;
+
+    iterator(const char* position, const char* end, size_t remaining) : mPosition(position), mEnd(end), mRemaining(remaining) {}
+
+    QualityObjectView operator*() const;
+    iterator& operator++();
+    bool operator==(const iterator& other) const { return mRemaining == other.mRemaining; }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+   private:
+    size_t recordSize() const;
+
+    const char* mPosition;
+    const char* mEnd;
+    size_t mRemaining;
+  };
+
+  iterator begin() const { return { mData + QualityObjectCodec::headerSize, mData + mSize, mNumberOfObjects }; }
+  iterator end() const { return { mData + mSize, mData + mSize, 0 }; }
+
+  /// \brief Decodes all the objects of the batch.
+  QualityObjectsType toQualityObjects() const;
+
+ private:
+  const char* mData;
+  size_t mSize;
+  size_t mNumberOfObjects;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_QUALITYOBJECTCODEC_H
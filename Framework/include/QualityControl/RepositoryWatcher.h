@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    RepositoryWatcher.h
+///
+
+#ifndef QUALITYCONTROL_REPOSITORYWATCHER_H
+#define QUALITYCONTROL_REPOSITORYWATCHER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace o2::ccdb
+{
+class CcdbApi;
+}
+
+namespace o2::quality_control::postprocessing
+{
+
+/// \brief Watches a set of object paths in a repository and tells subscribers when they get new versions.
+///
+/// All the subscribers of one watcher share the same queries to the repository. When a subscriber polls and it has
+/// already seen the results of the latest query, the watcher lists the versions created since the previous query under
+/// the common prefix of all the watched paths, with a single request, and dispatches them to the matching
+/// subscriptions. Thus, the number of requests per polling loop does not depend on the number of watched paths nor on
+/// the number of subscriptions. The requests are sent without blocking the other users of the watcher.
+///
+/// A watcher created without a database URL does not query anything, it only dispatches updates passed with notify().
+class RepositoryWatcher
+{
+ public:
+  /// \brief A new version of a watched object
+  struct Update {
+    std::string md5;
+    uint64_t validFrom = 0;
+    uint64_t created = 0;
+  };
+  using SubscriptionId = size_t;
+
+  /// \brief Creates a watcher. An empty databaseUrl means that it will receive updates only via notify().
+  explicit RepositoryWatcher(std::string databaseUrl = "");
+  ~RepositoryWatcher();
+
+  /// \brief Returns the watcher for the given database which is shared in the process.
+  static std::shared_ptr<RepositoryWatcher> getInstance(const std::string& databaseUrl);
+
+  /// \brief Starts watching an object path, considering only the versions which match the metadata.
+  /// The currently available version (if any) is not reported as an update.
+  SubscriptionId subscribe(const std::string& path, const std::map<std::string, std::string>& metadata = {});
+  void unsubscribe(SubscriptionId id);
+
+  /// \brief Returns the new version of the subscribed object if there is any since the last poll.
+  /// It queries the repository only if this subscription has already seen the results of the last query.
+  std::optional<Update> poll(SubscriptionId id);
+
+  /// \brief Pushes a new version of an object to all the matching subscriptions.
+  void notify(const std::string& path, const std::map<std::string, std::string>& metadata, const Update& update);
+
+  /// \brief Number of listing requests sent to the repository so far.
+  size_t getRequestCount() const;
+
+ private:
+  struct Subscription {
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    std::string lastMD5;
+    uint64_t lastCreated = 0;
+    std::optional<Update> pending;
+    uint64_t seenRound = 0;
+  };
+
+  struct ListedVersion {
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    Update update;
+  };
+
+  /// \brief Lists the versions under the prefix which were created since the last query (with a safety margin).
+  std::vector<ListedVersion> list(const std::string& prefix, uint64_t lastQueryTime, uint64_t queryTime);
+  void dispatch(const std::string& path, const std::map<std::string, std::string>& metadata, const Update& update);
+  /// \brief Returns the longest common prefix of the watched paths, or nothing if no path is watched.
+  std::optional<std::string> getListingPrefix() const;
+
+  std::string mDatabaseUrl;
+  std::unique_ptr<o2::ccdb::CcdbApi> mApi;
+  std::mutex mApiMutex; // CcdbApi is not thread-safe
+  mutable std::mutex mMutex;
+  bool mRefreshing = false;
+  std::map<SubscriptionId, Subscription> mSubscriptions;
+  SubscriptionId mNextId = 0;
+  uint64_t mRound = 0;
+  uint64_t mLastQueryTime = 0;
+  size_t mRequestCount = 0;
+};
+
+} // namespace o2::quality_control::postprocessing
+
+#endif //QUALITYCONTROL_REPOSITORYWATCHER_H
@@ -18,23 +18,63 @@
 #define QUALITYCONTROL_ROOTFILESOURCE_H
 
 #include <Framework/Task.h>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
+
+class TFile;
 
 namespace o2::quality_control::core
 {
 
-/// \brief A Data Processor which reads MonitorObjectCollections from a specified file
+class MonitorObjectCollection;
+
+/// \brief A Data Processor which reads MonitorObjectCollections from the specified files
+///
+/// One MonitorObjectCollection is published per invocation, so only a few of them are kept in memory at the same time.
+/// The next collections are read in the background while the current one is published, from several files at once if
+/// there are more of them. Only the collections of the requested tasks are read, the other keys are skipped.
 class RootFileSource : public framework::Task
 {
  public:
-  RootFileSource(std::string filePath);
-  ~RootFileSource() override = default;
+  /// \param filePaths - path to the input file, or a comma-separated list of paths
+  /// \param taskNames - names of the tasks whose MonitorObjectCollections should be published, all of them if empty
+  RootFileSource(std::string filePaths, std::vector<std::string> taskNames = {});
+  ~RootFileSource() override;
 
   void init(framework::InitContext& ictx) override;
   void run(framework::ProcessingContext& pctx) override;
 
+  /// \brief Returns the next collection to publish, or nullptr if all of them were returned. Called once per run().
+  ///
+  /// The collections which cannot be read are skipped.
+  std::unique_ptr<MonitorObjectCollection> readNext();
+
  private:
-  std::string mFilePath;
+  struct InputFile {
+    std::string path;
+    std::unique_ptr<TFile> file;
+    std::mutex mutex; // a TFile cannot be read by two threads at the same time
+  };
+  struct KeyToRead {
+    size_t fileIndex;
+    std::string name;
+  };
+
+  void readAhead();
+  std::unique_ptr<MonitorObjectCollection> read(InputFile& inputFile, const std::string& keyName);
+
+  std::vector<std::string> mFilePaths;
+  std::set<std::string> mTaskNames;
+  std::vector<std::unique_ptr<InputFile>> mFiles;
+  std::deque<KeyToRead> mKeysToRead;
+  size_t mMaxReadAhead = 1;
+  // declared after the files, so the pending reads are finished before the files are closed
+  std::deque<std::future<std::unique_ptr<MonitorObjectCollection>>> mReadAhead;
 };
 
 } // namespace o2::quality_control::core
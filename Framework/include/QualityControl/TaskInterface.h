@@ -29,8 +29,10 @@
 #include <Monitoring/Monitoring.h>
 // QC
 #include "QualityControl/Activity.h"
+#include "QualityControl/ConditionCache.h"
 #include "QualityControl/ObjectsManager.h"
 #include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/WorkerPool.h"
 
 namespace o2::ccdb
 {
@@ -90,6 +92,8 @@ class TaskInterface
   void setName(const std::string& name);
   void setCustomParameters(const std::unordered_map<std::string, std::string>& parameters);
   void setMonitoring(const std::shared_ptr<o2::monitoring::Monitoring>& mMonitoring);
+  void setWorkerPool(std::shared_ptr<WorkerPool> workerPool);
+  void setConditionCache(std::shared_ptr<ConditionCache> conditionCache);
   const std::string& getName() const;
   void setCcdbUrl(const std::string& url);
 
@@ -101,17 +105,41 @@ class TaskInterface
 
  protected:
   std::shared_ptr<ObjectsManager> getObjectsManager();
+
+  /// \brief Number of workers of the task, as configured with "workers" (1 by default).
+  size_t getNumberOfWorkers() const;
+  /// \brief Runs function(begin, end, worker) over the chunks of [0, n) on the workers of the task.
+  ///
+  /// The workers should fill only their own shards of the sharded histograms (see ObjectsManager::getShard) and must
+  /// not modify any other state shared with the other workers. The function returns once all the chunks are done.
+  void parallelFor(size_t n, const WorkerPool::Function& function, size_t grain = 0);
+
   TObject* retrieveCondition(std::string path, std::map<std::string, std::string> metadata = {}, long timestamp = -1);
   template <typename T>
   T* retrieveConditionAny(std::string const& path, std::map<std::string, std::string> const& metadata = {},
                           long timestamp = -1) const;
 
+  /// \brief Declares a condition which is needed by the task, so that it is retrieved at the start of each activity.
+  ///
+  /// To be called in initialize(). The condition should be then accessed with retrieveCachedCondition.
+  template <typename T>
+  void declareCondition(std::string const& path, std::map<std::string, std::string> const& metadata = {});
+  /// \brief Returns the condition from the cache of the task, which retrieves it from the CCDB only if needed.
+  ///
+  /// Contrary to retrieveConditionAny, the object is owned by the cache and it is served without waiting for the CCDB as
+  /// long as it is valid. See ConditionCache for details. Returns nullptr if the condition could not be retrieved.
+  template <typename T>
+  std::shared_ptr<const T> retrieveCachedCondition(std::string const& path, std::map<std::string, std::string> const& metadata = {},
+                                                   long timestamp = -1);
+
   std::unordered_map<std::string, std::string> mCustomParameters;
   std::shared_ptr<o2::monitoring::Monitoring> mMonitoring;
 
  private:
   std::string mName;
   std::shared_ptr<ObjectsManager> mObjectsManager;
+  std::shared_ptr<WorkerPool> mWorkerPool;
+  std::shared_ptr<ConditionCache> mConditionCache;
   std::shared_ptr<o2::ccdb::CcdbApi> mCcdbApi;
   std::string mCcdbUrl; // we need to keep the url in addition to the ccdbapi because we don't initialize the latter before the first call
 };
@@ -128,6 +156,25 @@ T* TaskInterface::retrieveConditionAny(std::string const& path, std::map<std::st
   }
 }
 
+template <typename T>
+void TaskInterface::declareCondition(std::string const& path, std::map<std::string, std::string> const& metadata)
+{
+  if (!mConditionCache) {
+    mConditionCache = std::make_shared<ConditionCache>(mCcdbUrl);
+  }
+  mConditionCache->declare<T>(path, metadata);
+}
+
+template <typename T>
+std::shared_ptr<const T> TaskInterface::retrieveCachedCondition(std::string const& path, std::map<std::string, std::string> const& metadata,
+                                                               long timestamp)
+{
+  if (!mConditionCache) {
+    mConditionCache = std::make_shared<ConditionCache>(mCcdbUrl);
+  }
+  return mConditionCache->get<T>(path, metadata, timestamp);
+}
+
 } // namespace o2::quality_control::core
 
 #endif // QC_CORE_TASKINTERFACE_H
@@ -27,9 +27,15 @@
 #include <Framework/InputSpan.h>
 #include <Headers/DataHeader.h>
 #include <Framework/InitContext.h>
+// STL
+#include <chrono>
 // QC
 #include "QualityControl/TaskRunnerConfig.h"
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/WorkerPool.h"
+#include "QualityControl/TimeslicePipeline.h"
+#include "QualityControl/BackgroundSerializer.h"
+#include "QualityControl/CycleClock.h"
 
 namespace o2::configuration
 {
@@ -82,8 +88,13 @@ class TaskRunner : public framework::Task
   void run(framework::ProcessingContext& pCtx) override;
 
   /// \brief TaskRunner's completion policy callback
+  ///
+  /// It expects the timer input to be the last one, as set by TaskRunnerFactory.
   static framework::CompletionPolicy::CompletionOp completionPolicyCallback(o2::framework::InputSpan const& inputs);
 
+  /// \brief Period of the timer input, which drives the cycle clock. A cycle ends at most one period after its deadline.
+  static constexpr int cycleClockTickMicroseconds = 100000;
+
   std::string getDeviceName() const { return mTaskConfig.deviceName; };
   const framework::Inputs& getInputsSpecs() const { return mTaskConfig.inputSpecs; };
   const framework::OutputSpec& getOutputSpec() const { return mTaskConfig.moSpec; };
@@ -111,25 +122,45 @@ class TaskRunner : public framework::Task
   /// \brief Callback for CallbackService::Id::Reset (DPL) a.k.a. RESET DEVICE transition (FairMQ)
   void reset();
 
-  std::tuple<bool /*data ready*/, bool /*timer ready*/> validateInputs(const framework::InputRecord&);
+  bool isDataReady(const framework::InputRecord&);
   void refreshConfig(framework::InitContext& iCtx);
   void initInfologger(framework::InitContext& iCtx);
   void printTaskConfig();
   void startOfActivity();
   void endOfActivity();
   void startCycle();
+  void mergeShards();
+  void mergeLanes();
   void finishCycle(framework::DataAllocator& outputs);
   int publish(framework::DataAllocator& outputs);
+  int publishAsync(framework::DataAllocator& outputs);
+  void sendSerialized(framework::DataAllocator& outputs, bool wait);
   void publishCycleStats();
-  void saveToFile();
+  void saveToFile(const MonitorObjectCollection& objects);
 
  private:
   TaskRunnerConfig mTaskConfig;
   std::shared_ptr<monitoring::Monitoring> mCollector;
   std::shared_ptr<TaskInterface> mTask;
   std::shared_ptr<ObjectsManager> mObjectsManager;
+  std::shared_ptr<WorkerPool> mWorkerPool;
+  // shared by all the instances of the task, the declared conditions are prefetched at each start of activity
+  std::shared_ptr<ConditionCache> mConditionCache;
   int mRunNumber;
 
+  /// \brief Additional instance of the task, which processes the timeslices in parallel to the main one.
+  struct Lane {
+    std::shared_ptr<ObjectsManager> objectsManager;
+    std::shared_ptr<WorkerPool> workerPool;
+    std::shared_ptr<TaskInterface> task;
+  };
+  // The lane 0 of the pipeline is the main task (mTask), the lane i is mLanes[i - 1].
+  // The pipeline is created only if there is more than one lane, otherwise the data is processed in run().
+  std::unique_ptr<TimeslicePipeline> mPipeline;
+  std::vector<Lane> mLanes;
+  // Only in the asynchronous publication mode, serializes a copy of the objects while the task keeps filling them.
+  std::unique_ptr<BackgroundSerializer> mSerializer;
+
   void updateMonitoringStats(framework::ProcessingContext& pCtx);
 
   bool mCycleOn = false;
@@ -141,9 +172,14 @@ class TaskRunner : public framework::Task
   int mNumberObjectsPublishedInCycle = 0;
   int mTotalNumberObjectsPublished = 0; // over a run
   double mLastPublicationDuration = 0;
+  double mLastShardsMergeDuration = 0;
+  double mLastLanesMergeDuration = 0;
+  double mLastCycleEndJitter = 0; // delay between the deadline of the last cycle and its actual end, in seconds
+  double mCycleStallDuration = 0;  // time spent by the processing thread on the publication in the cycle, in seconds
   uint64_t mDataReceivedInCycle = 0;
   AliceO2::Common::Timer mTimerTotalDurationActivity;
   AliceO2::Common::Timer mTimerDurationCycle;
+  CycleClock mCycleClock;
 };
 
 } // namespace o2::quality_control::core
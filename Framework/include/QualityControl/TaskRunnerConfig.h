@@ -52,6 +52,9 @@ struct TaskRunnerConfig {
   std::string activityPassName = "";
   std::string activityProvenance = "qc";
   int fallbackRunNumber = 0;
+  size_t workers = 1;
+  size_t timeslicePipeline = 1;
+  bool asyncPublication = false;
 };
 
 } // namespace o2::quality_control::core
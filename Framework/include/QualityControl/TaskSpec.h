@@ -59,6 +59,9 @@ struct TaskSpec {
   int maxNumberCycles = -1;
   size_t resetAfterCycles = 0;
   std::string saveObjectsToFile;
+  size_t workers = 1; // number of threads which may run the loops of the task, see TaskInterface::parallelFor
+  size_t timeslicePipeline = 1; // number of timeslices processed concurrently, each by its own instance of the task
+  bool asyncPublication = false; // serialize the objects on a background thread, see BackgroundSerializer
   std::unordered_map<std::string, std::string> customParameters = {};
   // multinode setups
   TaskLocationSpec location = TaskLocationSpec::Remote;
@@ -68,6 +71,9 @@ struct TaskSpec {
   std::string localControl = "aliecs";
   std::string mergingMode = "delta"; // todo as enum?
   int mergerCycleMultiplier = 1;
+  std::vector<int> mergerCycleMultipliers = {}; // per Merger layer, overrides mergerCycleMultiplier if not empty
+  std::vector<size_t> mergersPerLayer = {};      // explicit Merger topology, the last layer should have one Merger
+  size_t mergerReductionFactor = 0;              // max number of inputs per Merger, used if mergersPerLayer is empty
 };
 
 } // namespace o2::quality_control::core
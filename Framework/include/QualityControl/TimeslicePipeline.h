@@ -0,0 +1,106 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TimeslicePipeline.h
+///
+
+#ifndef QC_CORE_TIMESLICEPIPELINE_H
+#define QC_CORE_TIMESLICEPIPELINE_H
+
+#include <Framework/DataRef.h>
+#include <Framework/InputRecord.h>
+#include <Framework/InputSpan.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::framework
+{
+struct InputRoute;
+}
+
+namespace o2::quality_control::core
+{
+
+/// \brief Copy of the inputs of a timeslice, which stays valid after the DPL processing callback has returned.
+///
+/// The headers and payloads of all the parts of all the inputs are copied, missing inputs stay missing.
+/// The record() provides the same view of the data as the original InputRecord.
+class TimesliceInputs
+{
+ public:
+  TimesliceInputs(framework::InputRecord& inputs, const std::vector<framework::InputRoute>& routes);
+  TimesliceInputs(const TimesliceInputs&) = delete;
+  TimesliceInputs& operator=(const TimesliceInputs&) = delete;
+
+  framework::InputRecord& record() { return mRecord; }
+
+ private:
+  const char* copy(const char* data, size_t size);
+
+  std::vector<std::unique_ptr<char[]>> mBuffers;
+  std::vector<std::vector<framework::DataRef>> mRefs; // [input][part]
+  framework::InputSpan mSpan;
+  framework::InputRecord mRecord;
+};
+
+/// \brief Runs jobs on a fixed number of lanes, each of them with its own thread.
+///
+/// A lane runs one job at a time, so the jobs of a lane may use the state of that lane (e.g. an instance of a task)
+/// without locking. push() gives a job to an idle lane and returns immediately, or blocks until a lane becomes idle,
+/// which provides the backpressure to the caller. drain() waits until all the lanes are idle.
+class TimeslicePipeline
+{
+ public:
+  using Job = std::function<void(size_t lane)>;
+
+  explicit TimeslicePipeline(size_t lanes);
+  ~TimeslicePipeline();
+  TimeslicePipeline(const TimeslicePipeline&) = delete;
+  TimeslicePipeline& operator=(const TimeslicePipeline&) = delete;
+
+  size_t lanes() const { return mLanes.size(); }
+
+  /// \brief Gives the job to the first idle lane, waits for one if they are all busy.
+  ///
+  /// If a previous job has thrown, its exception is rethrown here and the job is not pushed.
+  void push(Job job);
+  /// \brief Waits until all the jobs are done. If a job has thrown, its exception is rethrown.
+  void drain();
+
+ private:
+  struct Lane {
+    Job job;
+    std::thread thread;
+  };
+
+  void laneLoop(size_t lane);
+  void rethrowLocked();
+
+  std::vector<Lane> mLanes;
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  std::condition_variable mLaneIdle;
+  size_t mBusyLanes = 0;
+  bool mStopping = false;
+  std::exception_ptr mException;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_TIMESLICEPIPELINE_H
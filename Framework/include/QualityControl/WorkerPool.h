@@ -0,0 +1,77 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   WorkerPool.h
+///
+
+#ifndef QC_CORE_WORKERPOOL_H
+#define QC_CORE_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Fixed pool of threads which run the loops of a task in parallel.
+///
+/// The thread which calls parallelFor() takes part in the work as the worker 0, the pool adds (size - 1) threads.
+/// Each worker has a stable index in [0, size), which tasks use to fill their own shard of the sharded objects
+/// (see ObjectsManager::startPublishingSharded). A pool of size 1 runs the loops inline.
+class WorkerPool
+{
+ public:
+  using Function = std::function<void(size_t begin, size_t end, size_t worker)>;
+
+  explicit WorkerPool(size_t size);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  size_t size() const { return mThreads.size() + 1; }
+
+  /// \brief Calls function(begin, end, worker) on chunks of [0, n), in parallel, and returns when all are done.
+  ///
+  /// Chunks are handed out dynamically, so that workers which are done early take over the remaining ones.
+  /// If grain is 0, the range is split in about 4 chunks per worker. If the function throws, the remaining chunks are
+  /// skipped and the first exception is rethrown by parallelFor. It must not be called concurrently.
+  void parallelFor(size_t n, const Function& function, size_t grain = 0);
+
+ private:
+  void workerLoop(size_t worker);
+  void work(size_t worker);
+
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  std::condition_variable mJobDone;
+  bool mStopping = false;
+  size_t mGeneration = 0;  // incremented for each job, so that the workers do not run a job twice
+  size_t mActiveWorkers = 0;
+
+  // current job
+  const Function* mFunction = nullptr;
+  size_t mSize = 0;
+  size_t mGrain = 1;
+  std::atomic<size_t> mNextChunk = 0;
+  std::exception_ptr mException;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_WORKERPOOL_H
@@ -15,7 +15,9 @@ SIZE_OBJECTS=(10);# 100 500 1000 2500 5000);# 10 100 1000);# in kB
 ### Misc variables
 # The log prefix will be followed by the benchmark description, e.g. 1 task 1 checker... or an id or both
 LOG_FILE_PREFIX=/tmp/logRepositoryBenchmark_
-NUMBER_CYCLES=120 ;# ec per cycle -> # seconds
+DURATION=120 ;# in seconds
+CLIENTS_PER_TASK=1 ;# concurrent clients in each process
+OPERATIONS="store:1" ;# e.g. store:70,retrieve:25,list:5
 PAUSE_BTW_RUNS=60 ;# in seconds, pause between tests
 DB_URL="ccdb-test.cern.ch:8080" ;#"aido2qc43:8080" ;#
 DB_USERNAME=""
@@ -23,7 +25,6 @@ DB_PASSWORD=""
 DB_NAME=""
 DB_BACKEND="CCDB"
 COMMAND_PREFIX="cd alice ; unset http_proxy ; unset https_proxy ; alienv setenv --no-refresh QualityControl/latest -c "
-MONITORING_URL="influxdb-udp://aido2mon.cern.ch:8087" ;#"influxdb-udp://aido2mon-gpn.cern.ch:8087"
 NODES=(
 "ccdb@aido2qc10"
 "ccdb@aido2qc40"
@@ -56,17 +57,12 @@ function startTask {
   number_tasks=$6
   log_file_name=${LOG_FILE_PREFIX}${log_file_suffix}.log
   echo "Starting task ${name} on host ${host}, logs in ${log_file_name}"
-    cmd="${COMMAND_PREFIX} repositoryBenchmark --max-iterations ${NUMBER_CYCLES} \
-        --id ${name} --mq-config ~/alice/QualityControl/Framework/alfa.json --number-tasks ${number_tasks}\
-        --delete 0 --control static --size-objects ${size_objects} --number-objects ${number_objects} \
-        --monitoring-url ${MONITORING_URL} --task-name ${name} \
+    cmd="${COMMAND_PREFIX} o2-qc-repository-benchmark --duration ${DURATION} \
+        --clients ${CLIENTS_PER_TASK} --operations ${OPERATIONS} \
+        --object-sizes ${size_objects} --number-objects ${number_objects} \
+        --task-name ${name} \
         --database-backend ${DB_BACKEND:-\"\"} \
-        --database-name ${DB_NAME:-\"\"} \
-        --database-username ${DB_USERNAME:-\"\"} \
-        --database-password ${DB_PASSWORD:-\"\"} \
         --database-url ${DB_URL:-\"\"} \
-        --monitoring-threaded 1 \
-        --monitoring-threaded-interval 1 \
         > ${log_file_name} 2>&1 "
   echo "ssh ${host} \"${cmd}\" &"
   ssh ${host} "${cmd}" &
@@ -88,13 +84,15 @@ function killAll {
 # Delete the database content
 # \param 1 : number of tasks
 # \param 2 : number of objects
+# \param 3 : size of the objects
 function cleanDatabase {
   number_tasks=$1
   number_objects=$2
+  size_objects=$3
   for (( task=0; task<$nb_tasks; task++ )); do
     name=benchmarkTask_${task}
-    cmd="repositoryBenchmark --id test --mq-config ~/dev/alice/QualityControl/Framework/alfa.json --delete 1 --control static \
-         --task-name ${name} --number-objects ${number_objects}" ;# > /dev/null 2>&1"
+    cmd="o2-qc-repository-benchmark --delete --database-url ${DB_URL} --task-name ${name} \
+         --object-sizes ${size_objects} --number-objects ${number_objects}" ;# > /dev/null 2>&1"
     echo ${cmd}
     eval ${cmd}
   done
@@ -115,7 +113,7 @@ for nb_tasks in ${NB_OF_TASKS[@]}; do
 
       echo "Kill all old processes"
       for machine in ${NODES[@]}; do
-        killAll "repositoryBenchmark" ${machine} "-9"
+        killAll "o2-qc-repository-benchmark" ${machine} "-9"
       done
 
       echo "Now start the tasks"
@@ -138,11 +136,11 @@ for nb_tasks in ${NB_OF_TASKS[@]}; do
       sleep 5 # leave time to finish
 
       for machine in ${NODES[@]}; do
-        killAll "repositoryBenchmark" ${machine} "-9"
+        killAll "o2-qc-repository-benchmark" ${machine} "-9"
       done
 
       echo "Delete database content"
-      cleanDatabase $nb_tasks
+      cleanDatabase $nb_tasks $nb_objects $size_objects
 
       sleep ${PAUSE_BTW_RUNS} # leave time to finish
 
@@ -21,6 +21,7 @@
 #include "QualityControl/UpdatePolicyType.h"
 #include <Common/Exceptions.h>
 
+#include <string_view>
 #include <utility>
 
 using namespace o2::quality_control::checker;
@@ -62,33 +63,29 @@ void Aggregator::init()
   }
 }
 
-QualityObjectsMapType Aggregator::filter(QualityObjectsMapType& qoMap)
+bool Aggregator::isSource(const std::string& qoName, const QualityObject& qo) const
 {
-  // This is a basic implementation, if it needs to be more efficient it will have to be rethought.
-  // for each qo in the list we receive, check if a source of this aggregator contains it (or rather
-  // contains the first part of its checkName before `/`).
+  // check if a source of this aggregator contains the qo (or rather contains the first part of its checkName before `/`).
+  std::string_view checkName = qo.getCheckName();
+  auto token = checkName.substr(0, checkName.find('/'));
+  auto it = std::find_if(mAggregatorConfig.sources.begin(), mAggregatorConfig.sources.end(),
+                         [&token](const AggregatorSource& source) { return token == source.name; });
+
+  // if no source found, it is not here
+  if (it == mAggregatorConfig.sources.end()) {
+    return false;
+  }
+
+  // search the qo in the objects of the source, if found we accept it.
+  // if the source has no qos specified we accept it.
+  return it->objects.empty() || find(it->objects.begin(), it->objects.end(), qoName) != it->objects.end();
+}
 
+QualityObjectsMapType Aggregator::filter(QualityObjectsMapType& qoMap)
+{
   QualityObjectsMapType result;
   for (auto const& [name, qo] : qoMap) {
-
-    // find the source for this qo
-    shared_ptr<const QualityObject> local = qo;
-    auto it = std::find_if(mAggregatorConfig.sources.begin(), mAggregatorConfig.sources.end(),
-                           [&local](const AggregatorSource source) {
-                             std::string token = local->getCheckName().substr(0, local->getCheckName().find("/"));
-                             return token == source.name;
-                           });
-
-    // if no source found, it is not here
-    if (it == mAggregatorConfig.sources.end()) {
-      continue;
-    }
-
-    // search the qo in the objects of the source, if found we accept it.
-    // if the source has no qos specified we accept it.
-    auto source = *it;
-    if (source.objects.empty() ||
-        find(source.objects.begin(), source.objects.end(), name) != source.objects.end()) { // no qo specified, we accept all
+    if (isSource(name, *qo)) {
       result[name] = qo;
     }
   }
@@ -98,10 +95,20 @@ QualityObjectsMapType Aggregator::filter(QualityObjectsMapType& qoMap)
 
 QualityObjectsType Aggregator::aggregate(QualityObjectsMapType& qoMap)
 {
+  // the filtered map is ours, the aggregator may modify it
   auto filtered = filter(qoMap);
-  auto results = mAggregatorInterface->aggregate(filtered);
+  return makeQualityObjects(mAggregatorInterface->aggregate(filtered));
+}
+
+QualityObjectsType Aggregator::aggregateSources(const QualityObjectsMapType& sourceQOs)
+{
+  return makeQualityObjects(mAggregatorInterface->aggregate(sourceQOs));
+}
+
+QualityObjectsType Aggregator::makeQualityObjects(const std::map<std::string, Quality>& qualities) const
+{
   QualityObjectsType qualityObjects;
-  for (auto const& [qualityName, quality] : results) {
+  for (auto const& [qualityName, quality] : qualities) {
     qualityObjects.emplace_back(std::make_shared<QualityObject>(
       quality,
       mAggregatorConfig.name + "/" + qualityName,
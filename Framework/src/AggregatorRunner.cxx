@@ -23,11 +23,13 @@
 #include <Monitoring/MonitoringFactory.h>
 #include <Monitoring/Monitoring.h>
 #include <Framework/InputRecordWalker.h>
+#include <Framework/DataRefUtils.h>
 #include <CommonUtils/ConfigurableParam.h>
 
 #include <utility>
 
 #include <TSystem.h>
+#include <TROOT.h>
 
 // QC
 #include "QualityControl/DatabaseFactory.h"
@@ -38,6 +40,8 @@
 #include "QualityControl/InfrastructureSpecReader.h"
 #include "QualityControl/AggregatorRunnerFactory.h"
 #include "QualityControl/RootClassFactory.h"
+#include "QualityControl/QualityObjectCodec.h"
+#include "QualityControl/WorkerPool.h"
 
 using namespace AliceO2::Common;
 using namespace AliceO2::InfoLogger;
@@ -179,12 +183,18 @@ void AggregatorRunner::run(framework::ProcessingContext& ctx)
   framework::InputRecord& inputs = ctx.inputs();
   for (auto const& ref : InputRecordWalker(inputs)) { // InputRecordWalker because the output of CheckRunner can be multi-part
     ILOG(Debug, Trace) << "AggregatorRunner received data" << ENDM;
+    auto dataHeader = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+    if (dataHeader->payloadSerializationMethod != o2::header::gSerializationMethodROOT) {
+      // a batch of QOs encoded with QualityObjectCodec, see CheckRunner::sendCompact
+      QualityObjectsBatchView batch(ref.payload, DataRefUtils::getPayloadSize(ref));
+      for (const auto& view : batch) {
+        receive(view.getName(), view.toQualityObject());
+      }
+      continue;
+    }
     shared_ptr<const QualityObject> qo = inputs.get<QualityObject*>(ref);
     if (qo != nullptr) {
-      ILOG(Debug, Trace) << "   It is a qo: " << qo->getName() << ENDM;
-      mQualityObjects[qo->getName()] = qo;
-      mTotalNumberObjectsReceived++;
-      updatePolicyManager.updateObjectRevision(qo->getName());
+      receive(qo->getName(), qo);
     }
   }
 
@@ -196,32 +206,83 @@ void AggregatorRunner::run(framework::ProcessingContext& ctx)
   sendPeriodicMonitoring();
 }
 
+void AggregatorRunner::receive(const std::string& name, std::shared_ptr<const QualityObject> qo)
+{
+  ILOG(Debug, Trace) << "   It is a qo: " << name << ENDM;
+  cacheQualityObject(name, std::move(qo));
+  mTotalNumberObjectsReceived++;
+}
+
+void AggregatorRunner::cacheQualityObject(const std::string& name, std::shared_ptr<const QualityObject> qo)
+{
+  // The aggregators using a QO depend only on its name, thus we look for them once.
+  auto sources = mSourcesOfQualityObject.find(name);
+  if (sources == mSourcesOfQualityObject.end()) {
+    std::vector<QualityObjectsMapType*> aggregatorsSources;
+    for (const auto& aggregator : mAggregators) {
+      if (aggregator->isSource(name, *qo)) {
+        aggregatorsSources.push_back(&mAggregatorsSources[aggregator->getName()]);
+      }
+    }
+    sources = mSourcesOfQualityObject.emplace(name, std::move(aggregatorsSources)).first;
+  }
+  for (auto* aggregatorSources : sources->second) {
+    (*aggregatorSources)[name] = qo;
+  }
+
+  mQualityObjects[name] = std::move(qo);
+  updatePolicyManager.updateObjectRevision(name);
+}
+
 QualityObjectsType AggregatorRunner::aggregate()
 {
   ILOG(Debug, Trace) << "Aggregate called in AggregatorRunner, QOs in cache: " << mQualityObjects.size() << ENDM;
 
   QualityObjectsType allQOs;
-  for (auto const& aggregator : mAggregators) {
-    string aggregatorName = aggregator->getName();
-    ILOG(Info, Devel) << "Processing aggregator: " << aggregatorName << ENDM;
-
-    if (updatePolicyManager.isReady(aggregatorName)) {
-      ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are  ready, aggregating" << ENDM;
-      auto newQOs = aggregator->aggregate(mQualityObjects); // we give the whole list
-      mTotalNumberObjectsProduced += newQOs.size();
-      mTotalNumberAggregatorExecuted++;
-      // we consider the output of the aggregators the same way we do the output of a check
-      for (const auto& qo : newQOs) {
-        mQualityObjects[qo->getName()] = qo;
-        updatePolicyManager.updateObjectRevision(qo->getName());
+  for (const auto& level : mAggregatorLevels) {
+    std::vector<std::shared_ptr<Aggregator>> readyAggregators;
+    for (const auto& aggregator : level) {
+      const auto& aggregatorName = aggregator->getName();
+      ILOG(Info, Devel) << "Processing aggregator: " << aggregatorName << ENDM;
+      if (updatePolicyManager.isReady(aggregatorName)) {
+        ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are  ready, aggregating" << ENDM;
+        readyAggregators.push_back(aggregator);
+      } else {
+        ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are not ready, ignoring" << ENDM;
       }
+    }
 
-      allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
-      newQOs.clear();
+    // The aggregators of one level do not depend on each other. Each of them reads its own sources, which are not
+    // modified until the whole level is done. They are copied only for the aggregators which may modify them.
+    std::vector<QualityObjectsType> newQOs(readyAggregators.size());
+    std::vector<double> durations(readyAggregators.size());
+    mWorkerPool->parallelFor(
+      readyAggregators.size(), [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+          AliceO2::Common::Timer timer;
+          timer.reset();
+          newQOs[i] = readyAggregators[i]->aggregateSources(mAggregatorsSources.at(readyAggregators[i]->getName()));
+          durations[i] = timer.getTime();
+        }
+      },
+      1);
+
+    // we consider the output of the aggregators the same way we do the output of a check
+    for (size_t i = 0; i < readyAggregators.size(); i++) {
+      const auto& aggregatorName = readyAggregators[i]->getName();
+      auto& latency = mAggregatorsLatencies[aggregatorName];
+      latency.sum += durations[i];
+      latency.max = std::max(latency.max, durations[i]);
+      latency.count++;
+
+      mTotalNumberObjectsProduced += newQOs[i].size();
+      mTotalNumberAggregatorExecuted++;
+      for (const auto& qo : newQOs[i]) {
+        cacheQualityObject(qo->getName(), qo);
+      }
+      allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs[i].begin()), std::make_move_iterator(newQOs[i].end()));
 
       updatePolicyManager.updateActorRevision(aggregatorName); // Was aggregated, update latest revision
-    } else {
-      ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are not ready, ignoring" << ENDM;
     }
   }
   return allQOs;
@@ -286,6 +347,7 @@ void AggregatorRunner::initAggregators()
                                     aggregator->getAllObjectsOption(),
                                     false);
       mAggregators.push_back(aggregator);
+      mAggregatorsSources[aggregator->getName()];
     } catch (...) {
       // catch the configuration exception and print it to avoid losing it
       ILOG(Error, Ops) << "Error creating aggregator '" << aggregatorConfig.name << "'"
@@ -295,6 +357,13 @@ void AggregatorRunner::initAggregators()
   }
 
   reorderAggregators();
+
+  if (mRunnerConfig.workers > 1) {
+    // the aggregators may use ROOT, e.g. to create new objects, in several threads at the same time
+    ROOT::EnableThreadSafety();
+  }
+  mWorkerPool = std::make_shared<WorkerPool>(mRunnerConfig.workers);
+  ILOG(Info, Devel) << "Aggregators are run in " << mAggregatorLevels.size() << " levels by " << mWorkerPool->size() << " threads" << ENDM;
 }
 
 void AggregatorRunner::initInfoLogger(InitContext& iCtx)
@@ -350,8 +419,11 @@ void AggregatorRunner::reorderAggregators()
   // Note that by "fulfilled" we mean that all the sources of an aggregator are already
   // in the result vector.
 
+  // The aggregators moved in the same iteration depend only on the ones moved earlier, thus they form one level.
+
   std::vector<std::shared_ptr<Aggregator>> originals = mAggregators;
   std::vector<std::shared_ptr<Aggregator>> results;
+  std::vector<std::vector<std::shared_ptr<Aggregator>>> levels;
   bool modificationLastIteration = true;
   // As long as there are items in original and we did some modifications in the last iteration
   while (!originals.empty() && modificationLastIteration) {
@@ -372,6 +444,9 @@ void AggregatorRunner::reorderAggregators()
       results.push_back(item);
       originals.erase(std::remove(originals.begin(), originals.end(), item), originals.end());
     }
+    if (!toBeMoved.empty()) {
+      levels.push_back(toBeMoved);
+    }
   }
 
   if (!originals.empty()) {
@@ -383,6 +458,7 @@ void AggregatorRunner::reorderAggregators()
   }
   assert(results.size() != mAggregators.size());
   mAggregators = results;
+  mAggregatorLevels = levels;
 }
 
 void AggregatorRunner::sendPeriodicMonitoring()
@@ -393,6 +469,18 @@ void AggregatorRunner::sendPeriodicMonitoring()
     mCollector->send({ mTotalNumberAggregatorExecuted, "qc_aggregator_executed" });
     mCollector->send({ mTotalNumberObjectsProduced, "qc_aggregator_objects_produced" });
     mCollector->send({ mTimerTotalDurationActivity.getTime(), "qc_aggregator_duration" });
+    if (!mAggregatorsLatencies.empty()) {
+      // durations of aggregate() in seconds, one value per aggregator
+      Metric meanLatencies{ "qc_aggregator_latency_mean" };
+      Metric maxLatencies{ "qc_aggregator_latency_max" };
+      for (const auto& [aggregatorName, latency] : mAggregatorsLatencies) {
+        meanLatencies.addValue(latency.sum / latency.count, aggregatorName);
+        maxLatencies.addValue(latency.max, aggregatorName);
+      }
+      mCollector->send(std::move(meanLatencies));
+      mCollector->send(std::move(maxLatencies));
+      mAggregatorsLatencies.clear();
+    }
   }
 }
 
@@ -82,6 +82,7 @@ AggregatorRunnerConfig AggregatorRunnerFactory::extractRunnerConfig(const core::
     commonSpec.activityPeriodName,
     commonSpec.activityPassName,
     commonSpec.activityProvenance,
+    commonSpec.aggregatorRunnerWorkers,
     options
   };
 }
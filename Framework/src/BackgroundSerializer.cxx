@@ -0,0 +1,150 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   BackgroundSerializer.cxx
+///
+
+#include "QualityControl/BackgroundSerializer.h"
+#include "QualityControl/MonitorObject.h"
+
+#include <Common/Timer.h>
+#include <TH1.h>
+#include <TMessage.h>
+#include <stdexcept>
+
+namespace o2::quality_control::core
+{
+
+BackgroundSerializer::BackgroundSerializer(Callback afterSerialization)
+  : mAfterSerialization(std::move(afterSerialization))
+{
+  mThread = std::thread([this]() { serializerLoop(); });
+}
+
+BackgroundSerializer::~BackgroundSerializer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mStateChanged.notify_all();
+  mThread.join();
+}
+
+void BackgroundSerializer::push(const MonitorObjectCollection& objects)
+{
+  // the copy is done on the calling thread, as it is the only one allowed to touch the live objects
+  auto shadow = copy(objects);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mState != State::Idle) {
+    throw std::logic_error("The previous set of MonitorObjects has not been taken from the BackgroundSerializer");
+  }
+  mShadow = std::move(shadow);
+  mState = State::Serializing;
+  mStateChanged.notify_all();
+}
+
+std::unique_ptr<TMessage> BackgroundSerializer::take(bool wait)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  if (wait) {
+    mStateChanged.wait(lock, [this]() { return mState != State::Serializing; });
+  }
+  if (mState != State::Done) {
+    return nullptr;
+  }
+  mState = State::Idle;
+  if (mException) {
+    auto exception = mException;
+    mException = nullptr;
+    std::rethrow_exception(exception);
+  }
+  return std::move(mSerialized);
+}
+
+bool BackgroundSerializer::isPending()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mState != State::Idle;
+}
+
+double BackgroundSerializer::getLastSerializationDuration()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mLastSerializationDuration;
+}
+
+std::unique_ptr<MonitorObjectCollection> BackgroundSerializer::copy(const MonitorObjectCollection& objects)
+{
+  auto shadow = std::make_unique<MonitorObjectCollection>();
+  shadow->SetOwner(true);
+  for (const auto* object : objects) {
+    auto mo = dynamic_cast<const MonitorObject*>(object);
+    if (mo == nullptr || mo->getObject() == nullptr) {
+      continue;
+    }
+    // the copy constructor of MonitorObject copies only the pointer to the object, so we replace it with a clone
+    auto moCopy = new MonitorObject(*mo);
+    auto objectCopy = mo->getObject()->Clone();
+    if (auto histogram = dynamic_cast<TH1*>(objectCopy)) {
+      histogram->SetDirectory(nullptr);
+    }
+    moCopy->setObject(objectCopy);
+    moCopy->setIsOwner(true);
+    shadow->Add(moCopy);
+  }
+  return shadow;
+}
+
+void BackgroundSerializer::serializerLoop()
+{
+  while (true) {
+    std::unique_ptr<MonitorObjectCollection> shadow;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mStateChanged.wait(lock, [this]() { return mStopping || mState == State::Serializing; });
+      if (mStopping) {
+        return;
+      }
+      shadow = std::move(mShadow);
+    }
+
+    AliceO2::Common::Timer serializationTimer;
+    std::unique_ptr<TMessage> serialized;
+    std::exception_ptr exception;
+    try {
+      // this is what a DPL snapshot of a MonitorObjectCollection does
+      serialized = std::make_unique<TMessage>(kMESS_OBJECT);
+      serialized->WriteObjectAny(shadow.get(), MonitorObjectCollection::Class());
+      if (mAfterSerialization) {
+        mAfterSerialization(*shadow);
+      }
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    auto duration = serializationTimer.getTime();
+    // the shadow set is deleted outside of the lock
+    shadow.reset();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mSerialized = std::move(serialized);
+      mException = exception;
+      mLastSerializationDuration = duration;
+      mState = State::Done;
+    }
+    mStateChanged.notify_all();
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -37,7 +37,9 @@
 // std
 #include <chrono>
 #include <sstream>
-#include <filesystem>
+#include <streambuf>
+#include <atomic>
+#include <thread>
 #include <unordered_set>
 // boost
 #include <boost/property_tree/json_parser.hpp>
@@ -57,6 +59,19 @@ using namespace rapidjson;
 namespace o2::quality_control::repository
 {
 
+namespace
+{
+/// \brief Read-only std::streambuf over a memory region, so we can stream objects from it without copying it.
+class MemoryStreamBuffer : public std::streambuf
+{
+ public:
+  MemoryStreamBuffer(char* data, size_t size)
+  {
+    setg(data, data, data + size);
+  }
+};
+} // namespace
+
 CcdbDatabase::~CcdbDatabase() { disconnect(); }
 
 void CcdbDatabase::loadDeprecatedStreamerInfos()
@@ -108,6 +123,9 @@ void CcdbDatabase::connect(const std::unordered_map<std::string, std::string>& c
   if (config.count("maxObjectSize")) {
     mMaxObjectSize = std::stoi(config.at("maxObjectSize"));
   }
+  if (config.count("maxConcurrentRequests")) {
+    mMaxConcurrentRequests = std::max(1, std::stoi(config.at("maxConcurrentRequests")));
+  }
 }
 
 void CcdbDatabase::init()
@@ -302,9 +320,14 @@ void CcdbDatabase::storeTRFC(std::shared_ptr<const o2::quality_control::TimeRang
 }
 
 TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
+{
+  return retrieveTObject(ccdbApi, path, metadata, timestamp, headers);
+}
+
+TObject* CcdbDatabase::retrieveTObject(o2::ccdb::CcdbApi& api, const std::string& path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
 {
   // we try first to load a TFile
-  auto* object = ccdbApi.retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
+  auto* object = api.retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
   if (object == nullptr) {
     ILOG(Error, Support) << "We could NOT retrieve the object " << path << " with timestamp " << timestamp << "." << ENDM;
     return nullptr;
@@ -365,11 +388,16 @@ std::shared_ptr<o2::quality_control::core::MonitorObject> CcdbDatabase::retrieve
 }
 
 std::shared_ptr<o2::quality_control::core::QualityObject> CcdbDatabase::retrieveQO(std::string qoPath, long timestamp, const core::Activity& activity)
+{
+  return retrieveQO(ccdbApi, qoPath, timestamp, activity);
+}
+
+std::shared_ptr<o2::quality_control::core::QualityObject> CcdbDatabase::retrieveQO(o2::ccdb::CcdbApi& api, const std::string& qoPath, long timestamp, const core::Activity& activity)
 {
   map<string, string> headers;
   map<string, string> metadata = database_helpers::asDatabaseMetadata(activity, false);
   auto fullPath = activity.mProvenance + "/" + qoPath;
-  TObject* obj = retrieveTObject(fullPath, metadata, timestamp, &headers);
+  TObject* obj = retrieveTObject(api, fullPath, metadata, timestamp, &headers);
   std::shared_ptr<QualityObject> qo(dynamic_cast<QualityObject*>(obj));
   if (qo == nullptr) {
     ILOG(Error, Devel) << "Could not cast the object " << fullPath << " to QualityObject" << ENDM;
@@ -383,6 +411,11 @@ std::shared_ptr<o2::quality_control::core::QualityObject> CcdbDatabase::retrieve
 }
 
 std::shared_ptr<o2::quality_control::TimeRangeFlagCollection> CcdbDatabase::retrieveTRFC(const std::string& trfcName, const std::string& detector, int runNumber, const string& passName, const string& periodName, const std::string& provenance, long timestamp)
+{
+  return retrieveTRFC(ccdbApi, trfcName, detector, runNumber, passName, periodName, provenance, timestamp);
+}
+
+std::shared_ptr<o2::quality_control::TimeRangeFlagCollection> CcdbDatabase::retrieveTRFC(o2::ccdb::CcdbApi& api, const std::string& trfcName, const std::string& detector, int runNumber, const string& passName, const string& periodName, const std::string& provenance, long timestamp)
 {
   map<string, string> headers;
   map<string, string> metadata;
@@ -396,48 +429,81 @@ std::shared_ptr<o2::quality_control::TimeRangeFlagCollection> CcdbDatabase::retr
     metadata["PeriodName"] = periodName;
   }
   const auto trfcPath = RepoPathUtils::getTrfcPath(detector, trfcName, provenance);
-  const std::string localFileDir = "/tmp";
-  const std::string localFileName = "trfc_" + trfcName + std::to_string(time_point_cast<nanoseconds>(system_clock::now()).time_since_epoch().count());
-  const std::string localFilePath = localFileDir + std::filesystem::path::preferred_separator + localFileName;
-  if (localFilePath.find("..") != std::string::npos || localFilePath.find('~') != std::string::npos) {
-    ILOG(Error, Support) << "The path '" << localFilePath << "' looks hacky, will not download any files there." << ENDM;
-    return nullptr;
-  }
 
-  auto resultMetadata = ccdbApi.retrieveHeaders(trfcPath, metadata, timestamp);
-  if (resultMetadata.empty()) {
-    ILOG(Error, Support) << "Could not extract headers of TRFC at '" << trfcPath << "' with the metadata: " << ENDM; // TODO
+  // Headers and body come with the same response, the blob is kept in memory.
+  std::vector<char> buffer;
+  api.loadFileToMemory(buffer, trfcPath, metadata, timestamp, &headers, "", "", "", false);
+  if (buffer.empty() || headers.count("Valid-From") == 0 || headers.count("Valid-Until") == 0) {
+    ILOG(Error, Support) << "Could not retrieve the TRFC at '" << trfcPath << "' with the metadata: " << ENDM;
     ILOG(Error, Support) << " - RunNumber  : " << metadata["RunNumber"] << ENDM;
     ILOG(Error, Support) << " - PassName   : " << metadata["PassName"] << ENDM;
     ILOG(Error, Support) << " - PeriodName : " << metadata["PeriodName"] << ENDM;
     return nullptr;
   }
 
-  auto success = ccdbApi.retrieveBlob(trfcPath, localFileDir, metadata, timestamp, false, localFileName);
-  if (!success) {
-    ILOG(Error, Support) << "Could not retrieve the TRFC at '" << trfcPath << "' with the metadata: " << ENDM; // TODO
-    ILOG(Error, Support) << " - RunNumber  : " << metadata["RunNumber"] << ENDM;
-    ILOG(Error, Support) << " - PassName   : " << metadata["PassName"] << ENDM;
-    ILOG(Error, Support) << " - PeriodName : " << metadata["PeriodName"] << ENDM;
-    return nullptr;
-  }
-
-  std::ifstream localFile(localFilePath);
-  if (!localFile.is_open()) {
-    ILOG(Error, Support) << "Could not open a file at '" << localFilePath << "'" << ENDM;
-    std::filesystem::remove(localFilePath);
-    return nullptr;
-  }
+  MemoryStreamBuffer streamBuffer(buffer.data(), buffer.size());
+  std::istream stream(&streamBuffer);
 
-  TimeRangeFlagCollection::RangeInterval validity{ std::stoull(resultMetadata["Valid-From"]), std::stoull(resultMetadata["Valid-Until"]) };
+  TimeRangeFlagCollection::RangeInterval validity{ std::stoull(headers["Valid-From"]), std::stoull(headers["Valid-Until"]) };
   auto trfc = std::make_shared<TimeRangeFlagCollection>(trfcName, detector, validity, runNumber, periodName, passName, provenance);
-  trfc->streamFrom(localFile);
-  localFile.close();
-  std::filesystem::remove(localFilePath);
+  trfc->streamFrom(stream);
 
   return trfc;
 }
 
+std::vector<std::shared_ptr<o2::quality_control::TimeRangeFlagCollection>> CcdbDatabase::retrieveTRFCs(const std::string& trfcName, const std::string& detector, const std::vector<int>& runNumbers, const string& passName, const string& periodName, const std::string& provenance, long timestamp)
+{
+  std::vector<std::shared_ptr<TimeRangeFlagCollection>> results(runNumbers.size());
+  runConcurrently(runNumbers.size(), [&](o2::ccdb::CcdbApi& api, size_t i) {
+    results[i] = retrieveTRFC(api, trfcName, detector, runNumbers[i], passName, periodName, provenance, timestamp);
+  });
+  return results;
+}
+
+std::vector<std::shared_ptr<o2::quality_control::core::QualityObject>> CcdbDatabase::retrieveQOs(const std::string& qoPath, const std::vector<long>& timestamps, const core::Activity& activity)
+{
+  std::vector<std::shared_ptr<QualityObject>> results(timestamps.size());
+  runConcurrently(timestamps.size(), [&](o2::ccdb::CcdbApi& api, size_t i) {
+    results[i] = retrieveQO(api, qoPath, timestamps[i], activity);
+  });
+  return results;
+}
+
+void CcdbDatabase::runConcurrently(size_t count, const std::function<void(o2::ccdb::CcdbApi&, size_t)>& task)
+{
+  if (count == 0) {
+    return;
+  }
+
+  // Each worker picks the next index until all of them are processed, we do not spawn one thread per index
+  // to avoid flooding the CCDB server with requests.
+  std::atomic<size_t> next = 0;
+  auto worker = [&](o2::ccdb::CcdbApi& api) {
+    for (size_t i = next++; i < count; i = next++) {
+      task(api, i);
+    }
+  };
+  const size_t nWorkers = std::min(count, mMaxConcurrentRequests);
+  if (nWorkers > 1) {
+    // the workers deserialize the retrieved objects with ROOT concurrently
+    ROOT::EnableThreadSafety();
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(nWorkers - 1);
+  for (size_t i = 1; i < nWorkers; i++) {
+    // CcdbApi is not thread-safe, each additional worker gets its own instance
+    workers.emplace_back([&]() {
+      o2::ccdb::CcdbApi api;
+      api.init(mUrl);
+      worker(api);
+    });
+  }
+  worker(ccdbApi);
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
 std::string CcdbDatabase::retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata)
 {
   map<string, string> headers;
@@ -563,7 +629,9 @@ std::vector<uint64_t> CcdbDatabase::getTimestampsForObject(std::string path)
   // As for today, we receive objects in the order of the newest to the oldest.
   // We prefer the other order here.
   for (auto rit = objects.rbegin(); rit != objects.rend(); ++rit) {
-    timestamps.emplace_back(rit->second.get<uint64_t>("Valid-From"));
+    // the JSON listings of the CCDB name the validity "validFrom", the older ones used the header name
+    auto validFrom = rit->second.get_optional<uint64_t>("validFrom");
+    timestamps.emplace_back(validFrom ? *validFrom : rit->second.get<uint64_t>("Valid-From"));
   }
 
   // we make sure it is sorted. If it is already, it shouldn't cost much.
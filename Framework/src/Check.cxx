@@ -13,9 +13,6 @@
 
 #include <memory>
 #include <algorithm>
-// boost
-#include <boost/range/adaptor/map.hpp>
-#include <boost/range/algorithm/copy.hpp>
 #include <utility>
 // ROOT
 #include <TClass.h>
@@ -82,47 +79,55 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Attempting to check, but no CheckInterface is loaded"));
   }
 
-  std::map<std::string, std::shared_ptr<MonitorObject>> shadowMap;
-  // Take only the MOs which are needed to be checked
+  // Take only the MOs which are needed to be checked.
+  // The selection points to the entries of moMap, so that neither the map nor the MOs are copied.
+  mSelection.clear();
   if (mCheckConfig.allObjects) {
     /*
      * User didn't specify the MOs.
      * All MOs are passed, no shadowing needed.
      */
-    shadowMap = moMap;
+    for (const auto& item : moMap) {
+      mSelection.push_back(&item);
+    }
   } else {
     /*
      * Shadow MOs.
      * Don't pass MOs that weren't specified by user.
-     * The user might safely rely on getting only required MOs inside the map.
-     *
-     * Implementation: Copy to different map only required MOs.
+     * The user might safely rely on getting only required MOs inside the view.
      */
     for (auto& key : mCheckConfig.objectNames) {
-      // don't create empty shared_ptr
-      if (moMap.count(key)) {
-        shadowMap.insert({ key, moMap[key] });
+      auto item = moMap.find(key);
+      if (item != moMap.end()) {
+        mSelection.push_back(&*item);
       }
     }
+    // the view is sorted by names, as the map was
+    std::sort(mSelection.begin(), mSelection.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    mSelection.erase(std::unique(mSelection.begin(), mSelection.end()), mSelection.end());
   }
 
-  // Prepare a vector of MO maps to be checked, each one will receive a separate Quality.
-  std::vector<std::map<std::string, std::shared_ptr<MonitorObject>>> moMapsToCheck;
+  // Prepare the views to be checked, each one will receive a separate Quality.
+  std::vector<MonitorObjectsView> viewsToCheck;
   if (mCheckConfig.policyType == UpdatePolicyType::OnEachSeparately) {
     // In this case we want to check all MOs separately and we get separate QOs for them.
-    for (auto mo : shadowMap) {
-      moMapsToCheck.push_back({ std::move(mo) });
+    viewsToCheck.reserve(mSelection.size());
+    for (size_t i = 0; i < mSelection.size(); i++) {
+      viewsToCheck.emplace_back(mSelection.data() + i, mSelection.data() + i + 1);
     }
   } else {
-    moMapsToCheck.emplace_back(shadowMap);
+    viewsToCheck.emplace_back(mSelection.data(), mSelection.data() + mSelection.size());
   }
 
   QualityObjectsType qualityObjects;
-  for (auto& moMapToCheck : moMapsToCheck) {
+  for (const auto& viewToCheck : viewsToCheck) {
     std::vector<std::string> monitorObjectsNames;
-    boost::copy(moMapToCheck | boost::adaptors::map_keys, std::back_inserter(monitorObjectsNames));
+    monitorObjectsNames.reserve(viewToCheck.size());
+    for (const auto& item : viewToCheck) {
+      monitorObjectsNames.push_back(item.first);
+    }
 
-    auto quality = mCheckInterface->check(&moMapToCheck);
+    auto quality = mCheckInterface->checkView(viewToCheck);
     ILOG(Info, Support) << "Check '" << mCheckConfig.name << "', quality '" << quality << "'" << ENDM;
     // todo: take metadata from somewhere
     qualityObjects.emplace_back(std::make_shared<QualityObject>(
@@ -131,23 +136,22 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
       mCheckConfig.detectorName,
       UpdatePolicyTypeUtils::ToString(mCheckConfig.policyType),
       stringifyInput(mCheckConfig.inputSpecs),
-      monitorObjectsNames));
-    beautify(moMapToCheck, quality);
+      std::move(monitorObjectsNames)));
+    beautify(viewToCheck, quality);
   }
 
   return qualityObjects;
 }
 
-void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, Quality quality)
+void Check::beautify(const MonitorObjectsView& moView, Quality quality)
 {
   if (!mCheckConfig.allowBeautify) {
     return;
   }
 
-  for (auto const& item : moMap) {
-    mCheckInterface->beautify(item.second /*mo*/, quality);
-  }
+  mCheckInterface->beautifyView(moView, quality);
 }
+
 UpdatePolicyType Check::getUpdatePolicyType() const
 {
   return mCheckConfig.policyType;
@@ -17,6 +17,8 @@
 #include "QualityControl/CheckInterface.h"
 
 #include <TClass.h>
+#include <Common/Exceptions.h>
+#include <vector>
 
 ClassImp(o2::quality_control::checker::CheckInterface)
 
@@ -25,6 +27,46 @@ ClassImp(o2::quality_control::checker::CheckInterface)
 namespace o2::quality_control::checker
 {
 
+namespace
+{
+// set while checkWithView() runs, to tell a missing override of checkView() from an endless recursion
+thread_local bool checkingWithView = false;
+} // namespace
+
+Quality CheckInterface::checkView(const MonitorObjectsView& moView)
+{
+  if (checkingWithView) {
+    BOOST_THROW_EXCEPTION(AliceO2::Common::FatalException() << AliceO2::Common::errinfo_details("The check implements check() with checkWithView(), but it does not override checkView()"));
+  }
+  auto moMap = moView.toMap();
+  return check(&moMap);
+}
+
+Quality CheckInterface::checkWithView(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap)
+{
+  std::vector<const MonitorObjectsView::value_type*> entries;
+  entries.reserve(moMap->size());
+  for (const auto& entry : *moMap) {
+    entries.push_back(&entry);
+  }
+  checkingWithView = true;
+  try {
+    auto quality = checkView(MonitorObjectsView(entries.data(), entries.data() + entries.size()));
+    checkingWithView = false;
+    return quality;
+  } catch (...) {
+    checkingWithView = false;
+    throw;
+  }
+}
+
+void CheckInterface::beautifyView(const MonitorObjectsView& moView, Quality checkResult)
+{
+  for (const auto& [name, mo] : moView) {
+    beautify(mo, checkResult);
+  }
+}
+
 std::string CheckInterface::getAcceptedType() { return "TObject"; }
 
 bool CheckInterface::isObjectCheckable(const std::shared_ptr<MonitorObject> mo)
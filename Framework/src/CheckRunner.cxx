@@ -33,6 +33,7 @@
 #include "QualityControl/InfrastructureSpecReader.h"
 #include "QualityControl/CheckRunnerFactory.h"
 #include "QualityControl/RootClassFactory.h"
+#include "QualityControl/QualityObjectCodec.h"
 
 #include <TSystem.h>
 
@@ -270,18 +271,18 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
       if (tobj->InheritsFrom("TObjArray")) {
         array.reset(dynamic_cast<TObjArray*>(tobj.release()));
         array->SetOwner(false);
-        ILOG(Info, Support) << "CheckRunner " << mDeviceName
-                            << " received an array with " << array->GetEntries()
-                            << " entries from " << input.binding << ENDM;
+        ILOG_RATE_LIMITED(Info, Support, 10) << "CheckRunner " << mDeviceName
+                                             << " received an array with " << array->GetEntries()
+                                             << " entries from " << input.binding << ENDM;
       } else {
         // it is just a TObject not embedded in a TObjArray. We build a TObjArray for it.
         auto* newArray = new TObjArray();    // we cannot use `array` to add an object as it is const
         TObject* newTObject = tobj->Clone(); // we need a copy to avoid that it gets deleted behind our back.
         newArray->Add(newTObject);
         array.reset(newArray); // now that the array is ready we can adopt it.
-        ILOG(Info, Support) << "CheckRunner " << mDeviceName
-                            << " received a tobject named " << tobj->GetName()
-                            << " from " << input.binding << ENDM;
+        ILOG_RATE_LIMITED(Info, Support, 10) << "CheckRunner " << mDeviceName
+                                             << " received a tobject named " << tobj->GetName()
+                                             << " from " << input.binding << ENDM;
       }
 
       // for each item of the array, check whether it is a MonitorObject. If not, create one and encapsulate.
@@ -383,6 +384,10 @@ void CheckRunner::send(QualityObjectsType& qualityObjects, framework::DataAlloca
   // This should be fine if they are retrieved on the other side with InputRecordWalker.
 
   ILOG(Info, Support) << "Sending " << qualityObjects.size() << " quality objects" << ENDM;
+  if (mConfig.compactQualityObjects) {
+    sendCompact(qualityObjects, allocator);
+    return;
+  }
   for (const auto& qo : qualityObjects) {
     const auto& correspondingCheck = mChecks.at(qo->getCheckName());
     auto outputSpec = correspondingCheck.getOutputSpec();
@@ -393,6 +398,25 @@ void CheckRunner::send(QualityObjectsType& qualityObjects, framework::DataAlloca
   }
 }
 
+void CheckRunner::sendCompact(QualityObjectsType& qualityObjects, framework::DataAllocator& allocator)
+{
+  // One message per check output, the QOs are encoded one after another in the same buffer.
+  std::map<std::string, QualityObjectsType> qualityObjectsPerCheck;
+  for (const auto& qo : qualityObjects) {
+    qualityObjectsPerCheck[qo->getCheckName()].push_back(qo);
+  }
+
+  for (const auto& [checkName, checkQualityObjects] : qualityObjectsPerCheck) {
+    auto outputSpec = mChecks.at(checkName).getOutputSpec();
+    auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(outputSpec);
+    auto buffer = allocator.make<char>(
+      framework::Output{ concreteOutput.origin, concreteOutput.description, concreteOutput.subSpec, outputSpec.lifetime },
+      QualityObjectCodec::getEncodedSize(checkQualityObjects));
+    QualityObjectCodec::encode(checkQualityObjects, buffer.data(), buffer.size());
+    mTotalQOSent += checkQualityObjects.size();
+  }
+}
+
 void CheckRunner::updateServiceDiscovery(const QualityObjectsType& qualityObjects)
 {
   if (mServiceDiscovery == nullptr) {
@@ -0,0 +1,255 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ConditionCache.cxx
+///
+
+#include "QualityControl/ConditionCache.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TROOT.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+long nowMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+long parseHeader(const std::map<std::string, std::string>& headers, const std::string& name, long defaultValue)
+{
+  if (auto header = headers.find(name); header != headers.end()) {
+    try {
+      return std::stol(header->second);
+    } catch (const std::exception&) {
+      // we use the default
+    }
+  }
+  return defaultValue;
+}
+
+std::string makeKey(const std::string& path, const std::map<std::string, std::string>& metadata, std::type_index type)
+{
+  std::string key = path;
+  for (const auto& [name, value] : metadata) {
+    key += "/" + name + "=" + value;
+  }
+  return key + "#" + type.name();
+}
+} // namespace
+
+ConditionCache::ConditionCache(const std::string& url) : mUrl(url)
+{
+}
+
+ConditionCache::~ConditionCache()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mWorkAvailable.notify_all();
+  if (mThread.joinable()) {
+    mThread.join();
+  }
+}
+
+void ConditionCache::declare(const std::string& path, const std::map<std::string, std::string>& metadata, std::type_index type, Fetcher fetcher)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  findOrCreate(path, metadata, type, fetcher);
+}
+
+std::shared_ptr<const void> ConditionCache::get(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp,
+                                                std::type_index type, Fetcher fetcher)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  auto key = makeKey(path, metadata, type);
+  auto& entry = findOrCreate(path, metadata, type, fetcher);
+
+  long requested = timestamp < 0 ? nowMs() : timestamp;
+  if (entry.object && entry.validFrom <= requested && requested < entry.validUntil) {
+    mHits++;
+    return entry.object;
+  }
+  if (entry.object && timestamp < 0 && entry.timestamp < 0) {
+    // the current object has just expired, we serve it while its successor is being retrieved
+    enqueueLocked(key, entry);
+    mHits++;
+    return entry.object;
+  }
+
+  mMisses++;
+  if (entry.timestamp != timestamp && entry.pending) {
+    // another version of the object is being retrieved, we wait for it not to be overwritten afterwards
+    mFetched.wait(lock, [&entry]() { return !entry.pending; });
+  }
+  entry.timestamp = timestamp;
+  enqueueLocked(key, entry);
+  mFetched.wait(lock, [&entry]() { return !entry.pending; });
+
+  // a failed retrieval keeps the previous object, which is not valid at the requested timestamp
+  requested = timestamp < 0 ? nowMs() : timestamp;
+  if (!entry.object || requested < entry.validFrom || entry.validUntil <= requested) {
+    ILOG(Warning, Support) << "Could not retrieve the condition '" << path << "' valid at " << requested << ENDM;
+    return nullptr;
+  }
+  return entry.object;
+}
+
+void ConditionCache::prefetch()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (auto& [key, entry] : mEntries) {
+    if (!entry.pending) {
+      entry.timestamp = -1;
+      enqueueLocked(key, entry);
+    }
+  }
+}
+
+void ConditionCache::setDefaultValidity(long milliseconds)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mDefaultValidity = milliseconds;
+}
+
+void ConditionCache::setRetryDelay(long milliseconds)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mRetryDelay = milliseconds;
+}
+
+size_t ConditionCache::getHits() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mHits;
+}
+
+size_t ConditionCache::getMisses() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mMisses;
+}
+
+ConditionCache::Entry& ConditionCache::findOrCreate(const std::string& path, const std::map<std::string, std::string>& metadata, std::type_index type, Fetcher& fetcher)
+{
+  auto key = makeKey(path, metadata, type);
+  auto entry = mEntries.find(key);
+  if (entry == mEntries.end()) {
+    Entry newEntry;
+    newEntry.path = path;
+    newEntry.metadata = metadata;
+    newEntry.fetcher = std::move(fetcher);
+    entry = mEntries.emplace(key, std::move(newEntry)).first;
+    startLocked();
+  }
+  return entry->second;
+}
+
+void ConditionCache::startLocked()
+{
+  if (mThread.joinable()) {
+    return;
+  }
+  // the conditions are deserialized on the background thread while the task uses ROOT
+  ROOT::EnableThreadSafety();
+  mCcdbApi.init(mUrl);
+  mThread = std::thread([this]() { fetcherLoop(); });
+}
+
+void ConditionCache::enqueueLocked(const std::string& key, Entry& entry)
+{
+  if (entry.pending) {
+    return;
+  }
+  entry.pending = true;
+  mQueue.push_back(key);
+  mWorkAvailable.notify_all();
+}
+
+void ConditionCache::fetcherLoop()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (!mStopping) {
+    // the current conditions are refreshed when their validity ends
+    long now = nowMs();
+    long nextRefresh = LONG_MAX;
+    for (auto& [key, entry] : mEntries) {
+      if (entry.timestamp >= 0 || entry.pending || entry.nextRefresh == 0) {
+        continue;
+      }
+      if (entry.nextRefresh <= now) {
+        enqueueLocked(key, entry);
+      } else {
+        nextRefresh = std::min(nextRefresh, entry.nextRefresh);
+      }
+    }
+
+    if (mQueue.empty()) {
+      auto wakeUp = nextRefresh == LONG_MAX ? std::chrono::milliseconds(60 * 1000) : std::chrono::milliseconds(nextRefresh - now);
+      mWorkAvailable.wait_for(lock, wakeUp, [this]() { return mStopping || !mQueue.empty(); });
+      continue;
+    }
+
+    auto key = mQueue.front();
+    mQueue.pop_front();
+    lock.unlock();
+    fetch(key);
+    lock.lock();
+    mFetched.notify_all();
+  }
+}
+
+void ConditionCache::fetch(const std::string& key)
+{
+  // the entries are never removed, so we can keep the reference while the lock is released
+  Entry* entry;
+  Fetcher fetcher;
+  long timestamp;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    entry = &mEntries.at(key);
+    fetcher = entry->fetcher;
+    timestamp = entry->timestamp;
+  }
+
+  std::map<std::string, std::string> headers;
+  std::shared_ptr<void> object;
+  try {
+    object = fetcher(mCcdbApi, entry->path, entry->metadata, timestamp, headers);
+  } catch (const std::exception& exception) {
+    ILOG(Warning, Support) << "Error while retrieving the condition '" << entry->path << "': " << exception.what() << ENDM;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  long now = nowMs();
+  if (object) {
+    entry->object = std::move(object);
+    entry->validFrom = parseHeader(headers, "Valid-From", timestamp < 0 ? now : timestamp);
+    entry->validUntil = parseHeader(headers, "Valid-Until", (timestamp < 0 ? now : timestamp) + mDefaultValidity);
+    entry->nextRefresh = std::max(entry->validUntil, now + mRetryDelay);
+    ILOG(Debug, Support) << "Retrieved the condition '" << entry->path << "' valid in [" << entry->validFrom << ", " << entry->validUntil << ")" << ENDM;
+  } else {
+    // a current condition which could not be retrieved is retried later, the previous object is kept meanwhile
+    entry->nextRefresh = now + mRetryDelay;
+  }
+  entry->pending = false;
+}
+
+} // namespace o2::quality_control::core
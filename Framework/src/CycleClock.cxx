@@ -0,0 +1,37 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CycleClock.cxx
+///
+
+#include "QualityControl/CycleClock.h"
+
+namespace o2::quality_control::core
+{
+
+void CycleClock::start(time_point now, duration cycleDuration)
+{
+  mCycleDuration = cycleDuration;
+  mDeadline = now + cycleDuration;
+}
+
+CycleClock::duration CycleClock::endCycle(time_point now)
+{
+  auto delay = now - mDeadline;
+  mDeadline += mCycleDuration;
+  if (mDeadline <= now) {
+    mDeadline = now + mCycleDuration;
+  }
+  return delay;
+}
+
+} // namespace o2::quality_control::core
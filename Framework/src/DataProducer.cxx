@@ -16,22 +16,85 @@
 #include "QualityControl/DataProducer.h"
 #include "QualityControl/QcInfoLogger.h"
 
-#include <random>
-#include <Common/Timer.h>
 #include <Monitoring/MonitoringFactory.h>
 #include <Framework/ControlService.h>
+#include <Headers/RAWDataHeader.h>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <optional>
+#include <thread>
 
 using namespace o2::framework;
 using namespace o2::monitoring;
 
 using SubSpec = o2::header::DataHeader::SubSpecificationType;
-using namespace AliceO2::Common;
 
 namespace o2::quality_control::core
 {
 
+// Messages are filled with fragments of this size at most, so the template does not grow with the message size.
+constexpr size_t maxTemplateFragment = 1024 * 1024;
+
+PayloadGenerator::PayloadGenerator(size_t maxSize, size_t pageSize, uint32_t seed)
+  : mGenerator(seed), mPageSize(pageSize)
+{
+  // twice the fragment size, so a fragment can start anywhere in the first half
+  mTemplate.resize(2 * std::clamp<size_t>(std::max(maxSize, pageSize), 1, maxTemplateFragment));
+  for (auto& item : mTemplate) {
+    item = static_cast<char>(mGenerator());
+  }
+}
+
+size_t PayloadGenerator::generateSize(size_t minSize, size_t maxSize)
+{
+  return (minSize >= maxSize) ? minSize : (minSize + (mGenerator() % (maxSize - minSize)));
+}
+
+void PayloadGenerator::fillFromTemplate(char* data, size_t length)
+{
+  const size_t fragmentSize = mTemplate.size() / 2;
+  while (length > 0) {
+    const size_t toCopy = std::min(length, fragmentSize);
+    std::memcpy(data, mTemplate.data() + mGenerator() % fragmentSize, toCopy);
+    data += toCopy;
+    length -= toCopy;
+  }
+}
+
+void PayloadGenerator::fill(char* data, size_t length)
+{
+  using RDH = o2::header::RAWDataHeaderV6;
+  if (mPageSize <= sizeof(RDH)) {
+    fillFromTemplate(data, length);
+    return;
+  }
+
+  const size_t pages = (length + mPageSize - 1) / mPageSize;
+  for (size_t page = 0; page < pages; page++) {
+    const size_t pageLength = std::min(mPageSize, length - page * mPageSize);
+    char* pageData = data + page * mPageSize;
+    if (pageLength < sizeof(RDH)) {
+      // not enough space for a header, we just fill the remainder
+      fillFromTemplate(pageData, pageLength);
+      break;
+    }
+    RDH rdh;
+    rdh.feeId = 0;
+    rdh.offsetToNext = pageLength;
+    rdh.memorySize = pageLength;
+    rdh.orbit = mOrbit;
+    rdh.pageCnt = page;
+    rdh.stop = page == pages - 1;
+    std::memcpy(pageData, &rdh, sizeof(RDH));
+    fillFromTemplate(pageData + sizeof(RDH), pageLength - sizeof(RDH));
+  }
+  mOrbit++;
+}
+
 DataProcessorSpec getDataProducerSpec(size_t minSize, size_t maxSize, double rate, uint64_t amount, size_t index,
-                                      std::string monitoringUrl, bool fill, size_t timepipeline)
+                                      std::string monitoringUrl, bool fill, size_t timepipeline, size_t pageSize)
 {
   DataProcessorSpec spec{
     "producer-" + std::to_string(index),
@@ -39,7 +102,7 @@ DataProcessorSpec getDataProducerSpec(size_t minSize, size_t maxSize, double rat
     Outputs{
       { { "out" }, "TST", "RAWDATA", static_cast<SubSpec>(index) } },
     getDataProducerAlgorithm({ "TST", "RAWDATA", static_cast<SubSpec>(index) }, minSize, maxSize, rate, amount,
-                             monitoringUrl, fill)
+                             monitoringUrl, fill, pageSize)
   };
   spec.maxInputTimeslices = timepipeline;
 
@@ -47,13 +110,15 @@ DataProcessorSpec getDataProducerSpec(size_t minSize, size_t maxSize, double rat
 }
 
 AlgorithmSpec getDataProducerAlgorithm(ConcreteDataMatcher output, size_t minSize, size_t maxSize, double rate,
-                                       uint64_t amount, std::string monitoringUrl, bool fill)
+                                       uint64_t amount, std::string monitoringUrl, bool fill, size_t pageSize)
 {
   return AlgorithmSpec{
     [=](InitContext&) {
       // this is the initialization code
-      std::default_random_engine generator(time(nullptr));
-      std::shared_ptr<Timer> timer = nullptr;
+      std::shared_ptr<PayloadGenerator> generator = std::make_shared<PayloadGenerator>(maxSize, pageSize, time(nullptr));
+      const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(rate > 0 ? 1.0 / rate : 0.0));
+      std::optional<std::chrono::steady_clock::time_point> nextMessageTime;
 
       uint64_t messageCounter = 0;
       std::shared_ptr<monitoring::Monitoring> collector;
@@ -74,27 +139,22 @@ AlgorithmSpec getDataProducerAlgorithm(ConcreteDataMatcher output, size_t minSiz
           return;
         }
 
-        // setting up the timer
-        if (!timer) {
-          timer = std::make_shared<Timer>();
-          timer->reset(static_cast<int>(1000000.0 / rate));
-        }
-        // keeping the message rate
-        double timeToSleep = timer->getRemainingTime();
-        if (timeToSleep > 0) {
-          usleep(timeToSleep * 1000000.0);
+        // keeping the message rate. If we are late, we do not sleep until we catch up.
+        if (rate > 0) {
+          if (!nextMessageTime.has_value()) {
+            nextMessageTime = std::chrono::steady_clock::now();
+          }
+          std::this_thread::sleep_until(nextMessageTime.value());
+          nextMessageTime.value() += period;
         }
-        timer->increment();
 
         // generating data
-        size_t length = (minSize == maxSize) ? minSize : (minSize + (generator() % (maxSize - minSize)));
+        size_t length = generator->generateSize(minSize, maxSize);
         auto data = processingContext.outputs().make<char>({ output.origin, output.description, output.subSpec },
                                                            length);
         ++messageCounter;
         if (fill) {
-          for (auto&& item : data) {
-            item = static_cast<char>(generator());
-          }
+          generator->fill(data.data(), data.size());
         }
 
         // send metrics
@@ -31,18 +31,19 @@
 #include "QualityControl/InfrastructureSpec.h"
 #include "QualityControl/RootFileSink.h"
 #include "QualityControl/RootFileSource.h"
+#include "QualityControl/Calculators.h"
 
 #include <Configuration/ConfigurationFactory.h>
 #include <Framework/DataSpecUtils.h>
 #include <Framework/ExternalFairMQDeviceProxy.h>
 #include <Framework/DataDescriptorQueryBuilder.h>
 #include <Framework/O2ControlLabels.h>
-#include <Mergers/MergerInfrastructureBuilder.h>
 #include <Mergers/MergerBuilder.h>
 #include <DataSampling/DataSampling.h>
 #include <boost/property_tree/ptree.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <set>
 
 using namespace o2::framework;
@@ -206,9 +207,20 @@ o2::framework::WorkflowSpec InfrastructureGenerator::generateRemoteInfrastructur
 
       // In "delta" mode Mergers should implement moving window, in "entire" - QC Tasks.
       size_t resetAfterCycles = taskSpec.mergingMode == "delta" ? taskSpec.resetAfterCycles : 0;
-      auto cycleDurationSeconds = taskSpec.cycleDurationSeconds * taskSpec.mergerCycleMultiplier;
+      auto mergersPerLayer = computeMergersPerLayer(numberOfLocalMachines, taskSpec);
+      std::vector<double> cycleDurationsSeconds;
+      if (taskSpec.mergerCycleMultipliers.empty()) {
+        cycleDurationsSeconds.resize(mergersPerLayer.size(), taskSpec.cycleDurationSeconds * taskSpec.mergerCycleMultiplier);
+      } else if (taskSpec.mergerCycleMultipliers.size() == mergersPerLayer.size()) {
+        for (auto multiplier : taskSpec.mergerCycleMultipliers) {
+          cycleDurationsSeconds.push_back(taskSpec.cycleDurationSeconds * multiplier);
+        }
+      } else {
+        throw std::runtime_error("Configuration error: task '" + taskSpec.taskName + "' has " + std::to_string(taskSpec.mergerCycleMultipliers.size()) +
+                                 " mergerCycleMultipliers, while its Merger topology has " + std::to_string(mergersPerLayer.size()) + " layers");
+      }
 
-      generateMergers(workflow, taskSpec.taskName, numberOfLocalMachines, cycleDurationSeconds, taskSpec.mergingMode, resetAfterCycles, infrastructureSpec.common.monitoringUrl, taskSpec.detectorName);
+      generateMergers(workflow, taskSpec.taskName, numberOfLocalMachines, mergersPerLayer, cycleDurationsSeconds, taskSpec.mergingMode, resetAfterCycles, infrastructureSpec.common.monitoringUrl, taskSpec.detectorName);
 
     } else if (taskSpec.location == TaskLocationSpec::Remote) {
 
@@ -311,15 +323,18 @@ framework::WorkflowSpec InfrastructureGenerator::generateRemoteBatchInfrastructu
   WorkflowSpec workflow;
 
   std::vector<OutputSpec> fileSourceOutputs;
+  std::vector<std::string> fileSourceTasks;
   for (const auto& taskSpec : infrastructureSpec.tasks) {
     if (taskSpec.active) {
       auto taskConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 0, 1);
       fileSourceOutputs.push_back(taskConfig.moSpec);
       fileSourceOutputs.back().binding.value = taskSpec.taskName;
+      fileSourceTasks.push_back(taskSpec.taskName);
     }
   }
   if (fileSourceOutputs.size() > 0) {
-    workflow.push_back({ "qc-root-file-source", {}, std::move(fileSourceOutputs), adaptFromTask<RootFileSource>(sourceFilePath) });
+    // only the objects of the active tasks are read from the file(s)
+    workflow.push_back({ "qc-root-file-source", {}, std::move(fileSourceOutputs), adaptFromTask<RootFileSource>(sourceFilePath, fileSourceTasks) });
   }
 
   generateCheckRunners(workflow, infrastructureSpec);
@@ -481,14 +496,48 @@ void InfrastructureGenerator::generateLocalTaskRemoteProxy(framework::WorkflowSp
   workflow.back().labels.emplace_back(taskSpec.localControl == "odc" ? ecs::preserveRawChannelsLabel : ecs::uniqueProxyLabel);
 }
 
+std::vector<size_t> InfrastructureGenerator::computeMergersPerLayer(size_t numberOfInputs, const TaskSpec& taskSpec)
+{
+  if (!taskSpec.mergersPerLayer.empty()) {
+    const auto& mergersPerLayer = taskSpec.mergersPerLayer;
+    bool valid = mergersPerLayer.back() == 1 && mergersPerLayer.front() <= numberOfInputs &&
+                 std::is_sorted(mergersPerLayer.rbegin(), mergersPerLayer.rend()) &&
+                 std::find(mergersPerLayer.begin(), mergersPerLayer.end(), 0) == mergersPerLayer.end();
+    if (!valid) {
+      throw std::runtime_error("Configuration error: mergersPerLayer of task '" + taskSpec.taskName +
+                               "' should be a non-increasing list of positive numbers ending with 1, with no more Mergers than "
+                               "the " + std::to_string(numberOfInputs) + " inputs in the first layer");
+    }
+    return mergersPerLayer;
+  }
+
+  if (taskSpec.mergerReductionFactor < 2 || numberOfInputs <= taskSpec.mergerReductionFactor) {
+    return { 1 };
+  }
+
+  std::vector<size_t> mergersPerLayer;
+  const size_t layers = calculators::numberOfMergerLayers(numberOfInputs, taskSpec.mergerReductionFactor);
+  size_t mergersInLayer = numberOfInputs;
+  for (size_t layer = 1; layer <= layers; layer++) {
+    mergersInLayer = std::ceil(mergersInLayer / (double)taskSpec.mergerReductionFactor);
+    mergersPerLayer.push_back(mergersInLayer);
+  }
+  // protection against rounding errors, there should be always one Merger at the top
+  if (mergersPerLayer.back() != 1) {
+    mergersPerLayer.push_back(1);
+  }
+  return mergersPerLayer;
+}
+
 void InfrastructureGenerator::generateMergers(framework::WorkflowSpec& workflow, std::string taskName,
-                                              size_t numberOfLocalMachines, double cycleDurationSeconds,
+                                              size_t numberOfLocalMachines, const std::vector<size_t>& mergersPerLayer,
+                                              const std::vector<double>& cycleDurationsSeconds,
                                               std::string mergingMode, size_t resetAfterCycles, std::string monitoringUrl,
                                               std::string detectorName)
 {
-  Inputs mergerInputs;
+  Inputs layerInputs;
   for (size_t id = 1; id <= numberOfLocalMachines; id++) {
-    mergerInputs.emplace_back(
+    layerInputs.emplace_back(
       InputSpec{ { taskName + std::to_string(id) },
                  TaskRunner::createTaskDataOrigin(detectorName),
                  TaskRunner::createTaskDataDescription(taskName),
@@ -496,23 +545,59 @@ void InfrastructureGenerator::generateMergers(framework::WorkflowSpec& workflow,
                  Lifetime::Sporadic });
   }
 
-  MergerInfrastructureBuilder mergersBuilder;
-  mergersBuilder.setInfrastructureName(taskName);
-  mergersBuilder.setInputSpecs(mergerInputs);
-  mergersBuilder.setOutputSpec(
-    { { "main" }, TaskRunner::createTaskDataOrigin(detectorName), TaskRunner::createTaskDataDescription(taskName), 0 });
   MergerConfig mergerConfig;
   // if we are to change the mode to Full, disable reseting tasks after each cycle.
   mergerConfig.inputObjectTimespan = { (mergingMode.empty() || mergingMode == "delta") ? InputObjectsTimespan::LastDifference : InputObjectsTimespan::FullHistory };
-  mergerConfig.publicationDecision = { PublicationDecision::EachNSeconds, cycleDurationSeconds };
   mergerConfig.mergedObjectTimespan = { MergedObjectTimespan::NCycles, (int)resetAfterCycles };
-  // for now one merger should be enough, multiple layers to be supported later
-  mergerConfig.topologySize = { TopologySize::NumberOfLayers, 1 };
+  mergerConfig.topologySize = { TopologySize::NumberOfLayers, 1 }; // each Merger is built separately
   mergerConfig.monitoringUrl = monitoringUrl;
   mergerConfig.detectorName = detectorName;
-  mergersBuilder.setConfig(mergerConfig);
 
-  mergersBuilder.generateInfrastructure(workflow);
+  // We build the layers by ourselves instead of using MergerInfrastructureBuilder,
+  // so we can have different publication intervals in each of them.
+  MergerBuilder mergerBuilder;
+  mergerBuilder.setName(taskName);
+  for (size_t layer = 1; layer <= mergersPerLayer.size(); layer++) {
+    const bool lastLayer = layer == mergersPerLayer.size();
+    auto layerConfig = mergerConfig;
+    layerConfig.publicationDecision = { PublicationDecision::EachNSeconds, cycleDurationsSeconds.at(layer - 1) };
+    if (!lastLayer && mergerConfig.inputObjectTimespan.value == InputObjectsTimespan::LastDifference) {
+      // Intermediate layers publish what they have merged since their previous publication,
+      // so the same data is not added many times. The moving window is applied only by the last layer.
+      // With entire objects, each layer replaces the previous version of its inputs, thus it has to publish everything.
+      layerConfig.mergedObjectTimespan = { MergedObjectTimespan::NCycles, 1 };
+    }
+    mergerBuilder.setConfig(layerConfig);
+
+    // inputs are distributed as evenly as possible among the Mergers of the layer
+    const size_t numberOfMergers = mergersPerLayer[layer - 1];
+    const size_t inputsPerMerger = layerInputs.size() / numberOfMergers;
+    const size_t inputsPerMergerRemainder = layerInputs.size() % numberOfMergers;
+    Inputs nextLayerInputs;
+    auto inputsRangeBegin = layerInputs.begin();
+    for (size_t m = 0; m < numberOfMergers; m++) {
+      auto inputsRangeEnd = inputsRangeBegin + inputsPerMerger + (m < inputsPerMergerRemainder);
+      mergerBuilder.setTopologyPosition(layer, m);
+      mergerBuilder.setInputSpecs(Inputs(inputsRangeBegin, inputsRangeEnd));
+      inputsRangeBegin = inputsRangeEnd;
+
+      if (lastLayer) {
+        mergerBuilder.setOutputSpec(
+          { { "main" }, TaskRunner::createTaskDataOrigin(detectorName), TaskRunner::createTaskDataDescription(taskName), 0 });
+      } else {
+        mergerBuilder.setOutputSpec(
+          { { MergerBuilder::mergerIdString() }, MergerBuilder::mergerDataOrigin(), MergerBuilder::mergerDataDescription(taskName), MergerBuilder::mergerSubSpec(layer, m) });
+      }
+      auto merger = mergerBuilder.buildSpec();
+      auto input = DataSpecUtils::matchingInput(merger.outputs.at(0));
+      // the Mergers of one layer share the output binding, the inputs of the next layer need unique ones
+      input.binding = MergerBuilder::mergerIdString() + std::to_string(layer) + "_" + std::to_string(m);
+      input.lifetime = Lifetime::Sporadic;
+      nextLayerInputs.push_back(input);
+      workflow.emplace_back(std::move(merger));
+    }
+    layerInputs = nextLayerInputs;
+  }
 }
 
 void InfrastructureGenerator::generateCheckRunners(framework::WorkflowSpec& workflow, const InfrastructureSpec& infrastructureSpec)
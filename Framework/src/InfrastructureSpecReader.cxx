@@ -71,6 +71,8 @@ CommonSpec InfrastructureSpecReader::readSpecEntry<CommonSpec>(std::string, cons
   spec.infologgerFilterDiscardDebug = commonTree.get<bool>("infologger.filterDiscardDebug", spec.infologgerFilterDiscardDebug);
   spec.infologgerDiscardLevel = commonTree.get<int>("infologger.filterDiscardLevel", spec.infologgerDiscardLevel);
   spec.postprocessingPeriod = commonTree.get<double>("postprocessing.period", spec.postprocessingPeriod);
+  spec.compactQualityObjects = commonTree.get<bool>("qualityObjects.compactFormat", spec.compactQualityObjects);
+  spec.aggregatorRunnerWorkers = commonTree.get<size_t>("aggregatorRunner.workers", spec.aggregatorRunnerWorkers);
 
   return spec;
 }
@@ -95,6 +97,9 @@ TaskSpec InfrastructureSpecReader::readSpecEntry<TaskSpec>(std::string taskID, c
   ts.maxNumberCycles = taskTree.get<int>("maxNumberCycles", ts.maxNumberCycles);
   ts.resetAfterCycles = taskTree.get<size_t>("resetAfterCycles", ts.resetAfterCycles);
   ts.saveObjectsToFile = taskTree.get<std::string>("saveObjectsToFile", ts.saveObjectsToFile);
+  ts.workers = taskTree.get<size_t>("workers", ts.workers);
+  ts.timeslicePipeline = taskTree.get<size_t>("timeslicePipeline", ts.timeslicePipeline);
+  ts.asyncPublication = taskTree.get<bool>("asyncPublication", ts.asyncPublication);
   if (taskTree.count("taskParameters") > 0) {
     for (const auto& [key, value] : taskTree.get_child("taskParameters")) {
       ts.customParameters.emplace(key, value.get_value<std::string>());
@@ -127,6 +132,17 @@ TaskSpec InfrastructureSpecReader::readSpecEntry<TaskSpec>(std::string taskID, c
   ts.localControl = taskTree.get<std::string>("localControl", ts.localControl);
   ts.mergingMode = taskTree.get<std::string>("mergingMode", ts.mergingMode);
   ts.mergerCycleMultiplier = taskTree.get<int>("mergerCycleMultiplier", ts.mergerCycleMultiplier);
+  if (taskTree.count("mergerCycleMultipliers") > 0) {
+    for (const auto& [key, value] : taskTree.get_child("mergerCycleMultipliers")) {
+      ts.mergerCycleMultipliers.emplace_back(value.get_value<int>());
+    }
+  }
+  if (taskTree.count("mergersPerLayer") > 0) {
+    for (const auto& [key, value] : taskTree.get_child("mergersPerLayer")) {
+      ts.mergersPerLayer.emplace_back(value.get_value<size_t>());
+    }
+  }
+  ts.mergerReductionFactor = taskTree.get<size_t>("mergerReductionFactor", ts.mergerReductionFactor);
 
   return ts;
 }
@@ -0,0 +1,381 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalCcdbServer.cxx
+///
+
+#include "LocalCcdbServer.h"
+
+#include "QualityControl/QcInfoLogger.h"
+
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using boost::asio::ip::tcp;
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+
+uint64_t nowMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool isNumber(const std::string& s)
+{
+  return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+std::string urlDecode(const std::string& s)
+{
+  std::string result;
+  result.reserve(s.size());
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i] == '%' && i + 2 < s.size()) {
+      result += static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16));
+      i += 2;
+    } else if (s[i] == '+') {
+      result += ' ';
+    } else {
+      result += s[i];
+    }
+  }
+  return result;
+}
+
+std::string jsonEscape(const std::string& s)
+{
+  std::string result;
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+/// \brief Splits a request target into the object path, the numeric segments (timestamps) and the metadata.
+/// As in the CCDB, the path ends at the first numeric segment or at the first key=value segment.
+void parseTarget(const std::string& target, std::string& path, std::vector<uint64_t>& numbers, std::map<std::string, std::string>& metadata)
+{
+  std::vector<std::string> segments;
+  auto withoutQuery = target.substr(0, target.find('?'));
+  boost::split(segments, withoutQuery, boost::is_any_of("/"), boost::token_compress_on);
+  bool inPath = true;
+  for (const auto& segment : segments) {
+    if (segment.empty()) {
+      continue;
+    }
+    auto decoded = urlDecode(segment);
+    if (auto equal = decoded.find('='); equal != std::string::npos) {
+      inPath = false;
+      metadata[decoded.substr(0, equal)] = decoded.substr(equal + 1);
+    } else if (isNumber(decoded) && (!inPath || !path.empty())) {
+      inPath = false;
+      numbers.push_back(std::stoull(decoded));
+    } else if (inPath) {
+      path += (path.empty() ? "" : "/") + decoded;
+    }
+  }
+}
+
+std::string hashOf(const std::string& blob, uint64_t id)
+{
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(blob) << std::setw(16) << id;
+  return ss.str();
+}
+
+} // namespace
+
+LocalCcdbServer::LocalCcdbServer(unsigned short port)
+  : mAcceptor(mIoContext, tcp::endpoint(boost::asio::ip::address_v4::loopback(), port))
+{
+  mAcceptThread = std::thread([this]() { acceptConnections(); });
+  ILOG(Info, Devel) << "Local CCDB stand-in listening at " << getUrl() << ENDM;
+}
+
+LocalCcdbServer::~LocalCcdbServer()
+{
+  stop();
+}
+
+std::string LocalCcdbServer::getUrl() const
+{
+  return "http://127.0.0.1:" + std::to_string(mAcceptor.local_endpoint().port());
+}
+
+void LocalCcdbServer::stop()
+{
+  if (!mRunning.exchange(false)) {
+    return;
+  }
+  // wake up the blocking accept with a dummy connection
+  try {
+    tcp::socket waker(mIoContext);
+    waker.connect(mAcceptor.local_endpoint());
+  } catch (const boost::system::system_error&) {
+  }
+  mAcceptThread.join();
+  mAcceptor.close();
+
+  std::lock_guard<std::mutex> lock(mConnectionsMutex);
+  for (auto& socket : mSockets) {
+    boost::system::error_code ec;
+    socket->shutdown(tcp::socket::shutdown_both, ec);
+  }
+  for (auto& thread : mConnectionThreads) {
+    thread.join();
+  }
+}
+
+void LocalCcdbServer::acceptConnections()
+{
+  while (mRunning) {
+    auto socket = std::make_shared<tcp::socket>(mIoContext);
+    boost::system::error_code ec;
+    mAcceptor.accept(*socket, ec);
+    if (ec || !mRunning) {
+      continue;
+    }
+    socket->set_option(tcp::no_delay(true));
+    std::lock_guard<std::mutex> lock(mConnectionsMutex);
+    mSockets.push_back(socket);
+    mConnectionThreads.emplace_back([this, socket]() { serveConnection(socket); });
+  }
+}
+
+void LocalCcdbServer::serveConnection(std::shared_ptr<tcp::socket> socket)
+{
+  boost::asio::streambuf buffer;
+  boost::system::error_code ec;
+  while (mRunning) {
+    boost::asio::read_until(*socket, buffer, "\r\n\r\n", ec);
+    if (ec) {
+      break;
+    }
+
+    std::istream stream(&buffer);
+    std::string method, target, version, line;
+    stream >> method >> target >> version;
+    std::getline(stream, line);
+    std::map<std::string, std::string> headers;
+    while (std::getline(stream, line) && line != "\r" && !line.empty()) {
+      if (auto colon = line.find(':'); colon != std::string::npos) {
+        headers[boost::to_lower_copy(line.substr(0, colon))] = boost::trim_copy(line.substr(colon + 1));
+      }
+    }
+
+    size_t contentLength = headers.count("content-length") ? std::stoull(headers["content-length"]) : 0;
+    if (boost::iequals(headers["expect"], "100-continue")) {
+      boost::asio::write(*socket, boost::asio::buffer(std::string("HTTP/1.1 100 Continue\r\n\r\n")), ec);
+    }
+    if (buffer.size() < contentLength) {
+      boost::asio::read(*socket, buffer, boost::asio::transfer_exactly(contentLength - buffer.size()), ec);
+      if (ec) {
+        break;
+      }
+    }
+    std::string body(contentLength, '\0');
+    stream.read(body.data(), contentLength);
+
+    auto start = std::chrono::steady_clock::now();
+    auto response = handle(method, target, headers, body);
+    mHandlingTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    mRequestCount++;
+
+    std::stringstream head;
+    head << "HTTP/1.1 " << response.code << " " << response.reason << "\r\n";
+    for (const auto& [key, value] : response.headers) {
+      head << key << ": " << value << "\r\n";
+    }
+    head << "Content-Length: " << response.body.size() << "\r\n\r\n";
+    auto headString = head.str();
+    std::vector<boost::asio::const_buffer> output{ boost::asio::buffer(headString) };
+    if (method != "HEAD") {
+      output.push_back(boost::asio::buffer(response.body));
+    }
+    boost::asio::write(*socket, output, ec);
+    if (ec || boost::iequals(headers["connection"], "close")) {
+      break;
+    }
+  }
+}
+
+LocalCcdbServer::Response LocalCcdbServer::handle(const std::string& method, const std::string& target, const std::map<std::string, std::string>& headers, const std::string& body)
+{
+  auto startsWith = [&](const std::string& prefix) { return target.rfind(prefix, 0) == 0; };
+  if (method == "POST" || method == "PUT") {
+    return store(target, headers, body);
+  } else if ((method == "GET" || method == "HEAD") && startsWith("/browse/")) {
+    return list(target.substr(8), false, headers);
+  } else if ((method == "GET" || method == "HEAD") && startsWith("/latest/")) {
+    return list(target.substr(8), true, headers);
+  } else if (method == "GET" || method == "HEAD") {
+    return retrieve(target, method == "GET");
+  } else if (method == "DELETE" && startsWith("/truncate/")) {
+    return truncate(target.substr(10));
+  }
+  return { 405, "Method Not Allowed" };
+}
+
+LocalCcdbServer::Response LocalCcdbServer::store(const std::string& target, const std::map<std::string, std::string>& headers, const std::string& body)
+{
+  Version version;
+  std::vector<uint64_t> numbers;
+  parseTarget(target, version.path, numbers, version.metadata);
+  if (version.path.empty() || numbers.size() < 2) {
+    return { 400, "Bad Request", {}, "Path, validity start and end are required" };
+  }
+  version.validFrom = numbers[0];
+  version.validUntil = numbers[1];
+
+  // we extract the (only) file of the multipart form
+  auto contentType = headers.count("content-type") ? headers.at("content-type") : "";
+  auto boundaryPos = contentType.find("boundary=");
+  if (boundaryPos == std::string::npos) {
+    version.blob = std::make_shared<const std::string>(body);
+  } else {
+    auto boundary = "--" + boost::trim_copy_if(contentType.substr(boundaryPos + 9), boost::is_any_of("\""));
+    auto partStart = body.find(boundary);
+    auto dataStart = body.find("\r\n\r\n", partStart);
+    auto dataEnd = body.find("\r\n" + boundary, dataStart);
+    if (partStart == std::string::npos || dataStart == std::string::npos || dataEnd == std::string::npos) {
+      return { 400, "Bad Request", {}, "Malformed multipart body" };
+    }
+    auto partHeaders = body.substr(partStart, dataStart - partStart);
+    if (auto fileNamePos = partHeaders.find("filename=\""); fileNamePos != std::string::npos) {
+      fileNamePos += 10;
+      version.fileName = partHeaders.substr(fileNamePos, partHeaders.find('"', fileNamePos) - fileNamePos);
+    }
+    version.blob = std::make_shared<const std::string>(body.substr(dataStart + 4, dataEnd - dataStart - 4));
+  }
+
+  std::lock_guard<std::mutex> lock(mStorageMutex);
+  version.created = nowMs();
+  version.id = mNextId++;
+  auto location = "/" + version.path + "/" + std::to_string(version.validFrom) + "/" + std::to_string(version.id);
+  mStorage[version.path].push_back(std::move(version));
+  return { 201, "Created", { { "Location", location } } };
+}
+
+LocalCcdbServer::Response LocalCcdbServer::retrieve(const std::string& target, bool withBody)
+{
+  std::string path;
+  std::vector<uint64_t> numbers;
+  std::map<std::string, std::string> metadata;
+  parseTarget(target, path, numbers, metadata);
+  uint64_t timestamp = numbers.empty() ? nowMs() : numbers[0];
+
+  std::lock_guard<std::mutex> lock(mStorageMutex);
+  auto versions = mStorage.find(path);
+  if (versions == mStorage.end()) {
+    return { 404, "Not Found" };
+  }
+  // the most recently created version which is valid at the timestamp and matches the metadata
+  for (auto it = versions->second.rbegin(); it != versions->second.rend(); ++it) {
+    if (timestamp < it->validFrom || timestamp >= it->validUntil) {
+      continue;
+    }
+    bool matches = std::all_of(metadata.begin(), metadata.end(), [&](const auto& requirement) {
+      auto value = it->metadata.find(requirement.first);
+      return value != it->metadata.end() && value->second == requirement.second;
+    });
+    if (!matches) {
+      continue;
+    }
+    Response response;
+    response.headers = {
+      { "Content-Type", "application/octet-stream" },
+      { "Content-Disposition", "inline;filename=\"" + it->fileName + "\"" },
+      { "Content-Location", "/" + it->path + "/" + std::to_string(it->validFrom) + "/" + std::to_string(it->id) },
+      { "ETag", "\"" + std::to_string(it->id) + "\"" },
+      { "Content-MD5", hashOf(*it->blob, it->id) },
+      { "Valid-From", std::to_string(it->validFrom) },
+      { "Valid-Until", std::to_string(it->validUntil) },
+      { "Created", std::to_string(it->created) },
+      { "Last-Modified", std::to_string(it->created) }
+    };
+    for (const auto& [key, value] : it->metadata) {
+      response.headers.emplace_back(key, value);
+    }
+    if (withBody) {
+      response.body = *it->blob;
+    } else {
+      response.headers.emplace_back("X-Content-Length", std::to_string(it->blob->size()));
+    }
+    return response;
+  }
+  return { 404, "Not Found" };
+}
+
+LocalCcdbServer::Response LocalCcdbServer::list(const std::string& target, bool latestOnly, const std::map<std::string, std::string>& headers)
+{
+  // listings use regular expressions in the CCDB, here we support only prefixes with an optional trailing ".*"
+  auto prefix = urlDecode(target.substr(0, target.find('?')));
+  if (boost::ends_with(prefix, ".*")) {
+    prefix.resize(prefix.size() - 2);
+  }
+  // the versions can be restricted to a range of creation times, as CcdbApi::list() asks
+  auto createdNotBefore = headers.count("if-not-before") ? std::stoull(headers.at("if-not-before")) : 0;
+  auto createdNotAfter = headers.count("if-not-after") ? std::stoull(headers.at("if-not-after")) : std::numeric_limits<uint64_t>::max();
+
+  std::stringstream json;
+  json << "{\"objects\":[";
+  bool first = true;
+  std::lock_guard<std::mutex> lock(mStorageMutex);
+  for (auto it = mStorage.lower_bound(prefix); it != mStorage.end() && boost::starts_with(it->first, prefix); ++it) {
+    auto& versions = it->second;
+    // newest first, as the CCDB does
+    for (auto version = versions.rbegin(); version != versions.rend(); ++version) {
+      if (version->created < createdNotBefore || version->created > createdNotAfter) {
+        continue;
+      }
+      auto hash = hashOf(*version->blob, version->id);
+      json << (first ? "" : ",") << "{\"path\":\"" << jsonEscape(version->path) << "\","
+           << "\"createTime\":" << version->created << ",\"lastModified\":" << version->created << ","
+           << "\"id\":\"" << version->id << "\",\"validFrom\":" << version->validFrom << ","
+           << "\"validUntil\":" << version->validUntil << ",\"MD5\":\"" << hash << "\","
+           << "\"fileName\":\"" << jsonEscape(version->fileName) << "\",\"size\":" << version->blob->size();
+      for (const auto& [key, value] : version->metadata) {
+        json << ",\"" << jsonEscape(key) << "\":\"" << jsonEscape(value) << "\"";
+      }
+      json << "}";
+      first = false;
+      if (latestOnly) {
+        break;
+      }
+    }
+  }
+  json << "],\"subfolders\":[]}";
+  return { 200, "OK", { { "Content-Type", "application/json" } }, json.str() };
+}
+
+LocalCcdbServer::Response LocalCcdbServer::truncate(const std::string& target)
+{
+  auto path = urlDecode(target.substr(0, target.find('?')));
+  std::lock_guard<std::mutex> lock(mStorageMutex);
+  mStorage.erase(path);
+  return { 200, "OK" };
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,98 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LocalCcdbServer.h
+///
+
+#ifndef QC_LOCALCCDBSERVER_H
+#define QC_LOCALCCDBSERVER_H
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief In-memory stand-in of the CCDB REST API, to be used by benchmarks and tests.
+///
+/// It implements only what the CcdbApi uses to store, retrieve, list and truncate objects: multipart POST uploads,
+/// GET/HEAD of the version valid at a timestamp (optionally filtered with metadata), JSON listings under /browse and
+/// /latest (optionally bounded by creation time with If-Not-Before and If-Not-After) and DELETE under /truncate. All the versions are kept in memory and each connection is served by its own
+/// thread, so the server adds as little as possible to the latency seen by the clients. The time spent handling each
+/// request is accumulated, so the client-side overhead can be told apart from the server-side one.
+class LocalCcdbServer
+{
+ public:
+  /// \brief Starts listening on localhost. The port 0 means that any free port is used.
+  explicit LocalCcdbServer(unsigned short port = 0);
+  ~LocalCcdbServer();
+
+  /// \brief Returns the URL to be given to the CcdbApi or CcdbDatabase.
+  std::string getUrl() const;
+  /// \brief Total number of requests handled so far.
+  uint64_t getRequestCount() const { return mRequestCount; }
+  /// \brief Total time spent handling requests (without the network transfers) in nanoseconds.
+  uint64_t getHandlingTimeNs() const { return mHandlingTimeNs; }
+  void stop();
+
+ private:
+  struct Version {
+    std::string path;
+    uint64_t validFrom;
+    uint64_t validUntil;
+    uint64_t created;
+    uint64_t id;
+    std::map<std::string, std::string> metadata;
+    std::string fileName;
+    std::shared_ptr<const std::string> blob;
+  };
+  struct Response {
+    int code = 200;
+    std::string reason = "OK";
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+  };
+
+  void acceptConnections();
+  void serveConnection(std::shared_ptr<boost::asio::ip::tcp::socket> socket);
+  Response handle(const std::string& method, const std::string& target, const std::map<std::string, std::string>& headers, const std::string& body);
+  Response store(const std::string& target, const std::map<std::string, std::string>& headers, const std::string& body);
+  Response retrieve(const std::string& target, bool withBody);
+  Response list(const std::string& path, bool latestOnly, const std::map<std::string, std::string>& headers);
+  Response truncate(const std::string& path);
+
+  boost::asio::io_context mIoContext;
+  boost::asio::ip::tcp::acceptor mAcceptor;
+  std::thread mAcceptThread;
+  std::mutex mConnectionsMutex;
+  std::vector<std::shared_ptr<boost::asio::ip::tcp::socket>> mSockets;
+  std::vector<std::thread> mConnectionThreads;
+  std::atomic<bool> mRunning = true;
+
+  std::mutex mStorageMutex;
+  std::map<std::string, std::vector<Version>> mStorage; // versions ordered by creation, per path
+  uint64_t mNextId = 1;
+
+  std::atomic<uint64_t> mRequestCount = 0;
+  std::atomic<uint64_t> mHandlingTimeNs = 0;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_LOCALCCDBSERVER_H
@@ -21,6 +21,8 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include <Common/Exceptions.h>
 #include <TObjArray.h>
+#include <TH1.h>
+#include <algorithm>
 
 using namespace o2::quality_control::core;
 using namespace AliceO2::Common;
@@ -64,6 +66,61 @@ void ObjectsManager::startPublishing(TObject* object)
   mUpdateServiceDiscovery = true;
 }
 
+void ObjectsManager::startPublishingSharded(TH1* histogram)
+{
+  startPublishing(histogram);
+  mShards[histogram] = createShards(histogram);
+}
+
+std::vector<std::unique_ptr<TH1>> ObjectsManager::createShards(TH1* histogram) const
+{
+  std::vector<std::unique_ptr<TH1>> shards;
+  for (size_t worker = 1; worker < mNumberOfShards; worker++) {
+    auto* shard = dynamic_cast<TH1*>(histogram->Clone());
+    shard->SetDirectory(nullptr);
+    shard->Reset();
+    shards.emplace_back(shard);
+  }
+  return shards;
+}
+
+TH1* ObjectsManager::getShardImpl(TH1* histogram, size_t worker)
+{
+  auto shards = mShards.find(histogram);
+  if (shards == mShards.end() || worker >= mNumberOfShards) {
+    BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(std::string(histogram->GetName()) + " (shard " + std::to_string(worker) + ")"));
+  }
+  return worker == 0 ? histogram : shards->second[worker - 1].get();
+}
+
+void ObjectsManager::setNumberOfShards(size_t shards)
+{
+  shards = std::max<size_t>(shards, 1);
+  if (shards == mNumberOfShards) {
+    return;
+  }
+  mergeShards();
+  mNumberOfShards = shards;
+  for (auto& [histogram, histogramShards] : mShards) {
+    histogramShards = createShards(histogram);
+  }
+}
+
+size_t ObjectsManager::getNumberOfShards() const
+{
+  return mNumberOfShards;
+}
+
+void ObjectsManager::mergeShards()
+{
+  for (auto& [histogram, shards] : mShards) {
+    for (auto& shard : shards) {
+      histogram->Add(shard.get());
+      shard->Reset();
+    }
+  }
+}
+
 void ObjectsManager::updateServiceDiscovery()
 {
   if (!mUpdateServiceDiscovery || mServiceDiscovery == nullptr) {
@@ -101,6 +158,9 @@ void ObjectsManager::stopPublishing(TObject* object)
 void ObjectsManager::stopPublishing(const string& objectName)
 {
   auto* mo = dynamic_cast<MonitorObject*>(getMonitorObject(objectName));
+  if (auto* histogram = dynamic_cast<TH1*>(mo->getObject())) {
+    mShards.erase(histogram);
+  }
   mMonitorObjects->Remove(mo);
 }
 
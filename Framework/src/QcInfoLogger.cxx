@@ -16,14 +16,228 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace o2::quality_control::core
 {
 
 AliceO2::InfoLogger::InfoLogger* QcInfoLogger::instance;
 AliceO2::InfoLogger::InfoLoggerContext* QcInfoLogger::mContext;
+std::atomic<bool> QcInfoLogger::mDiscardDebug{ false };
+std::atomic<int> QcInfoLogger::mDiscardFromLevel{ 21 /* Discard Trace */ };
 QcInfoLogger::_init QcInfoLogger::_initializer;
 
+namespace
+{
+
+using InfoLoggerMessageOption = AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption;
+
+/// Sends the asynchronous messages to InfoLogger and periodically reports the suppressed ones.
+class AsyncLogSink
+{
+ public:
+  static AsyncLogSink& get()
+  {
+    static AsyncLogSink sink;
+    return sink;
+  }
+
+  AsyncLogSink()
+    : mSlots(queueSize)
+  {
+    mThread = std::thread([this]() { sinkLoop(); });
+  }
+
+  ~AsyncLogSink()
+  {
+    // we do not drain the queue here, the InfoLogger given by DPL might not exist anymore
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStopping = true;
+    }
+    mMessageQueued.notify_all();
+    mThread.join();
+  }
+
+  void push(const InfoLoggerMessageOption& option, const char* message, size_t length)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (mQueued == mSlots.size()) {
+        mDropped++;
+        return;
+      }
+      auto& slot = mSlots[(mFirst + mQueued) % mSlots.size()];
+      slot.option = option;
+      slot.length = std::min(length, QcLogMessage::maxLength);
+      std::memcpy(slot.text.data(), message, slot.length);
+      slot.text[slot.length] = '\0';
+      mQueued++;
+    }
+    mMessageQueued.notify_one();
+  }
+
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mQueueEmpty.wait(lock, [this]() { return mQueued == 0 && !mSending; });
+  }
+
+  void registerRateLimiter(LogRateLimiter* limiter)
+  {
+    std::lock_guard<std::mutex> lock(mRateLimitersMutex);
+    mRateLimiters.push_back(limiter);
+  }
+
+  void unregisterRateLimiter(LogRateLimiter* limiter)
+  {
+    // once we have the lock, the sink thread is not reporting, so the limiter can be destroyed
+    std::lock_guard<std::mutex> lock(mRateLimitersMutex);
+    mRateLimiters.erase(std::remove(mRateLimiters.begin(), mRateLimiters.end(), limiter), mRateLimiters.end());
+  }
+
+  void setReportPeriod(double seconds)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mReportPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+      mReportPeriodChanged = true;
+    }
+    mMessageQueued.notify_one();
+  }
+
+ private:
+  static constexpr size_t queueSize = 256;
+
+  struct Slot {
+    InfoLoggerMessageOption option;
+    size_t length = 0;
+    std::array<char, QcLogMessage::maxLength + 1> text;
+  };
+
+  void sinkLoop()
+  {
+    // the slot is copied out, so that InfoLogger is called without holding the lock
+    Slot slot;
+    auto lastReport = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStopping) {
+      // the report period is read at each iteration, as it can be changed at any time
+      mMessageQueued.wait_until(lock, lastReport + mReportPeriod, [this]() { return mStopping || mQueued > 0 || mReportPeriodChanged; });
+      mReportPeriodChanged = false;
+      while (mQueued > 0 && !mStopping) {
+        slot.option = mSlots[mFirst].option;
+        slot.length = mSlots[mFirst].length;
+        std::memcpy(slot.text.data(), mSlots[mFirst].text.data(), slot.length + 1);
+        mFirst = (mFirst + 1) % mSlots.size();
+        mQueued--;
+        mSending = true;
+        lock.unlock();
+        ILOG_INST.log(slot.option, "%s", slot.text.data());
+        lock.lock();
+        mSending = false;
+      }
+      mQueueEmpty.notify_all();
+
+      if (std::chrono::steady_clock::now() >= lastReport + mReportPeriod) {
+        lastReport = std::chrono::steady_clock::now();
+        auto dropped = mDropped;
+        mDropped = 0;
+        lock.unlock();
+        report(dropped);
+        lock.lock();
+      }
+    }
+  }
+
+  void report(uint64_t dropped)
+  {
+    // the limiters are static objects at the call sites, they unregister themselves when they are destroyed
+    std::lock_guard<std::mutex> lock(mRateLimitersMutex);
+    for (auto limiter : mRateLimiters) {
+      if (auto suppressed = limiter->takeSuppressed(); suppressed > 0) {
+        ILOG(Info, Support) << suppressed << " messages were suppressed by the rate limiting at "
+                            << limiter->getFile() << ":" << limiter->getLine() << ENDM;
+      }
+    }
+    if (dropped > 0) {
+      ILOG(Warning, Support) << dropped << " asynchronous messages were dropped because the queue was full" << ENDM;
+    }
+  }
+
+  std::vector<Slot> mSlots;
+  size_t mFirst = 0;
+  size_t mQueued = 0;
+  bool mSending = false;
+  bool mStopping = false;
+  uint64_t mDropped = 0;
+  std::chrono::steady_clock::duration mReportPeriod = std::chrono::minutes(1);
+  bool mReportPeriodChanged = false;
+  std::vector<LogRateLimiter*> mRateLimiters;
+  std::mutex mRateLimitersMutex; // separate from mMutex, so that the messages are queued while we report
+  std::mutex mMutex;
+  std::condition_variable mMessageQueued;
+  std::condition_variable mQueueEmpty;
+  std::thread mThread;
+};
+
+} // namespace
+
+LogRateLimiter::LogRateLimiter(double intervalSeconds, const char* file, int line)
+  : mIntervalNs(static_cast<int64_t>(intervalSeconds * 1e9)), mFile(file), mLine(line)
+{
+  QcInfoLogger::registerRateLimiter(this);
+}
+
+LogRateLimiter::~LogRateLimiter()
+{
+  // the sink was created by the constructor at the latest, so it is destroyed after us
+  QcInfoLogger::unregisterRateLimiter(this);
+}
+
+bool LogRateLimiter::allow()
+{
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  int64_t nextAllowed = mNextAllowedNs.load(std::memory_order_relaxed);
+  // if another thread gets the message through at the same time, this one is suppressed
+  if (now < nextAllowed || !mNextAllowedNs.compare_exchange_strong(nextAllowed, now + mIntervalNs, std::memory_order_relaxed)) {
+    mSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void QcInfoLogger::pushAsync(const AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption& option, const char* message, size_t length)
+{
+  AsyncLogSink::get().push(option, message, length);
+}
+
+void QcInfoLogger::flushAsync()
+{
+  AsyncLogSink::get().flush();
+}
+
+void QcInfoLogger::registerRateLimiter(LogRateLimiter* limiter)
+{
+  AsyncLogSink::get().registerRateLimiter(limiter);
+}
+
+void QcInfoLogger::unregisterRateLimiter(LogRateLimiter* limiter)
+{
+  AsyncLogSink::get().unregisterRateLimiter(limiter);
+}
+
+void QcInfoLogger::setSuppressedMessagesReportPeriod(double seconds)
+{
+  AsyncLogSink::get().setReportPeriod(seconds);
+}
+
 void QcInfoLogger::setFacility(const std::string& facility)
 {
   mContext->setField(infoContext::FieldName::Facility, facility);
@@ -72,6 +286,8 @@ void QcInfoLogger::init(const std::string& facility,
   // Set the proper discard filters
   ILOG_INST.filterDiscardDebug(discardDebug);
   ILOG_INST.filterDiscardLevel(discardFromLevel);
+  mDiscardDebug = discardDebug;
+  mDiscardFromLevel = discardFromLevel;
   ILOG(Debug, Ops) << "QC infologger initialized" << ENDM;
   ILOG(Debug, Support) << "   Discard debug ? " << discardDebug << ENDM;
   ILOG(Debug, Support) << "   Discard from level ? " << discardFromLevel << ENDM;
@@ -91,6 +307,9 @@ void QcInfoLogger::init(const std::string& facility,
   std::string discardDebugStr = config.get<std::string>("qc.config.infologger.filterDiscardDebug", "false");
   bool discardDebug = discardDebugStr == "true" ? 1 : 0;
   int discardLevel = config.get<int>("qc.config.infologger.filterDiscardLevel", 21 /* Discard Trace */);
+  if (auto reportPeriod = config.get_optional<double>("qc.config.infologger.suppressedMessagesReportPeriod"); reportPeriod) {
+    setSuppressedMessagesReportPeriod(*reportPeriod);
+  }
   init(facility, discardDebug, discardLevel, dplInfoLogger, dplContext, run, partitionName);
 }
 
@@ -72,7 +72,7 @@ void QualityObject::updateQuality(Quality quality)
   //TODO: Update timestamp
   mQuality = quality;
 }
-Quality QualityObject::getQuality() const
+const Quality& QualityObject::getQuality() const
 {
   return mQuality;
 }
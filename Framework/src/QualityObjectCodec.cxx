@@ -0,0 +1,454 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   QualityObjectCodec.cxx
+///
+
+#include "QualityControl/QualityObjectCodec.h"
+
+#include <DataFormatsQualityControl/FlagReasons.h>
+#include <Common/Exceptions.h>
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace AliceO2::Common;
+
+namespace o2::quality_control::core
+{
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "QualityObjectCodec copies integers as they are in memory, it assumes a little-endian host");
+
+namespace
+{
+
+using FlagReasonKey = std::tuple<uint16_t, std::string, bool>;
+
+[[noreturn]] void throwMalformed(const std::string& details)
+{
+  BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Malformed batch of encoded QualityObjects: " + details));
+}
+
+// FlagReasons can be created only by FlagReasonFactory, thus we look them up by ID among the reasons it provides.
+// The reasons which are not listed here are streamed with ROOT next to their ID, name and flag.
+const std::unordered_map<uint16_t, FlagReason>& getFactoryReasons()
+{
+  static const std::unordered_map<uint16_t, FlagReason> reasons = [] {
+    std::unordered_map<uint16_t, FlagReason> reasons;
+    for (const auto& reason : { FlagReasonFactory::Invalid(), FlagReasonFactory::Unknown(), FlagReasonFactory::UnknownQuality(),
+                                FlagReasonFactory::BadTracking(), FlagReasonFactory::LimitedAcceptance(), FlagReasonFactory::NotBadFlagExample() }) {
+      reasons.emplace(static_cast<uint16_t>(reason.getID()), reason);
+    }
+    return reasons;
+  }();
+  return reasons;
+}
+
+const FlagReason* findFactoryReason(uint16_t id, std::string_view name, bool bad)
+{
+  const auto& reasons = getFactoryReasons();
+  auto it = reasons.find(id);
+  if (it == reasons.end() || it->second.getName() != name || it->second.getBad() != bad) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+TClass* getFlagReasonClass()
+{
+  static auto* reasonClass = TClass::GetClass(typeid(FlagReason));
+  if (reasonClass == nullptr) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Could not find the dictionary of FlagReason, which is needed to encode QualityObjects"));
+  }
+  return reasonClass;
+}
+
+// Returns an empty buffer for the reasons of FlagReasonFactory. Each other distinct reason is streamed once.
+const std::vector<char>& getStreamedReason(const FlagReason& reason)
+{
+  static const std::vector<char> none;
+  auto id = static_cast<uint16_t>(reason.getID());
+  if (findFactoryReason(id, reason.getName(), reason.getBad()) != nullptr) {
+    return none;
+  }
+
+  static std::mutex mutex;
+  static std::map<FlagReasonKey, std::vector<char>> streamed;
+  std::lock_guard lock(mutex);
+  auto key = std::make_tuple(id, reason.getName(), reason.getBad());
+  if (auto it = streamed.find(key); it != streamed.end()) {
+    return it->second;
+  }
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObjectAny(&reason, getFlagReasonClass());
+  return streamed.emplace(std::move(key), std::vector<char>(buffer.Buffer(), buffer.Buffer() + buffer.Length())).first->second;
+}
+
+FlagReason decodeFlagReason(uint16_t id, std::string_view name, bool bad, std::string_view streamedReason)
+{
+  if (streamedReason.empty()) {
+    if (auto* reason = findFactoryReason(id, name, bad)) {
+      return *reason;
+    }
+    throwMalformed("the flag reason " + std::to_string(id) + " '" + std::string(name) + "' is not provided by FlagReasonFactory");
+  }
+
+  static std::mutex mutex;
+  static std::map<FlagReasonKey, FlagReason> decoded;
+  std::lock_guard lock(mutex);
+  auto key = std::make_tuple(id, std::string(name), bad);
+  if (auto it = decoded.find(key); it != decoded.end()) {
+    return it->second;
+  }
+  TBufferFile buffer(TBuffer::kRead, streamedReason.size(), const_cast<char*>(streamedReason.data()), false);
+  std::unique_ptr<FlagReason> reason(static_cast<FlagReason*>(buffer.ReadObjectAny(getFlagReasonClass())));
+  if (reason == nullptr || static_cast<uint16_t>(reason->getID()) != id || reason->getName() != name || reason->getBad() != bad) {
+    throwMalformed("the streamed flag reason " + std::to_string(id) + " '" + std::string(name) + "' could not be read");
+  }
+  return decoded.emplace(std::move(key), *reason).first->second;
+}
+
+// Sizes of the fields, in the same order as they are written by encodeRecord()
+
+size_t stringSize(const std::string& string)
+{
+  return sizeof(uint32_t) + string.size();
+}
+
+size_t stringsSize(const std::vector<std::string>& strings)
+{
+  size_t size = sizeof(uint32_t);
+  for (const auto& string : strings) {
+    size += stringSize(string);
+  }
+  return size;
+}
+
+size_t recordSize(const QualityObject& qo)
+{
+  const auto& activity = qo.getActivity();
+  size_t size = sizeof(uint32_t); // quality level
+  size += stringSize(qo.getQuality().getName());
+  size += stringSize(qo.getCheckName());
+  size += stringSize(qo.getDetectorName());
+  size += stringSize(qo.getPolicyName());
+  size += stringsSize(qo.getMonitorObjectsNames());
+  size += stringsSize(qo.getInputs());
+  size += 2 * sizeof(int32_t) + stringSize(activity.mPeriodName) + stringSize(activity.mPassName) + stringSize(activity.mProvenance) + 2 * sizeof(uint64_t);
+  size += sizeof(uint32_t);
+  for (const auto& [reason, comment] : qo.getReasons()) {
+    size += sizeof(uint16_t) + stringSize(reason.getName()) + sizeof(uint8_t) + sizeof(uint32_t) + getStreamedReason(reason).size() + stringSize(comment);
+  }
+  size += sizeof(uint32_t);
+  for (const auto& [key, value] : qo.getMetadataMap()) {
+    size += stringSize(key) + stringSize(value);
+  }
+  return size;
+}
+
+class Writer
+{
+ public:
+  explicit Writer(char* buffer) : mPosition(buffer) {}
+
+  template <typename T>
+  void write(T value)
+  {
+    static_assert(std::is_arithmetic_v<T>);
+    std::memcpy(mPosition, &value, sizeof(T));
+    mPosition += sizeof(T);
+  }
+
+  void write(const std::string& string)
+  {
+    write(static_cast<uint32_t>(string.size()));
+    std::memcpy(mPosition, string.data(), string.size());
+    mPosition += string.size();
+  }
+
+  void write(const std::vector<char>& bytes)
+  {
+    write(static_cast<uint32_t>(bytes.size()));
+    std::memcpy(mPosition, bytes.data(), bytes.size());
+    mPosition += bytes.size();
+  }
+
+  void write(const std::vector<std::string>& strings)
+  {
+    write(static_cast<uint32_t>(strings.size()));
+    for (const auto& string : strings) {
+      write(string);
+    }
+  }
+
+  char* position() const { return mPosition; }
+
+ private:
+  char* mPosition;
+};
+
+class Reader
+{
+ public:
+  Reader(const char* data, size_t size) : mPosition(data), mEnd(data + size) {}
+
+  template <typename T>
+  T read()
+  {
+    static_assert(std::is_arithmetic_v<T>);
+    require(sizeof(T));
+    T value;
+    std::memcpy(&value, mPosition, sizeof(T));
+    mPosition += sizeof(T);
+    return value;
+  }
+
+  std::string_view readString()
+  {
+    auto length = read<uint32_t>();
+    require(length);
+    std::string_view string(mPosition, length);
+    mPosition += length;
+    return string;
+  }
+
+  std::vector<std::string> readStrings()
+  {
+    auto count = read<uint32_t>();
+    std::vector<std::string> strings;
+    strings.reserve(std::min<size_t>(count, remaining() / sizeof(uint32_t)));
+    for (uint32_t i = 0; i < count; i++) {
+      strings.emplace_back(readString());
+    }
+    return strings;
+  }
+
+  size_t remaining() const { return mEnd - mPosition; }
+
+ private:
+  void require(size_t size) const
+  {
+    if (remaining() < size) {
+      throwMalformed("a field is truncated");
+    }
+  }
+
+  const char* mPosition;
+  const char* mEnd;
+};
+
+void encodeRecord(Writer& writer, const QualityObject& qo)
+{
+  const auto& activity = qo.getActivity();
+  const auto& quality = qo.getQuality();
+  writer.write(static_cast<uint32_t>(quality.getLevel()));
+  writer.write(quality.getName());
+  writer.write(qo.getCheckName());
+  writer.write(qo.getDetectorName());
+  writer.write(qo.getPolicyName());
+  writer.write(qo.getMonitorObjectsNames());
+  writer.write(qo.getInputs());
+  writer.write(static_cast<int32_t>(activity.mId));
+  writer.write(static_cast<int32_t>(activity.mType));
+  writer.write(activity.mPeriodName);
+  writer.write(activity.mPassName);
+  writer.write(activity.mProvenance);
+  writer.write(static_cast<uint64_t>(activity.mValidity.getMin()));
+  writer.write(static_cast<uint64_t>(activity.mValidity.getMax()));
+  writer.write(static_cast<uint32_t>(qo.getReasons().size()));
+  for (const auto& [reason, comment] : qo.getReasons()) {
+    writer.write(static_cast<uint16_t>(reason.getID()));
+    writer.write(reason.getName());
+    writer.write(static_cast<uint8_t>(reason.getBad()));
+    writer.write(getStreamedReason(reason));
+    writer.write(comment);
+  }
+  writer.write(static_cast<uint32_t>(qo.getMetadataMap().size()));
+  for (const auto& [key, value] : qo.getMetadataMap()) {
+    writer.write(key);
+    writer.write(value);
+  }
+}
+
+} // namespace
+
+size_t QualityObjectCodec::getEncodedSize(const QualityObjectsType& qualityObjects)
+{
+  size_t size = headerSize;
+  for (const auto& qo : qualityObjects) {
+    size += sizeof(uint32_t) + recordSize(*qo);
+  }
+  return size;
+}
+
+size_t QualityObjectCodec::encode(const QualityObjectsType& qualityObjects, char* buffer, size_t bufferSize)
+{
+  auto encodedSize = getEncodedSize(qualityObjects);
+  if (bufferSize < encodedSize) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The buffer for encoding " + std::to_string(qualityObjects.size()) + " QualityObjects is too small: "
+                                                              + std::to_string(bufferSize) + " bytes given, " + std::to_string(encodedSize) + " needed"));
+  }
+
+  Writer writer(buffer);
+  writer.write(magic);
+  writer.write(version);
+  writer.write(static_cast<uint16_t>(0)); // reserved for flags
+  writer.write(static_cast<uint32_t>(qualityObjects.size()));
+  for (const auto& qo : qualityObjects) {
+    writer.write(static_cast<uint32_t>(recordSize(*qo)));
+    encodeRecord(writer, *qo);
+  }
+  return writer.position() - buffer;
+}
+
+std::vector<char> QualityObjectCodec::encode(const QualityObjectsType& qualityObjects)
+{
+  std::vector<char> buffer(getEncodedSize(qualityObjects));
+  encode(qualityObjects, buffer.data(), buffer.size());
+  return buffer;
+}
+
+bool QualityObjectCodec::isEncodedBatch(const char* data, size_t size)
+{
+  if (data == nullptr || size < headerSize) {
+    return false;
+  }
+  uint32_t batchMagic;
+  std::memcpy(&batchMagic, data, sizeof(batchMagic));
+  return batchMagic == magic;
+}
+
+QualityObjectView::QualityObjectView(const char* record, size_t size) : mRecord(record), mSize(size)
+{
+  Reader reader(record, size);
+  mLevel = reader.read<uint32_t>();
+  mQualityName = reader.readString();
+  mCheckName = reader.readString();
+  mDetectorName = reader.readString();
+  mPolicyName = reader.readString();
+  mNumberOfMonitorObjects = reader.read<uint32_t>();
+  if (mNumberOfMonitorObjects > 0) {
+    mFirstMonitorObjectName = reader.readString();
+  }
+}
+
+std::string QualityObjectView::getName() const
+{
+  if (mPolicyName == "OnEachSeparately") {
+    if (mNumberOfMonitorObjects != 1) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("QualityObjectView::getName: "
+                                                                "The vector of monitorObjectsNames must contain a single object"));
+    }
+    return std::string(mCheckName) + "/" + std::string(mFirstMonitorObjectName);
+  }
+  return std::string(mCheckName);
+}
+
+std::shared_ptr<QualityObject> QualityObjectView::toQualityObject() const
+{
+  Reader reader(mRecord, mSize);
+  auto level = reader.read<uint32_t>();
+  Quality quality(level, std::string(reader.readString()));
+  std::string checkName(reader.readString());
+  std::string detectorName(reader.readString());
+  std::string policyName(reader.readString());
+  auto monitorObjectsNames = reader.readStrings();
+  auto inputs = reader.readStrings();
+
+  Activity activity;
+  activity.mId = reader.read<int32_t>();
+  activity.mType = reader.read<int32_t>();
+  activity.mPeriodName = reader.readString();
+  activity.mPassName = reader.readString();
+  activity.mProvenance = reader.readString();
+  auto validityMin = reader.read<uint64_t>();
+  auto validityMax = reader.read<uint64_t>();
+  activity.mValidity = ValidityInterval(validityMin, validityMax);
+
+  auto numberOfReasons = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < numberOfReasons; i++) {
+    auto id = reader.read<uint16_t>();
+    auto name = reader.readString();
+    auto bad = reader.read<uint8_t>() != 0;
+    auto streamedReason = reader.readString();
+    quality.addReason(decodeFlagReason(id, name, bad, streamedReason), std::string(reader.readString()));
+  }
+
+  std::map<std::string, std::string> metadata;
+  auto numberOfMetadata = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < numberOfMetadata; i++) {
+    std::string key(reader.readString());
+    metadata.emplace(std::move(key), reader.readString());
+  }
+
+  auto qo = std::make_shared<QualityObject>(quality, std::move(checkName), std::move(detectorName), std::move(policyName),
+                                            std::move(inputs), std::move(monitorObjectsNames), std::move(metadata));
+  qo->setActivity(activity);
+  return qo;
+}
+
+QualityObjectsBatchView::QualityObjectsBatchView(const char* data, size_t size) : mData(data), mSize(size)
+{
+  if (!QualityObjectCodec::isEncodedBatch(data, size)) {
+    throwMalformed("the header is missing");
+  }
+  Reader reader(data, size);
+  reader.read<uint32_t>(); // magic
+  auto batchVersion = reader.read<uint16_t>();
+  if (batchVersion != QualityObjectCodec::version) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Unsupported version of encoded QualityObjects: " + std::to_string(batchVersion)
+                                                              + ", expected " + std::to_string(QualityObjectCodec::version)));
+  }
+  reader.read<uint16_t>(); // flags
+  mNumberOfObjects = reader.read<uint32_t>();
+}
+
+size_t QualityObjectsBatchView::iterator::recordSize() const
+{
+  Reader reader(mPosition, mEnd - mPosition);
+  auto size = reader.read<uint32_t>();
+  if (reader.remaining() < size) {
+    throwMalformed("a record is truncated");
+  }
+  return size;
+}
+
+QualityObjectView QualityObjectsBatchView::iterator::operator*() const
+{
+  return { mPosition + sizeof(uint32_t), recordSize() };
+}
+
+QualityObjectsBatchView::iterator& QualityObjectsBatchView::iterator::operator++()
+{
+  mPosition += sizeof(uint32_t) + recordSize();
+  mRemaining--;
+  return *this;
+}
+
+QualityObjectsType QualityObjectsBatchView::toQualityObjects() const
+{
+  QualityObjectsType qualityObjects;
+  qualityObjects.reserve(mNumberOfObjects);
+  for (const auto& view : *this) {
+    qualityObjects.push_back(view.toQualityObject());
+  }
+  return qualityObjects;
+}
+
+} // namespace o2::quality_control::core
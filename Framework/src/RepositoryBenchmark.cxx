@@ -15,13 +15,18 @@
 ///
 
 #include "RepositoryBenchmark.h"
+#include "LocalCcdbServer.h"
 
 #include <chrono>
-#include <thread> // this_thread::sleep_for
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
 
-#include <TH2F.h>
-
-#include <fairmq/ProgOptions.h> // device->fConfig
+#include <TH1F.h>
+#include <TROOT.h>
+#include <boost/algorithm/string.hpp>
 
 #include <Common/Exceptions.h>
 
@@ -32,165 +37,291 @@ using namespace std;
 using namespace std::chrono;
 using namespace AliceO2::Common;
 using namespace o2::quality_control::repository;
-using namespace o2::monitoring;
 
 namespace o2::quality_control::core
 {
 
-TH1* RepositoryBenchmark::createHisto(uint64_t sizeObjects, string name)
+constexpr auto benchmarkDetector = "BMK";
+
+size_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+  if (value < subBuckets) {
+    return value;
+  }
+  // the position of the most significant bit gives the power of two, the following bits give the sub-bucket
+  size_t msb = 63 - __builtin_clzll(value);
+  size_t shift = msb - subBucketsBits;
+  return (shift + 1) * subBuckets + ((value >> shift) & (subBuckets - 1));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+  if (index < subBuckets) {
+    return index;
+  }
+  size_t shift = index / subBuckets - 1;
+  uint64_t lower = (subBuckets + index % subBuckets) << shift;
+  return lower + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+  mCounts[bucketIndex(nanoseconds)]++;
+  mCount++;
+  mSum += nanoseconds;
+  mMax = std::max(mMax, nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
 {
-  TH1* myHisto;
-
-  // Prepare objects (and clean up existing ones)
-  switch (sizeObjects) {
-    case 1:
-      myHisto = new TH1F(name.c_str(), "h", 100, 0, 99); // 1kB
-      break;
-    case 10:
-      myHisto = new TH1F(name.c_str(), "h", 2400, 0, 99); // 10kB
-      break;
-    case 100:
-      myHisto = new TH2F(name.c_str(), "h", 260, 0, 99, 100, 0, 99); // 100kB
-      break;
-    case 500:
-      myHisto = new TH2F(name.c_str(), "h", 1250, 0, 99, 100, 0, 99); // 500kB
-      break;
-    case 1000:
-      myHisto = new TH2F(name.c_str(), "h", 2500, 0, 99, 100, 0, 99); // 1MB
-      break;
-    case 2500:
-      myHisto = new TH2F(name.c_str(), "h", 6250, 0, 99, 100, 0, 99); // 2.5MB
-      break;
-    case 5000:
-      myHisto = new TH2F(name.c_str(), "h", 12500, 0, 99, 100, 0, 99); // 5MB
-      break;
-    default:
-      BOOST_THROW_EXCEPTION(
-        FatalException() << errinfo_details(
-          "size of histo must be 1, 10, 100, 500, 1000, 2500 or 5000 (was: " + to_string(mSizeObjects) + ")"));
-  }
-  return myHisto;
+  for (size_t i = 0; i < mCounts.size(); i++) {
+    mCounts[i] += other.mCounts[i];
+  }
+  mCount += other.mCount;
+  mSum += other.mSum;
+  mMax = std::max(mMax, other.mMax);
 }
 
-void RepositoryBenchmark::InitTask()
+uint64_t LatencyHistogram::percentile(double p) const
 {
-  // parse arguments database
-  string dbUrl = fConfig->GetValue<string>("database-url");
-  string dbBackend = fConfig->GetValue<string>("database-backend");
-  mTaskName = fConfig->GetValue<string>("task-name");
-  try {
-    mDatabase = o2::quality_control::repository::DatabaseFactory::create(dbBackend);
-    mDatabase->connect(fConfig->GetValue<string>("database-url"), fConfig->GetValue<string>("database-name"),
-                       fConfig->GetValue<string>("database-username"), fConfig->GetValue<string>("database-password"));
-    mDatabase->prepareTaskDataContainer(mTaskName);
-  } catch (boost::exception& exc) {
-    string diagnostic = boost::current_exception_diagnostic_information();
-    ILOG(Error, Support) << "Unexpected exception, diagnostic information follows:\n"
-                         << diagnostic << ENDM;
-    if (diagnostic == "No diagnostic information available.") {
-      throw;
+  if (mCount == 0) {
+    return 0;
+  }
+  auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * mCount)));
+  uint64_t cumulated = 0;
+  for (size_t i = 0; i < mCounts.size(); i++) {
+    cumulated += mCounts[i];
+    if (cumulated >= target) {
+      return std::min(bucketUpperBound(i), mMax);
     }
   }
+  return mMax;
+}
 
-  // parse other arguments
-  mMaxIterations = fConfig->GetValue<uint64_t>("max-iterations");
-  mNumberObjects = fConfig->GetValue<uint64_t>("number-objects");
-  mSizeObjects = fConfig->GetValue<uint64_t>("size-objects");
-  mDeletionMode = static_cast<bool>(fConfig->GetValue<int>("delete"));
-  mObjectName = fConfig->GetValue<string>("object-name");
-  auto numberTasks = fConfig->GetValue<uint64_t>("number-tasks");
-
-  // monitoring
-  mMonitoring = MonitoringFactory::Get(fConfig->GetValue<string>("monitoring-url"));
-  mThreadedMonitoring = static_cast<bool>(fConfig->GetValue<int>("monitoring-threaded"));
-  mThreadedMonitoringInterval = fConfig->GetValue<int>("monitoring-threaded-interval");
-  mMonitoring->enableProcessMonitoring(1); // collect every seconds metrics for this process
-  mMonitoring->addGlobalTag("taskName", mTaskName);
-  mMonitoring->addGlobalTag("numberObject", to_string(mNumberObjects));
-  mMonitoring->addGlobalTag("sizeObject", to_string(mSizeObjects));
-  if (mTaskName == "benchmarkTask_0") { // send these parameters to monitoring only once per benchmark run
-    mMonitoring->send(Metric{ "ccdb_benchmark" }
-                        .addValue(mNumberObjects, "number_objects")
-                        .addValue(mSizeObjects * 1000, "size_objects")
-                        .addValue(numberTasks, "number_tasks"));
-  }
-
-  if (mDeletionMode) {
-    ILOG(Info, Support) << "Deletion mode..." << infologger::endm;
-    emptyDatabase();
-  }
-
-  // prepare objects
-  for (uint64_t i = 0; i < mNumberObjects; i++) {
-    TH1* histo = createHisto(mSizeObjects, mObjectName + to_string(i));
-    shared_ptr<MonitorObject> mo = make_shared<MonitorObject>(histo, mTaskName, "Benchmark", "BMK");
-    mo->setIsOwner(true);
-    mMyObjects.push_back(mo);
-  }
-
-  // start a timer in a thread to send monitoring metrics, if needed
-  if (mThreadedMonitoring) {
-    mTimer = new boost::asio::deadline_timer(io, boost::posix_time::seconds(mThreadedMonitoringInterval));
-    mTimer->async_wait(boost::bind(&RepositoryBenchmark::checkTimedOut, this));
-    th = new thread([&] { io.run(); });
+RepositoryBenchmark::RepositoryBenchmark(Config config) : mConfig(std::move(config))
+{
+  if (mConfig.clients == 0 || mConfig.objectsPerSize == 0) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The number of clients and objects must be positive"));
   }
+  if (mConfig.operationMix.empty()) {
+    mConfig.operationMix = { { Operation::Store, 1 } };
+  }
+  if (mConfig.sizeMix.empty()) {
+    mConfig.sizeMix = { { 1, 1 } };
+  }
+
+  for (const auto& [size, weight] : mConfig.sizeMix) {
+    mSizes.push_back(size);
+  }
+  mObjects = createObjects();
 }
 
-void RepositoryBenchmark::checkTimedOut()
+std::vector<std::shared_ptr<MonitorObject>> RepositoryBenchmark::createObjects() const
 {
-  mMonitoring->send({ mTotalNumberObjects, "ccdb_benchmark_objects_sent" }, DerivedMetricMode::RATE);
+  std::vector<std::shared_ptr<MonitorObject>> objects;
+  for (auto size : mSizes) {
+    for (size_t i = 0; i < mConfig.objectsPerSize; i++) {
+      TH1* histo = createHisto(size, getObjectName(size, i), mConfig.seed + i);
+      auto mo = make_shared<MonitorObject>(histo, mConfig.taskName, "Benchmark", benchmarkDetector);
+      mo->setIsOwner(true);
+      objects.push_back(mo);
+    }
+  }
+  return objects;
+}
 
-  // restart timer
-  mTimer->expires_at(mTimer->expires_at() + boost::posix_time::seconds(mThreadedMonitoringInterval));
-  mTimer->async_wait(boost::bind(&RepositoryBenchmark::checkTimedOut, this));
+std::string RepositoryBenchmark::getObjectName(uint64_t size, size_t index) const
+{
+  return mConfig.objectName + "-" + to_string(size) + "kB-" + to_string(index);
 }
 
-bool RepositoryBenchmark::ConditionalRun()
+TH1* RepositoryBenchmark::createHisto(uint64_t sizeObjects, const std::string& name, uint32_t seed)
 {
-  if (mDeletionMode) { // the only way to not run is to return false from here.
-    return false;
+  if (sizeObjects == 0) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("size of histo must be positive"));
+  }
+  // 4 bytes per bin. Contents are random, so that the compression does not make the objects much smaller.
+  auto bins = static_cast<int>(sizeObjects * 1000 / 4);
+  auto* histo = new TH1F(name.c_str(), "h", bins, 0, 99);
+  histo->SetDirectory(nullptr);
+  std::default_random_engine generator(seed);
+  std::uniform_real_distribution<float> distribution(0, 1000);
+  for (int i = 1; i <= bins; i++) {
+    histo->SetBinContent(i, distribution(generator));
   }
+  return histo;
+}
 
-  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+RepositoryBenchmark::Result RepositoryBenchmark::run()
+{
+  // the clients stream and read objects in parallel
+  ROOT::EnableThreadSafety();
 
-  // Store the object
-  for (unsigned int i = 0; i < mNumberObjects; i++) {
-    mDatabase->storeMO(mMyObjects[i]);
-    mTotalNumberObjects++;
+  std::unique_ptr<LocalCcdbServer> server;
+  auto url = mConfig.databaseUrl;
+  if (mConfig.localServer) {
+    server = std::make_unique<LocalCcdbServer>();
+    url = server->getUrl();
   }
-  if (!mThreadedMonitoring) {
-    mMonitoring->send({ mTotalNumberObjects, "ccdb_benchmark_objects_sent" }, DerivedMetricMode::RATE);
+
+  // each client has its own connection and its own copies of the objects, so they share nothing but the server
+  std::vector<std::unique_ptr<DatabaseInterface>> databases;
+  std::vector<std::vector<std::shared_ptr<MonitorObject>>> clientObjects;
+  for (size_t c = 0; c < mConfig.clients; c++) {
+    auto database = DatabaseFactory::create(mConfig.databaseBackend);
+    database->connect(url, "", "", "");
+    database->setMaxObjectSize(std::numeric_limits<int>::max());
+    databases.push_back(std::move(database));
+    clientObjects.push_back(c == 0 ? mObjects : createObjects());
   }
 
-  high_resolution_clock::time_point t2 = high_resolution_clock::now();
-  long duration = duration_cast<milliseconds>(t2 - t1).count();
-  mMonitoring->send({ duration / mNumberObjects, "ccdb_benchmark_store_duration_for_one_object_ms" });
+  // each object exists before we start retrieving them
+  for (const auto& mo : mObjects) {
+    databases[0]->storeMO(mo);
+  }
 
-  // determine how long we should wait till next iteration in order to have 1 sec between storage
-  auto duration2 = duration_cast<microseconds>(t2 - t1);
-  auto remaining = duration_cast<microseconds>(std::chrono::seconds(1) - duration2);
-  //  ILOG(Info, Support) <<"Remaining duration : " << remaining.count() << " us" << infologger::endm;
-  if (remaining.count() < 0) {
-    ILOG(Info, Support) << "Remaining duration is negative, we don't sleep " << infologger::endm;
-  } else {
-    this_thread::sleep_for(chrono::microseconds(remaining));
+  // retrieveMO expects the path without the provenance, the listing expects it with
+  const auto objectPath = std::string(benchmarkDetector) + "/MO/" + mConfig.taskName;
+  const auto taskPath = "qc/" + objectPath;
+  const auto end = steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(mConfig.duration));
+
+  std::vector<Operation> operations;
+  std::vector<double> operationWeights;
+  for (const auto& [operation, weight] : mConfig.operationMix) {
+    operations.push_back(operation);
+    operationWeights.push_back(weight);
+  }
+  std::vector<double> sizeWeights;
+  for (const auto& [size, weight] : mConfig.sizeMix) {
+    sizeWeights.push_back(weight);
   }
 
-  if (mMaxIterations > 0 && ++mNumIterations >= mMaxIterations) {
-    ILOG(Info, Support) << "Configured maximum number of iterations reached. Leaving RUNNING state."
-                        << infologger::endm;
-    return false;
+  Result result;
+  std::mutex resultMutex;
+  auto start = steady_clock::now();
+  std::vector<std::thread> clients;
+  for (size_t c = 0; c < mConfig.clients; c++) {
+    clients.emplace_back([&, c]() {
+      auto& database = *databases[c];
+      const auto& objects = clientObjects[c];
+      std::default_random_engine generator(mConfig.seed + c);
+      std::discrete_distribution<size_t> operationDistribution(operationWeights.begin(), operationWeights.end());
+      std::discrete_distribution<size_t> sizeDistribution(sizeWeights.begin(), sizeWeights.end());
+      std::uniform_int_distribution<size_t> indexDistribution(0, mConfig.objectsPerSize - 1);
+
+      Result local;
+      for (uint64_t i = 0; (mConfig.maxOperations == 0 || i < mConfig.maxOperations) && steady_clock::now() < end; i++) {
+        auto operation = operations[operationDistribution(generator)];
+        auto sizeIndex = sizeDistribution(generator);
+        const auto& mo = objects[sizeIndex * mConfig.objectsPerSize + indexDistribution(generator)];
+
+        bool success = true;
+        auto operationStart = steady_clock::now();
+        try {
+          switch (operation) {
+            case Operation::Store:
+              database.storeMO(mo);
+              local.storedBytes += mSizes[sizeIndex] * 1000;
+              break;
+            case Operation::Retrieve:
+              success = database.retrieveMO(objectPath, mo->getName()) != nullptr;
+              break;
+            case Operation::List:
+              success = !database.getPublishedObjectNames(taskPath).empty();
+              break;
+          }
+        } catch (...) {
+          success = false;
+        }
+        local.latencies[operation].record(duration_cast<nanoseconds>(steady_clock::now() - operationStart).count());
+        if (!success) {
+          local.failures[operation]++;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(resultMutex);
+      for (const auto& [operation, histogram] : local.latencies) {
+        result.latencies[operation].merge(histogram);
+      }
+      for (const auto& [operation, failures] : local.failures) {
+        result.failures[operation] += failures;
+      }
+      result.storedBytes += local.storedBytes;
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
   }
+  result.elapsed = duration<double>(steady_clock::now() - start).count();
 
-  return true;
+  if (server) {
+    result.serverRequests = server->getRequestCount();
+    result.serverHandlingTimeNs = server->getHandlingTimeNs();
+  }
+  return result;
 }
 
 void RepositoryBenchmark::emptyDatabase()
 {
-  mDatabase->truncate(mTaskName, mObjectName);
-  for (uint64_t i = 0; i < mNumberObjects; i++) {
-    mDatabase->truncate(mTaskName, mObjectName + to_string(i));
+  auto database = DatabaseFactory::create(mConfig.databaseBackend);
+  database->connect(mConfig.databaseUrl, "", "", "");
+  for (const auto& mo : mObjects) {
+    database->truncate("qc/" + std::string(benchmarkDetector) + "/MO/" + mConfig.taskName, mo->getName());
+  }
+}
+
+std::string RepositoryBenchmark::toString(Operation operation)
+{
+  switch (operation) {
+    case Operation::Store:
+      return "store";
+    case Operation::Retrieve:
+      return "retrieve";
+    case Operation::List:
+      return "list";
+  }
+  return "unknown";
+}
+
+std::map<RepositoryBenchmark::Operation, double> RepositoryBenchmark::parseOperationMix(const std::string& mix)
+{
+  std::map<Operation, double> result;
+  std::vector<std::string> items;
+  boost::split(items, mix, boost::is_any_of(","));
+  for (const auto& item : items) {
+    auto colon = item.find(':');
+    auto name = boost::trim_copy(item.substr(0, colon));
+    double weight = colon == std::string::npos ? 1.0 : std::stod(item.substr(colon + 1));
+    if (name == "store") {
+      result[Operation::Store] = weight;
+    } else if (name == "retrieve") {
+      result[Operation::Retrieve] = weight;
+    } else if (name == "list") {
+      result[Operation::List] = weight;
+    } else if (!name.empty()) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Unknown operation '" + name + "', use store, retrieve or list"));
+    }
+  }
+  return result;
+}
+
+std::map<uint64_t, double> RepositoryBenchmark::parseSizeMix(const std::string& mix)
+{
+  std::map<uint64_t, double> result;
+  std::vector<std::string> items;
+  boost::split(items, mix, boost::is_any_of(","));
+  for (const auto& item : items) {
+    if (boost::trim_copy(item).empty()) {
+      continue;
+    }
+    auto colon = item.find(':');
+    auto size = std::stoull(item.substr(0, colon));
+    if (size == 0) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Object sizes must be positive"));
+    }
+    result[size] = colon == std::string::npos ? 1.0 : std::stod(item.substr(colon + 1));
   }
+  return result;
 }
 
 } // namespace o2::quality_control::core
@@ -17,55 +17,107 @@
 #ifndef QC_REPOSITORYBENCHMARK_H
 #define QC_REPOSITORYBENCHMARK_H
 
-#include "QualityControl/DatabaseInterface.h"
-#include <fairmq/Device.h>
-#include <TH1.h>
-#include <Monitoring/MonitoringFactory.h>
-#include <boost/asio.hpp>
-#include <thread>
+#include "QualityControl/MonitorObject.h"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
+
+class TH1;
 
 namespace o2::quality_control::core
 {
 
-class RepositoryBenchmark : public fair::mq::Device
+/// \brief Latency histogram with logarithmic buckets, each of them 1/32 of its power of two wide.
+///
+/// The relative error of the reported percentiles is thus below 3%, while recording is a couple of integer operations
+/// and the memory footprint does not depend on the number of samples.
+class LatencyHistogram
+{
+ public:
+  void record(uint64_t nanoseconds);
+  void merge(const LatencyHistogram& other);
+  /// \brief Returns the upper bound of the bucket containing the given percentile (0-100) in nanoseconds.
+  uint64_t percentile(double p) const;
+  uint64_t count() const { return mCount; }
+  uint64_t max() const { return mMax; }
+  double mean() const { return mCount ? static_cast<double>(mSum) / mCount : 0; }
+
+ private:
+  static constexpr size_t subBucketsBits = 5;
+  static constexpr size_t subBuckets = 1 << subBucketsBits;
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t bucketUpperBound(size_t index);
+
+  std::array<uint64_t, (64 - subBucketsBits + 1) * subBuckets> mCounts{};
+  uint64_t mCount = 0;
+  uint64_t mSum = 0;
+  uint64_t mMax = 0;
+};
+
+/// \brief Multi-threaded benchmark of the QC repository client.
+///
+/// A number of clients, each with its own database connection, run a mixed workload of stores, retrievals and
+/// listings of MonitorObjects, whose sizes follow a configurable distribution. The latency of each operation is
+/// recorded per operation type. The benchmark can run against a local in-memory CCDB stand-in, so that the overhead
+/// of the client (serialization, HTTP, deserialization) can be measured separately from the one of the server.
+class RepositoryBenchmark
 {
  public:
-  RepositoryBenchmark() = default;
-  virtual ~RepositoryBenchmark() = default;
+  enum class Operation { Store,
+                         Retrieve,
+                         List };
+
+  struct Config {
+    std::string databaseBackend = "CCDB";
+    std::string databaseUrl;
+    bool localServer = false;                   // run against an in-memory CCDB stand-in instead of databaseUrl
+    size_t clients = 1;                         // number of concurrent clients, each in its own thread
+    double duration = 10;                       // in seconds
+    uint64_t maxOperations = 0;                 // per client, 0 for no limit
+    std::map<Operation, double> operationMix;   // relative weights of operations
+    std::map<uint64_t, double> sizeMix;         // object sizes in kB and their relative weights
+    size_t objectsPerSize = 10;                 // number of distinct objects of each size
+    std::string taskName = "benchmarkTask";
+    std::string objectName = "benchmark";
+    uint32_t seed = 0;
+  };
 
- protected:
-  virtual void InitTask();
-  virtual bool ConditionalRun();
+  struct Result {
+    std::map<Operation, LatencyHistogram> latencies;
+    std::map<Operation, uint64_t> failures;
+    uint64_t storedBytes = 0;
+    double elapsed = 0;                 // in seconds
+    uint64_t serverRequests = 0;        // only with the local server
+    uint64_t serverHandlingTimeNs = 0;  // only with the local server
+  };
+
+  explicit RepositoryBenchmark(Config config);
+
+  /// \brief Stores each object once, then runs the workload in all the clients and returns the merged results.
+  Result run();
+  /// \brief Deletes all the versions of the benchmark objects.
   void emptyDatabase();
-  void checkTimedOut();
-  TH1* createHisto(uint64_t sizeObjects, std::string name);
+
+  /// \brief Parses a mix like "store:70,retrieve:25,list:5".
+  static std::map<Operation, double> parseOperationMix(const std::string& mix);
+  /// \brief Parses a size distribution like "1:80,100:15,1000:5" (kB:weight).
+  static std::map<uint64_t, double> parseSizeMix(const std::string& mix);
+  static std::string toString(Operation operation);
+  /// \brief Creates a histogram which takes approximately the given size in kB once serialized.
+  static TH1* createHisto(uint64_t sizeObjects, const std::string& name, uint32_t seed = 0);
 
  private:
-  // user params
-  uint64_t mMaxIterations = 0;
-  uint64_t mNumIterations = 0;
-  uint64_t mNumberObjects = 1;
-  uint64_t mSizeObjects = 1;
-  std::string mTaskName;
-  std::string mObjectName;
-  bool mDeletionMode = false; // todo: is false ok as default?
-
-  // monitoring
-  std::unique_ptr<o2::monitoring::Monitoring> mMonitoring;
-  uint64_t mTotalNumberObjects = 0;
-  bool mThreadedMonitoring = true;
-  uint64_t mThreadedMonitoringInterval = 10;
-
-  // internal state
-  std::unique_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
-  std::vector<std::shared_ptr<MonitorObject>> mMyObjects;
-  //  TH1* mMyHisto;
-
-  // variables for the timer
-  boost::asio::deadline_timer* mTimer; /// the asynchronous timer to send monitoring data
-  boost::asio::io_service io;
-  std::thread* th;
+  std::string getObjectName(uint64_t size, size_t index) const;
+  /// \brief Creates the benchmark objects, the same ones at each call.
+  std::vector<std::shared_ptr<MonitorObject>> createObjects() const;
+
+  Config mConfig;
+  std::vector<std::shared_ptr<MonitorObject>> mObjects; // objects of each size follow each other
+  std::vector<uint64_t> mSizes;
 };
 
 } // namespace o2::quality_control::core
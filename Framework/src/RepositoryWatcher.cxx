@@ -0,0 +1,226 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    RepositoryWatcher.cxx
+///
+
+#include "QualityControl/RepositoryWatcher.h"
+#include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/Triggers.h"
+
+#include <CCDB/CcdbApi.h>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+namespace o2::quality_control::postprocessing
+{
+
+// Key names in the headers of an object.
+constexpr auto md5HeaderKey = "Content-MD5";
+constexpr auto createdHeaderKey = "Created";
+// Key names in the JSON listings, they differ from the headers.
+constexpr auto md5ListingKey = "MD5";
+constexpr auto validFromListingKey = "validFrom";
+constexpr auto createdListingKey = "createTime";
+// The creation time is given by the server clock, thus we overlap the queried periods to be safe against clock skews.
+// The objects which were already seen are filtered out.
+constexpr uint64_t clockSkewMarginMs = 10000;
+
+RepositoryWatcher::RepositoryWatcher(std::string databaseUrl) : mDatabaseUrl(std::move(databaseUrl)), mLastQueryTime(Trigger::msSinceEpoch())
+{
+  if (!mDatabaseUrl.empty()) {
+    mApi = std::make_unique<o2::ccdb::CcdbApi>();
+    mApi->init(mDatabaseUrl);
+    if (!mApi->isHostReachable()) {
+      ILOG(Error, Support) << "CCDB at URL '" << mDatabaseUrl << "' is not reachable." << ENDM;
+    }
+  }
+}
+
+RepositoryWatcher::~RepositoryWatcher() = default;
+
+std::shared_ptr<RepositoryWatcher> RepositoryWatcher::getInstance(const std::string& databaseUrl)
+{
+  static std::mutex instancesMutex;
+  static std::map<std::string, std::weak_ptr<RepositoryWatcher>> instances;
+
+  std::lock_guard<std::mutex> lock(instancesMutex);
+  auto watcher = instances[databaseUrl].lock();
+  if (!watcher) {
+    watcher = std::make_shared<RepositoryWatcher>(databaseUrl);
+    instances[databaseUrl] = watcher;
+  }
+  return watcher;
+}
+
+RepositoryWatcher::SubscriptionId RepositoryWatcher::subscribe(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  Subscription subscription{ path, metadata };
+
+  // We rely on changing MD5 - if the object has changed, it should have a different check sum.
+  // If someone reuploaded an old object, it should not have an influence.
+  if (mApi) {
+    std::lock_guard<std::mutex> apiLock(mApiMutex);
+    if (auto headers = mApi->retrieveHeaders(path, metadata); headers.count(md5HeaderKey)) {
+      subscription.lastMD5 = headers[md5HeaderKey];
+      if (headers.count(createdHeaderKey)) {
+        subscription.lastCreated = std::stoull(headers[createdHeaderKey]);
+      }
+    } else {
+      // We don't make a fuss over it, because we might be just waiting for the first version of such object.
+      // It should not happen often though, so having a warning makes sense.
+      ILOG(Warning, Support) << "No MD5 of the file '" << path << "' in the db '" << mDatabaseUrl << "', probably the file is missing." << ENDM;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  subscription.seenRound = mRound;
+  auto id = mNextId++;
+  mSubscriptions.emplace(id, std::move(subscription));
+  return id;
+}
+
+void RepositoryWatcher::unsubscribe(SubscriptionId id)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSubscriptions.erase(id);
+}
+
+std::optional<RepositoryWatcher::Update> RepositoryWatcher::poll(SubscriptionId id)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  auto it = mSubscriptions.find(id);
+  if (it == mSubscriptions.end()) {
+    return std::nullopt;
+  }
+  if (mApi && it->second.seenRound == mRound && !mRefreshing) {
+    // The listing requests are sent without holding the lock, so that the other subscribers are not blocked meanwhile.
+    // Only one of them refreshes at a time, the others return what they already have.
+    mRefreshing = true;
+    const auto prefix = getListingPrefix();
+    const auto lastQueryTime = mLastQueryTime;
+    lock.unlock();
+
+    const auto queryTime = Trigger::msSinceEpoch();
+    auto versions = prefix.has_value() ? list(prefix.value(), lastQueryTime, queryTime) : std::vector<ListedVersion>{};
+
+    lock.lock();
+    for (const auto& version : versions) {
+      dispatch(version.path, version.metadata, version.update);
+    }
+    mRequestCount += prefix.has_value() ? 1 : 0;
+    mLastQueryTime = queryTime;
+    mRound++;
+    mRefreshing = false;
+
+    it = mSubscriptions.find(id);
+    if (it == mSubscriptions.end()) {
+      return std::nullopt;
+    }
+  }
+  it->second.seenRound = mRound;
+  return std::exchange(it->second.pending, std::nullopt);
+}
+
+void RepositoryWatcher::notify(const std::string& path, const std::map<std::string, std::string>& metadata, const Update& update)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  dispatch(path, metadata, update);
+}
+
+size_t RepositoryWatcher::getRequestCount() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mRequestCount;
+}
+
+std::vector<RepositoryWatcher::ListedVersion> RepositoryWatcher::list(const std::string& prefix, uint64_t lastQueryTime, uint64_t queryTime)
+{
+  const long createdNotBefore = lastQueryTime > clockSkewMarginMs ? static_cast<long>(lastQueryTime - clockSkewMarginMs) : 0;
+
+  std::string listing;
+  {
+    std::lock_guard<std::mutex> apiLock(mApiMutex);
+    // the listing takes a regular expression, all the paths starting with the prefix are matched
+    listing = mApi->list(prefix + ".*", false, "application/json", -1, createdNotBefore);
+  }
+
+  boost::property_tree::ptree tree;
+  try {
+    std::stringstream listingStream(listing);
+    boost::property_tree::read_json(listingStream, tree);
+  } catch (const boost::property_tree::json_parser_error& e) {
+    ILOG(Warning, Support) << "Could not parse the listing of '" << prefix << "' in the db '" << mDatabaseUrl << "': " << e.what() << ENDM;
+    return {};
+  }
+
+  std::vector<ListedVersion> versions;
+  auto objects = tree.get_child_optional("objects");
+  if (!objects.has_value()) {
+    return versions;
+  }
+  for (const auto& [_, object] : objects.value()) {
+    auto path = object.get_optional<std::string>("path");
+    auto md5 = object.get_optional<std::string>(md5ListingKey);
+    if (!path.has_value() || !md5.has_value()) {
+      continue;
+    }
+    std::map<std::string, std::string> metadata;
+    for (const auto& [key, value] : object) {
+      if (value.empty()) {
+        metadata.emplace(key, value.data());
+      }
+    }
+    versions.push_back({ path.value(), std::move(metadata), { md5.value(), object.get<uint64_t>(validFromListingKey, 0), object.get<uint64_t>(createdListingKey, queryTime) } });
+  }
+  return versions;
+}
+
+void RepositoryWatcher::dispatch(const std::string& path, const std::map<std::string, std::string>& metadata, const Update& update)
+{
+  for (auto& [id, subscription] : mSubscriptions) {
+    // pushed updates might come without the creation time, then we rely only on MD5
+    bool seen = update.md5 == subscription.lastMD5 || (update.created != 0 && update.created <= subscription.lastCreated);
+    if (subscription.path != path || seen) {
+      continue;
+    }
+    bool matches = std::all_of(subscription.metadata.begin(), subscription.metadata.end(), [&](const auto& requirement) {
+      auto value = metadata.find(requirement.first);
+      return value != metadata.end() && value->second == requirement.second;
+    });
+    if (matches) {
+      subscription.lastMD5 = update.md5;
+      subscription.lastCreated = update.created;
+      subscription.pending = update;
+    }
+  }
+}
+
+std::optional<std::string> RepositoryWatcher::getListingPrefix() const
+{
+  // one listing for all the watched paths, the versions of other objects under the prefix are not dispatched
+  std::optional<std::string> prefix;
+  for (const auto& [id, subscription] : mSubscriptions) {
+    if (!prefix.has_value()) {
+      prefix = subscription.path;
+      continue;
+    }
+    auto mismatch = std::mismatch(prefix->begin(), prefix->end(), subscription.path.begin(), subscription.path.end());
+    prefix->erase(mismatch.first, prefix->end());
+  }
+  return prefix;
+}
+
+} // namespace o2::quality_control::postprocessing
@@ -21,56 +21,141 @@
 #include <Framework/ControlService.h>
 #include <TFile.h>
 #include <TKey.h>
+#include <TROOT.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
 
 using namespace o2::framework;
 
 namespace o2::quality_control::core
 {
-RootFileSource::RootFileSource(std::string filePath)
-  : mFilePath(std::move(filePath))
+
+// bounds the number of collections kept in memory besides the one being published
+constexpr size_t maxReadAhead = 4;
+
+RootFileSource::RootFileSource(std::string filePaths, std::vector<std::string> taskNames)
+  : mTaskNames(taskNames.begin(), taskNames.end())
 {
+  boost::split(mFilePaths, filePaths, boost::is_any_of(","), boost::token_compress_on);
+  mFilePaths.erase(std::remove(mFilePaths.begin(), mFilePaths.end(), ""), mFilePaths.end());
 }
 
+RootFileSource::~RootFileSource() = default;
+
 void RootFileSource::init(framework::InitContext&)
 {
+  // the files are read while the collections are serialized by the main thread
+  ROOT::EnableThreadSafety();
+
+  std::vector<std::deque<std::string>> keysPerFile;
+  for (const auto& filePath : mFilePaths) {
+    auto inputFile = std::make_unique<InputFile>();
+    inputFile->path = filePath;
+    inputFile->file.reset(TFile::Open(filePath.c_str(), "READ"));
+    if (inputFile->file == nullptr || inputFile->file->IsZombie()) {
+      throw std::runtime_error("File '" + filePath + "' is zombie.");
+    }
+    if (!inputFile->file->IsOpen()) {
+      throw std::runtime_error("Failed to open the file: " + filePath);
+    }
+    ILOG(Info) << "Input file '" << filePath << "' successfully open." << ENDM;
+
+    // only the list of keys is read at this point, the objects are read when they are about to be published
+    std::set<std::string> keyNames;
+    auto& keys = keysPerFile.emplace_back();
+    TIter next(inputFile->file->GetListOfKeys());
+    while (auto key = dynamic_cast<TKey*>(next())) {
+      if (!mTaskNames.empty() && mTaskNames.count(key->GetName()) == 0) {
+        ILOG(Debug, Devel) << "Skipping the key '" << key->GetName() << "' in the file '" << filePath << "', it does not belong to any requested task" << ENDM;
+        continue;
+      }
+      if (keyNames.insert(key->GetName()).second) {
+        keys.emplace_back(key->GetName());
+      }
+    }
+    mFiles.emplace_back(std::move(inputFile));
+  }
+
+  // the keys of different files are interleaved, so the consecutive reads can be done in parallel
+  bool keysLeft = true;
+  while (keysLeft) {
+    keysLeft = false;
+    for (size_t fileIndex = 0; fileIndex < keysPerFile.size(); fileIndex++) {
+      if (!keysPerFile[fileIndex].empty()) {
+        mKeysToRead.push_back({ fileIndex, std::move(keysPerFile[fileIndex].front()) });
+        keysPerFile[fileIndex].pop_front();
+        keysLeft = true;
+      }
+    }
+  }
+  mMaxReadAhead = std::clamp<size_t>(mFiles.size(), 1, maxReadAhead);
+  ILOG(Info, Support) << "Will publish " << mKeysToRead.size() << " MonitorObjectCollections from " << mFiles.size() << " file(s)" << ENDM;
 }
 
 void RootFileSource::run(framework::ProcessingContext& ctx)
 {
-  auto* file = new TFile(mFilePath.c_str(), "READ");
-  if (file->IsZombie()) {
-    throw std::runtime_error("File '" + mFilePath + "' is zombie.");
-  }
-  if (!file->IsOpen()) {
-    throw std::runtime_error("Failed to open the file: " + mFilePath);
+  auto storedMOC = readNext();
+  if (storedMOC == nullptr) {
+    for (auto& inputFile : mFiles) {
+      inputFile->file->Close();
+    }
+    mFiles.clear();
+    ctx.services().get<ControlService>().endOfStream();
+    ctx.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+    return;
   }
-  ILOG(Info) << "Input file '" << mFilePath << "' successfully open." << ENDM;
-
-  TIter next(file->GetListOfKeys());
-  TKey* key;
-  while ((key = (TKey*)next())) {
-    auto storedTObj = file->Get(key->GetName());
-    if (storedTObj != nullptr) {
-      auto storedMOC = dynamic_cast<MonitorObjectCollection*>(storedTObj);
-      if (storedMOC == nullptr) {
-        ILOG(Error) << "Could not cast the stored object to MonitorObjectCollection, skipping." << ENDM;
-        delete storedTObj;
-        continue;
-      }
 
-      // snapshot does a shallow copy, so we cannot let it delete elements in MOC when it deletes the MOC
-      storedMOC->SetOwner(false);
-      ctx.outputs().snapshot(OutputRef{ storedMOC->GetName(), 0 }, *storedMOC);
-      storedMOC->postDeserialization();
-      ILOG(Info) << "Read and published object '" << storedMOC->GetName() << "'" << ENDM;
+  // snapshot does a shallow copy, so we cannot let it delete elements in MOC when it deletes the MOC
+  storedMOC->SetOwner(false);
+  ctx.outputs().snapshot(OutputRef{ storedMOC->GetName(), 0 }, *storedMOC);
+  // the collection owns its objects again, so they are deleted with it once published
+  storedMOC->SetOwner(true);
+  storedMOC->postDeserialization();
+  ILOG(Info) << "Read and published object '" << storedMOC->GetName() << "'" << ENDM;
+}
+
+std::unique_ptr<MonitorObjectCollection> RootFileSource::readNext()
+{
+  readAhead();
+  while (!mReadAhead.empty()) {
+    auto storedMOC = mReadAhead.front().get();
+    mReadAhead.pop_front();
+    // the next collection is read while this one is published
+    readAhead();
+    if (storedMOC != nullptr) {
+      return storedMOC;
     }
-    delete storedTObj;
   }
-  file->Close();
-  delete file;
+  return nullptr;
+}
 
-  ctx.services().get<ControlService>().endOfStream();
-  ctx.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+void RootFileSource::readAhead()
+{
+  while (mReadAhead.size() < mMaxReadAhead && !mKeysToRead.empty()) {
+    auto keyToRead = std::move(mKeysToRead.front());
+    mKeysToRead.pop_front();
+    auto& inputFile = *mFiles[keyToRead.fileIndex];
+    mReadAhead.push_back(std::async(std::launch::async, [this, &inputFile, keyName = std::move(keyToRead.name)]() {
+      return read(inputFile, keyName);
+    }));
+  }
+}
+
+std::unique_ptr<MonitorObjectCollection> RootFileSource::read(InputFile& inputFile, const std::string& keyName)
+{
+  std::lock_guard<std::mutex> lock(inputFile.mutex);
+  std::unique_ptr<TObject> storedTObj(inputFile.file->Get(keyName.c_str()));
+  if (storedTObj == nullptr) {
+    ILOG(Error) << "Could not read the key '" << keyName << "' from the file '" << inputFile.path << "', skipping." << ENDM;
+    return nullptr;
+  }
+  auto storedMOC = dynamic_cast<MonitorObjectCollection*>(storedTObj.get());
+  if (storedMOC == nullptr) {
+    ILOG(Error) << "Could not cast the stored object to MonitorObjectCollection, skipping." << ENDM;
+    return nullptr;
+  }
+  storedTObj.release();
+  return std::unique_ptr<MonitorObjectCollection>(storedMOC);
 }
 
-} // namespace o2::quality_control::core
\ No newline at end of file
+} // namespace o2::quality_control::core
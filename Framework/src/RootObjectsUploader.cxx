@@ -0,0 +1,236 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RootObjectsUploader.cxx
+///
+
+#include "RootObjectsUploader.h"
+
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <CCDB/CcdbApi.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TROOT.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+using namespace o2::quality_control::repository;
+
+namespace o2::quality_control::core
+{
+
+RootObjectsUploader::RootObjectsUploader(Config config)
+  : mConfig(std::move(config))
+{
+  if (mConfig.clients == 0) {
+    throw std::invalid_argument("The number of clients must be positive");
+  }
+  if (mConfig.queueSize == 0) {
+    throw std::invalid_argument("The queue size must be positive");
+  }
+}
+
+RootObjectsUploader::Result RootObjectsUploader::run()
+{
+  std::unique_ptr<TFile> file(TFile::Open(mConfig.inputFilePath.c_str(), "READ"));
+  if (file == nullptr || file->IsZombie()) {
+    throw std::runtime_error("File '" + mConfig.inputFilePath + "' is zombie.");
+  }
+  if (!file->IsOpen()) {
+    throw std::runtime_error("Failed to open the file: " + mConfig.inputFilePath);
+  }
+  ILOG(Info) << "Input file '" << mConfig.inputFilePath << "' successfully open." << ENDM;
+
+  // the objects are serialized by the clients while the file is being read
+  ROOT::EnableThreadSafety();
+
+  mResult = {};
+  mQueue.clear();
+  mReadingDone = false;
+  mUploadsDone = false;
+
+  auto start = steady_clock::now();
+  std::vector<std::thread> clients;
+  for (size_t c = 0; c < mConfig.clients; c++) {
+    clients.emplace_back([this]() { upload(); });
+  }
+  std::thread progress;
+  if (mConfig.progressPeriod > 0) {
+    progress = std::thread([this]() { reportProgress(); });
+  }
+
+  std::exception_ptr exception;
+  try {
+    readDirectory(file.get(), "");
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mReadingDone = true;
+  }
+  mQueueChanged.notify_all();
+  for (auto& client : clients) {
+    client.join();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mUploadsDone = true;
+  }
+  mQueueChanged.notify_all();
+  if (progress.joinable()) {
+    progress.join();
+  }
+  file->Close();
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+  mResult.elapsed = duration<double>(steady_clock::now() - start).count();
+  return mResult;
+}
+
+void RootObjectsUploader::readDirectory(TDirectoryFile* directory, const std::string& path)
+{
+  TIter next(directory->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    auto storedTObj = directory->Get(key->GetName());
+    if (storedTObj == nullptr) {
+      continue;
+    }
+    if (storedTObj->InheritsFrom("TDirectoryFile")) {
+      readDirectory(dynamic_cast<TDirectoryFile*>(storedTObj), path + std::string(key->GetName()) + std::filesystem::path::preferred_separator);
+      delete storedTObj;
+      continue;
+    }
+
+    auto object = storedTObj;
+    if (mConfig.preserveDirectories) {
+      // one cannot change a name of a TObject, we have to create a new one...
+      object = storedTObj->Clone((path + storedTObj->GetName()).c_str());
+      delete storedTObj;
+    }
+    // the object is deleted by one of the clients, it cannot stay attached to the file which is being read
+    if (auto histogram = dynamic_cast<TH1*>(object)) {
+      histogram->SetDirectory(nullptr);
+    }
+    auto mo = std::make_shared<MonitorObject>(object, mConfig.taskName, "unknown", mConfig.detectorCode, mConfig.runNumber,
+                                              mConfig.periodName, mConfig.passName, mConfig.provenance);
+    mo->setIsOwner(true);
+    push(std::move(mo));
+  }
+}
+
+void RootObjectsUploader::push(std::shared_ptr<MonitorObject> mo)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mQueueChanged.wait(lock, [this]() { return mQueue.size() < mConfig.queueSize; });
+  mQueue.push_back(std::move(mo));
+  mResult.objectsRead++;
+  mQueueChanged.notify_all();
+}
+
+std::shared_ptr<MonitorObject> RootObjectsUploader::pop()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mQueueChanged.wait(lock, [this]() { return mReadingDone || !mQueue.empty(); });
+  if (mQueue.empty()) {
+    return nullptr;
+  }
+  auto mo = std::move(mQueue.front());
+  mQueue.pop_front();
+  mQueueChanged.notify_all();
+  return mo;
+}
+
+void RootObjectsUploader::upload()
+{
+  std::unique_ptr<CcdbDatabase> database;
+  if (!mConfig.dryRun) {
+    database = std::make_unique<CcdbDatabase>();
+    database->connect(mConfig.qcdbUrl, "", "", "");
+    // we retry the failed objects ourselves, the following ones should not be skipped meanwhile
+    database->setFailureDelay(0);
+  }
+
+  while (auto mo = pop()) {
+    if (mConfig.dryRun) {
+      auto image = o2::ccdb::CcdbApi::createObjectImage(mo->getObject());
+      std::lock_guard<std::mutex> lock(mMutex);
+      mResult.objectsUploaded++;
+      mResult.serializedBytes += image->size();
+      continue;
+    }
+
+    bool stored = false;
+    size_t retries = 0;
+    for (size_t attempt = 0; !stored && attempt <= mConfig.maxRetries; attempt++) {
+      if (attempt > 0) {
+        std::this_thread::sleep_for(duration<double>(mConfig.retryDelay * std::pow(2, attempt - 1)));
+        retries++;
+      }
+      try {
+        database->storeMO(mo, static_cast<long>(mConfig.validityStart), static_cast<long>(mConfig.validityEnd));
+        stored = !database->isStorageInFailure();
+      } catch (...) {
+        // e.g. an invalid object name, it would not help to retry
+        ILOG(Error, Support) << "Could not upload the object '" << mo->getName() << "': " << boost::current_exception_diagnostic_information(true) << ENDM;
+        break;
+      }
+    }
+    if (!stored) {
+      ILOG(Error, Support) << "Failed to upload the object '" << mo->getName() << "' after " << retries << " retries" << ENDM;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mResult.retries += retries;
+    if (stored) {
+      mResult.objectsUploaded++;
+    } else {
+      mResult.objectsFailed++;
+    }
+  }
+}
+
+void RootObjectsUploader::reportProgress()
+{
+  uint64_t lastUploaded = 0;
+  auto lastReport = steady_clock::now();
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (!mQueueChanged.wait_for(lock, duration<double>(mConfig.progressPeriod), [this]() { return mUploadsDone; })) {
+    auto result = mResult;
+    lock.unlock();
+
+    auto now = steady_clock::now();
+    auto rate = (result.objectsUploaded - lastUploaded) / duration<double>(now - lastReport).count();
+    ILOG(Info, Support) << (mConfig.dryRun ? "Serialized " : "Uploaded ") << result.objectsUploaded << " of the " << result.objectsRead
+                        << " objects read so far (" << result.objectsFailed << " failed, " << result.retries << " retries), "
+                        << rate << " objects/s" << ENDM;
+    lastUploaded = result.objectsUploaded;
+    lastReport = now;
+
+    lock.lock();
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,94 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RootObjectsUploader.h
+///
+
+#ifndef QC_ROOTOBJECTSUPLOADER_H
+#define QC_ROOTOBJECTSUPLOADER_H
+
+#include "QualityControl/MonitorObject.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class TDirectoryFile;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Uploads all the objects of a ROOT file to the QCDB as MonitorObjects.
+///
+/// The file is read by the calling thread, which passes the objects through a bounded queue to a number of clients,
+/// each uploading them with its own database connection. The uploads which fail because of the connection or the
+/// server are retried with an increasing delay. In the dry-run mode, the objects are only serialized as they would be
+/// for the upload, which allows to measure the throughput of the client side alone.
+class RootObjectsUploader
+{
+ public:
+  struct Config {
+    std::string inputFilePath;
+    std::string qcdbUrl;
+    std::string taskName;
+    std::string detectorCode = "TST";
+    uint64_t validityStart = 0;
+    uint64_t validityEnd = 0;
+    uint64_t runNumber = 0;
+    std::string periodName = "unknown";
+    std::string passName = "unknown";
+    std::string provenance = "qc";
+    bool preserveDirectories = false; // the directory structure of the file is kept in the object names
+    size_t clients = 8;               // number of concurrent uploads, each in its own thread
+    size_t queueSize = 64;            // number of objects read ahead of the uploads
+    size_t maxRetries = 3;            // per object
+    double retryDelay = 1;            // in seconds, doubled after each retry
+    double progressPeriod = 10;       // in seconds, 0 for no progress reports
+    bool dryRun = false;              // serialize the objects, but do not upload them
+  };
+
+  struct Result {
+    uint64_t objectsRead = 0;
+    uint64_t objectsUploaded = 0; // or serialized in the dry-run mode
+    uint64_t objectsFailed = 0;
+    uint64_t retries = 0;
+    uint64_t serializedBytes = 0; // only in the dry-run mode
+    double elapsed = 0;           // in seconds
+  };
+
+  explicit RootObjectsUploader(Config config);
+
+  /// \brief Reads the whole file and returns once all the objects were uploaded or have definitely failed.
+  Result run();
+
+ private:
+  void readDirectory(TDirectoryFile* directory, const std::string& path);
+  void push(std::shared_ptr<MonitorObject> mo);
+  std::shared_ptr<MonitorObject> pop();
+  void upload();
+  void reportProgress();
+
+  Config mConfig;
+  Result mResult;
+  std::mutex mMutex;
+  std::condition_variable mQueueChanged;
+  std::deque<std::shared_ptr<MonitorObject>> mQueue;
+  bool mReadingDone = false;
+  bool mUploadsDone = false;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_ROOTOBJECTSUPLOADER_H
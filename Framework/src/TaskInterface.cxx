@@ -69,6 +69,30 @@ void TaskInterface::setMonitoring(const std::shared_ptr<o2::monitoring::Monitori
   TaskInterface::mMonitoring = mMonitoring;
 }
 
+void TaskInterface::setWorkerPool(std::shared_ptr<WorkerPool> workerPool)
+{
+  mWorkerPool = std::move(workerPool);
+}
+
+void TaskInterface::setConditionCache(std::shared_ptr<ConditionCache> conditionCache)
+{
+  mConditionCache = std::move(conditionCache);
+}
+
+size_t TaskInterface::getNumberOfWorkers() const
+{
+  return mWorkerPool ? mWorkerPool->size() : 1;
+}
+
+void TaskInterface::parallelFor(size_t n, const WorkerPool::Function& function, size_t grain)
+{
+  if (mWorkerPool) {
+    mWorkerPool->parallelFor(n, function, grain);
+  } else if (n > 0) {
+    function(0, n, 0);
+  }
+}
+
 void TaskInterface::setCcdbUrl(const std::string& url)
 {
   mCcdbUrl = url;
@@ -25,12 +25,13 @@
 #include <DataSampling/DataSampling.h>
 
 #include <Framework/CallbackService.h>
-#include <Framework/CompletionPolicyHelpers.h>
 #include <Framework/TimesliceIndex.h>
 #include <Framework/DataSpecUtils.h>
 #include <Framework/InputRecordWalker.h>
 #include <Framework/InputSpan.h>
 #include <Framework/DataRefUtils.h>
+#include <Framework/DeviceSpec.h>
+#include <Mergers/MergerAlgorithm.h>
 #include <CommonUtils/ConfigurableParam.h>
 
 #include "QualityControl/QcInfoLogger.h"
@@ -41,6 +42,8 @@
 
 #include <string>
 #include <TFile.h>
+#include <TMessage.h>
+#include <TROOT.h>
 #include <boost/property_tree/ptree.hpp>
 #include <TSystem.h>
 
@@ -146,10 +149,45 @@ void TaskRunner::init(InitContext& iCtx)
   // setup publisher
   mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.className, mTaskConfig.detectorName, mTaskConfig.consulUrl, mTaskConfig.parallelTaskID);
 
+  // setup the workers of the task, each of them fills its own shard of the sharded objects
+  mWorkerPool = std::make_shared<WorkerPool>(mTaskConfig.workers);
+  mObjectsManager->setNumberOfShards(mWorkerPool->size());
+  if (mWorkerPool->size() > 1) {
+    // the workers fill and may create ROOT objects concurrently
+    ROOT::EnableThreadSafety();
+  }
+
   // setup user's task
   TaskFactory factory;
   mTask.reset(factory.create(mTaskConfig, mObjectsManager));
   mTask->setMonitoring(mCollector);
+  mTask->setWorkerPool(mWorkerPool);
+
+  // setup the additional instances of the task, which process timeslices concurrently to the main one.
+  // They publish nothing, their objects are merged into the main ones at the end of each cycle.
+  mLanes.clear();
+  for (size_t lane = 1; lane < mTaskConfig.timeslicePipeline; lane++) {
+    Lane newLane;
+    newLane.objectsManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.className, mTaskConfig.detectorName, mTaskConfig.consulUrl, mTaskConfig.parallelTaskID, true);
+    newLane.workerPool = std::make_shared<WorkerPool>(mTaskConfig.workers);
+    newLane.objectsManager->setNumberOfShards(newLane.workerPool->size());
+    newLane.task.reset(factory.create(mTaskConfig, newLane.objectsManager));
+    newLane.task->setMonitoring(mCollector);
+    newLane.task->setWorkerPool(newLane.workerPool);
+    mLanes.push_back(newLane);
+  }
+  mPipeline = mLanes.empty() ? nullptr : std::make_unique<TimeslicePipeline>(mLanes.size() + 1);
+  if (!mLanes.empty()) {
+    // the lanes fill and create ROOT objects from their own threads
+    ROOT::EnableThreadSafety();
+  }
+
+  // setup the asynchronous publication, the objects are then serialized and saved while the task fills them
+  mSerializer.reset();
+  if (mTaskConfig.asyncPublication) {
+    ROOT::EnableThreadSafety();
+    mSerializer = std::make_unique<BackgroundSerializer>([this](const MonitorObjectCollection& shadow) { saveToFile(shadow); });
+  }
 
   // load config params
   if (iCtx.options().isSet("configKeyValues")) {
@@ -157,8 +195,15 @@ void TaskRunner::init(InitContext& iCtx)
   }
 
   // init user's task
+  mConditionCache = std::make_shared<ConditionCache>(mTaskConfig.conditionUrl);
   mTask->setCcdbUrl(mTaskConfig.conditionUrl);
+  mTask->setConditionCache(mConditionCache);
   mTask->initialize(iCtx);
+  for (auto& lane : mLanes) {
+    lane.task->setCcdbUrl(mTaskConfig.conditionUrl);
+    lane.task->setConditionCache(mConditionCache);
+    lane.task->initialize(iCtx);
+  }
 
   mNoMoreCycles = false;
   mCycleNumber = 0;
@@ -166,9 +211,15 @@ void TaskRunner::init(InitContext& iCtx)
 
 void TaskRunner::run(ProcessingContext& pCtx)
 {
+  // the objects of the last cycle are sent as soon as they are serialized, also after the last cycle
+  if (mSerializer && mSerializer->isPending()) {
+    AliceO2::Common::Timer sendTimer;
+    sendSerialized(pCtx.outputs(), false);
+    mCycleStallDuration += sendTimer.getTime();
+  }
+
+  // it was logged when it happened, this is called for each input and timer tick
   if (mNoMoreCycles) {
-    ILOG(Info, Support) << "The maximum number of cycles (" << mTaskConfig.maxNumberCycles << ") has been reached"
-                        << " or the device has received an EndOfStream signal. Won't start a new cycle." << ENDM;
     return;
   }
 
@@ -176,14 +227,30 @@ void TaskRunner::run(ProcessingContext& pCtx)
     startCycle();
   }
 
-  auto [dataReady, timerReady] = validateInputs(pCtx.inputs());
-
-  if (dataReady) {
-    mTask->monitorData(pCtx);
+  if (isDataReady(pCtx.inputs())) {
+    if (mPipeline) {
+      // the inputs are copied, because the original messages are released once run() returns
+      auto inputs = std::make_shared<TimesliceInputs>(pCtx.inputs(), pCtx.services().get<DeviceSpec const>().inputs);
+      mPipeline->push([this, inputs, &services = pCtx.services(), &outputs = pCtx.outputs()](size_t lane) {
+        ProcessingContext laneContext{ inputs->record(), services, outputs };
+        auto& task = lane == 0 ? mTask : mLanes[lane - 1].task;
+        task->monitorData(laneContext);
+      });
+    } else {
+      mTask->monitorData(pCtx);
+    }
     updateMonitoringStats(pCtx);
   }
 
-  if (timerReady) {
+  // The cycle clock is checked on any input, so that the cycle ends on time both when idle (thanks to the timer ticks)
+  // and under load. The deadlines do not depend on the phase of the DPL timer.
+  auto now = steady_clock::now();
+  if (mCycleOn && mCycleClock.isCycleOver(now)) {
+    auto delay = mCycleClock.endCycle(now);
+    mLastCycleEndJitter = duration<double>(delay).count();
+    if (delay >= mCycleClock.getCycleDuration()) {
+      ILOG(Warning, Support) << "The cycle " << mCycleNumber << " ended more than a whole cycle after its deadline" << ENDM;
+    }
     finishCycle(pCtx.outputs());
     if (mTaskConfig.resetAfterCycles > 0 && (mCycleNumber % mTaskConfig.resetAfterCycles == 0)) {
       mTask->reset();
@@ -191,6 +258,8 @@ void TaskRunner::run(ProcessingContext& pCtx)
     if (mTaskConfig.maxNumberCycles < 0 || mCycleNumber < mTaskConfig.maxNumberCycles) {
       startCycle();
     } else {
+      ILOG(Info, Support) << "The maximum number of cycles (" << mTaskConfig.maxNumberCycles << ") has been reached."
+                          << " Won't start a new cycle." << ENDM;
       mNoMoreCycles = true;
     }
   }
@@ -198,40 +267,23 @@ void TaskRunner::run(ProcessingContext& pCtx)
 
 CompletionPolicy::CompletionOp TaskRunner::completionPolicyCallback(o2::framework::InputSpan const& inputs)
 {
-  // fixme: we assume that there is one timer input and the rest are data inputs. If some other implicit inputs are
+  // This is called for each new message, so it must be cheap: no header decoding, no logging.
+  // fixme: we assume that the timer is the last input and the rest are data inputs. If some other implicit inputs are
   //  added, this will break.
-  size_t dataInputsExpected = inputs.size() - 1;
-  size_t dataInputsPresent = 0;
-
-  CompletionPolicy::CompletionOp action = CompletionPolicy::CompletionOp::Wait;
-
-  for (auto& input : inputs) {
-    if (input.header == nullptr) {
-      continue;
-    }
-
-    const auto* dataHeader = CompletionPolicyHelpers::getHeader<DataHeader>(input);
-    assert(dataHeader);
-
-    if (!strncmp(dataHeader->dataDescription.str, "TIMER", 5)) {
-      action = CompletionPolicy::CompletionOp::Consume;
-    } else {
-      dataInputsPresent++;
-    }
+  if (inputs.size() == 0) {
+    return CompletionPolicy::CompletionOp::Wait;
   }
-
-  ILOG(Debug, Trace) << "Completion policy callback. "
-                     << "Total inputs possible: " << inputs.size()
-                     << ", data inputs: " << dataInputsPresent
-                     << ", timer inputs: " << (action == CompletionPolicy::CompletionOp::Consume) << ENDM;
-
-  if (dataInputsPresent == dataInputsExpected) {
-    action = CompletionPolicy::CompletionOp::Consume;
+  // a tick of the cycle clock is processed immediately, with whatever data is there
+  if (inputs.get(inputs.size() - 1).header != nullptr) {
+    return CompletionPolicy::CompletionOp::Consume;
   }
-
-  ILOG(Debug, Trace) << "Action: " << action << ENDM;
-
-  return action;
+  // otherwise we wait for all the data inputs, stopping at the first one which is missing
+  for (size_t i = 0; i + 1 < inputs.size(); i++) {
+    if (inputs.get(i).header == nullptr) {
+      return CompletionPolicy::CompletionOp::Wait;
+    }
+  }
+  return CompletionPolicy::CompletionOp::Consume;
 }
 
 std::string TaskRunner::createTaskRunnerIdString()
@@ -290,7 +342,11 @@ void TaskRunner::endOfStream(framework::EndOfStreamContext& eosContext)
 {
   ILOG(Info, Support) << "Received an EndOfStream, finishing the current cycle" << ENDM;
   finishCycle(eosContext.outputs());
-  mNoMoreCycles = true;
+  sendSerialized(eosContext.outputs(), true);
+  if (!mNoMoreCycles) {
+    ILOG(Info, Support) << "Won't start a new cycle after the EndOfStream" << ENDM;
+    mNoMoreCycles = true;
+  }
 }
 
 void TaskRunner::start(const ServiceRegistry& services)
@@ -322,12 +378,20 @@ void TaskRunner::stop()
 {
   try {
     if (mCycleOn) {
+      mergeLanes();
+      mergeShards();
       mTask->endOfCycle();
       mCycleNumber++;
       mCycleOn = false;
     }
+    if (mSerializer && mSerializer->take(true) != nullptr) {
+      ILOG(Warning, Support) << "The objects of the last cycle could not be sent before the end of the run" << ENDM;
+    }
     endOfActivity();
     mTask->reset();
+    for (auto& lane : mLanes) {
+      lane.task->reset();
+    }
     mRunNumber = 0;
   } catch (...) {
     // we catch here because we don't know where it will go in DPL's CallbackService
@@ -340,7 +404,12 @@ void TaskRunner::stop()
 void TaskRunner::reset()
 {
   try {
+    mSerializer.reset();
+    mPipeline.reset();
+    mLanes.clear();
     mTask.reset();
+    mWorkerPool.reset();
+    mConditionCache.reset();
     mCollector.reset();
     mObjectsManager.reset();
     mRunNumber = 0;
@@ -352,10 +421,9 @@ void TaskRunner::reset()
   }
 }
 
-std::tuple<bool /*data ready*/, bool /*timer ready*/> TaskRunner::validateInputs(const framework::InputRecord& inputs)
+bool TaskRunner::isDataReady(const framework::InputRecord& inputs)
 {
   size_t dataInputsPresent = 0;
-  bool timerReady = false;
 
   for (auto& input : inputs) {
     if (input.header != nullptr) {
@@ -363,16 +431,12 @@ std::tuple<bool /*data ready*/, bool /*timer ready*/> TaskRunner::validateInputs
       const auto* dataHeader = get<DataHeader*>(input.header);
       assert(dataHeader);
 
-      if (!strncmp(dataHeader->dataDescription.str, "TIMER", 5)) {
-        timerReady = true;
-      } else {
+      if (strncmp(dataHeader->dataDescription.str, "TIMER", 5)) {
         dataInputsPresent++;
       }
     }
   }
-  bool dataReady = dataInputsPresent == inputs.size() - 1;
-
-  return { dataReady, timerReady };
+  return dataInputsPresent == inputs.size() - 1;
 }
 
 void TaskRunner::printTaskConfig()
@@ -383,6 +447,9 @@ void TaskRunner::printTaskConfig()
   ILOG(Info, Support) << ">> Detector name : " << mTaskConfig.detectorName << ENDM;
   ILOG(Info, Support) << ">> Cycle duration seconds : " << mTaskConfig.cycleDurationSeconds << ENDM;
   ILOG(Info, Support) << ">> Max number cycles : " << mTaskConfig.maxNumberCycles << ENDM;
+  ILOG(Info, Support) << ">> Workers : " << mTaskConfig.workers << ENDM;
+  ILOG(Info, Support) << ">> Timeslice pipeline : " << mTaskConfig.timeslicePipeline << ENDM;
+  ILOG(Info, Support) << ">> Asynchronous publication : " << mTaskConfig.asyncPublication << ENDM;
   ILOG(Info, Support) << ">> Save to file : " << mTaskConfig.saveToFile << ENDM;
 }
 
@@ -391,13 +458,20 @@ void TaskRunner::startOfActivity()
   // stats
   mTimerTotalDurationActivity.reset();
   mTotalNumberObjectsPublished = 0;
+  mCycleClock.start(steady_clock::now(), seconds(mTaskConfig.cycleDurationSeconds));
 
   // Start activity in module's stask and update objectsManager
   Activity activity(mRunNumber, mTaskConfig.activityType, mTaskConfig.activityPeriodName, mTaskConfig.activityPassName, mTaskConfig.activityProvenance);
   ILOG(Info, Ops) << "Starting run " << mRunNumber << ENDM;
   mObjectsManager->setActivity(activity);
   mCollector->setRunNumber(mRunNumber);
+  // the conditions are retrieved in the background, while the task starts and waits for data
+  mConditionCache->prefetch();
   mTask->startOfActivity(activity);
+  for (auto& lane : mLanes) {
+    lane.objectsManager->setActivity(activity);
+    lane.task->startOfActivity(activity);
+  }
   mObjectsManager->updateServiceDiscovery();
 }
 
@@ -406,6 +480,9 @@ void TaskRunner::endOfActivity()
   Activity activity(mRunNumber, mTaskConfig.activityType, mTaskConfig.activityPeriodName, mTaskConfig.activityPassName, mTaskConfig.activityProvenance);
   ILOG(Info, Ops) << "Stopping run " << mRunNumber << ENDM;
   mTask->endOfActivity(activity);
+  for (auto& lane : mLanes) {
+    lane.task->endOfActivity(activity);
+  }
   mObjectsManager->removeAllFromServiceDiscovery();
 
   double rate = mTotalNumberObjectsPublished / mTimerTotalDurationActivity.getTime();
@@ -416,21 +493,72 @@ void TaskRunner::startCycle()
 {
   ILOG(Debug, Ops) << "Start cycle " << mCycleNumber << ENDM;
   mTask->startOfCycle();
+  for (auto& lane : mLanes) {
+    lane.task->startOfCycle();
+  }
   mNumberMessagesReceivedInCycle = 0;
   mNumberObjectsPublishedInCycle = 0;
   mDataReceivedInCycle = 0;
+  mCycleStallDuration = 0;
   mTimerDurationCycle.reset();
   mCycleOn = true;
 }
 
+void TaskRunner::mergeShards()
+{
+  AliceO2::Common::Timer mergeDurationTimer;
+  mObjectsManager->mergeShards();
+  mLastShardsMergeDuration = mergeDurationTimer.getTime();
+}
+
+void TaskRunner::mergeLanes()
+{
+  if (!mPipeline) {
+    return;
+  }
+  // the lanes must be done with their timeslices before we touch their objects
+  mPipeline->drain();
+
+  AliceO2::Common::Timer mergeDurationTimer;
+  for (auto& lane : mLanes) {
+    lane.objectsManager->mergeShards();
+    for (size_t i = 0; i < lane.objectsManager->getNumberPublishedObjects(); i++) {
+      auto laneObject = lane.objectsManager->getMonitorObject(i);
+      if (!mObjectsManager->isBeingPublished(laneObject->getName())) {
+        ILOG(Warning, Devel) << "The object '" << laneObject->getName() << "' is published only by an additional lane of the task, it is ignored" << ENDM;
+        continue;
+      }
+      try {
+        mergers::algorithm::merge(mObjectsManager->getMonitorObject(laneObject->getName())->getObject(), laneObject->getObject());
+      } catch (const std::exception& error) {
+        // one object which cannot be merged should not lose the others
+        ILOG(Warning, Devel) << "The object '" << laneObject->getName() << "' of an additional lane could not be merged, it is skipped: " << error.what() << ENDM;
+      }
+    }
+    // the lanes start each cycle empty, so that their data is merged only once
+    lane.task->reset();
+  }
+  mLastLanesMergeDuration = mergeDurationTimer.getTime();
+}
+
 void TaskRunner::finishCycle(DataAllocator& outputs)
 {
   ILOG(Debug, Ops) << "Finish cycle " << mCycleNumber << ENDM;
+  AliceO2::Common::Timer stallTimer;
+  // the task sees the complete objects in endOfCycle
+  mergeLanes();
+  mergeShards();
   mTask->endOfCycle();
 
-  mNumberObjectsPublishedInCycle += publish(outputs);
+  if (mSerializer) {
+    mNumberObjectsPublishedInCycle += publishAsync(outputs);
+  } else {
+    mNumberObjectsPublishedInCycle += publish(outputs);
+    std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+    saveToFile(*array);
+  }
   mTotalNumberObjectsPublished += mNumberObjectsPublishedInCycle;
-  saveToFile();
+  mCycleStallDuration += stallTimer.getTime();
 
   publishCycleStats();
   mObjectsManager->updateServiceDiscovery();
@@ -476,6 +604,11 @@ void TaskRunner::publishCycleStats()
   mCollector->send(Metric{ "qc_duration" }
                      .addValue(cycleDuration, "module_cycle")
                      .addValue(mLastPublicationDuration, "publication")
+                     .addValue(mLastShardsMergeDuration, "shards_merge")
+                     .addValue(mLastLanesMergeDuration, "lanes_merge")
+                     .addValue(mLastCycleEndJitter, "cycle_end_jitter")
+                     .addValue(mCycleStallDuration, "cycle_stall")
+                     .addValue(mSerializer ? mSerializer->getLastSerializationDuration() : 0.0, "background_serialization")
                      .addValue(totalDurationActivity, "activity_whole_run"));
 
   mCollector->send(Metric{ "qc_objects_published" }
@@ -507,13 +640,52 @@ int TaskRunner::publish(DataAllocator& outputs)
   return objectsPublished;
 }
 
-void TaskRunner::saveToFile()
+int TaskRunner::publishAsync(DataAllocator& outputs)
+{
+  // There is only one shadow set, the previous one has to be sent before we can make a new one.
+  // It has usually been sent long ago, unless the serialization takes longer than a cycle.
+  sendSerialized(outputs, true);
+
+  std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+  ILOG(Info, Support) << "Publishing " << array->GetEntries() << " MonitorObjects in the background" << ENDM;
+  mSerializer->push(*array);
+  return array->GetEntries();
+}
+
+void TaskRunner::sendSerialized(DataAllocator& outputs, bool wait)
+{
+  if (!mSerializer) {
+    return;
+  }
+  AliceO2::Common::Timer publicationDurationTimer;
+  auto serialized = mSerializer->take(wait);
+  if (serialized == nullptr) {
+    return;
+  }
+
+  auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mTaskConfig.moSpec);
+  // the payload is the same as the one of a snapshot of the MonitorObjectCollection
+  outputs.snapshot(
+    Output{ concreteOutput.origin,
+            concreteOutput.description,
+            concreteOutput.subSpec,
+            mTaskConfig.moSpec.lifetime },
+    serialized->Buffer(),
+    serialized->BufferSize(),
+    header::gSerializationMethodROOT);
+
+  mLastPublicationDuration = publicationDurationTimer.getTime();
+}
+
+void TaskRunner::saveToFile(const MonitorObjectCollection& objects)
 {
   if (!mTaskConfig.saveToFile.empty()) {
     ILOG(Debug, Support) << "Save data to file " << mTaskConfig.saveToFile << ENDM;
     TFile f(mTaskConfig.saveToFile.c_str(), "RECREATE");
-    for (size_t i = 0; i < mObjectsManager->getNumberPublishedObjects(); i++) {
-      mObjectsManager->getMonitorObject(i)->getObject()->Write();
+    for (const auto* object : objects) {
+      if (auto mo = dynamic_cast<const MonitorObject*>(object); mo != nullptr && mo->getObject() != nullptr) {
+        mo->getObject()->Write();
+      }
     }
     f.Close();
   }
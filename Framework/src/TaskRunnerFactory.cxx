@@ -67,6 +67,7 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
     cycleDurationSeconds = 10;
   }
   auto inputs = taskSpec.dataSource.inputs;
+  // the timer must be the last input, TaskRunner::completionPolicyCallback relies on it
   inputs.emplace_back("timer-cycle",
                       TaskRunner::createTaskDataOrigin(taskSpec.detectorName),
                       TaskRunner::createTimerDataDescription(taskSpec.taskName),
@@ -80,7 +81,7 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
                                  Lifetime::Sporadic };
 
   Options options{
-    { "period-timer-cycle", framework::VariantType::Int, static_cast<int>(taskSpec.cycleDurationSeconds * 1000000), { "timer period" } },
+    { "period-timer-cycle", framework::VariantType::Int, TaskRunner::cycleClockTickMicroseconds, { "timer period, i.e. the tick of the cycle clock" } },
     { "runNumber", framework::VariantType::String, { "Run number" } },
     { "qcConfiguration", VariantType::Dict, emptyDict(), { "Some dictionary configuration" } }
   };
@@ -109,7 +110,10 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
     globalConfig.activityPeriodName,
     globalConfig.activityPassName,
     globalConfig.activityProvenance,
-    globalConfig.activityNumber
+    globalConfig.activityNumber,
+    std::max<size_t>(taskSpec.workers, 1),
+    std::max<size_t>(taskSpec.timeslicePipeline, 1),
+    taskSpec.asyncPublication
   };
 }
 
@@ -0,0 +1,147 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TimeslicePipeline.cxx
+///
+
+#include "QualityControl/TimeslicePipeline.h"
+
+#include <Framework/DataRefUtils.h>
+#include <Framework/InputRoute.h>
+#include <Headers/Stack.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace o2::quality_control::core
+{
+
+using namespace o2::framework;
+
+TimesliceInputs::TimesliceInputs(InputRecord& inputs, const std::vector<InputRoute>& routes)
+  : mRefs(inputs.size()),
+    mSpan([this](size_t input, size_t part) { return mRefs[input][part]; },
+          [this](size_t input) { return mRefs[input].size(); },
+          inputs.size()),
+    mRecord(routes, mSpan)
+{
+  for (size_t input = 0; input < inputs.size(); input++) {
+    size_t parts = std::max<size_t>(inputs.getNofParts(input), 1);
+    for (size_t part = 0; part < parts; part++) {
+      auto ref = inputs.getByPos(input, part);
+      DataRef copied;
+      copied.spec = ref.spec;
+      if (ref.header != nullptr) {
+        auto headerSize = header::Stack::headerStackSize(reinterpret_cast<const std::byte*>(ref.header));
+        auto payloadSize = DataRefUtils::getPayloadSize(ref);
+        copied.header = copy(ref.header, headerSize);
+        copied.payload = ref.payload != nullptr ? copy(ref.payload, payloadSize) : nullptr;
+        copied.payloadSize = payloadSize;
+      }
+      mRefs[input].push_back(copied);
+    }
+  }
+}
+
+const char* TimesliceInputs::copy(const char* data, size_t size)
+{
+  // operator new[] provides an alignment suitable for any fundamental type, as the message buffers do
+  auto& buffer = mBuffers.emplace_back(new char[std::max<size_t>(size, 1)]);
+  std::memcpy(buffer.get(), data, size);
+  return buffer.get();
+}
+
+TimeslicePipeline::TimeslicePipeline(size_t lanes)
+  : mLanes(std::max<size_t>(lanes, 1))
+{
+  // the lanes are started only once the vector does not move anymore
+  for (size_t lane = 0; lane < mLanes.size(); lane++) {
+    mLanes[lane].thread = std::thread([this, lane]() { laneLoop(lane); });
+  }
+}
+
+TimeslicePipeline::~TimeslicePipeline()
+{
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mLaneIdle.wait(lock, [this]() { return mBusyLanes == 0; });
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  for (auto& lane : mLanes) {
+    lane.thread.join();
+  }
+}
+
+void TimeslicePipeline::push(Job job)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mLaneIdle.wait(lock, [this]() { return mBusyLanes < mLanes.size(); });
+  rethrowLocked();
+
+  auto idleLane = std::find_if(mLanes.begin(), mLanes.end(), [](const Lane& lane) { return !lane.job; });
+  idleLane->job = std::move(job);
+  mBusyLanes++;
+  lock.unlock();
+  mJobAvailable.notify_all();
+}
+
+void TimeslicePipeline::drain()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mLaneIdle.wait(lock, [this]() { return mBusyLanes == 0; });
+  rethrowLocked();
+}
+
+void TimeslicePipeline::rethrowLocked()
+{
+  if (mException) {
+    auto exception = mException;
+    mException = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void TimeslicePipeline::laneLoop(size_t lane)
+{
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mJobAvailable.wait(lock, [&]() { return mStopping || mLanes[lane].job; });
+      if (mStopping) {
+        return;
+      }
+      job = mLanes[lane].job;
+    }
+
+    std::exception_ptr exception;
+    try {
+      job(lane);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (exception && !mException) {
+        mException = exception;
+      }
+      // the lane becomes idle only now, so that it is not given another job while this one runs
+      mLanes[lane].job = nullptr;
+      mBusyLanes--;
+    }
+    mLaneIdle.notify_all();
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -18,6 +18,7 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/DatabaseHelpers.h"
 #include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/RepositoryWatcher.h"
 
 #include <CCDB/CcdbApi.h>
 #include <Common/Timer.h>
@@ -139,43 +140,24 @@ TriggerFcn Periodic(double seconds, const Activity& activity)
 
 TriggerFcn NewObject(std::string databaseUrl, std::string databaseType, std::string objectPath, const Activity& activity)
 {
-  // Key names in the header map.
-  constexpr auto md5key = "Content-MD5";
-  constexpr auto timestampKey = "Valid-From";
   auto fullObjectPath = (databaseType == "qcdb" ? activity.mProvenance + "/" : "") + objectPath;
-
-  // We support only CCDB here.
-  auto db = std::make_shared<o2::ccdb::CcdbApi>();
-  db->init(databaseUrl);
-  if (!db->isHostReachable()) {
-    ILOG(Error, Support) << "CCDB at URL '" << databaseUrl << "' is not reachable." << ENDM;
-  }
-
-  // We rely on changing MD5 - if the object has changed, it should have a different check sum.
-  // If someone reuploaded an old object, it should not have an influence.
-  std::string lastMD5;
   auto metadata = repository::database_helpers::asDatabaseMetadata(activity, false);
-  if (auto headers = db->retrieveHeaders(fullObjectPath, metadata); headers.count(md5key)) {
-    lastMD5 = headers[md5key];
-  } else {
-    // We don't make a fuss over it, because we might be just waiting for the first version of such object.
-    // It should not happen often though, so having a warning makes sense.
-    ILOG(Warning, Support) << "No MD5 of the file '" << fullObjectPath << "' in the db '" << databaseUrl << "', probably the file is missing." << ENDM;
-  }
 
-  return [db, databaseUrl = std::move(databaseUrl), fullObjectPath = std::move(fullObjectPath), lastMD5, activity, metadata]() mutable -> Trigger {
-    if (auto headers = db->retrieveHeaders(fullObjectPath, metadata); headers.count(md5key)) {
-      auto newMD5 = headers[md5key];
-      if (lastMD5 != newMD5) {
-        lastMD5 = newMD5;
-        return { TriggerType::NewObject, false, activity, std::stoull(headers[timestampKey]) };
-      }
-    } else {
-      // We don't make a fuss over it, because we might be just waiting for the first version of such object.
-      // It should not happen often though, so having a warning makes sense.
-      ILOG(Warning, Support) << "No MD5 of the file '" << fullObjectPath << "' in the db '" << databaseUrl << "', probably the file is missing." << ENDM;
+  // We support only CCDB here.
+  // The watcher is shared by all the NewObject triggers of this process which use the same database,
+  // so the number of requests does not grow with the number of triggers.
+  auto watcher = RepositoryWatcher::getInstance(databaseUrl);
+  auto subscription = std::shared_ptr<RepositoryWatcher::SubscriptionId>(
+    new RepositoryWatcher::SubscriptionId(watcher->subscribe(fullObjectPath, metadata)),
+    [watcher](RepositoryWatcher::SubscriptionId* id) {
+      watcher->unsubscribe(*id);
+      delete id;
+    });
+
+  return [watcher, subscription, activity]() mutable -> Trigger {
+    if (auto update = watcher->poll(*subscription); update.has_value()) {
+      return { TriggerType::NewObject, false, activity, update->validFrom };
     }
-
     return { TriggerType::No, false };
   };
 }
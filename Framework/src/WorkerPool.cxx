@@ -0,0 +1,115 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   WorkerPool.cxx
+///
+
+#include "QualityControl/WorkerPool.h"
+
+#include <algorithm>
+
+namespace o2::quality_control::core
+{
+
+WorkerPool::WorkerPool(size_t size)
+{
+  for (size_t worker = 1; worker < std::max<size_t>(size, 1); worker++) {
+    mThreads.emplace_back([this, worker]() { workerLoop(worker); });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::parallelFor(size_t n, const Function& function, size_t grain)
+{
+  if (n == 0) {
+    return;
+  }
+  if (mThreads.empty()) {
+    function(0, n, 0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFunction = &function;
+    mSize = n;
+    mGrain = grain > 0 ? grain : std::max<size_t>(1, n / (4 * size()));
+    mNextChunk = 0;
+    mException = nullptr;
+    mActiveWorkers = mThreads.size();
+    mGeneration++;
+  }
+  mJobAvailable.notify_all();
+
+  work(0);
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mJobDone.wait(lock, [this]() { return mActiveWorkers == 0; });
+  mFunction = nullptr;
+  if (mException) {
+    std::rethrow_exception(mException);
+  }
+}
+
+void WorkerPool::workerLoop(size_t worker)
+{
+  size_t lastGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mJobAvailable.wait(lock, [&]() { return mStopping || mGeneration != lastGeneration; });
+      if (mStopping) {
+        return;
+      }
+      lastGeneration = mGeneration;
+    }
+
+    work(worker);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (--mActiveWorkers == 0) {
+      mJobDone.notify_one();
+    }
+  }
+}
+
+void WorkerPool::work(size_t worker)
+{
+  while (true) {
+    size_t begin = mNextChunk.fetch_add(mGrain);
+    if (begin >= mSize) {
+      return;
+    }
+    try {
+      (*mFunction)(begin, std::min(begin + mGrain, mSize), worker);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mException) {
+        mException = std::current_exception();
+      }
+      mNextChunk = mSize; // the other workers stop at their next chunk
+    }
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -41,7 +41,7 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   workflowOptions.push_back(
     ConfigParamSpec{ "empty", VariantType::Bool, false, { "Don't fill messages with random data." } });
   workflowOptions.push_back(
-    ConfigParamSpec{ "message-rate", VariantType::Double, 10.0, { "Rate of messages per second." } });
+    ConfigParamSpec{ "message-rate", VariantType::Double, 10.0, { "Rate of messages per second (0 for no limit)." } });
   workflowOptions.push_back(
     ConfigParamSpec{ "message-amount", VariantType::Int, 0, { "Amount of messages to be produced in total (0 for inf)." } });
   workflowOptions.push_back(
@@ -50,6 +50,8 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
     ConfigParamSpec{ "timepipeline", VariantType::Int, 1, { "Timepipeline parameter, i.e. how many copies of each producer. See the DPL documentation for explanation." } });
   workflowOptions.push_back(
     ConfigParamSpec{ "monitoring-url", VariantType::String, "", { "URL of the Monitoring backend." } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "page-size", VariantType::Int, 0, { "Size of RDH pages the messages are split into (0 for no RDHs)." } });
 }
 
 #include <Framework/runDataProcessing.h>
@@ -67,10 +69,11 @@ WorkflowSpec defineDataProcessing(const ConfigContext& config)
   size_t producers = config.options().get<int>("producers");
   size_t timepipeline = config.options().get<int>("timepipeline");
   std::string monitoringUrl = config.options().get<std::string>("monitoring-url");
+  size_t pageSize = config.options().get<int>("page-size");
 
   WorkflowSpec specs;
   for (size_t i = 0; i < producers; i++) {
-    specs.push_back(getDataProducerSpec(minSize, maxSize, rate, amount, i, monitoringUrl, fill, timepipeline));
+    specs.push_back(getDataProducerSpec(minSize, maxSize, rate, amount, i, monitoringUrl, fill, timepipeline, pageSize));
   }
   return specs;
 }
\ No newline at end of file
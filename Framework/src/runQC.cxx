@@ -69,7 +69,7 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
                                                                "Do not run many QC workflows on the same file at the same time." } });
   workflowOptions.push_back(
     ConfigParamSpec{ "remote-batch", VariantType::String, "", { "Runs the remote part of the QC workflow reading the inputs from a file (files). "
-                                                                "Takes the file path as argument." } });
+                                                                "Takes the file path (comma-separated paths) as argument." } });
 
   workflowOptions.push_back(
     ConfigParamSpec{ "override-values", VariantType::String, "", { "QC configuration file key/value pairs which should be overwritten. "
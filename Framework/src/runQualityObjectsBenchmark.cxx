@@ -0,0 +1,170 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   runQualityObjectsBenchmark.cxx
+///
+/// \brief Measures how many QualityObjects per second a CheckRunner can encode and an AggregatorRunner can decode.
+///
+/// For each format, the benchmark repeatedly encodes a batch of QualityObjects as CheckRunner::send does, decodes it
+/// as AggregatorRunner::run does and puts the objects in the map given to the aggregators. The messages are not sent
+/// between devices, so the transport is not measured, only the encoded sizes are reported. The formats are:
+/// - root: each object is streamed by ROOT separately, as DPL does with snapshot(),
+/// - compact: the batch is encoded with QualityObjectCodec and the objects are decoded.
+
+#include "QualityControl/QualityObjectCodec.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <DataFormatsQualityControl/FlagReasons.h>
+#include <TBufferFile.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control;
+using namespace o2::quality_control::core;
+
+namespace
+{
+
+struct Result {
+  double encodingSeconds = 0;
+  double decodingSeconds = 0;
+  size_t bytes = 0;
+};
+
+QualityObjectsType createQualityObjects(size_t objects, size_t reasons, size_t metadata)
+{
+  QualityObjectsType qualityObjects;
+  for (size_t i = 0; i < objects; i++) {
+    auto qo = std::make_shared<QualityObject>(i % 3 == 0 ? Quality::Bad : Quality::Good, "benchmarkCheck" + std::to_string(i), "TST", "OnAny",
+                                              std::vector<std::string>{ "TST:QC/benchmarkTask" }, std::vector<std::string>{ "histogram" + std::to_string(i) });
+    for (size_t r = 0; r < reasons; r++) {
+      qo->addReason(FlagReasonFactory::Unknown(), "reason " + std::to_string(r));
+    }
+    for (size_t m = 0; m < metadata; m++) {
+      qo->addMetadata("key" + std::to_string(m), "value" + std::to_string(m));
+    }
+    qo->setActivity({ 300000, 2, "LHC22a", "apass1", "qc", { 1654000000000, 1654000060000 } });
+    qualityObjects.push_back(qo);
+  }
+  return qualityObjects;
+}
+
+template <typename Encode, typename Decode>
+Result measure(size_t iterations, Encode encode, Decode decode)
+{
+  using Clock = std::chrono::steady_clock;
+  Result result;
+  for (size_t i = 0; i < iterations; i++) {
+    auto start = Clock::now();
+    auto encoded = encode();
+    auto encodedTime = Clock::now();
+    decode(encoded);
+    auto decodedTime = Clock::now();
+
+    result.encodingSeconds += std::chrono::duration<double>(encodedTime - start).count();
+    result.decodingSeconds += std::chrono::duration<double>(decodedTime - encodedTime).count();
+    for (const auto& message : encoded) {
+      result.bytes += message.size();
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                         //
+      ("help,h", "Help screen")                                                                                //
+      ("objects", bpo::value<size_t>()->default_value(100), "Number of QualityObjects sent in one cycle")      //
+      ("iterations", bpo::value<size_t>()->default_value(1000), "Number of cycles")                            //
+      ("reasons", bpo::value<size_t>()->default_value(1), "Number of flag reasons in each QualityObject")      //
+      ("metadata", bpo::value<size_t>()->default_value(2), "Number of metadata entries in each QualityObject") //
+      ("formats", bpo::value<std::string>()->default_value("root,compact"), "Formats to benchmark");           //
+
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    auto objects = vm["objects"].as<size_t>();
+    auto iterations = vm["iterations"].as<size_t>();
+    std::set<std::string> formats;
+    std::istringstream formatsStream(vm["formats"].as<std::string>());
+    for (std::string format; std::getline(formatsStream, format, ',');) {
+      formats.insert(format);
+    }
+    auto qualityObjects = createQualityObjects(objects, vm["reasons"].as<size_t>(), vm["metadata"].as<size_t>());
+    QualityObjectsMapType received;
+
+    std::map<std::string, Result> results;
+    if (formats.count("root")) {
+      results["root"] = measure(
+        iterations,
+        [&]() {
+          std::vector<std::vector<char>> messages;
+          for (const auto& qo : qualityObjects) {
+            TBufferFile buffer(TBuffer::kWrite);
+            buffer.WriteObjectAny(qo.get(), QualityObject::Class());
+            messages.emplace_back(buffer.Buffer(), buffer.Buffer() + buffer.Length());
+          }
+          return messages;
+        },
+        [&](std::vector<std::vector<char>>& messages) {
+          for (auto& message : messages) {
+            TBufferFile buffer(TBuffer::kRead, message.size(), message.data(), false);
+            std::shared_ptr<const QualityObject> qo(static_cast<QualityObject*>(buffer.ReadObjectAny(QualityObject::Class())));
+            received[qo->getName()] = qo;
+          }
+        });
+    }
+    if (formats.count("compact")) {
+      results["compact"] = measure(
+        iterations,
+        [&]() { return std::vector<std::vector<char>>{ QualityObjectCodec::encode(qualityObjects) }; },
+        [&](std::vector<std::vector<char>>& messages) {
+          QualityObjectsBatchView batch(messages[0].data(), messages[0].size());
+          for (const auto& view : batch) {
+            received[view.getName()] = view.toQualityObject();
+          }
+        });
+    }
+
+    double totalObjects = static_cast<double>(objects) * iterations;
+    std::cout << "format,objects,bytes_per_object,encode_qos_per_s,decode_qos_per_s,qos_per_s\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& [format, result] : results) {
+      std::cout << format << "," << static_cast<size_t>(totalObjects) << "," << result.bytes / totalObjects << ","
+                << totalObjects / result.encodingSeconds << "," << totalObjects / result.decodingSeconds << ","
+                << totalObjects / (result.encodingSeconds + result.decodingSeconds) << "\n";
+    }
+  } catch (const bpo::error& ex) {
+    ILOG(Error, Ops) << "Exception caught: " << ex.what() << ENDM;
+    return 1;
+  } catch (...) {
+    ILOG(Error, Ops) << "Exception caught: " << boost::current_exception_diagnostic_information(true) << ENDM;
+    return 1;
+  }
+  return 0;
+}
@@ -15,41 +15,89 @@
 ///
 
 #include "RepositoryBenchmark.h"
-#include <fairmq/runDevice.h>
+#include "QualityControl/QcInfoLogger.h"
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options.hpp>
+#include <iomanip>
+#include <iostream>
 
 namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
 
-void addCustomOptions(bpo::options_description& options)
+int main(int argc, const char* argv[])
 {
-  options.add_options()("number-objects", bpo::value<uint64_t>()->default_value(1),
-                        "Number of objects to try to send to the CCDB every second (default : 1)")(
-    "size-objects", bpo::value<uint64_t>()->default_value(1),
-    "Size of the objects to send (in kB, 1, 10, 100, 1000, default : 1)")(
-    "max-iterations", bpo::value<uint64_t>()->default_value(3),
-    "Maximum number of iterations of Run/ConditionalRun/OnData (0 - infinite, default : 3)")(
-    "number-tasks", bpo::value<uint64_t>()->default_value(0),
-    "Informative only, the number of tasks being ran in parallel.")(
-    "database-url", bpo::value<std::string>()->default_value("ccdb-test.cern.ch:8080"),
-    "Database url (default : ccdb-test.cern.ch:8080")("database-username", bpo::value<std::string>()->default_value(""),
-                                                      "Database username (default : <empty>)")(
-    "database-password", bpo::value<std::string>()->default_value(""), "Database password (default : <empty>)")(
-    "database-name", bpo::value<std::string>()->default_value(""), "Database name (default : <empty>")(
-    "task-name", bpo::value<std::string>()->default_value("benchmarkTask"),
-    "Name of the task (default : benchmarkTask)")("object-name", bpo::value<std::string>()->default_value("benchmark"),
-                                                  "Name of the object (default : benchmark)")(
-    "delete", bpo::value<int>()->default_value(0),
-    "Deletion mode (deletes all the versions of the object, 1:true, 0:false)")(
-    "database-backend", bpo::value<std::string>()->default_value("CCDB"),
-    "Name of the database backend (\"CCDB\" (default) or \"MySql\"")(
-    "monitoring-threaded", bpo::value<int>()->default_value(1),
-    "Whether to send the objects rate from a dedicated thread (1, default) or directly from the main thread (0)")(
-    "monitoring-threaded-interval", bpo::value<int>()->default_value(1),
-    "In case we have a thread for the monitoring, interval in sec. between sending monitoring data")(
-    "monitoring-url", bpo::value<std::string>()->default_value("infologger://"),
-    "The URL to the monitoring system (default : \"infologger://\")");
-}
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                                         //
+      ("help,h", "Help screen")                                                                                                //
+      ("clients", bpo::value<size_t>()->default_value(1), "Number of concurrent clients, each in its own thread")              //
+      ("duration", bpo::value<double>()->default_value(10), "Duration of the benchmark in seconds")                            //
+      ("max-operations", bpo::value<uint64_t>()->default_value(0), "Maximum number of operations per client (0 - infinite)")   //
+      ("operations", bpo::value<std::string>()->default_value("store:1"), "Mix of operations, e.g. store:70,retrieve:25,list:5") //
+      ("object-sizes", bpo::value<std::string>()->default_value("1:1"), "Object sizes in kB with weights, e.g. 1:80,1000:20")     //
+      ("number-objects", bpo::value<size_t>()->default_value(10), "Number of distinct objects of each size")                   //
+      ("local-server", bpo::bool_switch()->default_value(false), "Run against an in-memory CCDB stand-in")                     //
+      ("database-url", bpo::value<std::string>()->default_value("ccdb-test.cern.ch:8080"), "Database url")                     //
+      ("database-backend", bpo::value<std::string>()->default_value("CCDB"), "Name of the database backend")                   //
+      ("task-name", bpo::value<std::string>()->default_value("benchmarkTask"), "Name of the task")                             //
+      ("object-name", bpo::value<std::string>()->default_value("benchmark"), "Prefix of the object names")                     //
+      ("seed", bpo::value<uint32_t>()->default_value(0), "Seed of the random number generators")                               //
+      ("delete", bpo::bool_switch()->default_value(false), "Deletion mode (deletes all the versions of the objects)");
 
-std::unique_ptr<fair::mq::Device> getDevice(fair::mq::ProgOptions& /*config*/)
-{
-  return std::make_unique<o2::quality_control::core::RepositoryBenchmark>();
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    RepositoryBenchmark::Config config;
+    config.databaseBackend = vm["database-backend"].as<std::string>();
+    config.databaseUrl = vm["database-url"].as<std::string>();
+    config.localServer = vm["local-server"].as<bool>();
+    config.clients = vm["clients"].as<size_t>();
+    config.duration = vm["duration"].as<double>();
+    config.maxOperations = vm["max-operations"].as<uint64_t>();
+    config.operationMix = RepositoryBenchmark::parseOperationMix(vm["operations"].as<std::string>());
+    config.sizeMix = RepositoryBenchmark::parseSizeMix(vm["object-sizes"].as<std::string>());
+    config.objectsPerSize = vm["number-objects"].as<size_t>();
+    config.taskName = vm["task-name"].as<std::string>();
+    config.objectName = vm["object-name"].as<std::string>();
+    config.seed = vm["seed"].as<uint32_t>();
+
+    RepositoryBenchmark benchmark(config);
+    if (vm["delete"].as<bool>()) {
+      ILOG(Info, Support) << "Deletion mode..." << ENDM;
+      benchmark.emptyDatabase();
+      return 0;
+    }
+
+    auto result = benchmark.run();
+
+    std::cout << "operation,count,failures,ops_per_s,mean_us,p50_us,p99_us,p999_us,max_us\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (auto& [operation, latencies] : result.latencies) {
+      std::cout << RepositoryBenchmark::toString(operation) << "," << latencies.count() << ","
+                << result.failures[operation] << "," << latencies.count() / result.elapsed << ","
+                << latencies.mean() / 1e3 << "," << latencies.percentile(50) / 1e3 << ","
+                << latencies.percentile(99) / 1e3 << "," << latencies.percentile(99.9) / 1e3 << ","
+                << latencies.max() / 1e3 << "\n";
+    }
+    std::cout << "# elapsed " << result.elapsed << " s, stored " << result.storedBytes / result.elapsed / 1e6 << " MB/s\n";
+    if (config.localServer && result.serverRequests > 0) {
+      std::cout << "# local server: " << result.serverRequests << " requests, "
+                << result.serverHandlingTimeNs / 1e3 / result.serverRequests << " us spent in the server per request\n";
+    }
+  } catch (const bpo::error& ex) {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  } catch (...) {
+    std::cerr << boost::current_exception_diagnostic_information(true) << std::endl;
+    return 1;
+  }
+
+  return 0;
 }
@@ -18,19 +18,16 @@
 /// This is an executable which reads QAResults.root generated by DPL analysis tasks and puts them to QCDB.
 /// It will ignore the directory structure and put all objects in under the task name specified as the argument.
 /// By default the current date and time will be used as the start of validity, and the object will be valid for 10 years.
+/// The objects are uploaded by several concurrent clients, see RootObjectsUploader.
 
+#include "RootObjectsUploader.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/CcdbDatabase.h"
-#include "QualityControl/MonitorObject.h"
 #include "QualityControl/RepoPathUtils.h"
 
-#include <functional>
-#include <filesystem>
 #include <string>
 #include <boost/program_options.hpp>
 #include <boost/exception/diagnostic_information.hpp>
-#include <TFile.h>
-#include <TKey.h>
 
 namespace bpo = boost::program_options;
 using namespace o2::quality_control::core;
@@ -38,7 +35,7 @@ using namespace o2::quality_control::repository;
 
 int main(int argc, const char* argv[])
 {
-  size_t objectsUploaded = 0;
+  RootObjectsUploader::Result result;
 
   try {
     bpo::options_description desc{ "Options" };
@@ -54,7 +51,13 @@ int main(int argc, const char* argv[])
       ("period-name", bpo::value<std::string>()->default_value("unknown"), "Period name of the objects")                                                               // todo one could ask logbook
       ("pass-name", bpo::value<std::string>()->default_value("unknown"), "Calib/reco/sim pass name")                                                                   //
       ("provenance", bpo::value<std::string>()->default_value("qc"), "Object path prefix used to mark if data comes from detector (use qc) or simulation (use qc_mc)") //
-      ("preserve-directories", bpo::bool_switch()->default_value(false), "If present, the directory structure of the input file will be preserved in QCDB");
+      ("preserve-directories", bpo::bool_switch()->default_value(false), "If present, the directory structure of the input file will be preserved in QCDB")            //
+      ("clients", bpo::value<size_t>()->default_value(8), "Number of concurrent uploads")                                                                              //
+      ("queue-size", bpo::value<size_t>()->default_value(64), "Maximum number of objects read from the file ahead of the uploads")                                     //
+      ("retries", bpo::value<size_t>()->default_value(3), "Number of retries of a failed upload")                                                                      //
+      ("retry-delay", bpo::value<double>()->default_value(1), "Delay before the first retry in seconds, it is doubled at each next retry")                             //
+      ("progress-period", bpo::value<double>()->default_value(10), "Period of the progress reports in seconds (0 - no reports)")                                       //
+      ("dry-run", bpo::bool_switch()->default_value(false), "If present, the objects are read and serialized, but not uploaded. Allows to measure the throughput");
 
     bpo::variables_map vm;
     store(parse_command_line(argc, argv, desc), vm);
@@ -67,79 +70,47 @@ int main(int argc, const char* argv[])
     }
 
     /// Read and validate arguments
-    auto inputFilePath = vm["input-file"].as<std::string>();
-    auto qcdbUrl = vm["qcdb-url"].as<std::string>();
-    auto taskName = vm["task-name"].as<std::string>();
-    auto detectorCode = vm["detector-code"].as<std::string>();
-    auto validityStart = vm["validity-start"].as<uint64_t>();
-    auto validityEnd = vm["validity-end"].as<uint64_t>();
-    auto runNumber = vm["run-number"].as<uint64_t>();
-    auto periodName = vm["period-name"].as<std::string>();
-    auto passName = vm["pass-name"].as<std::string>();
-    auto provenance = vm["provenance"].as<std::string>();
-    auto preserveDirectories = vm["preserve-directories"].as<bool>();
-
-    if (validityStart == 0) {
-      validityStart = CcdbDatabase::getCurrentTimestamp();
-    }
-    if (validityEnd == 0) {
-      validityEnd = validityStart + 1000ull * 60 * 60 * 24 * 365 * 10;
-    }
-    if (validityStart > validityEnd) {
-      throw std::runtime_error("Validity start (" + std::to_string(validityStart) + ") is further in the future than validity end (" + std::to_string(validityEnd) + ")");
+    RootObjectsUploader::Config config;
+    config.inputFilePath = vm["input-file"].as<std::string>();
+    config.qcdbUrl = vm["qcdb-url"].as<std::string>();
+    config.taskName = vm["task-name"].as<std::string>();
+    config.detectorCode = vm["detector-code"].as<std::string>();
+    config.validityStart = vm["validity-start"].as<uint64_t>();
+    config.validityEnd = vm["validity-end"].as<uint64_t>();
+    config.runNumber = vm["run-number"].as<uint64_t>();
+    config.periodName = vm["period-name"].as<std::string>();
+    config.passName = vm["pass-name"].as<std::string>();
+    config.provenance = vm["provenance"].as<std::string>();
+    config.preserveDirectories = vm["preserve-directories"].as<bool>();
+    config.clients = vm["clients"].as<size_t>();
+    config.queueSize = vm["queue-size"].as<size_t>();
+    config.maxRetries = vm["retries"].as<size_t>();
+    config.retryDelay = vm["retry-delay"].as<double>();
+    config.progressPeriod = vm["progress-period"].as<double>();
+    config.dryRun = vm["dry-run"].as<bool>();
+
+    if (config.validityStart == 0) {
+      config.validityStart = CcdbDatabase::getCurrentTimestamp();
     }
-    if (!RepoPathUtils::isProvenanceAllowed(provenance)) {
-      throw std::runtime_error(std::string(RepoPathUtils::allowedProvenancesMessage) + " '" + provenance + "' was given.");
+    if (config.validityEnd == 0) {
+      config.validityEnd = config.validityStart + 1000ull * 60 * 60 * 24 * 365 * 10;
     }
-
-    /// Open ROOT file
-    auto* file = new TFile(inputFilePath.c_str(), "READ");
-    if (file->IsZombie()) {
-      throw std::runtime_error("File '" + inputFilePath + "' is zombie.");
+    if (config.validityStart > config.validityEnd) {
+      throw std::runtime_error("Validity start (" + std::to_string(config.validityStart) + ") is further in the future than validity end (" + std::to_string(config.validityEnd) + ")");
     }
-    if (!file->IsOpen()) {
-      throw std::runtime_error("Failed to open the file: " + inputFilePath);
+    if (!RepoPathUtils::isProvenanceAllowed(config.provenance)) {
+      throw std::runtime_error(std::string(RepoPathUtils::allowedProvenancesMessage) + " '" + config.provenance + "' was given.");
     }
-    ILOG(Info) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
-
-    /// Open CCDB interface
-    CcdbDatabase database;
-    database.connect(qcdbUrl, "", "", "");
 
     /// Upload the objects
-    std::function<void(TDirectoryFile*, std::string)> browseFileAndUpload = [&](TDirectoryFile* directory, const std::string& path) {
-      TIter next(directory->GetListOfKeys());
-      TKey* key;
-      while ((key = (TKey*)next())) {
-        auto storedTObj = directory->Get(key->GetName());
-        if (storedTObj != nullptr) {
-          if (storedTObj->InheritsFrom("TDirectoryFile")) {
-            browseFileAndUpload(dynamic_cast<TDirectoryFile*>(storedTObj), path + std::string(key->GetName()) + std::filesystem::path::preferred_separator);
-          } else {
-            std::shared_ptr<MonitorObject> mo = nullptr;
-            if (preserveDirectories) {
-              // one cannot change a name of a TObject, we have to create a new one...
-              auto clonedTObj = storedTObj->Clone((path + storedTObj->GetName()).c_str());
-              mo = std::make_shared<MonitorObject>(clonedTObj, taskName, "unknown", detectorCode, runNumber, periodName, passName, provenance);
-              mo->setIsOwner(true);
-            } else {
-              mo = std::make_shared<MonitorObject>(storedTObj, taskName, "unknown", detectorCode, runNumber, periodName, passName, provenance);
-              mo->setIsOwner(false);
-            }
-            database.storeMO(mo, validityStart, validityEnd);
-            objectsUploaded++;
-          }
-        }
-        delete storedTObj;
-      }
-    };
-
-    browseFileAndUpload(file, "");
+    RootObjectsUploader uploader(config);
+    result = uploader.run();
 
-    file->Close();
-    delete file;
-
-    database.disconnect();
+    if (config.dryRun) {
+      ILOG(Info, Support) << "Dry run: serialized " << result.objectsUploaded << " objects (" << result.serializedBytes << " bytes) in " << result.elapsed << " s, "
+                          << result.objectsUploaded / result.elapsed << " objects/s, " << result.serializedBytes / result.elapsed / 1e6 << " MB/s" << ENDM;
+      return 0;
+    }
 
   } catch (const bpo::error& ex) {
     ILOG(Error, Ops) << "Exception caught: " << ex.what() << ENDM;
@@ -149,10 +120,14 @@ int main(int argc, const char* argv[])
     return 1;
   }
 
-  if (objectsUploaded > 0) {
-    ILOG(Info, Support) << "Successfully uploaded " << objectsUploaded << " objects to the QCDB." << ENDM;
-  } else {
+  if (result.objectsUploaded > 0) {
+    ILOG(Info, Support) << "Successfully uploaded " << result.objectsUploaded << " objects to the QCDB in " << result.elapsed << " s (" << result.retries << " retries)." << ENDM;
+  } else if (result.objectsFailed == 0) {
     ILOG(Info, Support) << "No objects were uploaded to the QCDB. Maybe the file is empty?" << ENDM;
   }
+  if (result.objectsFailed > 0) {
+    ILOG(Error, Ops) << "Failed to upload " << result.objectsFailed << " objects to the QCDB." << ENDM;
+    return 1;
+  }
   return 0;
-}
\ No newline at end of file
+}
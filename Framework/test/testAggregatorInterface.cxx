@@ -75,6 +75,20 @@ class SimpleTestAggregator : public checker::AggregatorInterface
   string mValidString;
 };
 
+// Empties the map it is given, as an aggregator implementing only the non-const aggregate() is allowed to
+class ErasingTestAggregator : public checker::AggregatorInterface
+{
+ public:
+  void configure(std::string) override {}
+
+  std::map<std::string, Quality> aggregate(std::map<std::string, std::shared_ptr<const o2::quality_control::core::QualityObject>>& qoMap) override
+  {
+    std::map<std::string, Quality> result{ { "size", qoMap.size() == 2 ? Quality::Good : Quality::Bad } };
+    qoMap.clear();
+    return result;
+  }
+};
+
 } /* namespace test */
 } /* namespace o2::quality_control */
 
@@ -108,3 +122,19 @@ BOOST_AUTO_TEST_CASE(test_invoke_all_methods)
   BOOST_CHECK_EQUAL(result4.size(), 1);
   BOOST_CHECK_EQUAL(result4["asdf"], Quality::Bad);
 }
+
+BOOST_AUTO_TEST_CASE(test_const_map_fallback)
+{
+  test::ErasingTestAggregator erasingAggregator;
+  checker::AggregatorInterface& aggregator = erasingAggregator;
+
+  QualityObjectsMapType input;
+  input["testCheckGood"] = make_shared<QualityObject>(1, "testCheckGood", "TST");
+  input["testCheckBad"] = make_shared<QualityObject>(3, "testCheckBad", "TST");
+  const QualityObjectsMapType& constInput = input;
+
+  // the default const overload gives a copy to the aggregator
+  auto result = aggregator.aggregate(constInput);
+  BOOST_CHECK_EQUAL(result["size"], Quality::Good);
+  BOOST_CHECK_EQUAL(input.size(), 2);
+}
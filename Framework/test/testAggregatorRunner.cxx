@@ -87,6 +87,15 @@ BOOST_AUTO_TEST_CASE(test_aggregator_runner)
   BOOST_CHECK(aggregators.at(1)->getName() == "MyAggregatorC" || aggregators.at(1)->getName() == "MyAggregatorB");
   BOOST_CHECK(aggregators.at(2)->getName() == "MyAggregatorA");
   BOOST_CHECK(aggregators.at(3)->getName() == "MyAggregatorD");
+
+  // B and C do not depend on other aggregators, thus they can run concurrently
+  const auto& levels = aggregatorRunner.getAggregatorLevels();
+  BOOST_REQUIRE_EQUAL(levels.size(), 3);
+  BOOST_CHECK_EQUAL(levels.at(0).size(), 2);
+  BOOST_REQUIRE_EQUAL(levels.at(1).size(), 1);
+  BOOST_CHECK_EQUAL(levels.at(1).at(0)->getName(), "MyAggregatorA");
+  BOOST_REQUIRE_EQUAL(levels.at(2).size(), 1);
+  BOOST_CHECK_EQUAL(levels.at(2).at(0)->getName(), "MyAggregatorD");
 }
 
 Quality getQualityForCheck(QualityObjectsType qos, string checkName)
@@ -138,6 +147,78 @@ BOOST_AUTO_TEST_CASE(test_aggregator_quality_filter)
   qoMap["dataSizeCheck2/someNumbersTask/example2"] = make_shared<QualityObject>(Quality::Bad, "dataSizeCheck2/someNumbersTask/example2");
   result = aggregator->aggregate(qoMap);
   BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Medium);
+
+  // the same selection, done beforehand with isSource()
+  QualityObjectsMapType sources;
+  for (const auto& [name, qo] : qoMap) {
+    if (aggregator->isSource(name, *qo)) {
+      sources[name] = qo;
+    }
+  }
+  BOOST_CHECK_EQUAL(sources.size(), 3);
+  BOOST_CHECK(!aggregator->isSource("whatever/q1", QualityObject(Quality::Bad, "whatever/q1")));
+  result = aggregator->aggregateSources(sources);
+  BOOST_CHECK_EQUAL(getQualityForCheck(result, "MyAggregatorB/newQuality"), Quality::Medium);
+}
+
+// the names and qualities of the QOs produced by the aggregators of the test configuration, in the order of production
+std::vector<std::pair<std::string, Quality>> runAggregators(size_t workers)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  auto [aggregatorRunnerConfig, aggregatorConfigs] = getAggregatorConfigs(configFilePath);
+  aggregatorRunnerConfig.workers = workers;
+  AggregatorRunner aggregatorRunner{ aggregatorRunnerConfig, aggregatorConfigs };
+
+  Options options{
+    { "runNumber", VariantType::String, { "Run number" } },
+    { "qcConfiguration", VariantType::Dict, emptyDict(), { "Some dictionary configuration" } }
+  };
+  std::vector<std::unique_ptr<ParamRetriever>> retr;
+  std::unique_ptr<ConfigParamStore> store = make_unique<ConfigParamStore>(move(options), move(retr));
+  ConfigParamRegistry cfReg(std::move(store));
+  ServiceRegistry sReg;
+  InitContext initContext{ cfReg, sReg };
+  aggregatorRunner.init(initContext);
+
+  for (const auto& [checkName, quality] : std::vector<std::pair<std::string, Quality>>{
+         { "dataSizeCheck1/q1", Quality::Good },
+         { "dataSizeCheck2/someNumbersTask/example", Quality::Medium },
+         { "dataSizeCheck/q1", Quality::Bad },
+         { "someNumbersCheck/q1", Quality::Good } }) {
+    aggregatorRunner.receive(checkName, make_shared<QualityObject>(quality, checkName, "TST"));
+  }
+
+  std::vector<std::pair<std::string, Quality>> results;
+  for (const auto& qo : aggregatorRunner.aggregate()) {
+    results.emplace_back(qo->getName(), qo->getQuality());
+  }
+  return results;
+}
+
+BOOST_AUTO_TEST_CASE(test_aggregator_runner_workers)
+{
+  auto sequential = runAggregators(1);
+  auto concurrent = runAggregators(4);
+
+  // B and C run concurrently, but their results come in the same order, before the ones of A and then D
+  BOOST_REQUIRE_EQUAL(sequential.size(), 8);
+  BOOST_REQUIRE_EQUAL(concurrent.size(), sequential.size());
+  for (size_t i = 0; i < sequential.size(); i++) {
+    BOOST_CHECK_EQUAL(concurrent[i].first, sequential[i].first);
+    BOOST_CHECK_EQUAL(concurrent[i].second, sequential[i].second);
+  }
+  auto position = [&](const std::string& name) {
+    return std::find_if(concurrent.begin(), concurrent.end(), [&](const auto& result) { return result.first == name; }) - concurrent.begin();
+  };
+  BOOST_CHECK_LT(position("MyAggregatorB/newQuality"), position("MyAggregatorA/newQuality"));
+  BOOST_CHECK_LT(position("MyAggregatorC/newQuality"), position("MyAggregatorA/newQuality"));
+  BOOST_CHECK_LT(position("MyAggregatorA/newQuality"), position("MyAggregatorD/newQuality"));
+
+  auto quality = [&](const std::string& name) { return concurrent.at(position(name)).second; };
+  BOOST_CHECK_EQUAL(quality("MyAggregatorB/newQuality"), Quality::Medium);
+  BOOST_CHECK_EQUAL(quality("MyAggregatorC/newQuality"), Quality::Bad);
+  BOOST_CHECK_EQUAL(quality("MyAggregatorA/newQuality"), Quality::Bad);
+  BOOST_CHECK_EQUAL(quality("MyAggregatorD/newQuality"), Quality::Bad);
 }
 
 BOOST_AUTO_TEST_CASE(test_getDetector)
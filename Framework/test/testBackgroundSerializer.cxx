@@ -0,0 +1,97 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testBackgroundSerializer.cxx
+///
+
+#include "QualityControl/BackgroundSerializer.h"
+#include "QualityControl/MonitorObject.h"
+
+#define BOOST_TEST_MODULE BackgroundSerializer test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <TH1F.h>
+#include <TMessage.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <stdexcept>
+
+using namespace o2::quality_control::core;
+
+namespace
+{
+// TMessage does not allow to read an external buffer otherwise
+class ReadOnlyMessage : public TMessage
+{
+ public:
+  ReadOnlyMessage(void* buffer, Int_t size) : TMessage(buffer, size) { ResetBit(kIsOwner); }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(background_serializer_shadow_set)
+{
+  TH1F histogram("histogram", "histogram", 10, 0, 10);
+  histogram.Fill(1);
+  MonitorObject* mo = new MonitorObject(&histogram, "task", "class", "TST");
+  mo->setIsOwner(false);
+  MonitorObjectCollection liveObjects;
+  liveObjects.SetOwner(true);
+  liveObjects.Add(mo);
+
+  std::atomic<int> callbacks = 0;
+  BackgroundSerializer serializer([&](const MonitorObjectCollection& shadow) {
+    BOOST_CHECK_EQUAL(shadow.GetEntries(), 1);
+    callbacks++;
+  });
+  BOOST_CHECK(!serializer.isPending());
+  BOOST_CHECK(serializer.take(false) == nullptr);
+
+  serializer.push(liveObjects);
+  BOOST_CHECK(serializer.isPending());
+  BOOST_CHECK_THROW(serializer.push(liveObjects), std::logic_error);
+  // the live objects can be modified right away, it does not affect what is being serialized
+  histogram.Fill(2);
+
+  auto serialized = serializer.take(true);
+  BOOST_REQUIRE(serialized != nullptr);
+  BOOST_CHECK(!serializer.isPending());
+  BOOST_CHECK_EQUAL(callbacks, 1);
+
+  ReadOnlyMessage message(serialized->Buffer(), serialized->BufferSize());
+  std::unique_ptr<MonitorObjectCollection> received(static_cast<MonitorObjectCollection*>(message.ReadObjectAny(MonitorObjectCollection::Class())));
+  BOOST_REQUIRE(received != nullptr);
+  received->postDeserialization();
+  BOOST_REQUIRE_EQUAL(received->GetEntries(), 1);
+  auto receivedMO = dynamic_cast<MonitorObject*>(received->At(0));
+  BOOST_REQUIRE(receivedMO != nullptr);
+  BOOST_CHECK_EQUAL(receivedMO->getName(), "histogram");
+  BOOST_CHECK_EQUAL(receivedMO->getTaskName(), "task");
+  auto receivedHistogram = dynamic_cast<TH1F*>(receivedMO->getObject());
+  BOOST_REQUIRE(receivedHistogram != nullptr);
+  BOOST_CHECK_EQUAL(receivedHistogram->GetEntries(), 1);
+
+  // the next set can be pushed once the previous one was taken
+  BOOST_CHECK_NO_THROW(serializer.push(liveObjects));
+  serialized = serializer.take(true);
+  BOOST_CHECK(serialized != nullptr);
+  BOOST_CHECK_EQUAL(callbacks, 2);
+}
+
+BOOST_AUTO_TEST_CASE(background_serializer_exception)
+{
+  MonitorObjectCollection liveObjects;
+  BackgroundSerializer serializer([](const MonitorObjectCollection&) { throw std::runtime_error("test"); });
+  serializer.push(liveObjects);
+  BOOST_CHECK_THROW(serializer.take(true), std::runtime_error);
+  BOOST_CHECK(!serializer.isPending());
+}
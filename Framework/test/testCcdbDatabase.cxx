@@ -28,6 +28,7 @@
 #include <TH1F.h>
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/testUtils.h"
+#include "LocalCcdbServer.h"
 #include <DataFormatsQualityControl/TimeRangeFlagCollection.h>
 #include <TROOT.h>
 
@@ -194,6 +195,25 @@ BOOST_AUTO_TEST_CASE(ccdb_retrieve_timestamps, *utf::depends_on("ccdb_store"))
   BOOST_CHECK_EQUAL(qo->getName(), f.taskName + "/short");
 }
 
+BOOST_AUTO_TEST_CASE(ccdb_retrieve_qo_batch)
+{
+  // the batch is retrieved with several concurrent requests, they are sent to a local stand-in of the CCDB
+  LocalCcdbServer server;
+  CcdbDatabase backend;
+  backend.connect({ { "host", server.getUrl() }, { "maxConcurrentRequests", "3" } });
+
+  auto qo = make_shared<QualityObject>(Quality::Good, "taskBatch/batch", "TST", "OnAll", vector{ string("input1") });
+  backend.storeQO(qo, 10000, 20000);
+
+  auto qos = backend.retrieveQOs(RepoPathUtils::getQoPath("TST", "taskBatch/batch", "", {}, "", false), { 15000, 5000, 19999 });
+  BOOST_REQUIRE_EQUAL(qos.size(), 3);
+  BOOST_REQUIRE_NE(qos[0], nullptr);
+  BOOST_CHECK_EQUAL(qos[0]->getName(), "taskBatch/batch");
+  BOOST_CHECK(qos[1] == nullptr);
+  BOOST_REQUIRE_NE(qos[2], nullptr);
+  BOOST_CHECK_EQUAL(qos[2]->getMetadata("Valid-From"), "10000");
+}
+
 BOOST_AUTO_TEST_CASE(ccdb_retrieve_inexisting_mo)
 {
   test_fixture f;
@@ -406,5 +426,32 @@ BOOST_AUTO_TEST_CASE(ccdb_trfc)
   }
 }
 
+BOOST_AUTO_TEST_CASE(ccdb_trfc_batch)
+{
+  // the batch is retrieved with several concurrent requests, they are sent to a local stand-in of the CCDB
+  LocalCcdbServer server;
+  CcdbDatabase backend;
+  backend.connect({ { "host", server.getUrl() }, { "maxConcurrentRequests", "3" } });
+  const std::string trfcName = "Test_batch";
+
+  std::vector<int> runNumbers{ 42, 43, 44, 45, 46, 47, 48 };
+  for (auto runNumber : runNumbers) {
+    std::shared_ptr<TimeRangeFlagCollection> trfc{ new TimeRangeFlagCollection{ trfcName, "TST", { 45, 500000 }, runNumber, "LHC42x", "spass", "qc" } };
+    trfc->insert({ 50, 77 + runNumber, FlagReasonFactory::Invalid(), "a comment", "a source" });
+    backend.storeTRFC(trfc);
+  }
+  runNumbers.push_back(123456789); // does not exist
+
+  auto trfcs = backend.retrieveTRFCs(trfcName, "TST", runNumbers, "spass", "LHC42x", "qc", 400000);
+  BOOST_REQUIRE_EQUAL(trfcs.size(), runNumbers.size());
+  for (size_t i = 0; i < runNumbers.size() - 1; i++) {
+    BOOST_REQUIRE(trfcs[i] != nullptr);
+    BOOST_CHECK_EQUAL(trfcs[i]->getRunNumber(), runNumbers[i]);
+    BOOST_REQUIRE_EQUAL(trfcs[i]->size(), 1);
+    BOOST_CHECK_EQUAL(trfcs[i]->begin()->getEnd(), static_cast<uint64_t>(77 + runNumbers[i]));
+  }
+  BOOST_CHECK(trfcs.back() == nullptr);
+}
+
 } // namespace
 } // namespace o2::quality_control::core
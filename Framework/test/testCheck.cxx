@@ -21,6 +21,7 @@
 #include <DataSampling/DataSampling.h>
 #include <Common/Exceptions.h>
 #include <TH1F.h>
+#include <type_traits>
 #include <Configuration/ConfigurationFactory.h>
 #include <Configuration/ConfigurationInterface.h>
 
@@ -155,3 +156,132 @@ BOOST_AUTO_TEST_CASE(test_check_postprocessing)
   // Beautify should run - single MO declared
   BOOST_CHECK(testCheck.mBeautify);
 }
+
+/*
+ * Test the checks which receive a view on the objects instead of a map
+ */
+class TestViewCheck : public CheckInterface
+{
+ public:
+  void configure() override {}
+  Quality checkView(const MonitorObjectsView& moView) override
+  {
+    mViews.emplace_back();
+    for (const auto& item : moView) {
+      mViews.back().push_back(&item);
+    }
+    return Quality::Good;
+  }
+  Quality check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap) override { return checkWithView(moMap); }
+  void beautify(std::shared_ptr<MonitorObject>, Quality) override {}
+
+  std::vector<std::vector<const MonitorObjectsView::value_type*>> mViews;
+};
+
+// a check which implements none of the check methods cannot be instantiated
+class TestNoCheck : public CheckInterface
+{
+ public:
+  void configure() override {}
+  void beautify(std::shared_ptr<MonitorObject>, Quality) override {}
+};
+static_assert(std::is_abstract_v<TestNoCheck>);
+static_assert(!std::is_abstract_v<TestViewCheck>);
+
+// a check which relies on checkView() without overriding it
+class TestMissingViewCheck : public CheckInterface
+{
+ public:
+  void configure() override {}
+  Quality check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap) override { return checkWithView(moMap); }
+  void beautify(std::shared_ptr<MonitorObject>, Quality) override {}
+};
+
+BOOST_AUTO_TEST_CASE(test_check_view)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap = {
+    { "abcTask/test2", std::make_shared<MonitorObject>() },
+    { "abcTask/test1", std::make_shared<MonitorObject>() },
+    { "abcTask/other", std::make_shared<MonitorObject>() }
+  };
+
+  {
+    Check check(getCheckConfig(configFilePath, "checkAny"));
+    check.init();
+    TestViewCheck testCheck;
+    check.setCheckInterface(&testCheck);
+
+    auto qos = check.check(moMap);
+    BOOST_REQUIRE_EQUAL(qos.size(), 1);
+    BOOST_REQUIRE_EQUAL(testCheck.mViews.size(), 1);
+    // only the declared objects, sorted by name and not copied
+    BOOST_REQUIRE_EQUAL(testCheck.mViews[0].size(), 2);
+    BOOST_CHECK_EQUAL(testCheck.mViews[0][0], &*moMap.find("abcTask/test1"));
+    BOOST_CHECK_EQUAL(testCheck.mViews[0][1], &*moMap.find("abcTask/test2"));
+    BOOST_CHECK_EQUAL(qos[0]->getMonitorObjectsNames().size(), 2);
+  }
+  {
+    Check check(getCheckConfig(configFilePath, "checkOnEachSeparately"));
+    check.init();
+    TestViewCheck testCheck;
+    check.setCheckInterface(&testCheck);
+
+    auto qos = check.check(moMap);
+    BOOST_REQUIRE_EQUAL(qos.size(), 2);
+    BOOST_REQUIRE_EQUAL(testCheck.mViews.size(), 2);
+    BOOST_CHECK_EQUAL(testCheck.mViews[0].size(), 1);
+    BOOST_CHECK_EQUAL(testCheck.mViews[1].size(), 1);
+    BOOST_CHECK_EQUAL(qos[1]->getMonitorObjectsNames()[0], "abcTask/test2");
+  }
+  {
+    Check check(getCheckConfig(configFilePath, "checkGlobalAny"));
+    check.init();
+    TestViewCheck testCheck;
+    check.setCheckInterface(&testCheck);
+
+    check.check(moMap);
+    BOOST_REQUIRE_EQUAL(testCheck.mViews.size(), 1);
+    BOOST_CHECK_EQUAL(testCheck.mViews[0].size(), 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_check_with_view)
+{
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap = {
+    { "b", std::make_shared<MonitorObject>() },
+    { "a", std::make_shared<MonitorObject>() }
+  };
+  TestViewCheck viewCheck;
+  BOOST_CHECK_EQUAL(viewCheck.check(&moMap), Quality::Good);
+  BOOST_REQUIRE_EQUAL(viewCheck.mViews.size(), 1);
+  BOOST_REQUIRE_EQUAL(viewCheck.mViews[0].size(), 2);
+  BOOST_CHECK_EQUAL(viewCheck.mViews[0][0], &*moMap.find("a"));
+
+  TestMissingViewCheck missingViewCheck;
+  BOOST_CHECK_THROW(missingViewCheck.check(&moMap), AliceO2::Common::FatalException);
+  // the failure does not affect the next checks in the thread
+  BOOST_CHECK_EQUAL(viewCheck.check(&moMap), Quality::Good);
+}
+
+BOOST_AUTO_TEST_CASE(test_monitor_objects_view)
+{
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap = {
+    { "a", std::make_shared<MonitorObject>() },
+    { "b", std::make_shared<MonitorObject>() },
+    { "c", std::make_shared<MonitorObject>() }
+  };
+  std::vector<const MonitorObjectsView::value_type*> selection{ &*moMap.find("a"), &*moMap.find("c") };
+  MonitorObjectsView view(selection.data(), selection.data() + selection.size());
+
+  BOOST_CHECK_EQUAL(view.size(), 2);
+  BOOST_CHECK_EQUAL(view.count("a"), 1);
+  BOOST_CHECK_EQUAL(view.count("b"), 0);
+  BOOST_CHECK(view.find("b") == view.end());
+  BOOST_CHECK_EQUAL(view.get("c"), moMap["c"].get());
+  BOOST_CHECK(view.get("d") == nullptr);
+
+  auto copy = view.toMap();
+  BOOST_CHECK_EQUAL(copy.size(), 2);
+  BOOST_CHECK_EQUAL(copy["c"], moMap["c"]);
+}
@@ -0,0 +1,149 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testConditionCache.cxx
+///
+
+#include "QualityControl/ConditionCache.h"
+
+#define BOOST_TEST_MODULE ConditionCache test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace o2::quality_control::core;
+using namespace std::chrono;
+
+namespace
+{
+long nowMs()
+{
+  return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// no CCDB is contacted, the objects are made up by the fetcher
+ConditionCache::Fetcher makeFetcher(std::atomic<int>& calls, long validityMs)
+{
+  return [&calls, validityMs](o2::ccdb::CcdbApi&, const std::string&, const std::map<std::string, std::string>&, long,
+                              std::map<std::string, std::string>& headers) -> std::shared_ptr<void> {
+    int call = ++calls;
+    headers["Valid-From"] = std::to_string(nowMs() - 1000);
+    headers["Valid-Until"] = std::to_string(nowMs() + validityMs);
+    return std::make_shared<int>(call);
+  };
+}
+
+bool waitFor(const std::function<bool()>& condition)
+{
+  auto deadline = steady_clock::now() + seconds(10);
+  while (!condition() && steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  return condition();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(condition_cache_hits_within_validity)
+{
+  ConditionCache cache("http://localhost:1");
+  std::atomic<int> calls = 0;
+  auto fetcher = makeFetcher(calls, 60 * 1000);
+
+  auto first = std::static_pointer_cast<const int>(cache.get("TST/Calib/Test", {}, -1, typeid(int), fetcher));
+  BOOST_REQUIRE(first != nullptr);
+  BOOST_CHECK_EQUAL(*first, 1);
+  auto second = std::static_pointer_cast<const int>(cache.get("TST/Calib/Test", {}, -1, typeid(int), fetcher));
+  BOOST_CHECK_EQUAL(first, second);
+  BOOST_CHECK_EQUAL(calls, 1);
+  BOOST_CHECK_EQUAL(cache.getMisses(), 1);
+  BOOST_CHECK_EQUAL(cache.getHits(), 1);
+
+  // other metadata is another condition
+  auto other = cache.get("TST/Calib/Test", { { "key", "value" } }, -1, typeid(int), fetcher);
+  BOOST_CHECK(other != nullptr);
+  BOOST_CHECK_EQUAL(calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(condition_cache_background_refresh)
+{
+  ConditionCache cache("http://localhost:1");
+  cache.setRetryDelay(10);
+  std::atomic<int> calls = 0;
+  auto fetcher = makeFetcher(calls, 100);
+
+  auto first = std::static_pointer_cast<const int>(cache.get("TST/Calib/Test", {}, -1, typeid(int), fetcher));
+  BOOST_REQUIRE(first != nullptr);
+  // the object is retrieved again when its validity ends, without anybody asking for it
+  BOOST_CHECK(waitFor([&]() { return calls >= 2; }));
+  BOOST_CHECK(waitFor([&]() {
+    auto refreshed = std::static_pointer_cast<const int>(cache.get("TST/Calib/Test", {}, -1, typeid(int), fetcher));
+    return refreshed != nullptr && *refreshed >= 2;
+  }));
+  BOOST_CHECK_EQUAL(cache.getMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(condition_cache_prefetch)
+{
+  ConditionCache cache("http://localhost:1");
+  std::atomic<int> calls = 0;
+  cache.declare("TST/Calib/Test", {}, typeid(int), makeFetcher(calls, 60 * 1000));
+  BOOST_CHECK_EQUAL(calls, 0);
+
+  cache.prefetch();
+  BOOST_CHECK(waitFor([&]() { return calls == 1; }));
+  // the prefetched object is used, it is not retrieved again
+  auto object = cache.get("TST/Calib/Test", {}, -1, typeid(int), makeFetcher(calls, 60 * 1000));
+  BOOST_CHECK(object != nullptr);
+  BOOST_CHECK_EQUAL(calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(condition_cache_failure)
+{
+  ConditionCache cache("http://localhost:1");
+  auto fetcher = [](o2::ccdb::CcdbApi&, const std::string&, const std::map<std::string, std::string>&, long,
+                    std::map<std::string, std::string>&) -> std::shared_ptr<void> { return nullptr; };
+  BOOST_CHECK(cache.get("TST/Calib/Missing", {}, -1, typeid(int), fetcher) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(condition_cache_failure_for_timestamp)
+{
+  ConditionCache cache("http://localhost:1");
+  // only the objects valid at a timestamp before 1000 exist
+  auto fetcher = [](o2::ccdb::CcdbApi&, const std::string&, const std::map<std::string, std::string>&, long timestamp,
+                    std::map<std::string, std::string>& headers) -> std::shared_ptr<void> {
+    if (timestamp >= 1000) {
+      return nullptr;
+    }
+    headers["Valid-From"] = "0";
+    headers["Valid-Until"] = "1000";
+    return std::make_shared<int>(1);
+  };
+
+  BOOST_CHECK(cache.get("TST/Calib/Test", {}, 500, typeid(int), fetcher) != nullptr);
+  // the previous object is kept after the failure, but it is not valid at the requested timestamp
+  BOOST_CHECK(cache.get("TST/Calib/Test", {}, 2000, typeid(int), fetcher) == nullptr);
+  BOOST_CHECK(cache.get("TST/Calib/Test", {}, 2000, typeid(int), fetcher) == nullptr);
+  BOOST_CHECK(cache.get("TST/Calib/Test", {}, 999, typeid(int), fetcher) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(condition_cache_unused)
+{
+  // nothing is declared nor retrieved, the background thread is never started
+  ConditionCache cache("http://localhost:1");
+  cache.prefetch();
+  BOOST_CHECK_EQUAL(cache.getHits(), 0);
+  BOOST_CHECK_EQUAL(cache.getMisses(), 0);
+}
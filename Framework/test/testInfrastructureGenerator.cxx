@@ -21,10 +21,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include "QualityControl/InfrastructureGenerator.h"
+#include "QualityControl/TaskSpec.h"
 #include "getTestDataDirectory.h"
 
 #include <Framework/DataSpecUtils.h>
 #include <Configuration/ConfigurationFactory.h>
+#include <boost/property_tree/ptree.hpp>
+#include <set>
 
 using namespace o2::quality_control::core;
 using namespace o2::framework;
@@ -171,6 +174,75 @@ BOOST_AUTO_TEST_CASE(qc_factory_remote_test)
   BOOST_CHECK(aggregator != workflow.end());
 }
 
+BOOST_AUTO_TEST_CASE(qc_factory_remote_multilayer_mergers_test)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  auto configInterface = ConfigurationFactory::getConfiguration(configFilePath);
+  auto configTree = configInterface->getRecursive();
+
+  // two local machines merged by two Mergers in the first layer and one in the second
+  boost::property_tree::ptree mergersPerLayer;
+  for (auto mergers : { "2", "1" }) {
+    boost::property_tree::ptree value;
+    value.put("", mergers);
+    mergersPerLayer.push_back({ "", value });
+  }
+  configTree.put_child("qc.tasks.skeletonTask.mergersPerLayer", mergersPerLayer);
+  auto workflow = InfrastructureGenerator::generateRemoteInfrastructure(configTree);
+
+  // one additional device with respect to the single layer setup
+  BOOST_REQUIRE_EQUAL(workflow.size(), 13);
+
+  auto mergerCount = std::count_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name.find("MERGER") != std::string::npos;
+    });
+  BOOST_CHECK_EQUAL(mergerCount, 3);
+
+  // the top Merger receives the results of the two Mergers below and publishes to the usual task output
+  auto topMerger = std::find_if(
+    workflow.begin(), workflow.end(),
+    [](const DataProcessorSpec& d) {
+      return d.name.find("MERGER") != std::string::npos &&
+             d.inputs.size() == 3 &&
+             d.outputs.size() == 1 && DataSpecUtils::getOptionalSubSpec(d.outputs[0]).value_or(-1) == 0;
+    });
+  BOOST_REQUIRE(topMerger != workflow.end());
+  std::set<std::string> bindings;
+  for (const auto& input : topMerger->inputs) {
+    BOOST_CHECK(bindings.insert(input.binding).second);
+  }
+
+  // the number of per-layer cycle multipliers should match the number of layers
+  boost::property_tree::ptree multipliers;
+  boost::property_tree::ptree value;
+  value.put("", "1");
+  multipliers.push_back({ "", value });
+  configTree.put_child("qc.tasks.skeletonTask.mergerCycleMultipliers", multipliers);
+  BOOST_CHECK_THROW(InfrastructureGenerator::generateRemoteInfrastructure(configTree), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(qc_factory_mergers_per_layer)
+{
+  TaskSpec taskSpec;
+  BOOST_CHECK(InfrastructureGenerator::computeMergersPerLayer(250, taskSpec) == std::vector<size_t>({ 1 }));
+
+  taskSpec.mergerReductionFactor = 10;
+  BOOST_CHECK(InfrastructureGenerator::computeMergersPerLayer(5, taskSpec) == std::vector<size_t>({ 1 }));
+  BOOST_CHECK(InfrastructureGenerator::computeMergersPerLayer(10, taskSpec) == std::vector<size_t>({ 1 }));
+  BOOST_CHECK(InfrastructureGenerator::computeMergersPerLayer(11, taskSpec) == std::vector<size_t>({ 2, 1 }));
+  BOOST_CHECK(InfrastructureGenerator::computeMergersPerLayer(250, taskSpec) == std::vector<size_t>({ 25, 3, 1 }));
+
+  taskSpec.mergersPerLayer = { 4, 1 };
+  BOOST_CHECK(InfrastructureGenerator::computeMergersPerLayer(250, taskSpec) == std::vector<size_t>({ 4, 1 }));
+  BOOST_CHECK_THROW(InfrastructureGenerator::computeMergersPerLayer(3, taskSpec), std::runtime_error);
+  taskSpec.mergersPerLayer = { 4, 2 };
+  BOOST_CHECK_THROW(InfrastructureGenerator::computeMergersPerLayer(250, taskSpec), std::runtime_error);
+  taskSpec.mergersPerLayer = { 1, 2, 1 };
+  BOOST_CHECK_THROW(InfrastructureGenerator::computeMergersPerLayer(250, taskSpec), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(qc_factory_standalone_test)
 {
   std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
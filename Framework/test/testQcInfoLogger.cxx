@@ -22,6 +22,7 @@
 #include <boost/test/unit_test.hpp>
 #include <fairlogger/Logger.h>
 #include <cstdlib>
+#include <string>
 
 using namespace std;
 using namespace AliceO2::InfoLogger;
@@ -95,4 +96,55 @@ BOOST_AUTO_TEST_CASE(qc_info_logger_dplil)
   QcInfoLogger::init("facility", false, 21, &dplInfoLogger, dplContext);
 }
 
+BOOST_AUTO_TEST_CASE(qc_info_logger_rate_limiter)
+{
+  LogRateLimiter limiter(3600, __FILE__, __LINE__);
+  BOOST_CHECK(limiter.allow());
+  for (int i = 0; i < 10; i++) {
+    BOOST_CHECK(!limiter.allow());
+  }
+  BOOST_CHECK_EQUAL(limiter.takeSuppressed(), 10);
+  BOOST_CHECK_EQUAL(limiter.takeSuppressed(), 0);
+
+  LogRateLimiter noLimit(0, __FILE__, __LINE__);
+  BOOST_CHECK(noLimit.allow());
+  BOOST_CHECK(noLimit.allow());
+  BOOST_CHECK_EQUAL(noLimit.takeSuppressed(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(qc_info_logger_rate_limiter_lifetime)
+{
+  // the limiters are destroyed while the sink reports their suppressed messages, they must unregister first
+  QcInfoLogger::setSuppressedMessagesReportPeriod(0.001);
+  for (int i = 0; i < 1000; i++) {
+    LogRateLimiter limiter(3600, __FILE__, __LINE__);
+    limiter.allow();
+    limiter.allow();
+  }
+  QcInfoLogger::setSuppressedMessagesReportPeriod(60);
+}
+
+BOOST_AUTO_TEST_CASE(qc_info_logger_deferred_formatting)
+{
+  QcInfoLogger::init("facility", true, 21);
+  int formatted = 0;
+  auto format = [&formatted]() { return ++formatted; };
+
+  for (int i = 0; i < 100; i++) {
+    ILOG_RATE_LIMITED(Info, Support, 3600) << "rate-limited message " << format() << ENDM;
+  }
+  BOOST_CHECK_EQUAL(formatted, 1);
+
+  ILOG_ASYNC(Debug, Support) << "discarded debug message " << format() << ENDM;
+  ILOG_ASYNC(Info, Trace) << "discarded trace message " << format() << ENDM;
+  BOOST_CHECK_EQUAL(formatted, 1);
+
+  ILOG_ASYNC(Info, Support) << "asynchronous message " << format() << ENDM;
+  ILOG_ASYNC(Warning, Support) << "truncated message " << std::string(2 * QcLogMessage::maxLength, 'x') << ENDM;
+  BOOST_CHECK_EQUAL(formatted, 2);
+  QcInfoLogger::flushAsync();
+
+  QcInfoLogger::init("facility", false, 21);
+}
+
 } // namespace o2::quality_control::core
@@ -0,0 +1,126 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testQualityObjectCodec.cxx
+///
+
+#include "QualityControl/QualityObjectCodec.h"
+#include <DataFormatsQualityControl/FlagReasons.h>
+
+#define BOOST_TEST_MODULE QualityObjectCodec test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control;
+using namespace AliceO2::Common;
+
+namespace
+{
+QualityObjectsType createQualityObjects()
+{
+  auto qo1 = std::make_shared<QualityObject>(Quality::Bad, "xyzCheck", "TST", "OnAny",
+                                             std::vector<std::string>{ "qc/TST/MO/testTask/mo1", "qc/TST/MO/testTask/mo2" },
+                                             std::vector<std::string>{ "mo1", "mo2" },
+                                             std::map<std::string, std::string>{ { "threshold", "3" }, { "", "empty key" } });
+  qo1->addReason(FlagReasonFactory::BadTracking(), "too few tracks");
+  qo1->addReason(FlagReasonFactory::Unknown());
+  qo1->setActivity({ 300000, 2, "LHC22a", "apass1", "qc_mc", { 1000, 2000 } });
+
+  auto qo2 = std::make_shared<QualityObject>(Quality::Good, "abcCheck", "TST", "OnEachSeparately",
+                                             std::vector<std::string>{}, std::vector<std::string>{ "mo3" });
+  auto qo3 = std::make_shared<QualityObject>(Quality::Null, "");
+  return { qo1, qo2, qo3 };
+}
+
+void checkEqual(const QualityObject& decoded, const QualityObject& original)
+{
+  BOOST_CHECK_EQUAL(decoded.getQuality(), original.getQuality());
+  BOOST_CHECK_EQUAL(decoded.getCheckName(), original.getCheckName());
+  BOOST_CHECK_EQUAL(decoded.getDetectorName(), original.getDetectorName());
+  BOOST_CHECK_EQUAL(decoded.getPolicyName(), original.getPolicyName());
+  BOOST_CHECK(decoded.getInputs() == original.getInputs());
+  BOOST_CHECK(decoded.getMonitorObjectsNames() == original.getMonitorObjectsNames());
+  BOOST_CHECK(decoded.getMetadataMap() == original.getMetadataMap());
+  BOOST_CHECK(decoded.getReasons() == original.getReasons());
+  BOOST_CHECK(decoded.getActivity() == original.getActivity());
+  BOOST_CHECK_EQUAL(decoded.getName(), original.getName());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(codec_round_trip)
+{
+  auto qualityObjects = createQualityObjects();
+  auto buffer = QualityObjectCodec::encode(qualityObjects);
+  BOOST_CHECK_EQUAL(buffer.size(), QualityObjectCodec::getEncodedSize(qualityObjects));
+  BOOST_REQUIRE(QualityObjectCodec::isEncodedBatch(buffer.data(), buffer.size()));
+
+  QualityObjectsBatchView batch(buffer.data(), buffer.size());
+  BOOST_REQUIRE_EQUAL(batch.size(), qualityObjects.size());
+
+  size_t i = 0;
+  for (const auto& view : batch) {
+    BOOST_CHECK_EQUAL(view.getLevel(), qualityObjects[i]->getQuality().getLevel());
+    BOOST_CHECK_EQUAL(view.getQualityName(), qualityObjects[i]->getQuality().getName());
+    BOOST_CHECK_EQUAL(view.getCheckName(), qualityObjects[i]->getCheckName());
+    BOOST_CHECK_EQUAL(view.getDetectorName(), qualityObjects[i]->getDetectorName());
+    BOOST_CHECK_EQUAL(view.getPolicyName(), qualityObjects[i]->getPolicyName());
+    BOOST_CHECK_EQUAL(view.getNumberOfMonitorObjects(), qualityObjects[i]->getMonitorObjectsNames().size());
+    BOOST_CHECK_EQUAL(view.getName(), qualityObjects[i]->getName());
+    checkEqual(*view.toQualityObject(), *qualityObjects[i]);
+    i++;
+  }
+  BOOST_CHECK_EQUAL(i, qualityObjects.size());
+
+  auto decoded = batch.toQualityObjects();
+  BOOST_REQUIRE_EQUAL(decoded.size(), qualityObjects.size());
+  for (size_t j = 0; j < decoded.size(); j++) {
+    checkEqual(*decoded[j], *qualityObjects[j]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(codec_empty_batch)
+{
+  auto buffer = QualityObjectCodec::encode({});
+  BOOST_CHECK_EQUAL(buffer.size(), QualityObjectCodec::headerSize);
+  QualityObjectsBatchView batch(buffer.data(), buffer.size());
+  BOOST_CHECK_EQUAL(batch.size(), 0);
+  BOOST_CHECK(batch.begin() == batch.end());
+}
+
+BOOST_AUTO_TEST_CASE(codec_malformed)
+{
+  auto qualityObjects = createQualityObjects();
+  auto buffer = QualityObjectCodec::encode(qualityObjects);
+
+  // too small buffer
+  std::vector<char> smallBuffer(buffer.size() - 1);
+  BOOST_CHECK_THROW(QualityObjectCodec::encode(qualityObjects, smallBuffer.data(), smallBuffer.size()), FatalException);
+
+  // not a batch
+  std::string text = "definitely not a batch of QOs";
+  BOOST_CHECK(!QualityObjectCodec::isEncodedBatch(text.data(), text.size()));
+  BOOST_CHECK(!QualityObjectCodec::isEncodedBatch(nullptr, 0));
+  BOOST_CHECK_THROW(QualityObjectsBatchView(text.data(), text.size()), FatalException);
+
+  // unsupported version
+  auto otherVersion = buffer;
+  otherVersion[4] = QualityObjectCodec::version + 1;
+  BOOST_CHECK_THROW(QualityObjectsBatchView(otherVersion.data(), otherVersion.size()), FatalException);
+
+  // truncated records
+  for (size_t size : { buffer.size() - 1, buffer.size() / 2, QualityObjectCodec::headerSize + 2 }) {
+    QualityObjectsBatchView batch(buffer.data(), size);
+    BOOST_CHECK_THROW(batch.toQualityObjects(), FatalException);
+  }
+}
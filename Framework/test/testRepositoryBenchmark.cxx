@@ -0,0 +1,107 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testRepositoryBenchmark.cxx
+///
+
+#include "RepositoryBenchmark.h"
+#include "LocalCcdbServer.h"
+#include "QualityControl/CcdbDatabase.h"
+
+#define BOOST_TEST_MODULE RepositoryBenchmark test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+BOOST_AUTO_TEST_CASE(test_latency_histogram)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.percentile(50), 0);
+
+  for (uint64_t i = 1; i <= 1000000; i++) {
+    histogram.record(i);
+  }
+  BOOST_CHECK_EQUAL(histogram.count(), 1000000);
+  BOOST_CHECK_EQUAL(histogram.max(), 1000000);
+  BOOST_CHECK_CLOSE(histogram.mean(), 500000.5, 0.001);
+  BOOST_CHECK_CLOSE(static_cast<double>(histogram.percentile(50)), 500000, 3.2);
+  BOOST_CHECK_CLOSE(static_cast<double>(histogram.percentile(99)), 990000, 3.2);
+  BOOST_CHECK_CLOSE(static_cast<double>(histogram.percentile(99.9)), 999000, 3.2);
+  BOOST_CHECK_EQUAL(histogram.percentile(100), 1000000);
+
+  LatencyHistogram other;
+  other.record(5);
+  other.merge(histogram);
+  BOOST_CHECK_EQUAL(other.count(), 1000001);
+  BOOST_CHECK_EQUAL(other.percentile(0.00001), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_mixes)
+{
+  auto operations = RepositoryBenchmark::parseOperationMix("store:70,retrieve:25,list");
+  BOOST_REQUIRE_EQUAL(operations.size(), 3);
+  BOOST_CHECK_EQUAL(operations[RepositoryBenchmark::Operation::Store], 70);
+  BOOST_CHECK_EQUAL(operations[RepositoryBenchmark::Operation::List], 1);
+  BOOST_CHECK_THROW(RepositoryBenchmark::parseOperationMix("delete:3"), AliceO2::Common::FatalException);
+
+  auto sizes = RepositoryBenchmark::parseSizeMix("1:80,1000:20");
+  BOOST_REQUIRE_EQUAL(sizes.size(), 2);
+  BOOST_CHECK_EQUAL(sizes[1000], 20);
+}
+
+BOOST_AUTO_TEST_CASE(test_local_server)
+{
+  LocalCcdbServer server;
+  CcdbDatabase database;
+  database.connect(server.getUrl(), "", "", "");
+
+  auto mo = std::make_shared<MonitorObject>(new TH1F("histo", "histo", 10, 0, 10), "task", "class", "TST");
+  mo->setIsOwner(true);
+  database.storeMO(mo);
+
+  auto retrieved = database.retrieveMO("TST/MO/task", "histo");
+  BOOST_REQUIRE(retrieved != nullptr);
+  BOOST_CHECK_EQUAL(retrieved->getObject()->GetName(), std::string("histo"));
+  BOOST_CHECK(database.retrieveMO("TST/MO/task", "missing") == nullptr);
+
+  auto names = database.getPublishedObjectNames("qc/TST/MO/task");
+  BOOST_REQUIRE_EQUAL(names.size(), 1);
+  BOOST_CHECK_EQUAL(names[0], "/histo");
+  BOOST_CHECK_GE(server.getRequestCount(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_benchmark_local_server)
+{
+  RepositoryBenchmark::Config config;
+  config.localServer = true;
+  config.clients = 3;
+  config.maxOperations = 20;
+  config.operationMix = RepositoryBenchmark::parseOperationMix("store:2,retrieve:2,list:1");
+  config.sizeMix = RepositoryBenchmark::parseSizeMix("1:3,10:1");
+  config.objectsPerSize = 2;
+
+  RepositoryBenchmark benchmark(config);
+  auto result = benchmark.run();
+
+  uint64_t operations = 0;
+  for (const auto& [operation, latencies] : result.latencies) {
+    operations += latencies.count();
+    BOOST_CHECK_EQUAL(result.failures[operation], 0);
+  }
+  BOOST_CHECK_EQUAL(operations, 60);
+  BOOST_CHECK_GE(result.serverRequests, 60);
+}
@@ -0,0 +1,116 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testRootFileSource.cxx
+///
+
+#include "QualityControl/RootFileSource.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include <Framework/InitContext.h>
+#include <Framework/ConfigParamRegistry.h>
+#include <Framework/ConfigParamStore.h>
+
+#define BOOST_TEST_MODULE RootFileSource test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <TFile.h>
+#include <TH1F.h>
+#include <filesystem>
+#include <unistd.h>
+
+using namespace o2::quality_control::core;
+using namespace o2::framework;
+
+namespace
+{
+// one MonitorObjectCollection per task, as RootFileSink stores them
+std::string createInputFile(const std::string& name, const std::vector<std::string>& taskNames)
+{
+  auto path = (std::filesystem::temp_directory_path() / ("testRootFileSource_" + name + "_" + std::to_string(getpid()) + ".root")).string();
+  TFile file(path.c_str(), "RECREATE");
+  for (const auto& taskName : taskNames) {
+    MonitorObjectCollection collection;
+    collection.SetName(taskName.c_str());
+    collection.SetOwner(true);
+    auto histo = new TH1F("histo", "histo", 10, 0, 10);
+    histo->Fill(5);
+    auto mo = new MonitorObject(histo, taskName, "TestClass", "TST");
+    mo->setIsOwner(true);
+    collection.Add(mo);
+    file.WriteObject(&collection, collection.GetName());
+  }
+  file.Close();
+  return path;
+}
+
+void initialize(RootFileSource& source)
+{
+  std::vector<std::unique_ptr<ParamRetriever>> retrievers;
+  ConfigParamRegistry registry(std::make_unique<ConfigParamStore>(Options{}, std::move(retrievers)));
+  ServiceRegistry services;
+  InitContext initContext{ registry, services };
+  source.init(initContext);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_several_files)
+{
+  auto firstPath = createInputFile("first", { "taskA", "taskB", "taskC" });
+  auto secondPath = createInputFile("second", { "taskD", "taskE" });
+
+  // taskC is not requested, taskX exists in no file
+  RootFileSource source(firstPath + "," + secondPath, { "taskA", "taskB", "taskD", "taskE", "taskX" });
+  initialize(source);
+
+  // one collection per invocation, the keys of both files are interleaved
+  std::vector<std::string> readNames;
+  while (auto collection = source.readNext()) {
+    readNames.emplace_back(collection->GetName());
+    BOOST_REQUIRE_EQUAL(collection->GetEntries(), 1);
+    auto mo = dynamic_cast<MonitorObject*>(collection->At(0));
+    BOOST_REQUIRE(mo != nullptr);
+    BOOST_CHECK_EQUAL(mo->getTaskName(), collection->GetName());
+    BOOST_REQUIRE(mo->getObject() != nullptr);
+    BOOST_CHECK_EQUAL(dynamic_cast<TH1*>(mo->getObject())->GetEntries(), 1);
+  }
+  std::vector<std::string> expectedNames{ "taskA", "taskD", "taskB", "taskE" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(readNames.begin(), readNames.end(), expectedNames.begin(), expectedNames.end());
+  // once all the collections are returned, there is nothing more to read
+  BOOST_CHECK(source.readNext() == nullptr);
+
+  std::filesystem::remove(firstPath);
+  std::filesystem::remove(secondPath);
+}
+
+BOOST_AUTO_TEST_CASE(test_all_tasks)
+{
+  auto path = createInputFile("all", { "taskA", "taskB", "taskC" });
+
+  RootFileSource source(path);
+  initialize(source);
+  size_t collections = 0;
+  while (source.readNext() != nullptr) {
+    collections++;
+  }
+  BOOST_CHECK_EQUAL(collections, 3);
+
+  std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(test_missing_file)
+{
+  RootFileSource source("/nonexistent/testRootFileSource.root");
+  BOOST_CHECK_THROW(initialize(source), std::runtime_error);
+}
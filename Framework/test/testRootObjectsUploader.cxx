@@ -0,0 +1,130 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testRootObjectsUploader.cxx
+///
+
+#include "RootObjectsUploader.h"
+#include "LocalCcdbServer.h"
+#include "QualityControl/CcdbDatabase.h"
+
+#define BOOST_TEST_MODULE RootObjectsUploader test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <TFile.h>
+#include <TH1F.h>
+#include <filesystem>
+#include <unistd.h>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+namespace
+{
+// 5 histograms at the top level and 2 in a directory
+std::string createInputFile()
+{
+  auto path = (std::filesystem::temp_directory_path() / ("testRootObjectsUploader_" + std::to_string(getpid()) + ".root")).string();
+  TFile file(path.c_str(), "RECREATE");
+  for (int i = 0; i < 5; i++) {
+    TH1F histo(("histo" + std::to_string(i)).c_str(), "histo", 10, 0, 10);
+    histo.Fill(i);
+    histo.Write();
+  }
+  auto directory = file.mkdir("dir");
+  directory->cd();
+  for (int i = 5; i < 7; i++) {
+    TH1F histo(("histo" + std::to_string(i)).c_str(), "histo", 10, 0, 10);
+    histo.Write();
+  }
+  file.Close();
+  return path;
+}
+
+RootObjectsUploader::Config createConfig(const std::string& inputFilePath, const std::string& url)
+{
+  RootObjectsUploader::Config config;
+  config.inputFilePath = inputFilePath;
+  config.qcdbUrl = url;
+  config.taskName = "task";
+  config.validityStart = CcdbDatabase::getCurrentTimestamp();
+  config.validityEnd = config.validityStart + 1000 * 60;
+  config.clients = 3;
+  config.queueSize = 2;
+  config.progressPeriod = 0.01;
+  config.preserveDirectories = true;
+  return config;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_upload)
+{
+  auto inputFilePath = createInputFile();
+  LocalCcdbServer server;
+
+  RootObjectsUploader uploader(createConfig(inputFilePath, server.getUrl()));
+  auto result = uploader.run();
+  BOOST_CHECK_EQUAL(result.objectsRead, 7);
+  BOOST_CHECK_EQUAL(result.objectsUploaded, 7);
+  BOOST_CHECK_EQUAL(result.objectsFailed, 0);
+  BOOST_CHECK_EQUAL(result.retries, 0);
+
+  CcdbDatabase database;
+  database.connect(server.getUrl(), "", "", "");
+  auto mo = database.retrieveMO("TST/MO/task", "histo3");
+  BOOST_REQUIRE(mo != nullptr);
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1*>(mo->getObject())->GetEntries(), 1);
+  BOOST_CHECK(database.retrieveMO("TST/MO/task", "dir/histo6") != nullptr);
+
+  std::filesystem::remove(inputFilePath);
+}
+
+BOOST_AUTO_TEST_CASE(test_upload_failure)
+{
+  auto inputFilePath = createInputFile();
+  std::string url;
+  {
+    // nothing listens there anymore
+    LocalCcdbServer server;
+    url = server.getUrl();
+  }
+
+  auto config = createConfig(inputFilePath, url);
+  config.maxRetries = 2;
+  config.retryDelay = 0.001;
+  RootObjectsUploader uploader(config);
+  auto result = uploader.run();
+  BOOST_CHECK_EQUAL(result.objectsRead, 7);
+  BOOST_CHECK_EQUAL(result.objectsUploaded, 0);
+  BOOST_CHECK_EQUAL(result.objectsFailed, 7);
+  BOOST_CHECK_EQUAL(result.retries, 14);
+
+  std::filesystem::remove(inputFilePath);
+}
+
+BOOST_AUTO_TEST_CASE(test_dry_run)
+{
+  auto inputFilePath = createInputFile();
+
+  auto config = createConfig(inputFilePath, "");
+  config.dryRun = true;
+  RootObjectsUploader uploader(config);
+  auto result = uploader.run();
+  BOOST_CHECK_EQUAL(result.objectsUploaded, 7);
+  BOOST_CHECK_GT(result.serializedBytes, 0);
+
+  BOOST_CHECK_THROW(RootObjectsUploader(createConfig("/nonexistent/file.root", "")).run(), std::runtime_error);
+
+  std::filesystem::remove(inputFilePath);
+}
@@ -25,6 +25,10 @@
 #include <Framework/InitContext.h>
 #include <Framework/ConfigParamRegistry.h>
 #include <Framework/ConfigParamStore.h>
+#include <Framework/DataRef.h>
+#include <Headers/DataHeader.h>
+#include <chrono>
+#include <vector>
 
 #define BOOST_TEST_MODULE TaskRunner test
 #define BOOST_TEST_MAIN
@@ -134,3 +138,91 @@ BOOST_AUTO_TEST_CASE(test_task_good_detector_name)
 
   //  cout << "no error message" << endl;
 }
+
+BOOST_AUTO_TEST_CASE(test_cycle_end_without_data)
+{
+  using namespace std::chrono;
+  // without data, the cycle clock is checked only at the ticks of the timer input
+  const auto tick = microseconds(TaskRunner::cycleClockTickMicroseconds);
+  const auto cycleDuration = seconds(1);
+  const auto start = steady_clock::time_point{} + hours(1);
+
+  CycleClock clock;
+  clock.start(start, cycleDuration);
+  BOOST_CHECK(clock.getDeadline() == start + cycleDuration);
+
+  // the timer ticks with a phase which is not aligned with the start of the cycles
+  std::vector<steady_clock::time_point> cycleEnds;
+  for (auto now = start + milliseconds(37); now < start + seconds(10) + milliseconds(50); now += tick) {
+    if (clock.isCycleOver(now)) {
+      auto deadline = clock.getDeadline();
+      auto delay = clock.endCycle(now);
+      BOOST_CHECK(delay == now - deadline);
+      cycleEnds.push_back(now);
+    }
+  }
+
+  // each cycle ends at the first tick after its deadline and the deadlines do not drift
+  BOOST_REQUIRE_EQUAL(cycleEnds.size(), 10);
+  for (size_t i = 0; i < cycleEnds.size(); i++) {
+    auto deadline = start + (i + 1) * cycleDuration;
+    BOOST_CHECK(cycleEnds[i] >= deadline);
+    BOOST_CHECK(cycleEnds[i] < deadline + tick);
+  }
+  BOOST_CHECK(clock.getDeadline() == start + 11 * cycleDuration);
+}
+
+BOOST_AUTO_TEST_CASE(test_cycle_end_late)
+{
+  using namespace std::chrono;
+  const auto cycleDuration = seconds(10);
+  const auto start = steady_clock::time_point{} + hours(1);
+
+  CycleClock clock;
+  clock.start(start, cycleDuration);
+  BOOST_CHECK(!clock.isCycleOver(start + cycleDuration - milliseconds(1)));
+
+  // a cycle which ends late, but within a cycle, does not shift the next deadlines
+  auto now = start + cycleDuration + seconds(3);
+  BOOST_REQUIRE(clock.isCycleOver(now));
+  BOOST_CHECK(clock.endCycle(now) == seconds(3));
+  BOOST_CHECK(clock.getDeadline() == start + 2 * cycleDuration);
+
+  // a cycle which ends more than a whole cycle late restarts the clock, instead of ending the next one immediately
+  now = start + 4 * cycleDuration + seconds(5);
+  BOOST_REQUIRE(clock.isCycleOver(now));
+  BOOST_CHECK(clock.endCycle(now) == 2 * cycleDuration + seconds(5));
+  BOOST_CHECK(clock.getDeadline() == now + cycleDuration);
+  BOOST_CHECK(!clock.isCycleOver(now));
+}
+
+BOOST_AUTO_TEST_CASE(test_completion_policy)
+{
+  // the last input is the timer, as set by TaskRunnerFactory
+  DataHeader header;
+  auto completionOp = [&header](std::vector<bool> present) {
+    std::vector<DataRef> refs;
+    for (bool isPresent : present) {
+      DataRef ref;
+      ref.header = isPresent ? reinterpret_cast<const char*>(&header) : nullptr;
+      refs.push_back(ref);
+    }
+    InputSpan span([&refs](size_t input, size_t) { return refs[input]; },
+                   [](size_t) { return size_t{ 1 }; },
+                   refs.size());
+    return TaskRunner::completionPolicyCallback(span);
+  };
+
+  // nothing arrived
+  BOOST_CHECK(completionOp({}) == CompletionPolicy::CompletionOp::Wait);
+  BOOST_CHECK(completionOp({ false, false, false }) == CompletionPolicy::CompletionOp::Wait);
+  // the data inputs arrived partially, we wait for the others
+  BOOST_CHECK(completionOp({ true, false, false }) == CompletionPolicy::CompletionOp::Wait);
+  BOOST_CHECK(completionOp({ false, true, false }) == CompletionPolicy::CompletionOp::Wait);
+  // all the data inputs arrived
+  BOOST_CHECK(completionOp({ true, true, false }) == CompletionPolicy::CompletionOp::Consume);
+  // a tick of the timer is consumed at once, so that the cycle can end without data
+  BOOST_CHECK(completionOp({ false, false, true }) == CompletionPolicy::CompletionOp::Consume);
+  BOOST_CHECK(completionOp({ true, false, true }) == CompletionPolicy::CompletionOp::Consume);
+  BOOST_CHECK(completionOp({ true }) == CompletionPolicy::CompletionOp::Consume);
+}
@@ -0,0 +1,77 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testTimeslicePipeline.cxx
+///
+
+#include "QualityControl/TimeslicePipeline.h"
+
+#define BOOST_TEST_MODULE TimeslicePipeline test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace o2::quality_control::core;
+
+BOOST_AUTO_TEST_CASE(timeslice_pipeline_runs_all_jobs)
+{
+  const size_t lanes = 3;
+  TimeslicePipeline pipeline(lanes);
+  BOOST_CHECK_EQUAL(pipeline.lanes(), lanes);
+
+  std::vector<std::atomic<int>> runningInLane(lanes);
+  std::atomic<int> running = 0;
+  std::atomic<int> maxRunning = 0;
+  std::atomic<int> done = 0;
+  std::atomic<bool> laneRanTwoJobsAtOnce = false;
+
+  for (int i = 0; i < 30; i++) {
+    pipeline.push([&](size_t lane) {
+      if (runningInLane[lane]++ != 0) {
+        laneRanTwoJobsAtOnce = true;
+      }
+      int nowRunning = ++running;
+      int previousMax = maxRunning;
+      while (nowRunning > previousMax && !maxRunning.compare_exchange_weak(previousMax, nowRunning)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      running--;
+      runningInLane[lane]--;
+      done++;
+    });
+  }
+  pipeline.drain();
+
+  BOOST_CHECK_EQUAL(done, 30);
+  BOOST_CHECK(!laneRanTwoJobsAtOnce);
+  BOOST_CHECK(maxRunning <= static_cast<int>(lanes));
+  BOOST_CHECK(maxRunning > 1);
+}
+
+BOOST_AUTO_TEST_CASE(timeslice_pipeline_exception)
+{
+  TimeslicePipeline pipeline(2);
+  pipeline.push([](size_t) { throw std::runtime_error("test"); });
+  BOOST_CHECK_THROW(pipeline.drain(), std::runtime_error);
+
+  // the exception is reported once and the pipeline is still usable
+  std::atomic<int> done = 0;
+  pipeline.push([&](size_t) { done++; });
+  BOOST_CHECK_NO_THROW(pipeline.drain());
+  BOOST_CHECK_EQUAL(done, 1);
+}
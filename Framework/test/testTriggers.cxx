@@ -24,11 +24,15 @@
 #include "QualityControl/DatabaseFactory.h"
 #include "QualityControl/CcdbDatabase.h"
 #include "QualityControl/RepoPathUtils.h"
+#include "QualityControl/RepositoryWatcher.h"
+#include "LocalCcdbServer.h"
 
 #include <boost/test/unit_test.hpp>
+#include <CCDB/CcdbApi.h>
 #include <TH1F.h>
 #include <cstdlib>
 #include <chrono>
+#include <thread>
 using namespace std::chrono;
 
 using namespace o2::quality_control::postprocessing;
@@ -128,6 +132,113 @@ BOOST_AUTO_TEST_CASE(test_trigger_new_object)
   directDBAPI->truncate(fullObjectPath);
 }
 
+BOOST_AUTO_TEST_CASE(test_repository_watcher_notifications)
+{
+  // a watcher without a database URL only dispatches pushed updates
+  RepositoryWatcher watcher;
+  auto subA = watcher.subscribe("qc/TST/MO/Task/a");
+  auto subARun42 = watcher.subscribe("qc/TST/MO/Task/a", { { "RunNumber", "42" } });
+  auto subB = watcher.subscribe("qc/TST/MO/Task/b");
+
+  BOOST_CHECK(!watcher.poll(subA).has_value());
+  BOOST_CHECK(!watcher.poll(subARun42).has_value());
+  BOOST_CHECK(!watcher.poll(subB).has_value());
+
+  watcher.notify("qc/TST/MO/Task/a", { { "RunNumber", "43" } }, { "md5-1", 100 });
+  auto update = watcher.poll(subA);
+  BOOST_REQUIRE(update.has_value());
+  BOOST_CHECK_EQUAL(update->validFrom, 100u);
+  BOOST_CHECK(!watcher.poll(subA).has_value());
+  BOOST_CHECK(!watcher.poll(subARun42).has_value());
+  BOOST_CHECK(!watcher.poll(subB).has_value());
+
+  // the same object again should not be reported
+  watcher.notify("qc/TST/MO/Task/a", { { "RunNumber", "43" } }, { "md5-1", 100 });
+  BOOST_CHECK(!watcher.poll(subA).has_value());
+
+  watcher.notify("qc/TST/MO/Task/a", { { "RunNumber", "42" } }, { "md5-2", 200 });
+  BOOST_CHECK(watcher.poll(subA).has_value());
+  update = watcher.poll(subARun42);
+  BOOST_REQUIRE(update.has_value());
+  BOOST_CHECK_EQUAL(update->validFrom, 200u);
+  BOOST_CHECK(!watcher.poll(subB).has_value());
+
+  watcher.unsubscribe(subA);
+  watcher.notify("qc/TST/MO/Task/a", {}, { "md5-3", 300 });
+  BOOST_CHECK(!watcher.poll(subA).has_value());
+
+  BOOST_CHECK_EQUAL(watcher.getRequestCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_trigger_new_object_shared_watcher)
+{
+  const size_t nTriggers = 10;
+  for (size_t nPaths : { 1, 2, 5 }) {
+    LocalCcdbServer server;
+    std::vector<TriggerFcn> newObjectTriggers;
+    for (size_t i = 0; i < nTriggers; i++) {
+      newObjectTriggers.push_back(triggers::NewObject(server.getUrl(), "qcdb", "TST/MO/testTriggersSharedWatcher/object" + std::to_string(i % nPaths)));
+    }
+    auto watcher = RepositoryWatcher::getInstance(server.getUrl());
+
+    // each round of polling all the triggers should result in one request, whatever the number of watched paths
+    for (size_t round = 0; round < 3; round++) {
+      auto requestsBefore = watcher->getRequestCount();
+      auto serverRequestsBefore = server.getRequestCount();
+      for (auto& trigger : newObjectTriggers) {
+        BOOST_CHECK_EQUAL(trigger(), TriggerType::No);
+      }
+      BOOST_CHECK_EQUAL(watcher->getRequestCount() - requestsBefore, 1u);
+      BOOST_CHECK_EQUAL(server.getRequestCount() - serverRequestsBefore, 1u);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_repository_watcher_listing)
+{
+  // the stand-in returns the listings in the same format as the CCDB
+  LocalCcdbServer server;
+  CcdbDatabase database;
+  database.connect(server.getUrl(), "", "", "");
+  auto store = [&](const std::string& name, long validFrom) {
+    auto mo = std::make_shared<MonitorObject>(new TH1F(name.c_str(), name.c_str(), 10, 0, 10), "testWatcher", "class", "TST");
+    mo->setIsOwner(true);
+    database.storeMO(mo, validFrom, validFrom + 100000);
+  };
+  store("a", 1000);
+
+  RepositoryWatcher watcher(server.getUrl());
+  auto subA = watcher.subscribe("qc/TST/MO/testWatcher/a");
+  auto subB = watcher.subscribe("qc/TST/MO/testWatcher/b");
+  BOOST_CHECK(!watcher.poll(subA).has_value());
+  BOOST_CHECK(!watcher.poll(subB).has_value());
+
+  // the creation times have a millisecond precision
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  store("a", 2000);
+  store("b", 3000);
+  auto updateA = watcher.poll(subA);
+  BOOST_REQUIRE(updateA.has_value());
+  BOOST_CHECK_EQUAL(updateA->validFrom, 2000u);
+  auto updateB = watcher.poll(subB);
+  BOOST_REQUIRE(updateB.has_value());
+  BOOST_CHECK_EQUAL(updateB->validFrom, 3000u);
+
+  BOOST_CHECK(!watcher.poll(subA).has_value());
+  BOOST_CHECK(!watcher.poll(subB).has_value());
+
+  // the versions created before the If-Not-Before bound are not listed
+  auto createdNotBefore = static_cast<long>(updateA->created);
+  o2::ccdb::CcdbApi api;
+  api.init(server.getUrl());
+  auto listing = api.list("qc/TST/MO/testWatcher/.*", false, "application/json", -1, createdNotBefore);
+  BOOST_CHECK(listing.find("\"validFrom\":1000,") == std::string::npos);
+  BOOST_CHECK(listing.find("\"validFrom\":2000,") != std::string::npos);
+  BOOST_CHECK(listing.find("\"validFrom\":3000,") != std::string::npos);
+  listing = api.list("qc/TST/MO/testWatcher/.*", false, "application/json", -1, 0);
+  BOOST_CHECK(listing.find("\"validFrom\":1000,") != std::string::npos);
+}
+
 BOOST_AUTO_TEST_CASE(test_trigger_for_each_object)
 {
   // Setup and initialise objects
@@ -0,0 +1,128 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testWorkerPool.cxx
+///
+
+#include "QualityControl/WorkerPool.h"
+#include "QualityControl/ObjectsManager.h"
+
+#define BOOST_TEST_MODULE WorkerPool test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <TH1F.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::quality_control::core;
+using namespace AliceO2::Common;
+
+BOOST_AUTO_TEST_CASE(worker_pool_covers_range)
+{
+  for (size_t size : { 1, 2, 4 }) {
+    WorkerPool pool(size);
+    BOOST_CHECK_EQUAL(pool.size(), size);
+
+    for (size_t grain : { 0, 1, 7, 1000 }) {
+      std::vector<std::atomic<int>> visits(1000);
+      std::mutex workersMutex;
+      std::set<size_t> workers;
+      pool.parallelFor(
+        visits.size(), [&](size_t begin, size_t end, size_t worker) {
+          for (size_t i = begin; i < end; i++) {
+            visits[i]++;
+          }
+          std::lock_guard<std::mutex> lock(workersMutex);
+          workers.insert(worker);
+        },
+        grain);
+      for (auto& visit : visits) {
+        BOOST_CHECK_EQUAL(visit, 1);
+      }
+      BOOST_CHECK(*workers.rbegin() < size);
+    }
+  }
+
+  WorkerPool pool(3);
+  bool called = false;
+  pool.parallelFor(0, [&](size_t, size_t, size_t) { called = true; });
+  BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(worker_pool_exception)
+{
+  WorkerPool pool(4);
+  BOOST_CHECK_THROW(pool.parallelFor(
+                      100, [](size_t begin, size_t, size_t) {
+                        if (begin == 50) {
+                          throw std::runtime_error("test");
+                        }
+                      },
+                      1),
+                    std::runtime_error);
+  // the pool is still usable
+  std::atomic<size_t> sum = 0;
+  pool.parallelFor(100, [&](size_t begin, size_t end, size_t) { sum += end - begin; });
+  BOOST_CHECK_EQUAL(sum, 100);
+}
+
+BOOST_AUTO_TEST_CASE(sharded_histogram)
+{
+  ObjectsManager objectsManager("test", "TestClass", "TST", "", 0, true);
+  WorkerPool pool(4);
+  objectsManager.setNumberOfShards(pool.size());
+
+  TH1F histogram("sharded", "sharded", 100, 0, 100);
+  objectsManager.startPublishingSharded(&histogram);
+  BOOST_CHECK(objectsManager.isBeingPublished("sharded"));
+  BOOST_CHECK_EQUAL(objectsManager.getShard(&histogram, 0), &histogram);
+  BOOST_CHECK_THROW(objectsManager.getShard(&histogram, 4), ObjectNotFoundError);
+
+  TH1F notSharded("notSharded", "notSharded", 100, 0, 100);
+  BOOST_CHECK_THROW(objectsManager.getShard(&notSharded, 1), ObjectNotFoundError);
+
+  TH1F expected("expected", "expected", 100, 0, 100);
+  for (int i = 0; i < 100000; i++) {
+    expected.Fill(i % 100);
+  }
+
+  for (int cycle = 0; cycle < 2; cycle++) {
+    pool.parallelFor(100000, [&](size_t begin, size_t end, size_t worker) {
+      auto* shard = objectsManager.getShard(&histogram, worker);
+      for (size_t i = begin; i < end; i++) {
+        shard->Fill(i % 100);
+      }
+    });
+    objectsManager.mergeShards();
+
+    BOOST_CHECK_EQUAL(histogram.GetEntries(), expected.GetEntries());
+    for (int bin = 1; bin <= 100; bin++) {
+      BOOST_CHECK_EQUAL(histogram.GetBinContent(bin), expected.GetBinContent(bin));
+    }
+    BOOST_CHECK_CLOSE(histogram.GetMean(), expected.GetMean(), 1e-6);
+    histogram.Reset();
+  }
+
+  // changing the number of shards keeps the content which was not merged yet
+  objectsManager.getShard(&histogram, 3)->Fill(5);
+  objectsManager.setNumberOfShards(2);
+  BOOST_CHECK_EQUAL(histogram.GetEntries(), 1);
+  BOOST_CHECK_THROW(objectsManager.getShard(&histogram, 3), ObjectNotFoundError);
+
+  objectsManager.stopPublishing(&histogram);
+  BOOST_CHECK_THROW(objectsManager.getShard(&histogram, 1), ObjectNotFoundError);
+}
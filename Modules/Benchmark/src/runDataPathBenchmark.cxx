@@ -0,0 +1,496 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runDataPathBenchmark.cxx
+///
+/// \brief Throughput benchmark of the data path of a QC task, from the producers to the serialized MonitorObjects.
+///
+/// It runs a matrix of configurations (number of producers, payload size, number of histograms, number of bins) in one
+/// process. Producer threads generate messages with the same generator as o2-qc-run-producer, as fast as possible
+/// (or at the requested rate), a consumer thread walks their RDH pages and fills the histograms. The histograms are
+/// published with an ObjectsManager and, at the end of each cycle, its MonitorObjectCollection is serialized with ROOT
+/// as TaskRunner does for publication. The latencies of each stage are sampled and reported as percentiles, together
+/// with the achieved message, byte and object rates, in CSV or JSON.
+///
+/// It does not run a TaskInterface nor a TaskRunner, so the user code, the DPL input handling, the transport (a bounded
+/// in-memory queue stands for it) and the monitoring are not included. It shows the cost of the fill and publication
+/// path alone, comparable between machines and commits. To benchmark full tasks, use o2-qc-benchmark-tasks.sh.
+///
+
+#include "QualityControl/DataProducer.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/ObjectsManager.h"
+#include "QualityControl/Version.h"
+
+#include <Headers/RAWDataHeader.h>
+#include <TBufferFile.h>
+#include <TH1F.h>
+#include <boost/program_options.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+/// \brief Keeps a uniform sample of the recorded latencies of bounded size (reservoir sampling).
+class LatencyRecorder
+{
+ public:
+  LatencyRecorder() : LatencyRecorder(100000) {}
+  explicit LatencyRecorder(size_t capacity) : mCapacity(capacity) { mSamples.reserve(capacity); }
+
+  void record(Clock::duration duration)
+  {
+    double us = std::chrono::duration<double, std::micro>(duration).count();
+    mCount++;
+    mMax = std::max(mMax, us);
+    if (mSamples.size() < mCapacity) {
+      mSamples.push_back(us);
+    } else if (auto index = mGenerator() % mCount; index < mCapacity) {
+      mSamples[index] = us;
+    }
+  }
+
+  /// \brief Merges the reservoirs, so that the result is a uniform sample of the latencies recorded by both.
+  void merge(const LatencyRecorder& other)
+  {
+    mMax = std::max(mMax, other.mMax);
+    if (mCount + other.mCount <= mCapacity) {
+      // both reservoirs contain all their latencies
+      mSamples.insert(mSamples.end(), other.mSamples.begin(), other.mSamples.end());
+      mCount += other.mCount;
+      return;
+    }
+
+    // Each sample is drawn from one of the reservoirs with a probability proportional to the number of latencies
+    // it represents which were not drawn yet.
+    auto ours = std::move(mSamples);
+    auto theirs = other.mSamples;
+    std::shuffle(ours.begin(), ours.end(), mGenerator);
+    std::shuffle(theirs.begin(), theirs.end(), mGenerator);
+    size_t oursLeft = mCount;
+    size_t theirsLeft = other.mCount;
+    mSamples.clear();
+    mSamples.reserve(mCapacity);
+    while (mSamples.size() < mCapacity && (!ours.empty() || !theirs.empty())) {
+      bool fromOurs = theirs.empty() || (!ours.empty() && mGenerator() % (oursLeft + theirsLeft) < oursLeft);
+      auto& source = fromOurs ? ours : theirs;
+      mSamples.push_back(source.back());
+      source.pop_back();
+      (fromOurs ? oursLeft : theirsLeft)--;
+    }
+    mCount += other.mCount;
+  }
+
+  /// \brief Returns the given percentile (0-100) in microseconds.
+  double percentile(double p)
+  {
+    if (mSamples.empty()) {
+      return 0;
+    }
+    auto index = std::min(mSamples.size() - 1, static_cast<size_t>(p / 100.0 * mSamples.size()));
+    std::nth_element(mSamples.begin(), mSamples.begin() + index, mSamples.end());
+    return mSamples[index];
+  }
+
+  double max() const { return mMax; }
+
+ private:
+  size_t mCapacity;
+  size_t mCount = 0;
+  double mMax = 0;
+  std::vector<double> mSamples;
+  std::default_random_engine mGenerator;
+};
+
+struct Message {
+  std::vector<char> payload;
+  Clock::time_point produced;
+};
+
+/// \brief Transport between the producers and the consumer, bounded by the amount of queued bytes.
+/// The payloads are given back once processed and reused by the producers, so they are allocated only at the start.
+class MessageQueue
+{
+ public:
+  explicit MessageQueue(size_t maxBytes) : mMaxBytes(maxBytes) {}
+
+  bool push(Message&& message)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotFull.wait(lock, [&] { return mBytes < mMaxBytes || mClosed; });
+    if (mClosed) {
+      return false;
+    }
+    mBytes += message.payload.size();
+    mQueue.push_back(std::move(message));
+    mNotEmpty.notify_one();
+    return true;
+  }
+
+  bool pop(Message& message, Clock::duration timeout)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (!mNotEmpty.wait_for(lock, timeout, [&] { return !mQueue.empty(); })) {
+      return false;
+    }
+    message = std::move(mQueue.front());
+    mQueue.pop_front();
+    mBytes -= message.payload.size();
+    mNotFull.notify_all();
+    return true;
+  }
+
+  /// \brief Returns a payload of the given size, reusing a released one if possible.
+  std::vector<char> acquire(size_t size)
+  {
+    std::vector<char> payload;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mFreePayloads.empty()) {
+        payload = std::move(mFreePayloads.back());
+        mFreePayloads.pop_back();
+      }
+    }
+    payload.resize(size);
+    return payload;
+  }
+
+  void release(std::vector<char>&& payload)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFreePayloads.push_back(std::move(payload));
+  }
+
+  /// \brief Makes the pending and future pushes fail.
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mClosed = true;
+    mNotFull.notify_all();
+  }
+
+ private:
+  size_t mMaxBytes;
+  size_t mBytes = 0;
+  bool mClosed = false;
+  std::deque<Message> mQueue;
+  std::vector<std::vector<char>> mFreePayloads;
+  std::mutex mMutex;
+  std::condition_variable mNotEmpty;
+  std::condition_variable mNotFull;
+};
+
+struct Configuration {
+  size_t producers;
+  size_t payloadSize;
+  size_t histograms;
+  size_t bins;
+  size_t repetition;
+};
+
+struct Settings {
+  double duration;
+  double cycle;
+  double rate;
+  size_t pageSize;
+  size_t queueBytes;
+  uint32_t seed;
+};
+
+struct Result {
+  Configuration configuration;
+  double elapsed = 0;
+  uint64_t messages = 0;
+  uint64_t bytes = 0;
+  uint64_t publishedObjects = 0;
+  uint64_t publishedBytes = 0;
+  LatencyRecorder produce;
+  LatencyRecorder transport;
+  LatencyRecorder process;
+  LatencyRecorder publish;
+};
+
+/// \brief The minimum a task would do with the data: read the pages and fill the histograms with something derived
+/// from the content, so the payload has to be really accessed.
+double processPayload(const std::vector<char>& payload, size_t pageSize)
+{
+  using RDH = o2::header::RAWDataHeaderV6;
+  uint64_t sum = 0;
+  if (pageSize > sizeof(RDH)) {
+    size_t offset = 0;
+    while (offset + sizeof(RDH) <= payload.size()) {
+      RDH rdh;
+      std::memcpy(&rdh, payload.data() + offset, sizeof(RDH));
+      sum += rdh.memorySize + static_cast<unsigned char>(payload[offset + sizeof(RDH) - 1]);
+      if (rdh.offsetToNext == 0) {
+        break;
+      }
+      offset += rdh.offsetToNext;
+    }
+  } else {
+    for (size_t i = 0; i < payload.size(); i += 4096) {
+      sum += static_cast<unsigned char>(payload[i]);
+    }
+  }
+  return static_cast<double>((sum + payload.size()) % 30000);
+}
+
+Result runConfiguration(const Configuration& configuration, const Settings& settings)
+{
+  Result result{ configuration };
+  MessageQueue queue(settings.queueBytes);
+  std::atomic<bool> stop = false;
+
+  std::vector<LatencyRecorder> produceLatencies(configuration.producers);
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < configuration.producers; p++) {
+    producers.emplace_back([&, p]() {
+      PayloadGenerator generator(configuration.payloadSize, settings.pageSize, settings.seed + p);
+      const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(settings.rate > 0 ? 1.0 / settings.rate : 0.0));
+      auto next = Clock::now();
+      while (!stop) {
+        if (settings.rate > 0) {
+          std::this_thread::sleep_until(next);
+          next += period;
+        }
+        Message message{ queue.acquire(configuration.payloadSize) };
+        auto start = Clock::now();
+        generator.fill(message.payload.data(), message.payload.size());
+        message.produced = Clock::now();
+        produceLatencies[p].record(message.produced - start);
+        if (!queue.push(std::move(message))) {
+          break;
+        }
+      }
+    });
+  }
+
+  // the histograms are published as a task would do, but without service discovery
+  ObjectsManager objectsManager("benchmark", "DataPathBenchmark", "TST", "", 0, true);
+  std::vector<std::unique_ptr<TH1F>> histograms;
+  for (size_t h = 0; h < configuration.histograms; h++) {
+    auto name = "histo-" + std::to_string(h);
+    histograms.push_back(std::make_unique<TH1F>(name.c_str(), name.c_str(), configuration.bins, 0, 30000));
+    histograms.back()->SetDirectory(nullptr);
+    objectsManager.startPublishing(histograms.back().get());
+  }
+
+  // the same serialization as the snapshot of the MonitorObjectCollection in TaskRunner::publish
+  auto publish = [&]() {
+    auto start = Clock::now();
+    std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArray());
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObjectAny(array.get(), MonitorObjectCollection::Class());
+    result.publishedBytes += buffer.Length();
+    result.publishedObjects += array->GetEntries();
+    for (auto& histogram : histograms) {
+      histogram->Reset();
+    }
+    result.publish.record(Clock::now() - start);
+  };
+
+  const auto begin = Clock::now();
+  const auto end = begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settings.duration));
+  const auto cycle = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settings.cycle));
+  auto cycleEnd = begin + cycle;
+  Message message;
+  while (Clock::now() < end) {
+    if (queue.pop(message, std::chrono::milliseconds(10))) {
+      auto start = Clock::now();
+      result.transport.record(start - message.produced);
+      auto value = processPayload(message.payload, settings.pageSize);
+      for (auto& histogram : histograms) {
+        histogram->Fill(value++);
+      }
+      result.process.record(Clock::now() - start);
+      result.messages++;
+      result.bytes += message.payload.size();
+      queue.release(std::move(message.payload));
+    }
+    if (Clock::now() >= cycleEnd) {
+      publish();
+      cycleEnd += cycle;
+    }
+  }
+  publish();
+  result.elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+  stop = true;
+  queue.close();
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  for (auto& latencies : produceLatencies) {
+    result.produce.merge(latencies);
+  }
+  return result;
+}
+
+std::vector<size_t> parseList(const std::string& list)
+{
+  std::vector<std::string> items;
+  boost::split(items, list, boost::is_any_of(","));
+  std::vector<size_t> values;
+  for (const auto& item : items) {
+    if (!item.empty()) {
+      values.push_back(std::stoull(item));
+    }
+  }
+  if (values.empty()) {
+    throw std::invalid_argument("empty list of values: '" + list + "'");
+  }
+  return values;
+}
+
+const std::vector<std::string> stages = { "produce", "transport", "process", "publish" };
+
+LatencyRecorder& getStage(Result& result, const std::string& stage)
+{
+  return stage == "produce" ? result.produce : stage == "transport" ? result.transport : stage == "process" ? result.process : result.publish;
+}
+
+void printCsvHeader(std::ostream& out)
+{
+  out << "qc_version,producers,payload_size,histograms,bins,repetition,elapsed_s,messages_per_s,bytes_per_s,objects_per_s,published_bytes";
+  for (const auto& stage : stages) {
+    out << "," << stage << "_p50_us," << stage << "_p90_us," << stage << "_p99_us," << stage << "_max_us";
+  }
+  out << "\n";
+}
+
+void printCsv(std::ostream& out, Result& result)
+{
+  const auto& c = result.configuration;
+  out << Version::GetQcVersion().getString() << "," << c.producers << "," << c.payloadSize << "," << c.histograms << ","
+      << c.bins << "," << c.repetition << "," << result.elapsed << "," << result.messages / result.elapsed << ","
+      << result.bytes / result.elapsed << "," << result.publishedObjects / result.elapsed << "," << result.publishedBytes;
+  for (const auto& stage : stages) {
+    auto& latencies = getStage(result, stage);
+    out << "," << latencies.percentile(50) << "," << latencies.percentile(90) << "," << latencies.percentile(99) << ","
+        << latencies.max();
+  }
+  out << "\n";
+}
+
+void printJson(std::ostream& out, Result& result)
+{
+  const auto& c = result.configuration;
+  out << "{\"qc_version\":\"" << Version::GetQcVersion().getString() << "\",\"producers\":" << c.producers
+      << ",\"payload_size\":" << c.payloadSize << ",\"histograms\":" << c.histograms << ",\"bins\":" << c.bins
+      << ",\"repetition\":" << c.repetition << ",\"elapsed_s\":" << result.elapsed
+      << ",\"messages_per_s\":" << result.messages / result.elapsed << ",\"bytes_per_s\":" << result.bytes / result.elapsed
+      << ",\"objects_per_s\":" << result.publishedObjects / result.elapsed << ",\"published_bytes\":" << result.publishedBytes
+      << ",\"latencies_us\":{";
+  for (const auto& stage : stages) {
+    auto& latencies = getStage(result, stage);
+    out << (stage == stages.front() ? "" : ",") << "\"" << stage << "\":{\"p50\":" << latencies.percentile(50)
+        << ",\"p90\":" << latencies.percentile(90) << ",\"p99\":" << latencies.percentile(99)
+        << ",\"max\":" << latencies.max() << "}";
+  }
+  out << "}}\n";
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                                  //
+      ("help,h", "Help screen")                                                                                         //
+      ("producers", bpo::value<std::string>()->default_value("1,2,4"), "Comma-separated numbers of producers")          //
+      ("payload-sizes", bpo::value<std::string>()->default_value("256,2000,1000000"), "Comma-separated payload sizes")  //
+      ("histograms", bpo::value<std::string>()->default_value("1,100"), "Comma-separated numbers of histograms")         //
+      ("bins", bpo::value<std::string>()->default_value("10,1000"), "Comma-separated numbers of bins")                  //
+      ("repetitions", bpo::value<size_t>()->default_value(1), "Number of repetitions of each configuration")            //
+      ("duration", bpo::value<double>()->default_value(10), "Duration of each test in seconds")                         //
+      ("cycle", bpo::value<double>()->default_value(1), "Duration of the task cycle in seconds")                        //
+      ("message-rate", bpo::value<double>()->default_value(0), "Messages per second per producer (0 for no limit)")     //
+      ("page-size", bpo::value<size_t>()->default_value(8192), "Size of RDH pages (0 for no RDHs)")                     //
+      ("queue-size", bpo::value<size_t>()->default_value(256 * 1024 * 1024), "Max number of bytes in transport")        //
+      ("seed", bpo::value<uint32_t>()->default_value(0), "Seed of the payload generators")                              //
+      ("format", bpo::value<std::string>()->default_value("csv"), "Output format, csv or json")                         //
+      ("output", bpo::value<std::string>()->default_value(""), "Output file, standard output if empty");
+
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    const auto format = vm["format"].as<std::string>();
+    if (format != "csv" && format != "json") {
+      std::cerr << "Unknown output format '" << format << "', use 'csv' or 'json'." << std::endl;
+      return 1;
+    }
+    Settings settings{ vm["duration"].as<double>(), vm["cycle"].as<double>(), vm["message-rate"].as<double>(),
+                       vm["page-size"].as<size_t>(), vm["queue-size"].as<size_t>(), vm["seed"].as<uint32_t>() };
+    if (settings.duration <= 0 || settings.cycle <= 0) {
+      std::cerr << "The duration and the cycle should be positive." << std::endl;
+      return 1;
+    }
+
+    std::ofstream outputFile;
+    if (!vm["output"].as<std::string>().empty()) {
+      outputFile.open(vm["output"].as<std::string>());
+    }
+    std::ostream& out = outputFile.is_open() ? outputFile : std::cout;
+    if (format == "csv") {
+      printCsvHeader(out);
+    }
+
+    for (auto producers : parseList(vm["producers"].as<std::string>())) {
+      for (auto payloadSize : parseList(vm["payload-sizes"].as<std::string>())) {
+        for (auto histograms : parseList(vm["histograms"].as<std::string>())) {
+          for (auto bins : parseList(vm["bins"].as<std::string>())) {
+            for (size_t repetition = 0; repetition < vm["repetitions"].as<size_t>(); repetition++) {
+              std::cerr << "Running: producers " << producers << ", payload size " << payloadSize << ", histograms "
+                        << histograms << ", bins " << bins << ", repetition " << repetition << std::endl;
+              auto result = runConfiguration({ producers, payloadSize, histograms, bins, repetition }, settings);
+              format == "csv" ? printCsv(out, result) : printJson(out, result);
+              out.flush();
+            }
+          }
+        }
+      }
+    }
+  } catch (const bpo::error& ex) {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  } catch (const std::exception& ex) {
+    std::cerr << "Benchmark failed: " << ex.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
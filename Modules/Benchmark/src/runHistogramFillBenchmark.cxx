@@ -0,0 +1,170 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runHistogramFillBenchmark.cxx
+///
+/// \brief Compares the filling of ROOT histograms with TH1::Fill, TH1::FillN and the accumulators of
+/// Common/HistogramAccumulators.h, for a range of numbers of bins.
+///
+/// The time of the accumulators includes the flush into the histogram, done once per repetition as it would be once
+/// per cycle. The results are printed as CSV, with the time per value and the speedup with respect to TH1::Fill.
+///
+
+#include "Common/HistogramAccumulators.h"
+
+#include <TH1F.h>
+#include <TH2F.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::common;
+
+namespace
+{
+
+std::vector<int> parseList(const std::string& list)
+{
+  std::vector<int> values;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      values.push_back(std::stoi(item));
+    }
+  }
+  if (values.empty()) {
+    throw std::invalid_argument("empty list of values: '" + list + "'");
+  }
+  return values;
+}
+
+/// Runs the function the given number of times, returns the time per value in ns.
+template <typename Function>
+double measure(size_t repetitions, size_t values, Function&& function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repetitions; i++) {
+    function();
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return elapsed / (repetitions * values);
+}
+
+void printResult(const std::string& histogram, int bins, const std::string& method, double ns, double reference, double entries)
+{
+  std::cout << histogram << "," << bins << "," << method << "," << ns << "," << reference / ns << "," << entries << "\n";
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                           //
+      ("help,h", "Help screen")                                                                                  //
+      ("bins", bpo::value<std::string>()->default_value("10,100,1000,10000"), "Comma-separated numbers of bins") //
+      ("values", bpo::value<size_t>()->default_value(1000000), "Number of values filled per repetition")         //
+      ("repetitions", bpo::value<size_t>()->default_value(20), "Number of repetitions of each method")           //
+      ("seed", bpo::value<uint32_t>()->default_value(0), "Seed of the random values");
+
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    auto nValues = vm["values"].as<size_t>();
+    auto repetitions = vm["repetitions"].as<size_t>();
+    std::default_random_engine generator(vm["seed"].as<uint32_t>());
+    // a part of the values falls in the under- and overflow, as it usually does
+    std::normal_distribution<double> distribution(0.5, 0.25);
+    std::vector<double> xs(nValues), ys(nValues);
+    for (size_t i = 0; i < nValues; i++) {
+      xs[i] = distribution(generator);
+      ys[i] = distribution(generator);
+    }
+
+    std::cout << "histogram,bins,method,ns_per_value,speedup,entries\n";
+    for (auto bins : parseList(vm["bins"].as<std::string>())) {
+      {
+        TH1F histogram("fill", "fill", bins, 0, 1);
+        auto reference = measure(repetitions, nValues, [&]() {
+          for (auto x : xs) {
+            histogram.Fill(x);
+          }
+        });
+        printResult("TH1F", bins, "Fill", reference, reference, histogram.GetEntries());
+
+        histogram.Reset();
+        auto fillN = measure(repetitions, nValues, [&]() { histogram.FillN(nValues, xs.data(), nullptr); });
+        printResult("TH1F", bins, "FillN", fillN, reference, histogram.GetEntries());
+
+        histogram.Reset();
+        HistogramAccumulator1D accumulator(histogram);
+        auto scalar = measure(repetitions, nValues, [&]() {
+          for (auto x : xs) {
+            accumulator.fill(x);
+          }
+          accumulator.flush(histogram);
+        });
+        printResult("TH1F", bins, "accumulator", scalar, reference, histogram.GetEntries());
+
+        histogram.Reset();
+        auto bulk = measure(repetitions, nValues, [&]() {
+          accumulator.fill(gsl::span<const double>(xs));
+          accumulator.flush(histogram);
+        });
+        printResult("TH1F", bins, "accumulator_span", bulk, reference, histogram.GetEntries());
+      }
+      if (bins <= 1000) { // we do not want to allocate gigabytes for the squared number of bins
+        TH2F histogram("fill2d", "fill2d", bins, 0, 1, bins, 0, 1);
+        auto reference = measure(repetitions, nValues, [&]() {
+          for (size_t i = 0; i < nValues; i++) {
+            histogram.Fill(xs[i], ys[i]);
+          }
+        });
+        printResult("TH2F", bins, "Fill", reference, reference, histogram.GetEntries());
+
+        histogram.Reset();
+        auto fillN = measure(repetitions, nValues, [&]() { histogram.FillN(nValues, xs.data(), ys.data(), nullptr); });
+        printResult("TH2F", bins, "FillN", fillN, reference, histogram.GetEntries());
+
+        histogram.Reset();
+        HistogramAccumulator2D accumulator(histogram);
+        auto bulk = measure(repetitions, nValues, [&]() {
+          accumulator.fill(gsl::span<const double>(xs), gsl::span<const double>(ys));
+          accumulator.flush(histogram);
+        });
+        printResult("TH2F", bins, "accumulator_span", bulk, reference, histogram.GetEntries());
+      }
+    }
+  } catch (const bpo::error& ex) {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  } catch (...) {
+    std::cerr << boost::current_exception_diagnostic_information(true) << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
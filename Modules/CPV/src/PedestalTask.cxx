@@ -139,7 +139,7 @@ void PedestalTask::startOfCycle()
 
 void PedestalTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  LOG(info) << "PedestalTask::monitorData()";
+  ILOG_RATE_LIMITED(Info, Devel, 10) << "PedestalTask::monitorData()" << ENDM;
   // In this function you can access data inputs specified in the JSON config file, for example:
   //   "query": "random:ITS/RAWDATA/0"
   // which is correspondingly <binding>:<dataOrigin>/<dataDescription>/<subSpecification
@@ -63,6 +63,11 @@ void PhysicsTask::initialize(o2::framework::InitContext& /*ctx*/)
   initHistograms();
   mNEventsTotal = 0;
   loadCcdb(); // initialize ccdb.
+
+  // used when they do not come from the DPL CCDB fetcher, they are then retrieved at the start of each activity
+  declareCondition<o2::cpv::CalibParams>("CPV/Calib/Gains");
+  declareCondition<o2::cpv::BadChannelMap>("CPV/Calib/BadChannelMap");
+  declareCondition<o2::cpv::Pedestals>("CPV/Calib/Pedestals");
 }
 
 void PhysicsTask::startOfActivity(Activity& activity)
@@ -232,8 +237,7 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  // 3. Access CCDB. If it is enough to retrieve it once, do it in initialize().
-  // Remember to delete the object when the pointer goes out of scope or it is no longer needed.
+  // 3. Access CCDB. The objects retrieved directly are kept in the condition cache and refreshed when their validity ends.
 
   // !!!todo
   // we need somehow to extract timestamp from data when there are no ccdb dpl fetcher inputs available
@@ -254,6 +258,7 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
   if (checkCcdbEntries) {
     // retrieve gains
     const o2::cpv::CalibParams* gains = nullptr;
+    std::shared_ptr<const o2::cpv::CalibParams> gainsCached; // owns the object if it is retrieved from CCDB directly
     if (hasGains) {
       LOG(info) << "Retrieving CPV/Calib/Gains from DPL fetcher (i.e. internal-dpl-ccdb-backend)";
       std::decay_t<decltype(ctx.inputs().get<o2::cpv::CalibParams*>("gains"))> gainsPtr{};
@@ -261,7 +266,8 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
       gains = gainsPtr.get();
     } else {
       LOG(info) << "Retrieving CPV/Calib/Gains directly from CCDB";
-      gains = TaskInterface::retrieveConditionAny<o2::cpv::CalibParams>("CPV/Calib/Gains");
+      gainsCached = retrieveCachedCondition<o2::cpv::CalibParams>("CPV/Calib/Gains");
+      gains = gainsCached.get();
     }
     if (gains) {
       LOG(info) << "Retrieved CPV/Calib/Gains";
@@ -274,15 +280,13 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
         }
         mIntensiveHist2D[H2DGainsM2 + iMod]->setCycleNumber(mCycleNumber);
       }
-      if (!hasGains) {
-        delete gains; // delete object only if is retrieved from CCDB directly. DPL fetcher owns
-      }
     } else {
       LOG(info) << "failed to retrieve CPV/Calib/Gains";
     }
 
     // retrieve bad channel map
     const o2::cpv::BadChannelMap* bcm = nullptr;
+    std::shared_ptr<const o2::cpv::BadChannelMap> bcmCached; // owns the object if it is retrieved from CCDB directly
     if (hasBadChannelMap) {
       LOG(info) << "Retrieving CPV/Calib/BadChannelMap from DPL fetcher (i.e. internal-dpl-ccdb-backend)";
       std::decay_t<decltype(ctx.inputs().get<o2::cpv::BadChannelMap*>("badmap"))> bcmPtr{};
@@ -290,7 +294,8 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
       bcm = bcmPtr.get();
     } else {
       LOG(info) << "Retrieving CPV/Calib/BadChannelMap directly from CCDB";
-      bcm = TaskInterface::retrieveConditionAny<o2::cpv::BadChannelMap>("CPV/Calib/BadChannelMap");
+      bcmCached = retrieveCachedCondition<o2::cpv::BadChannelMap>("CPV/Calib/BadChannelMap");
+      bcm = bcmCached.get();
     }
     if (bcm) {
       LOG(info) << "Retrieved CPV/Calib/BadChannelMap";
@@ -303,15 +308,13 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
         }
         mIntensiveHist2D[H2DBadChannelMapM2 + iMod]->setCycleNumber(mCycleNumber);
       }
-      if (!hasBadChannelMap) {
-        delete bcm; // delete object only if is retrieved from CCDB directly. DPL fetcher owns
-      }
     } else {
       LOG(info) << "failed to retrieve CPV/Calib/BadChannelMap";
     }
 
     // retrieve pedestals
     const o2::cpv::Pedestals* peds = nullptr;
+    std::shared_ptr<const o2::cpv::Pedestals> pedsCached; // owns the object if it is retrieved from CCDB directly
     if (hasPedestals) {
       LOG(info) << "Retrieving CPV/Calib/Pedestals from DPL fetcher (i.e. internal-dpl-ccdb-backend)";
       std::decay_t<decltype(ctx.inputs().get<o2::cpv::Pedestals*>("peds"))> pedsPtr{};
@@ -319,7 +322,8 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
       peds = pedsPtr.get();
     } else {
       LOG(info) << "Retrieving CPV/Calib/Pedestals directly from CCDB";
-      peds = TaskInterface::retrieveConditionAny<o2::cpv::Pedestals>("CPV/Calib/Pedestals");
+      pedsCached = retrieveCachedCondition<o2::cpv::Pedestals>("CPV/Calib/Pedestals");
+      peds = pedsCached.get();
     }
     if (peds) {
       LOG(info) << "Retrieved CPV/Calib/Pedestals";
@@ -334,9 +338,6 @@ void PhysicsTask::monitorData(o2::framework::ProcessingContext& ctx)
         mIntensiveHist2D[H2DPedestalValueM2 + iMod]->setCycleNumber(mCycleNumber);
         mIntensiveHist2D[H2DPedestalSigmaM2 + iMod]->setCycleNumber(mCycleNumber);
       }
-      if (!hasPedestals) {
-        delete peds; // delete object only if is retrieved from CCDB directly. DPL fetcher owns
-      }
     } else {
       LOG(info) << "failed to retrieve CPV/Calib/Pedestals";
     }
@@ -0,0 +1,80 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ChipDescriptorTable.h
+///
+
+#ifndef QUALITYCONTROL_CHIPDESCRIPTORTABLE_H
+#define QUALITYCONTROL_CHIPDESCRIPTORTABLE_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace o2::quality_control_modules::common
+{
+
+/// \brief Read-only table of per-chip descriptors, indexed by the chip ID.
+///
+/// Detector tasks which decode the position of a chip (layer, stave, module, histogram bins...) for each digit or
+/// cluster can build such a table once and replace the arithmetic or the lookups in several arrays by a single indexed
+/// load. The descriptors must be power-of-two sized and aligned on their size, so that none of them straddles two cache
+/// lines. Tables are shared among all the tasks of a process with getShared().
+template <typename Descriptor>
+class ChipDescriptorTable
+{
+  static_assert(sizeof(Descriptor) == alignof(Descriptor) && 64 % sizeof(Descriptor) == 0,
+                "The descriptors should be aligned on their size, which should divide the cache line size");
+
+ public:
+  /// \brief Builds the table by calling builder(chipID, descriptor) for each chip.
+  template <typename Builder>
+  ChipDescriptorTable(size_t nChips, Builder&& builder) : mDescriptors(nChips)
+  {
+    for (size_t chipID = 0; chipID < nChips; chipID++) {
+      builder(chipID, mDescriptors[chipID]);
+    }
+  }
+
+  const Descriptor& operator[](size_t chipID) const { return mDescriptors[chipID]; }
+  size_t size() const { return mDescriptors.size(); }
+  const Descriptor* data() const { return mDescriptors.data(); }
+
+  /// \brief Returns the table registered under the given key (e.g. the geometry name), building it if needed.
+  ///
+  /// The table is kept alive as long as one of its users is, and it is built again if all of them are gone.
+  template <typename Builder>
+  static std::shared_ptr<const ChipDescriptorTable> getShared(const std::string& key, size_t nChips, Builder&& builder)
+  {
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<const ChipDescriptorTable>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto& entry = registry[key];
+    auto table = entry.lock();
+    if (!table) {
+      table = std::make_shared<const ChipDescriptorTable>(nChips, std::forward<Builder>(builder));
+      entry = table;
+    }
+    return table;
+  }
+
+ private:
+  std::vector<Descriptor> mDescriptors;
+};
+
+} // namespace o2::quality_control_modules::common
+
+#endif // QUALITYCONTROL_CHIPDESCRIPTORTABLE_H
@@ -0,0 +1,660 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramAccumulators.h
+///
+/// \brief Accumulators which collect the fills of fixed-binning histograms without ROOT and add them to the published
+/// histograms in one go.
+///
+/// TH1::Fill is a virtual call which searches the bin, updates the statistics and possibly the errors each time, in a
+/// way that cannot be vectorized nor parallelized. Tasks which fill histograms in their innermost loop can instead
+/// fill an accumulator with the same binning, possibly with a whole span of values at a time, and call flush() in
+/// endOfCycle. The published histogram then has the same contents, errors, entries and statistics as if it had been
+/// filled directly. The accumulators are not thread safe, but they are cheap: each thread can fill its own instance,
+/// and the instances are combined with merge() before the flush. As with the default TH1::StatOverflows setting, the
+/// under- and overflows are not included in the statistics. Histograms with variable bins or extendable axes are not
+/// supported.
+///
+/// Example:
+///   HistogramAccumulator1D mAmplitudeAccumulator{ *mAmplitude }; // same binning as the TH1F
+///   ...
+///   mAmplitudeAccumulator.fill(gsl::span<const float>(amplitudes)); // in monitorData
+///   ...
+///   mAmplitudeAccumulator.flush(*mAmplitude); // in endOfCycle
+///
+
+#ifndef QUALITYCONTROL_HISTOGRAMACCUMULATORS_H
+#define QUALITYCONTROL_HISTOGRAMACCUMULATORS_H
+
+#include <TAxis.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TProfile.h>
+#include <gsl/span>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace o2::quality_control_modules::common
+{
+
+/// \brief Uniform binning of an axis, with the underflow in the bin 0 and the overflow in the bin nBins + 1.
+struct FixedBinning {
+  int nBins = 1;
+  double min = 0;
+  double max = 1;
+
+  FixedBinning() = default;
+  FixedBinning(int nBins, double min, double max) : nBins(nBins), min(min), max(max)
+  {
+    if (nBins <= 0 || !(min < max)) {
+      throw std::invalid_argument("Invalid binning: " + std::to_string(nBins) + " bins in [" + std::to_string(min) + ", " + std::to_string(max) + ")");
+    }
+  }
+  /// \brief Takes the binning of a ROOT axis, which must not have variable bins nor be extendable.
+  explicit FixedBinning(const TAxis& axis) : FixedBinning(axis.GetNbins(), axis.GetXmin(), axis.GetXmax())
+  {
+    if (axis.IsVariableBinSize()) {
+      throw std::invalid_argument(std::string("The axis '") + axis.GetName() + "' has variable bins, which are not supported");
+    }
+    if (axis.CanExtend()) {
+      throw std::invalid_argument(std::string("The axis '") + axis.GetName() + "' can be extended, which is not supported");
+    }
+  }
+
+  /// \brief Returns the same bin as TAxis::FindFixBin, without branches, so that loops over it can be vectorized.
+  int findBin(double x) const
+  {
+    // the position is clamped before the conversion, which is undefined for values which do not fit an int
+    double position = nBins * (x - min) / (max - min);
+    position = std::max(0.0, std::min(position, static_cast<double>(nBins)));
+    int inside = 1 + static_cast<int>(position);
+    return x < min ? 0 : (x < max ? inside : nBins + 1);
+  }
+  bool isInRange(int bin) const { return bin >= 1 && bin <= nBins; }
+
+  bool operator==(const FixedBinning& other) const { return nBins == other.nBins && min == other.min && max == other.max; }
+  bool operator!=(const FixedBinning& other) const { return !(*this == other); }
+};
+
+namespace accumulators_details
+{
+/// Values are binned by chunks of this size: the bins are computed in a vectorizable loop, then the bins are updated.
+constexpr size_t ChunkSize = 256;
+
+inline void checkBinning(const FixedBinning& expected, const TAxis& axis, const char* histogram)
+{
+  if (axis.IsVariableBinSize() || expected != FixedBinning(axis.GetNbins(), axis.GetXmin(), axis.GetXmax())) {
+    throw std::invalid_argument(std::string("The binning of the histogram '") + histogram + "' differs from the one of the accumulator");
+  }
+  // the histogram would move the fills outside of the range to new bins, the accumulator puts them in the overflows
+  if (axis.CanExtend()) {
+    throw std::invalid_argument(std::string("The histogram '") + histogram + "' can extend its axes, which is not supported");
+  }
+}
+
+inline void add(std::vector<double>& to, const std::vector<double>& from)
+{
+  for (size_t i = 0; i < to.size(); i++) {
+    to[i] += from[i];
+  }
+}
+
+/// ROOT creates the sum of squares of weights at the first fill with a weight different from 1, we do the same.
+inline bool needsSumw2(const TH1& histogram, bool weighted)
+{
+  return weighted && histogram.GetSumw2N() == 0 && !histogram.TestBit(TH1::kIsNotW);
+}
+} // namespace accumulators_details
+
+/// \brief Accumulates the fills of a TH1 with fixed bins.
+class HistogramAccumulator1D
+{
+ public:
+  HistogramAccumulator1D(int nBins, double min, double max) : HistogramAccumulator1D(FixedBinning(nBins, min, max)) {}
+  explicit HistogramAccumulator1D(const FixedBinning& binning) : mBinning(binning), mSumw(binning.nBins + 2, 0.0) {}
+  /// \brief Takes the binning of the histogram, which it does not modify.
+  explicit HistogramAccumulator1D(const TH1& histogram) : HistogramAccumulator1D(FixedBinning(*histogram.GetXaxis())) {}
+
+  void fill(double x)
+  {
+    int bin = mBinning.findBin(x);
+    mSumw[bin] += 1;
+    if (!mSumw2.empty()) {
+      mSumw2[bin] += 1;
+    }
+    mEntries += 1;
+    if (mBinning.isInRange(bin)) {
+      addStats(1, x);
+    }
+  }
+
+  void fill(double x, double w)
+  {
+    if (w != 1.0) {
+      enableSumw2();
+    }
+    int bin = mBinning.findBin(x);
+    mSumw[bin] += w;
+    if (!mSumw2.empty()) {
+      mSumw2[bin] += w * w;
+    }
+    mEntries += 1;
+    if (mBinning.isInRange(bin)) {
+      addStats(w, x);
+    }
+  }
+
+  /// \brief Fills each of the values with the weight 1.
+  template <typename T>
+  void fill(gsl::span<const T> xs)
+  {
+    std::array<int, accumulators_details::ChunkSize> bins;
+    for (size_t first = 0; first < xs.size(); first += bins.size()) {
+      size_t n = std::min(bins.size(), xs.size() - first);
+      const T* x = xs.data() + first;
+      for (size_t i = 0; i < n; i++) {
+        bins[i] = mBinning.findBin(x[i]);
+      }
+      for (size_t i = 0; i < n; i++) {
+        mSumw[bins[i]] += 1;
+      }
+      if (!mSumw2.empty()) {
+        for (size_t i = 0; i < n; i++) {
+          mSumw2[bins[i]] += 1;
+        }
+      }
+      for (size_t i = 0; i < n; i++) {
+        bool inRange = mBinning.isInRange(bins[i]);
+        double xi = inRange ? static_cast<double>(x[i]) : 0.0;
+        mStats[0] += inRange ? 1.0 : 0.0;
+        mStats[1] += inRange ? 1.0 : 0.0;
+        mStats[2] += xi;
+        mStats[3] += xi * xi;
+      }
+    }
+    mEntries += xs.size();
+  }
+
+  /// \brief Fills each of the values with the corresponding weight.
+  template <typename T, typename W>
+  void fill(gsl::span<const T> xs, gsl::span<const W> ws)
+  {
+    if (xs.size() != ws.size()) {
+      throw std::invalid_argument("The numbers of values and weights differ");
+    }
+    if (std::any_of(ws.begin(), ws.end(), [](W w) { return w != 1; })) {
+      enableSumw2();
+    }
+    std::array<int, accumulators_details::ChunkSize> bins;
+    for (size_t first = 0; first < xs.size(); first += bins.size()) {
+      size_t n = std::min(bins.size(), xs.size() - first);
+      const T* x = xs.data() + first;
+      const W* w = ws.data() + first;
+      for (size_t i = 0; i < n; i++) {
+        bins[i] = mBinning.findBin(x[i]);
+      }
+      for (size_t i = 0; i < n; i++) {
+        mSumw[bins[i]] += w[i];
+      }
+      if (!mSumw2.empty()) {
+        for (size_t i = 0; i < n; i++) {
+          mSumw2[bins[i]] += static_cast<double>(w[i]) * w[i];
+        }
+      }
+      for (size_t i = 0; i < n; i++) {
+        bool inRange = mBinning.isInRange(bins[i]);
+        double wi = inRange ? static_cast<double>(w[i]) : 0.0;
+        double xi = inRange ? static_cast<double>(x[i]) : 0.0;
+        mStats[0] += wi;
+        mStats[1] += wi * wi;
+        mStats[2] += wi * xi;
+        mStats[3] += wi * xi * xi;
+      }
+    }
+    mEntries += xs.size();
+  }
+
+  /// \brief Adds the fills of another accumulator with the same binning, e.g. the one of another thread.
+  void merge(const HistogramAccumulator1D& other)
+  {
+    if (mBinning != other.mBinning) {
+      throw std::invalid_argument("Cannot merge accumulators with different binnings");
+    }
+    if (!other.mSumw2.empty()) {
+      enableSumw2();
+    }
+    if (!mSumw2.empty()) {
+      accumulators_details::add(mSumw2, other.mSumw2.empty() ? other.mSumw : other.mSumw2);
+    }
+    accumulators_details::add(mSumw, other.mSumw);
+    for (size_t i = 0; i < mStats.size(); i++) {
+      mStats[i] += other.mStats[i];
+    }
+    mEntries += other.mEntries;
+  }
+
+  /// \brief Adds the accumulated fills to the histogram and resets the accumulator.
+  ///
+  /// The histogram must have the same binning. It may already contain entries, e.g. the ones of the previous cycles.
+  void flush(TH1& histogram)
+  {
+    accumulators_details::checkBinning(mBinning, *histogram.GetXaxis(), histogram.GetName());
+    if (accumulators_details::needsSumw2(histogram, !mSumw2.empty())) {
+      histogram.Sumw2();
+    }
+    // the statistics are taken before the contents change, ROOT might otherwise recompute them from the new contents
+    double stats[TH1::kNstat] = { 0 };
+    histogram.GetStats(stats);
+    auto entries = histogram.GetEntries();
+
+    for (int bin = 0; bin < static_cast<int>(mSumw.size()); bin++) {
+      if (mSumw[bin] != 0) {
+        histogram.AddBinContent(bin, mSumw[bin]);
+      }
+    }
+    if (histogram.GetSumw2N() > 0) {
+      auto* sumw2 = histogram.GetSumw2()->GetArray();
+      const auto& ourSumw2 = mSumw2.empty() ? mSumw : mSumw2;
+      for (size_t bin = 0; bin < ourSumw2.size(); bin++) {
+        sumw2[bin] += ourSumw2[bin];
+      }
+    }
+    for (size_t i = 0; i < mStats.size(); i++) {
+      stats[i] += mStats[i];
+    }
+    histogram.PutStats(stats);
+    histogram.SetEntries(entries + mEntries);
+
+    reset();
+  }
+
+  void reset()
+  {
+    std::fill(mSumw.begin(), mSumw.end(), 0.0);
+    mSumw2.clear();
+    mStats.fill(0.0);
+    mEntries = 0;
+  }
+
+  const FixedBinning& getBinning() const { return mBinning; }
+  double getBinContent(int bin) const { return mSumw[bin]; }
+  double getEntries() const { return mEntries; }
+  /// \brief Returns the sum of weights, the sum of squared weights, the sum of w*x and of w*x^2, as in TH1::GetStats.
+  const std::array<double, 4>& getStats() const { return mStats; }
+
+ private:
+  void addStats(double w, double x)
+  {
+    mStats[0] += w;
+    mStats[1] += w * w;
+    mStats[2] += w * x;
+    mStats[3] += w * x * x;
+  }
+  void enableSumw2()
+  {
+    if (mSumw2.empty()) {
+      mSumw2 = mSumw; // all the previous fills had the weight 1
+    }
+  }
+
+  FixedBinning mBinning;
+  std::vector<double> mSumw;
+  std::vector<double> mSumw2; // empty as long as all the weights are 1, then the sum of weights is used instead
+  std::array<double, 4> mStats = { 0 };
+  double mEntries = 0;
+};
+
+/// \brief Accumulates the fills of a TH2 with fixed bins.
+class HistogramAccumulator2D
+{
+ public:
+  HistogramAccumulator2D(int nBinsX, double minX, double maxX, int nBinsY, double minY, double maxY)
+    : HistogramAccumulator2D(FixedBinning(nBinsX, minX, maxX), FixedBinning(nBinsY, minY, maxY)) {}
+  HistogramAccumulator2D(const FixedBinning& binningX, const FixedBinning& binningY)
+    : mBinningX(binningX), mBinningY(binningY), mSumw((binningX.nBins + 2) * (binningY.nBins + 2), 0.0) {}
+  explicit HistogramAccumulator2D(const TH2& histogram)
+    : HistogramAccumulator2D(FixedBinning(*histogram.GetXaxis()), FixedBinning(*histogram.GetYaxis())) {}
+
+  void fill(double x, double y) { fill(x, y, 1.0); }
+
+  void fill(double x, double y, double w)
+  {
+    if (w != 1.0) {
+      enableSumw2();
+    }
+    int binX = mBinningX.findBin(x);
+    int binY = mBinningY.findBin(y);
+    int bin = getBin(binX, binY);
+    mSumw[bin] += w;
+    if (!mSumw2.empty()) {
+      mSumw2[bin] += w * w;
+    }
+    mEntries += 1;
+    if (mBinningX.isInRange(binX) && mBinningY.isInRange(binY)) {
+      addStats(w, x, y);
+    }
+  }
+
+  /// \brief Fills each pair of values with the weight 1.
+  template <typename T>
+  void fill(gsl::span<const T> xs, gsl::span<const T> ys)
+  {
+    if (xs.size() != ys.size()) {
+      throw std::invalid_argument("The numbers of x and y values differ");
+    }
+    std::array<int, accumulators_details::ChunkSize> bins;
+    std::array<bool, accumulators_details::ChunkSize> inRange;
+    for (size_t first = 0; first < xs.size(); first += bins.size()) {
+      size_t n = std::min(bins.size(), xs.size() - first);
+      const T* x = xs.data() + first;
+      const T* y = ys.data() + first;
+      for (size_t i = 0; i < n; i++) {
+        int binX = mBinningX.findBin(x[i]);
+        int binY = mBinningY.findBin(y[i]);
+        bins[i] = getBin(binX, binY);
+        inRange[i] = mBinningX.isInRange(binX) && mBinningY.isInRange(binY);
+      }
+      for (size_t i = 0; i < n; i++) {
+        mSumw[bins[i]] += 1;
+      }
+      if (!mSumw2.empty()) {
+        for (size_t i = 0; i < n; i++) {
+          mSumw2[bins[i]] += 1;
+        }
+      }
+      for (size_t i = 0; i < n; i++) {
+        double xi = inRange[i] ? static_cast<double>(x[i]) : 0.0;
+        double yi = inRange[i] ? static_cast<double>(y[i]) : 0.0;
+        addStats(inRange[i] ? 1.0 : 0.0, xi, yi);
+      }
+    }
+    mEntries += xs.size();
+  }
+
+  void merge(const HistogramAccumulator2D& other)
+  {
+    if (mBinningX != other.mBinningX || mBinningY != other.mBinningY) {
+      throw std::invalid_argument("Cannot merge accumulators with different binnings");
+    }
+    if (!other.mSumw2.empty()) {
+      enableSumw2();
+    }
+    if (!mSumw2.empty()) {
+      accumulators_details::add(mSumw2, other.mSumw2.empty() ? other.mSumw : other.mSumw2);
+    }
+    accumulators_details::add(mSumw, other.mSumw);
+    for (size_t i = 0; i < mStats.size(); i++) {
+      mStats[i] += other.mStats[i];
+    }
+    mEntries += other.mEntries;
+  }
+
+  /// \brief Adds the accumulated fills to the histogram and resets the accumulator.
+  void flush(TH2& histogram)
+  {
+    accumulators_details::checkBinning(mBinningX, *histogram.GetXaxis(), histogram.GetName());
+    accumulators_details::checkBinning(mBinningY, *histogram.GetYaxis(), histogram.GetName());
+    if (accumulators_details::needsSumw2(histogram, !mSumw2.empty())) {
+      histogram.Sumw2();
+    }
+    double stats[TH1::kNstat] = { 0 };
+    histogram.GetStats(stats);
+    auto entries = histogram.GetEntries();
+
+    for (int bin = 0; bin < static_cast<int>(mSumw.size()); bin++) {
+      if (mSumw[bin] != 0) {
+        histogram.AddBinContent(bin, mSumw[bin]);
+      }
+    }
+    if (histogram.GetSumw2N() > 0) {
+      auto* sumw2 = histogram.GetSumw2()->GetArray();
+      const auto& ourSumw2 = mSumw2.empty() ? mSumw : mSumw2;
+      for (size_t bin = 0; bin < ourSumw2.size(); bin++) {
+        sumw2[bin] += ourSumw2[bin];
+      }
+    }
+    for (size_t i = 0; i < mStats.size(); i++) {
+      stats[i] += mStats[i];
+    }
+    histogram.PutStats(stats);
+    histogram.SetEntries(entries + mEntries);
+
+    reset();
+  }
+
+  void reset()
+  {
+    std::fill(mSumw.begin(), mSumw.end(), 0.0);
+    mSumw2.clear();
+    mStats.fill(0.0);
+    mEntries = 0;
+  }
+
+  /// \brief Returns the global bin, as TH1::GetBin.
+  int getBin(int binX, int binY) const { return binX + (mBinningX.nBins + 2) * binY; }
+  double getBinContent(int binX, int binY) const { return mSumw[getBin(binX, binY)]; }
+  double getEntries() const { return mEntries; }
+  /// \brief Returns the statistics in the order of TH2::GetStats.
+  const std::array<double, 7>& getStats() const { return mStats; }
+
+ private:
+  void addStats(double w, double x, double y)
+  {
+    mStats[0] += w;
+    mStats[1] += w * w;
+    mStats[2] += w * x;
+    mStats[3] += w * x * x;
+    mStats[4] += w * y;
+    mStats[5] += w * y * y;
+    mStats[6] += w * x * y;
+  }
+  void enableSumw2()
+  {
+    if (mSumw2.empty()) {
+      mSumw2 = mSumw;
+    }
+  }
+
+  FixedBinning mBinningX;
+  FixedBinning mBinningY;
+  std::vector<double> mSumw;
+  std::vector<double> mSumw2; // empty as long as all the weights are 1
+  std::array<double, 7> mStats = { 0 };
+  double mEntries = 0;
+};
+
+/// \brief Accumulates the fills of a TProfile with fixed bins.
+///
+/// As for the TProfile, the values of y outside of [minY, maxY] are ignored if minY < maxY.
+class ProfileAccumulator
+{
+ public:
+  ProfileAccumulator(int nBins, double min, double max, double minY = 0, double maxY = 0)
+    : ProfileAccumulator(FixedBinning(nBins, min, max), minY, maxY) {}
+  explicit ProfileAccumulator(const FixedBinning& binning, double minY = 0, double maxY = 0)
+    : mBinning(binning), mMinY(minY), mMaxY(maxY), mSumw(binning.nBins + 2, 0.0), mSumwy(binning.nBins + 2, 0.0), mSumwy2(binning.nBins + 2, 0.0) {}
+  explicit ProfileAccumulator(const TProfile& profile)
+    : ProfileAccumulator(FixedBinning(*profile.GetXaxis()), profile.GetYmin(), profile.GetYmax()) {}
+
+  void fill(double x, double y) { fill(x, y, 1.0); }
+
+  void fill(double x, double y, double w)
+  {
+    if (!isAccepted(y)) {
+      return;
+    }
+    if (w != 1.0) {
+      enableSumw2();
+    }
+    int bin = mBinning.findBin(x);
+    mSumw[bin] += w;
+    mSumwy[bin] += w * y;
+    mSumwy2[bin] += w * y * y;
+    if (!mSumw2.empty()) {
+      mSumw2[bin] += w * w;
+    }
+    mEntries += 1;
+    if (mBinning.isInRange(bin)) {
+      addStats(w, x, y);
+    }
+  }
+
+  /// \brief Fills each pair of values with the weight 1.
+  template <typename T>
+  void fill(gsl::span<const T> xs, gsl::span<const T> ys)
+  {
+    if (xs.size() != ys.size()) {
+      throw std::invalid_argument("The numbers of x and y values differ");
+    }
+    std::array<int, accumulators_details::ChunkSize> bins;
+    std::array<double, accumulators_details::ChunkSize> weights;
+    for (size_t first = 0; first < xs.size(); first += bins.size()) {
+      size_t n = std::min(bins.size(), xs.size() - first);
+      const T* x = xs.data() + first;
+      const T* y = ys.data() + first;
+      // the rejected values get the weight 0 instead of being skipped, but they are not counted as entries
+      for (size_t i = 0; i < n; i++) {
+        bins[i] = mBinning.findBin(x[i]);
+        weights[i] = isAccepted(y[i]) ? 1.0 : 0.0;
+      }
+      for (size_t i = 0; i < n; i++) {
+        double yi = weights[i] != 0 ? static_cast<double>(y[i]) : 0.0;
+        mSumw[bins[i]] += weights[i];
+        mSumwy[bins[i]] += yi;
+        mSumwy2[bins[i]] += yi * yi;
+      }
+      if (!mSumw2.empty()) {
+        for (size_t i = 0; i < n; i++) {
+          mSumw2[bins[i]] += weights[i];
+        }
+      }
+      for (size_t i = 0; i < n; i++) {
+        bool inRange = mBinning.isInRange(bins[i]);
+        double wi = inRange ? weights[i] : 0.0;
+        double xi = wi != 0 ? static_cast<double>(x[i]) : 0.0;
+        double yi = wi != 0 ? static_cast<double>(y[i]) : 0.0;
+        addStats(wi, xi, yi);
+        mEntries += weights[i];
+      }
+    }
+  }
+
+  void merge(const ProfileAccumulator& other)
+  {
+    if (mBinning != other.mBinning || mMinY != other.mMinY || mMaxY != other.mMaxY) {
+      throw std::invalid_argument("Cannot merge accumulators with different binnings");
+    }
+    if (!other.mSumw2.empty()) {
+      enableSumw2();
+    }
+    if (!mSumw2.empty()) {
+      accumulators_details::add(mSumw2, other.mSumw2.empty() ? other.mSumw : other.mSumw2);
+    }
+    accumulators_details::add(mSumw, other.mSumw);
+    accumulators_details::add(mSumwy, other.mSumwy);
+    accumulators_details::add(mSumwy2, other.mSumwy2);
+    for (size_t i = 0; i < mStats.size(); i++) {
+      mStats[i] += other.mStats[i];
+    }
+    mEntries += other.mEntries;
+  }
+
+  /// \brief Adds the accumulated fills to the profile and resets the accumulator.
+  void flush(TProfile& profile)
+  {
+    accumulators_details::checkBinning(mBinning, *profile.GetXaxis(), profile.GetName());
+    if (profile.GetYmin() != mMinY || profile.GetYmax() != mMaxY) {
+      throw std::invalid_argument(std::string("The y range of the profile '") + profile.GetName() + "' differs from the one of the accumulator");
+    }
+    if (!mSumw2.empty() && profile.GetBinSumw2()->GetSize() == 0 && !profile.TestBit(TH1::kIsNotW)) {
+      profile.Sumw2();
+    }
+    double stats[TH1::kNstat] = { 0 };
+    profile.GetStats(stats);
+    auto entries = profile.GetEntries();
+
+    // a TProfile keeps the sums of w*y in its contents, the sums of w*y^2 in its sumw2 and the sums of w in its entries
+    auto* sumwy = profile.GetArray();
+    auto* sumwy2 = profile.GetSumw2()->GetArray();
+    auto* binSumw2 = profile.GetBinSumw2()->GetSize() > 0 ? profile.GetBinSumw2()->GetArray() : nullptr;
+    const auto& ourSumw2 = mSumw2.empty() ? mSumw : mSumw2;
+    for (int bin = 0; bin < static_cast<int>(mSumw.size()); bin++) {
+      sumwy[bin] += mSumwy[bin];
+      sumwy2[bin] += mSumwy2[bin];
+      profile.SetBinEntries(bin, profile.GetBinEntries(bin) + mSumw[bin]);
+      if (binSumw2) {
+        binSumw2[bin] += ourSumw2[bin];
+      }
+    }
+    for (size_t i = 0; i < mStats.size(); i++) {
+      stats[i] += mStats[i];
+    }
+    profile.PutStats(stats);
+    profile.SetEntries(entries + mEntries);
+
+    reset();
+  }
+
+  void reset()
+  {
+    std::fill(mSumw.begin(), mSumw.end(), 0.0);
+    std::fill(mSumwy.begin(), mSumwy.end(), 0.0);
+    std::fill(mSumwy2.begin(), mSumwy2.end(), 0.0);
+    mSumw2.clear();
+    mStats.fill(0.0);
+    mEntries = 0;
+  }
+
+  /// \brief Returns the mean of y in the bin, as TProfile::GetBinContent.
+  double getBinContent(int bin) const { return mSumw[bin] != 0 ? mSumwy[bin] / mSumw[bin] : 0.0; }
+  double getBinEntries(int bin) const { return mSumw[bin]; }
+  double getEntries() const { return mEntries; }
+  /// \brief Returns the statistics in the order of TProfile::GetStats.
+  const std::array<double, 6>& getStats() const { return mStats; }
+
+ private:
+  bool isAccepted(double y) const { return !(mMinY < mMaxY) || (y >= mMinY && y <= mMaxY); }
+  void addStats(double w, double x, double y)
+  {
+    mStats[0] += w;
+    mStats[1] += w * w;
+    mStats[2] += w * x;
+    mStats[3] += w * x * x;
+    mStats[4] += w * y;
+    mStats[5] += w * y * y;
+  }
+  void enableSumw2()
+  {
+    if (mSumw2.empty()) {
+      mSumw2 = mSumw;
+    }
+  }
+
+  FixedBinning mBinning;
+  double mMinY;
+  double mMaxY;
+  std::vector<double> mSumw;   // sum of weights per bin, i.e. the bin entries of the profile
+  std::vector<double> mSumwy;  // sum of w*y per bin
+  std::vector<double> mSumwy2; // sum of w*y^2 per bin
+  std::vector<double> mSumw2;  // sum of w^2 per bin, empty as long as all the weights are 1
+  std::array<double, 6> mStats = { 0 };
+  double mEntries = 0;
+};
+
+} // namespace o2::quality_control_modules::common
+
+#endif // QUALITYCONTROL_HISTOGRAMACCUMULATORS_H
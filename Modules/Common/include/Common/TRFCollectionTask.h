@@ -19,7 +19,11 @@
 
 #include "QualityControl/PostProcessingInterface.h"
 #include "Common/TRFCollectionTaskConfig.h"
+#include "QualityControl/QualityObject.h"
 #include <DataFormatsQualityControl/TimeRangeFlagCollection.h>
+#include <map>
+#include <memory>
+#include <string>
 
 namespace o2::quality_control::repository
 {
@@ -51,6 +55,8 @@ class TRFCollectionTask final : public quality_control::postprocessing::PostProc
  private:
   TRFCollectionTaskConfig mConfig;
   uint64_t mLastTimestampLimitStart = 0;
+  // versions of QOs retrieved so far (QO name -> Valid-From -> QO), so the next updates retrieve only the new ones
+  std::map<std::string, std::map<long, std::shared_ptr<quality_control::core::QualityObject>>> mQualityObjectsCache;
 };
 
 } // namespace o2::quality_control_modules::common
@@ -38,6 +38,7 @@ struct TRFCollectionTaskConfig : quality_control::postprocessing::PostProcessing
   std::string periodName;
   std::string provenance;
   std::vector<std::string> qualityObjects;
+  bool incremental = false; // the collection is updated at each update trigger, retrieving only the new QO versions
 };
 
 } // namespace o2::quality_control_modules::common
@@ -34,6 +34,8 @@ class WorstOfAllAggregator : public o2::quality_control::checker::AggregatorInte
   void configure(std::string name) override;
   std::map<std::string, o2::quality_control::core::Quality>
     aggregate(o2::quality_control::core::QualityObjectsMapType& qoMap) override;
+  std::map<std::string, o2::quality_control::core::Quality>
+    aggregate(const o2::quality_control::core::QualityObjectsMapType& qoMap) override;
 
   ClassDefOverride(WorstOfAllAggregator, 1);
 
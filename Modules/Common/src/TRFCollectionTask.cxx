@@ -88,26 +88,32 @@ std::unique_ptr<quality_control::TimeRangeFlagCollection> TRFCollectionTask::tra
 
     // if available, we move one timestamp back, because 'validUntil' might cover our period.
     if (firstMatchingTimestamp != availableTimestamps.begin()) {
-
-      auto currentObjTimestamp = firstMatchingTimestamp - 1;
-      auto qo = qcdb.retrieveQO(qoPath, *currentObjTimestamp);
-      if (qo == nullptr) {
-        throw std::runtime_error("Could not retrieve a QO for timestamp '" + std::to_string(*currentObjTimestamp) + "'");
+      firstMatchingTimestamp--;
+    }
+    auto lastMatchingTimestamp = std::lower_bound(firstMatchingTimestamp, availableTimestamps.end(), timestampLimitEnd);
+
+    // only the versions which were not retrieved by a previous update are fetched, all of them at once.
+    // the cached versions before the time range will not be needed anymore.
+    auto& cachedQOs = mQualityObjectsCache[qoName];
+    cachedQOs.erase(cachedQOs.begin(), cachedQOs.lower_bound(*firstMatchingTimestamp));
+    std::vector<long> missingTimestamps;
+    for (auto timestamp = firstMatchingTimestamp; timestamp != lastMatchingTimestamp; timestamp++) {
+      if (cachedQOs.count(*timestamp) == 0 && (missingTimestamps.empty() || missingTimestamps.back() != static_cast<long>(*timestamp))) {
+        missingTimestamps.push_back(static_cast<long>(*timestamp));
       }
-      converter(*qo);
     }
-
-    // the main loop over QOs
-    for (auto currentStartTime = firstMatchingTimestamp;
-         currentStartTime != availableTimestamps.end() && *currentStartTime < timestampLimitEnd;
-         currentStartTime++) {
-
-      auto newQO = qcdb.retrieveQO(qoPath, *currentStartTime);
-      if (newQO == nullptr) {
-        throw std::runtime_error("Could not retrieve a QO for timestamp '" + std::to_string(*currentStartTime) + "'");
+    auto retrievedQOs = qcdb.retrieveQOs(qoPath, missingTimestamps);
+    for (size_t i = 0; i < missingTimestamps.size(); i++) {
+      if (retrievedQOs[i] == nullptr) {
+        throw std::runtime_error("Could not retrieve a QO for timestamp '" + std::to_string(missingTimestamps[i]) + "'");
       }
+      cachedQOs[missingTimestamps[i]] = retrievedQOs[i];
+    }
+    ILOG(Debug, Devel) << "Retrieved " << missingTimestamps.size() << " new versions of the QO '" << qoPath << "'" << ENDM;
 
-      converter(*newQO);
+    // the main loop over QOs
+    for (auto currentStartTime = firstMatchingTimestamp; currentStartTime != lastMatchingTimestamp; currentStartTime++) {
+      converter(*cachedQOs.at(*currentStartTime));
     }
 
     totalQOsIncluded += converter.getQOsIncluded();
@@ -124,9 +130,16 @@ std::unique_ptr<quality_control::TimeRangeFlagCollection> TRFCollectionTask::tra
   return mainTrfCollection;
 }
 
-void TRFCollectionTask::update(Trigger, framework::ServiceRegistry&)
+void TRFCollectionTask::update(Trigger t, framework::ServiceRegistry& services)
 {
-  throw std::runtime_error("Only two timestamps should be given to the task");
+  if (!mConfig.incremental) {
+    throw std::runtime_error("Only two timestamps should be given to the task, unless it is configured as incremental");
+  }
+
+  // the collection always starts at the initial timestamp, but only the QOs which appeared since the last update are retrieved
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+  auto trfCollection = transformQualities(qcdb, mLastTimestampLimitStart, t.timestamp);
+  qcdb.storeTRFC(std::shared_ptr<const TimeRangeFlagCollection>(trfCollection.release()));
 }
 
 void TRFCollectionTask::finalize(Trigger t, framework::ServiceRegistry& services)
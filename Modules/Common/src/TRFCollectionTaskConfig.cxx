@@ -27,6 +27,7 @@ TRFCollectionTaskConfig::TRFCollectionTaskConfig(std::string name, const boost::
   for (const auto& qoPath : config.get_child("qc.postprocessing." + name + ".QOs")) {
     qualityObjects.push_back(qoPath.second.data());
   }
+  incremental = config.get<bool>("qc.postprocessing." + name + ".incremental", false);
   runNumber = config.get<int>("qc.config.Activity.number", 0);
   passName = config.get<std::string>("qc.config.Activity.passName", "");
   periodName = config.get<std::string>("qc.config.Activity.periodName", "");
@@ -17,6 +17,8 @@
 #include "Common/WorstOfAllAggregator.h"
 #include "QualityControl/QcInfoLogger.h"
 
+#include <utility>
+
 using namespace o2::quality_control::core;
 using namespace o2::quality_control;
 
@@ -29,6 +31,11 @@ void WorstOfAllAggregator::configure(std::string name)
 }
 
 std::map<std::string, Quality> WorstOfAllAggregator::aggregate(QualityObjectsMapType& qoMap)
+{
+  return aggregate(std::as_const(qoMap));
+}
+
+std::map<std::string, Quality> WorstOfAllAggregator::aggregate(const QualityObjectsMapType& qoMap)
 {
   if (qoMap.empty()) {
     Quality null = Quality::Null;
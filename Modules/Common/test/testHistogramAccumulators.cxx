@@ -0,0 +1,204 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testHistogramAccumulators.cxx
+///
+
+#include "Common/HistogramAccumulators.h"
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TProfile.h>
+#include <TRandom3.h>
+#include <limits>
+
+#define BOOST_TEST_MODULE HistogramAccumulators test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control_modules::common;
+
+namespace
+{
+void checkSame(TH1& expected, TH1& actual)
+{
+  BOOST_REQUIRE_EQUAL(expected.GetNcells(), actual.GetNcells());
+  for (int bin = 0; bin < expected.GetNcells(); bin++) {
+    BOOST_CHECK_CLOSE(expected.GetBinContent(bin), actual.GetBinContent(bin), 1e-6);
+    BOOST_CHECK_CLOSE(expected.GetBinError(bin), actual.GetBinError(bin), 1e-6);
+  }
+  BOOST_CHECK_EQUAL(expected.GetEntries(), actual.GetEntries());
+  BOOST_CHECK_CLOSE(expected.GetMean(), actual.GetMean(), 1e-6);
+  BOOST_CHECK_CLOSE(expected.GetStdDev(), actual.GetStdDev(), 1e-6);
+  BOOST_CHECK_EQUAL(expected.GetSumw2N() > 0, actual.GetSumw2N() > 0);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_fixed_binning)
+{
+  FixedBinning binning(10, -1.0, 1.0);
+  TAxis axis(10, -1.0, 1.0);
+  for (double x : { -2.0, -1.0, -0.99, -0.2, 0.0, 0.1, 0.3, 0.7, 0.99999, 1.0, 5.0, 1e300, -1e300 }) {
+    BOOST_CHECK_EQUAL(binning.findBin(x), axis.FindFixBin(x));
+  }
+  BOOST_CHECK_EQUAL(binning.findBin(std::numeric_limits<double>::quiet_NaN()), 11);
+
+  BOOST_CHECK_THROW(FixedBinning(0, 0, 1), std::invalid_argument);
+  BOOST_CHECK_THROW(FixedBinning(10, 1, 1), std::invalid_argument);
+  double edges[] = { 0, 1, 3 };
+  TAxis variableAxis(2, edges);
+  BOOST_CHECK_THROW(FixedBinning{ variableAxis }, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_extendable_axes)
+{
+  // an extendable histogram would create new bins for the values out of its range, which the accumulators cannot do
+  TH1F extendable("extendable", "extendable", 10, 0, 10);
+  extendable.SetCanExtend(TH1::kAllAxes);
+  BOOST_CHECK_THROW(FixedBinning{ *extendable.GetXaxis() }, std::invalid_argument);
+  BOOST_CHECK_THROW(HistogramAccumulator1D{ extendable }, std::invalid_argument);
+
+  HistogramAccumulator1D accumulator(10, 0, 10);
+  accumulator.fill(20.0);
+  BOOST_CHECK_THROW(accumulator.flush(extendable), std::invalid_argument);
+  BOOST_CHECK_EQUAL(extendable.GetEntries(), 0);
+
+  TH2F extendable2D("extendable2D", "extendable2D", 10, 0, 10, 10, 0, 10);
+  extendable2D.SetCanExtend(TH1::kYaxis);
+  BOOST_CHECK_THROW(HistogramAccumulator2D{ extendable2D }, std::invalid_argument);
+  HistogramAccumulator2D accumulator2D(10, 0, 10, 10, 0, 10);
+  BOOST_CHECK_THROW(accumulator2D.flush(extendable2D), std::invalid_argument);
+
+  TProfile extendableProfile("extendableProfile", "extendableProfile", 10, 0, 10);
+  extendableProfile.SetCanExtend(TH1::kAllAxes);
+  BOOST_CHECK_THROW(ProfileAccumulator{ extendableProfile }, std::invalid_argument);
+  ProfileAccumulator profileAccumulator(10, 0, 10);
+  BOOST_CHECK_THROW(profileAccumulator.flush(extendableProfile), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_accumulator_1d)
+{
+  TRandom3 random(1);
+  std::vector<float> values(10000);
+  std::vector<double> weights(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = random.Gaus(50, 30);
+    weights[i] = random.Uniform(0.5, 2);
+  }
+
+  TH1F expected("expected", "expected", 100, 0, 100);
+  TH1F actual("actual", "actual", 100, 0, 100);
+  HistogramAccumulator1D accumulator(actual);
+
+  // the histogram may already contain the entries of the previous cycles
+  for (size_t i = 0; i < 100; i++) {
+    expected.Fill(values[i]);
+    actual.Fill(values[i]);
+  }
+  for (size_t i = 100; i < 5000; i++) {
+    expected.Fill(values[i]);
+  }
+  accumulator.fill(gsl::span<const float>(values.data() + 100, 4900));
+  accumulator.flush(actual);
+  checkSame(expected, actual);
+  BOOST_CHECK_EQUAL(accumulator.getEntries(), 0);
+
+  // weights, split between two accumulators as they would be between two threads
+  HistogramAccumulator1D other(100, 0, 100);
+  for (size_t i = 5000; i < values.size(); i++) {
+    expected.Fill(values[i], weights[i]);
+    (i % 2 ? accumulator : other).fill(values[i], weights[i]);
+  }
+  accumulator.merge(other);
+  accumulator.flush(actual);
+  checkSame(expected, actual);
+
+  TH1F wrongBinning("wrong", "wrong", 10, 0, 100);
+  BOOST_CHECK_THROW(accumulator.flush(wrongBinning), std::invalid_argument);
+  BOOST_CHECK_THROW(accumulator.merge(HistogramAccumulator1D(wrongBinning)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_accumulator_1d_bulk_weights)
+{
+  TRandom3 random(2);
+  std::vector<double> values(1000);
+  std::vector<double> weights(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = random.Uniform(-10, 110);
+    weights[i] = random.Integer(3);
+  }
+
+  TH1F expected("expected", "expected", 50, 0, 100);
+  TH1F actual("actual", "actual", 50, 0, 100);
+  expected.FillN(values.size(), values.data(), weights.data());
+  HistogramAccumulator1D accumulator(actual);
+  accumulator.fill(gsl::span<const double>(values), gsl::span<const double>(weights));
+  accumulator.flush(actual);
+  checkSame(expected, actual);
+}
+
+BOOST_AUTO_TEST_CASE(test_accumulator_2d)
+{
+  TRandom3 random(3);
+  std::vector<double> xs(10000), ys(10000);
+  for (size_t i = 0; i < xs.size(); i++) {
+    xs[i] = random.Gaus(5, 3);
+    ys[i] = random.Gaus(0, 2);
+  }
+
+  TH2F expected("expected", "expected", 10, 0, 10, 20, -5, 5);
+  TH2F actual("actual", "actual", 10, 0, 10, 20, -5, 5);
+  HistogramAccumulator2D accumulator(actual);
+  for (size_t i = 0; i < xs.size(); i++) {
+    expected.Fill(xs[i], ys[i], i < 5000 ? 1.0 : 0.5);
+  }
+  accumulator.fill(gsl::span<const double>(xs.data(), 5000), gsl::span<const double>(ys.data(), 5000));
+  for (size_t i = 5000; i < xs.size(); i++) {
+    accumulator.fill(xs[i], ys[i], 0.5);
+  }
+  accumulator.flush(actual);
+  checkSame(expected, actual);
+  BOOST_CHECK_CLOSE(expected.GetMean(2), actual.GetMean(2), 1e-6);
+  BOOST_CHECK_CLOSE(expected.GetCorrelationFactor(), actual.GetCorrelationFactor(), 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_profile_accumulator)
+{
+  TRandom3 random(4);
+  std::vector<double> xs(10000), ys(10000);
+  for (size_t i = 0; i < xs.size(); i++) {
+    xs[i] = random.Uniform(-1, 11);
+    ys[i] = xs[i] + random.Gaus(0, 1);
+  }
+
+  for (auto [minY, maxY] : { std::pair{ 0.0, 0.0 }, std::pair{ 0.0, 8.0 } }) {
+    TProfile expected("expected", "expected", 10, 0, 10, minY, maxY);
+    TProfile actual("actual", "actual", 10, 0, 10, minY, maxY);
+    ProfileAccumulator accumulator(actual);
+    for (size_t i = 0; i < xs.size(); i++) {
+      expected.Fill(xs[i], ys[i], i < 5000 ? 1.0 : 2.0);
+    }
+    accumulator.fill(gsl::span<const double>(xs.data(), 5000), gsl::span<const double>(ys.data(), 5000));
+    for (size_t i = 5000; i < xs.size(); i++) {
+      accumulator.fill(xs[i], ys[i], 2.0);
+    }
+    accumulator.flush(actual);
+
+    checkSame(expected, actual);
+    for (int bin = 0; bin < expected.GetNcells(); bin++) {
+      BOOST_CHECK_CLOSE(expected.GetBinEntries(bin), actual.GetBinEntries(bin), 1e-6);
+      BOOST_CHECK_CLOSE(expected.GetBinEffectiveEntries(bin), actual.GetBinEffectiveEntries(bin), 1e-6);
+    }
+    BOOST_CHECK_CLOSE(expected.GetMean(2), actual.GetMean(2), 1e-6);
+  }
+}
@@ -0,0 +1,126 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testTRFCollectionTask.cxx
+///
+
+#include "Common/TRFCollectionTask.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/QualityObject.h"
+#include "QualityControl/Triggers.h"
+#include "LocalCcdbServer.h"
+
+#include <DataFormatsQualityControl/TimeRangeFlagCollection.h>
+#include <DataFormatsQualityControl/FlagReasons.h>
+#include <Framework/ServiceRegistry.h>
+#include <boost/property_tree/ptree.hpp>
+
+#define BOOST_TEST_MODULE TRFCollectionTask test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::postprocessing;
+using namespace o2::quality_control::repository;
+using namespace o2::quality_control;
+
+namespace o2::quality_control_modules::common
+{
+
+namespace
+{
+// remembers the versions of the QOs requested by each call to retrieveQOs
+class RecordingDatabase : public CcdbDatabase
+{
+ public:
+  std::vector<std::shared_ptr<QualityObject>> retrieveQOs(const std::string& qoPath, const std::vector<long>& timestamps, const Activity& activity) override
+  {
+    requestedTimestamps.push_back(timestamps);
+    return CcdbDatabase::retrieveQOs(qoPath, timestamps, activity);
+  }
+
+  std::vector<std::vector<long>> requestedTimestamps;
+};
+
+void storeQO(DatabaseInterface& database, Quality quality, long from, long to)
+{
+  auto qo = std::make_shared<QualityObject>(quality, "testTRFCollectionTaskCheck", "TST");
+  database.storeQO(qo, from, to);
+}
+
+bool containsFlag(const TimeRangeFlagCollection& trfc, uint64_t start, uint64_t end, const FlagReason& flag)
+{
+  return std::any_of(trfc.begin(), trfc.end(), [&](const TimeRangeFlag& trf) {
+    return trf.getStart() == start && trf.getEnd() == end && trf.getFlag() == flag;
+  });
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_incremental_updates)
+{
+  LocalCcdbServer server;
+  RecordingDatabase database;
+  database.connect({ { "host", server.getUrl() }, { "maxConcurrentRequests", "3" } });
+
+  const std::string taskName = "TestTRFCollectionTask";
+  boost::property_tree::ptree config;
+  config.put("qc.config.database.implementation", "CCDB");
+  config.put("qc.config.database.host", server.getUrl());
+  const std::string prefix = "qc.postprocessing." + taskName;
+  config.put(prefix + ".moduleName", "QcCommon");
+  config.put(prefix + ".className", "o2::quality_control_modules::common::TRFCollectionTask");
+  config.put(prefix + ".detectorName", "TST");
+  config.put(prefix + ".incremental", true);
+  boost::property_tree::ptree qos, qo, triggers, trigger;
+  qo.put("", "testTRFCollectionTaskCheck");
+  qos.push_back({ "", qo });
+  config.put_child(prefix + ".QOs", qos);
+  trigger.put("", "once");
+  triggers.push_back({ "", trigger });
+  config.put_child(prefix + ".initTrigger", triggers);
+  config.put_child(prefix + ".updateTrigger", triggers);
+  config.put_child(prefix + ".stopTrigger", triggers);
+
+  storeQO(database, Quality::Bad, 1000, 2000);
+  storeQO(database, Quality::Good, 2000, 3000);
+
+  o2::framework::ServiceRegistry services;
+  services.registerService<DatabaseInterface>(&database);
+  TRFCollectionTask task;
+  task.configure(taskName, config);
+  task.initialize({ TriggerType::UserOrControl, false, 500 }, services);
+
+  task.update({ TriggerType::Periodic, false, 2500 }, services);
+  BOOST_REQUIRE_EQUAL(database.requestedTimestamps.size(), 1u);
+  BOOST_CHECK(database.requestedTimestamps[0] == (std::vector<long>{ 1000, 2000 }));
+
+  // the second update retrieves only the version which appeared since the first one
+  storeQO(database, Quality::Bad, 3000, 4000);
+  task.update({ TriggerType::Periodic, false, 4500 }, services);
+  BOOST_REQUIRE_EQUAL(database.requestedTimestamps.size(), 2u);
+  BOOST_CHECK(database.requestedTimestamps[1] == (std::vector<long>{ 3000 }));
+
+  // ...but the stored collection covers the whole range since the initialization
+  auto trfc = database.retrieveTRFC(taskName, "TST", 0, "", "", "qc", 4000);
+  BOOST_REQUIRE(trfc != nullptr);
+  BOOST_CHECK_EQUAL(trfc->getStart(), 500u);
+  BOOST_CHECK_EQUAL(trfc->getEnd(), 4500u);
+  BOOST_CHECK(containsFlag(*trfc, 500, 999, FlagReasonFactory::UnknownQuality()));
+  BOOST_CHECK(containsFlag(*trfc, 1000, 2000, FlagReasonFactory::Unknown()));
+  BOOST_CHECK(containsFlag(*trfc, 3000, 4000, FlagReasonFactory::Unknown()));
+  BOOST_CHECK(containsFlag(*trfc, 4000, 4500, FlagReasonFactory::UnknownQuality()));
+}
+
+} // namespace o2::quality_control_modules::common
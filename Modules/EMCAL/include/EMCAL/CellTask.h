@@ -19,6 +19,7 @@
 
 #include "QualityControl/TaskInterface.h"
 #include <array>
+#include <memory>
 #include <unordered_map>
 #include <string_view>
 #include <gsl/span>
@@ -144,12 +145,12 @@ class CellTask final : public TaskInterface
     };
   };
   std::vector<CombinedEvent> buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const;
-  Bool_t mIgnoreTriggerTypes = false;                        ///< Do not differenciate between trigger types, treat all triggers as phys. triggers
-  std::map<std::string, CellHistograms> mHistogramContainer; ///< Container with histograms per trigger class
-  o2::emcal::Geometry* mGeometry = nullptr;                  ///< EMCAL geometry
-  o2::emcal::BadChannelMap* mBadChannelMap;                  ///< EMCAL channel map
-  o2::emcal::TimeCalibrationParams* mTimeCalib;              ///< EMCAL time calib
-  int mTimeFramesPerCycles = 0;                              ///< TF per cycles
+  Bool_t mIgnoreTriggerTypes = false;                                 ///< Do not differenciate between trigger types, treat all triggers as phys. triggers
+  std::map<std::string, CellHistograms> mHistogramContainer;          ///< Container with histograms per trigger class
+  o2::emcal::Geometry* mGeometry = nullptr;                           ///< EMCAL geometry
+  std::shared_ptr<const o2::emcal::BadChannelMap> mBadChannelMap;     ///< EMCAL channel map
+  std::shared_ptr<const o2::emcal::TimeCalibrationParams> mTimeCalib; ///< EMCAL time calib
+  int mTimeFramesPerCycles = 0;                                       ///< TF per cycles
 
   TH1* mEvCounterTF = nullptr;      ///< Number of Events per timeframe
   TH1* mEvCounterTFPHYS = nullptr;  ///< Number of Events per timeframe per PHYS
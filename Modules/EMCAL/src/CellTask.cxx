@@ -205,6 +205,10 @@ void CellTask::initialize(o2::framework::InitContext& /*ctx*/)
   mCells_ev_DCAL_Thres->GetXaxis()->SetTitle("ncellsperEvent");
   mCells_ev_DCAL_Thres->SetStats(0);
   getObjectsManager()->startPublishing(mCells_ev_DCAL_Thres);
+
+  // retrieved at the start of each activity, before the first cycle needs them
+  declareCondition<o2::emcal::BadChannelMap>(o2::emcal::CalibDB::getCDBPathBadChannelMap());
+  declareCondition<o2::emcal::TimeCalibrationParams>(o2::emcal::CalibDB::getCDBPathTimeCalibrationParams());
 }
 
 void CellTask::startOfActivity(Activity& /*activity*/)
@@ -217,13 +221,13 @@ void CellTask::startOfCycle()
 {
   mTimeFramesPerCycles = 0;
   ILOG(Debug, Support) << "startOfCycle" << ENDM;
-  std::map<std::string, std::string> metadata;
-  mBadChannelMap = retrieveConditionAny<o2::emcal::BadChannelMap>(o2::emcal::CalibDB::getCDBPathBadChannelMap(), metadata);
+  // the objects are retrieved from the CCDB only when their validity has ended
+  mBadChannelMap = retrieveCachedCondition<o2::emcal::BadChannelMap>(o2::emcal::CalibDB::getCDBPathBadChannelMap());
   // it was EMC/BadChannelMap
   if (!mBadChannelMap)
     ILOG(Info, Support) << "No Bad Channel Map object " << ENDM;
 
-  mTimeCalib = retrieveConditionAny<o2::emcal::TimeCalibrationParams>(o2::emcal::CalibDB::getCDBPathTimeCalibrationParams(), metadata);
+  mTimeCalib = retrieveCachedCondition<o2::emcal::TimeCalibrationParams>(o2::emcal::CalibDB::getCDBPathTimeCalibrationParams());
   //"EMC/TimeCalibrationParams
   if (!mTimeCalib)
     ILOG(Info, Support) << " No Time Calib object " << ENDM;
@@ -18,10 +18,10 @@
 #define QC_MODULE_FT0_FT0BASICDIGITQCTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "FT0/EventColumns.h"
 #include <memory>
 #include "TH1.h"
 #include "TH2.h"
-#include "TTree.h"
 #include "TFile.h"
 #include "TMultiGraph.h"
 #include "Rtypes.h"
@@ -53,7 +53,7 @@ class BasicDigitQcTask final : public TaskInterface
   std::unique_ptr<TH1F> mChargeHistogram;
   std::unique_ptr<TH1F> mTimeHistogram;
   std::unique_ptr<TH2F> mAmplitudeAndTime;
-  std::unique_ptr<TTree> mTTree;
+  std::unique_ptr<EventColumns> mEvents;
 };
 
 } // namespace o2::quality_control_modules::ft0
@@ -0,0 +1,87 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   EventColumns.h
+///
+
+#ifndef QC_MODULE_FT0_EVENTCOLUMNS_H
+#define QC_MODULE_FT0_EVENTCOLUMNS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <TObject.h>
+#include <Mergers/MergeInterface.h>
+#include <gsl/span>
+
+#include "DataFormatsFT0/ChannelData.h"
+
+namespace o2::quality_control_modules::ft0
+{
+
+/// \brief Events and their channels of one cycle, stored column by column.
+///
+/// Each property is kept in its own array: one entry per event for the event columns, one entry per channel for the
+/// channel columns. The channels of the event i are at the positions [offsets[i], offsets[i + 1]) of the channel
+/// columns. Arrays of basic types are streamed by ROOT in one go and compress well, unlike a TTree of objects, and
+/// the readers loop over them directly.
+class EventColumns final : public TObject, public o2::mergers::MergeInterface
+{
+ public:
+  EventColumns() = default;
+  explicit EventColumns(std::string name) : mName(std::move(name)) {}
+  ~EventColumns() override = default;
+
+  void addEvent(int eventID, uint16_t bc, uint32_t orbit, gsl::span<const o2::ft0::ChannelData> channels);
+  /// \brief Appends the events of the other object.
+  void merge(MergeInterface* other) override;
+  void Clear(Option_t* option = "") override;
+
+  const char* GetName() const override { return mName.c_str(); }
+
+  size_t getNEvents() const { return mEventIDs.size(); }
+  size_t getNChannels() const { return mChannelIDs.size(); }
+
+  // event columns
+  gsl::span<const int32_t> getEventIDs() const { return mEventIDs; }
+  gsl::span<const uint16_t> getBCs() const { return mBCs; }
+  gsl::span<const uint32_t> getOrbits() const { return mOrbits; }
+  /// \brief Returns nEvents + 1 offsets of the events in the channel columns.
+  gsl::span<const uint32_t> getChannelOffsets() const { return mChannelOffsets; }
+  double getTimestamp(size_t event) const;
+
+  // channel columns
+  gsl::span<const uint8_t> getChannelIDs() const { return mChannelIDs; }
+  gsl::span<const uint8_t> getChainQTCs() const { return mChainQTCs; }
+  gsl::span<const int16_t> getCFDTimes() const { return mCFDTimes; }
+  gsl::span<const int16_t> getQTCAmplitudes() const { return mQTCAmplitudes; }
+
+ private:
+  std::string mName;
+
+  std::vector<int32_t> mEventIDs;
+  std::vector<uint16_t> mBCs;
+  std::vector<uint32_t> mOrbits;
+  std::vector<uint32_t> mChannelOffsets{ 0 };
+
+  std::vector<uint8_t> mChannelIDs;
+  std::vector<uint8_t> mChainQTCs;
+  std::vector<int16_t> mCFDTimes;
+  std::vector<int16_t> mQTCAmplitudes;
+
+  ClassDefOverride(EventColumns, 1);
+};
+
+} // namespace o2::quality_control_modules::ft0
+
+#endif // QC_MODULE_FT0_EVENTCOLUMNS_H
@@ -3,7 +3,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
-#pragma link C++ class o2::quality_control_modules::ft0::EventWithChannelData + ;
+#pragma link C++ class o2::quality_control_modules::ft0::EventColumns + ;
 
 #pragma link C++ class o2::quality_control_modules::ft0::BasicDigitQcTask + ;
 #pragma link C++ class o2::quality_control_modules::ft0::DigitQcTask + ;
@@ -47,6 +47,9 @@ class OutOfBunchCollTask final : public quality_control::postprocessing::PostPro
   void configure(std::string, const boost::property_tree::ptree&) override;
 
  private:
+  /// \brief Rebuilds mHistBcPattern if the filling scheme differs from the one it was built with
+  void updateBcPattern(const o2::BunchFilling& bunchFilling);
+
   std::string mPathDigitQcTask;
   std::string mPathBunchFilling;
   o2::quality_control::repository::DatabaseInterface* mDatabase = nullptr;
@@ -58,6 +61,8 @@ class OutOfBunchCollTask final : public quality_control::postprocessing::PostPro
   // if storage size matters it can be replaced with TH1
   // and TH2 can be created based on it on the fly, but only TH1 would be stored
   std::unique_ptr<TH2F> mHistBcPattern;
+  o2::BunchFilling::Pattern mCachedBcPattern;
+  bool mBcPatternValid = false;
 };
 
 } // namespace o2::quality_control_modules::ft0
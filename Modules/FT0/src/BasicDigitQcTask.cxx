@@ -21,7 +21,7 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include "FT0/BasicDigitQcTask.h"
-#include "FT0/Utilities.h"
+#include "FT0/EventColumns.h"
 #include "DataFormatsFT0/Digit.h"
 #include "DataFormatsFT0/ChannelData.h"
 #include <Framework/InputRecord.h>
@@ -40,11 +40,11 @@ void BasicDigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   mChargeHistogram = std::make_unique<TH1F>("Charge", "Charge", 200, 0, 200);
   mTimeHistogram = std::make_unique<TH1F>("Time", "Time", 200, 0, 200);
   mAmplitudeAndTime = std::make_unique<TH2F>("ChargeAndTime", "ChargeAndTime", 10, 0, 200, 10, 0, 200);
-  mTTree = std::make_unique<TTree>("EventTree", "EventTree");
+  mEvents = std::make_unique<EventColumns>("Events");
 
   getObjectsManager()->startPublishing(mChargeHistogram.get());
   getObjectsManager()->startPublishing(mTimeHistogram.get());
-  getObjectsManager()->startPublishing(mTTree.get());
+  getObjectsManager()->startPublishing(mEvents.get());
   getObjectsManager()->startPublishing(mAmplitudeAndTime.get());
 }
 
@@ -53,7 +53,7 @@ void BasicDigitQcTask::startOfActivity(Activity& activity)
   ILOG(Info, Support) << "startOfActivity" << activity.mId << ENDM;
   mTimeHistogram->Reset();
   mChargeHistogram->Reset();
-  mTTree->Reset();
+  mEvents->Clear();
 }
 
 void BasicDigitQcTask::startOfCycle()
@@ -67,17 +67,9 @@ void BasicDigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
   auto channels = ctx.inputs().get<gsl::span<o2::ft0::ChannelData>>("channels");
   auto digits = ctx.inputs().get<gsl::span<o2::ft0::Digit>>("digits");
 
-  std::vector<o2::ft0::ChannelData> channelDataCopy(channels.begin(), channels.end());
-  std::vector<o2::ft0::Digit> digitDataCopy(digits.begin(), digits.end());
-
-  EventWithChannelData event;
-  mTTree->Branch("EventWithChannelData", &event);
-
   for (auto& digit : digits) {
     auto currentChannels = digit.getBunchChannelData(channels);
-    auto timestamp = o2::InteractionRecord::bc2ns(digit.getBC(), digit.getOrbit());
-    event = EventWithChannelData{ digit.getEventID(), digit.getBC(), digit.getOrbit(), timestamp, std::vector<o2::ft0::ChannelData>(currentChannels.begin(), currentChannels.end()) };
-    mTTree->Fill();
+    mEvents->addEvent(digit.getEventID(), digit.getBC(), digit.getOrbit(), currentChannels);
 
     for (auto& channel : currentChannels) {
       mChargeHistogram->Fill(channel.QTCAmpl);
@@ -85,16 +77,6 @@ void BasicDigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       mAmplitudeAndTime->Fill(channel.QTCAmpl, channel.CFDTime);
     }
   }
-
-  // saving TTree if you want to read it from disk
-  // its required to make a copy of tree - but it is only for debbuging
-
-  // auto hFile = std::make_unique<TFile>("debugTree.root", "RECREATE");
-  // auto treeCopy = mTTree->CloneTree();
-  // treeCopy->SetEntries();
-  // treeCopy->Write();
-  // mTTree->Print();
-  // hFile->Close();
 }
 
 void BasicDigitQcTask::endOfCycle()
@@ -113,7 +95,7 @@ void BasicDigitQcTask::reset()
 
   mTimeHistogram->Reset();
   mChargeHistogram->Reset();
-  mTTree->Reset();
+  mEvents->Clear();
   mAmplitudeAndTime->Reset();
 }
 
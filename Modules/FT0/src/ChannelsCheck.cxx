@@ -18,7 +18,6 @@
 #include <fairlogger/Logger.h>
 // ROOT
 #include "TH1.h"
-#include "TTree.h"
 // Quality Control
 #include "FT0/ChannelsCheck.h"
 #include "QualityControl/MonitorObject.h"
@@ -26,7 +25,7 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "DataFormatsFT0/Digit.h"
 #include "DataFormatsFT0/ChannelData.h"
-#include "FT0/Utilities.h"
+#include "FT0/EventColumns.h"
 
 using namespace std;
 
@@ -40,26 +39,26 @@ Quality ChannelsCheck::check(std::map<std::string, std::shared_ptr<MonitorObject
   for (auto [name, obj] : *moMap) {
     (void)name;
 
-    if (obj->getName() == "EventTree") {
-      TTree* tree = dynamic_cast<TTree*>(obj->getObject());
-      if (tree->GetEntries() == 0) {
+    if (obj->getName() == "Events") {
+      auto events = dynamic_cast<EventColumns*>(obj->getObject());
+      if (!events || events->getNEvents() == 0) {
         return Quality::Bad;
       }
 
-      EventWithChannelData event, *pEvent = &event;
-      tree->SetBranchAddress("EventWithChannelData", &pEvent);
-      for (unsigned int i = 0; i < tree->GetEntries(); ++i) {
-        tree->GetEntry(i);
-        const auto& channels = event.getChannels();
-
-        if (channels.empty()) {
+      auto offsets = events->getChannelOffsets();
+      for (size_t i = 0; i < events->getNEvents(); ++i) {
+        if (offsets[i] == offsets[i + 1]) {
           return Quality::Bad;
         }
+      }
 
-        for (const auto& channel : channels) {
-          if (channel.ChId == 0xff || channel.ChainQTC == 0xff || channel.CFDTime == -1000 || channel.QTCAmpl == -1000) {
-            return Quality::Bad;
-          }
+      auto channelIDs = events->getChannelIDs();
+      auto chainQTCs = events->getChainQTCs();
+      auto cfdTimes = events->getCFDTimes();
+      auto amplitudes = events->getQTCAmplitudes();
+      for (size_t i = 0; i < events->getNChannels(); ++i) {
+        if (channelIDs[i] == 0xff || chainQTCs[i] == 0xff || cfdTimes[i] == -1000 || amplitudes[i] == -1000) {
+          return Quality::Bad;
         }
       }
 
@@ -70,7 +69,7 @@ Quality ChannelsCheck::check(std::map<std::string, std::shared_ptr<MonitorObject
   return Quality::Bad;
 }
 
-std::string ChannelsCheck::getAcceptedType() { return "TTree"; }
+std::string ChannelsCheck::getAcceptedType() { return "o2::quality_control_modules::ft0::EventColumns"; }
 
 void ChannelsCheck::beautify(std::shared_ptr<MonitorObject>, Quality)
 {
@@ -18,7 +18,6 @@
 #include <fairlogger/Logger.h>
 // ROOT
 #include "TH1.h"
-#include "TTree.h"
 // Quality Control
 #include "FT0/DigitsCheck.h"
 #include "QualityControl/MonitorObject.h"
@@ -26,7 +25,7 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "DataFormatsFT0/Digit.h"
 #include "DataFormatsFT0/ChannelData.h"
-#include "FT0/Utilities.h"
+#include "FT0/EventColumns.h"
 
 using namespace std;
 
@@ -39,17 +38,18 @@ Quality DigitsCheck::check(std::map<std::string, std::shared_ptr<MonitorObject>>
 {
   for (auto [name, obj] : *moMap) {
     (void)name;
-    if (obj->getName() == "EventTree") {
-      TTree* tree = dynamic_cast<TTree*>(obj->getObject());
-      if (tree->GetEntries() == 0) {
+    if (obj->getName() == "Events") {
+      auto events = dynamic_cast<EventColumns*>(obj->getObject());
+      if (!events || events->getNEvents() == 0) {
         return Quality::Bad;
       }
 
-      EventWithChannelData event, *pEvent = &event;
-      tree->SetBranchAddress("EventWithChannelData", &pEvent);
-      for (unsigned int i = 0; i < tree->GetEntries(); ++i) {
-        tree->GetEntry(i);
-        if (event.getEventID() < 0 || event.getBC() == o2::InteractionRecord::DummyBC || event.getOrbit() == o2::InteractionRecord::DummyOrbit || event.getTimestamp() == 0 || event.getChannels().empty()) {
+      auto eventIDs = events->getEventIDs();
+      auto bcs = events->getBCs();
+      auto orbits = events->getOrbits();
+      auto offsets = events->getChannelOffsets();
+      for (size_t i = 0; i < events->getNEvents(); ++i) {
+        if (eventIDs[i] < 0 || bcs[i] == o2::InteractionRecord::DummyBC || orbits[i] == o2::InteractionRecord::DummyOrbit || events->getTimestamp(i) == 0 || offsets[i] == offsets[i + 1]) {
           return Quality::Bad;
         }
       }
@@ -61,7 +61,7 @@ Quality DigitsCheck::check(std::map<std::string, std::shared_ptr<MonitorObject>>
   return Quality::Bad;
 }
 
-std::string DigitsCheck::getAcceptedType() { return "TTree"; }
+std::string DigitsCheck::getAcceptedType() { return "o2::quality_control_modules::ft0::EventColumns"; }
 
 void DigitsCheck::beautify(std::shared_ptr<MonitorObject>, Quality)
 {
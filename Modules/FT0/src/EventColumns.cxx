@@ -0,0 +1,80 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   EventColumns.cxx
+///
+
+#include "FT0/EventColumns.h"
+
+#include <CommonDataFormat/InteractionRecord.h>
+
+ClassImp(o2::quality_control_modules::ft0::EventColumns);
+
+namespace o2::quality_control_modules::ft0
+{
+
+void EventColumns::addEvent(int eventID, uint16_t bc, uint32_t orbit, gsl::span<const o2::ft0::ChannelData> channels)
+{
+  mEventIDs.push_back(eventID);
+  mBCs.push_back(bc);
+  mOrbits.push_back(orbit);
+  mChannelOffsets.push_back(mChannelOffsets.back() + channels.size());
+
+  for (const auto& channel : channels) {
+    mChannelIDs.push_back(channel.ChId);
+    mChainQTCs.push_back(channel.ChainQTC);
+    mCFDTimes.push_back(channel.CFDTime);
+    mQTCAmplitudes.push_back(channel.QTCAmpl);
+  }
+}
+
+void EventColumns::merge(MergeInterface* other)
+{
+  auto otherColumns = dynamic_cast<const EventColumns*>(other);
+  if (!otherColumns) {
+    return;
+  }
+
+  auto append = [](auto& to, const auto& from) { to.insert(to.end(), from.begin(), from.end()); };
+  append(mEventIDs, otherColumns->mEventIDs);
+  append(mBCs, otherColumns->mBCs);
+  append(mOrbits, otherColumns->mOrbits);
+  append(mChannelIDs, otherColumns->mChannelIDs);
+  append(mChainQTCs, otherColumns->mChainQTCs);
+  append(mCFDTimes, otherColumns->mCFDTimes);
+  append(mQTCAmplitudes, otherColumns->mQTCAmplitudes);
+
+  // the offsets of the other object are shifted by the number of channels we had
+  auto shift = mChannelOffsets.back();
+  for (size_t i = 1; i < otherColumns->mChannelOffsets.size(); i++) {
+    mChannelOffsets.push_back(otherColumns->mChannelOffsets[i] + shift);
+  }
+}
+
+void EventColumns::Clear(Option_t*)
+{
+  mEventIDs.clear();
+  mBCs.clear();
+  mOrbits.clear();
+  mChannelOffsets.assign(1, 0);
+  mChannelIDs.clear();
+  mChainQTCs.clear();
+  mCFDTimes.clear();
+  mQTCAmplitudes.clear();
+}
+
+double EventColumns::getTimestamp(size_t event) const
+{
+  return o2::InteractionRecord::bc2ns(mBCs[event], mOrbits[event]);
+}
+
+} // namespace o2::quality_control_modules::ft0
@@ -26,7 +26,6 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "DataFormatsFT0/Digit.h"
 #include "DataFormatsFT0/ChannelData.h"
-#include "FT0/Utilities.h"
 
 using namespace std;
 
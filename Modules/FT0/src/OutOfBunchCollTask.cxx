@@ -21,6 +21,7 @@
 
 #include <TH1F.h>
 #include <TH2.h>
+#include <algorithm>
 #include <typeinfo>
 #include "Rtypes.h"
 
@@ -91,40 +92,66 @@ void OutOfBunchCollTask::update(Trigger t, framework::ServiceRegistry&)
 {
   std::map<std::string, std::string> metadata;
   std::map<std::string, std::string> headers;
-  const auto* bcPattern = mCcdbApi.retrieveFromTFileAny<o2::BunchFilling>(mPathBunchFilling, metadata, -1, &headers);
+  std::unique_ptr<o2::BunchFilling> bcPattern(mCcdbApi.retrieveFromTFileAny<o2::BunchFilling>(mPathBunchFilling, metadata, -1, &headers));
   if (!bcPattern) {
     ILOG(Error, Support) << "object \"" << mPathBunchFilling << "\" NOT retrieved!!!"
                          << ENDM;
     return;
   }
-  const int nBc = 3564;
-  const int nOrbits = 256;
-  mHistBcPattern->Reset();
-  for (int j = 0; j < nOrbits + 1; j++)
-    for (int i = 0; i < nBc + 1; i++)
-      mHistBcPattern->SetBinContent(j + 1, i + 1, bcPattern->testBC(i));
+  updateBcPattern(*bcPattern);
 
+  const float* bcPatternCells = mHistBcPattern->GetArray();
   for (auto& entry : mMapOutOfBunchColl) {
     auto moName = Form("BcOrbitMap_Trg%s", mMapDigitTrgNames.at(entry.first).c_str());
     auto mo = mDatabase->retrieveMO(mPathDigitQcTask, moName, t.timestamp, t.activity);
-    auto hBcOrbitMapTrg = mo ? (TH2F*)mo->getObject() : nullptr;
+    auto hBcOrbitMapTrg = mo ? dynamic_cast<TH2F*>(mo->getObject()) : nullptr;
     if (!hBcOrbitMapTrg) {
       ILOG(Error, Support) << "MO \"" << moName << "\" NOT retrieved!!!"
                            << ENDM;
       continue;
     }
+    if (hBcOrbitMapTrg->GetNcells() != entry.second->GetNcells()) {
+      ILOG(Error, Support) << "MO \"" << moName << "\" does not have the expected binning" << ENDM;
+      continue;
+    }
     entry.second->Reset();
-    // scale bc pattern by vmax to make sure the difference is non positive
+    // scale bc pattern by vmax to make sure the difference is non positive for the colliding BCs,
+    // then clamp the negative bins to zero, all in one pass over the bin arrays (under- and overflows included)
     float vmax = hBcOrbitMapTrg->GetBinContent(hBcOrbitMapTrg->GetMaximumBin());
-    entry.second->Add(hBcOrbitMapTrg, mHistBcPattern.get(), 1, -1 * vmax);
-    for (int j = 0; j < nOrbits + 1; j++)
-      for (int i = 0; i < nBc + 1; i++)
-        if (entry.second->GetBinContent(j + 1, i + 1) < 0)
-          entry.second->SetBinContent(j + 1, i + 1, 0); // is it too slow?
+    const float* bcOrbitMapCells = hBcOrbitMapTrg->GetArray();
+    float* outOfBunchCells = entry.second->GetArray();
+    const int nCells = entry.second->GetNcells();
+    for (int cell = 0; cell < nCells; cell++) {
+      outOfBunchCells[cell] = std::max(bcOrbitMapCells[cell] - vmax * bcPatternCells[cell], 0.f);
+    }
     entry.second->SetEntries(entry.second->Integral());
-    getObjectsManager()->getMonitorObject(entry.second->GetName())->addOrUpdateMetadata("BcOrbitMapIntegral", std::to_string(hBcOrbitMapTrg->Integral()));
-    ILOG(Debug, Support) << "Trg: " << moName << " Integrals BcOrbitMap: " << hBcOrbitMapTrg->Integral() << ", OutOfBunchColl:" << entry.second->Integral() << ENDM;
+    auto bcOrbitMapIntegral = hBcOrbitMapTrg->Integral();
+    getObjectsManager()->getMonitorObject(entry.second->GetName())->addOrUpdateMetadata("BcOrbitMapIntegral", std::to_string(bcOrbitMapIntegral));
+    ILOG(Debug, Support) << "Trg: " << moName << " Integrals BcOrbitMap: " << bcOrbitMapIntegral << ", OutOfBunchColl:" << entry.second->Integral() << ENDM;
+  }
+}
+
+void OutOfBunchCollTask::updateBcPattern(const o2::BunchFilling& bunchFilling)
+{
+  // the BC pattern histogram depends only on the filling scheme, which rarely changes within a run
+  if (mBcPatternValid && bunchFilling.getBCPattern() == mCachedBcPattern) {
+    return;
+  }
+  mCachedBcPattern = bunchFilling.getBCPattern();
+  mBcPatternValid = true;
+  ILOG(Info, Support) << "Filling scheme changed, rebuilding the BC pattern with " << mCachedBcPattern.count() << " colliding BCs" << ENDM;
+
+  mHistBcPattern->Reset();
+  float* cells = mHistBcPattern->GetArray();
+  const int nCellsX = mHistBcPattern->GetNbinsX() + 2;
+  const int nBc = std::min<int>(mHistBcPattern->GetNbinsY(), mCachedBcPattern.size());
+  for (int bc = 0; bc < nBc; bc++) {
+    if (mCachedBcPattern.test(bc)) {
+      // every orbit bin of the BC row, the orbit overflow included
+      std::fill_n(cells + (bc + 1) * nCellsX + 1, nCellsX - 1, 1.f);
+    }
   }
+  mHistBcPattern->SetEntries(mHistBcPattern->Integral());
 }
 
 void OutOfBunchCollTask::finalize(Trigger t, framework::ServiceRegistry&)
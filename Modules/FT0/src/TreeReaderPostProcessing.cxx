@@ -16,10 +16,9 @@
 
 #include "FT0/TreeReaderPostProcessing.h"
 #include "QualityControl/QcInfoLogger.h"
-#include "FT0/Utilities.h"
+#include "FT0/EventColumns.h"
 
 #include <TH1F.h>
-#include <TTree.h>
 
 using namespace o2::quality_control::postprocessing;
 
@@ -40,18 +39,12 @@ void TreeReaderPostProcessing::initialize(Trigger, framework::ServiceRegistry& s
 void TreeReaderPostProcessing::update(Trigger t, framework::ServiceRegistry&)
 {
   mChargeHistogram->Reset();
-  auto mo = mDatabase->retrieveMO("FT0/MO/BasicDigitQcTask", "EventTree", t.timestamp, t.activity);
-  TTree* moTree = static_cast<TTree*>(mo ? mo->getObject() : nullptr);
+  auto mo = mDatabase->retrieveMO("FT0/MO/BasicDigitQcTask", "Events", t.timestamp, t.activity);
+  auto events = dynamic_cast<EventColumns*>(mo ? mo->getObject() : nullptr);
 
-  if (moTree) {
-    EventWithChannelData event, *pEvent = &event;
-    moTree->SetBranchAddress("EventWithChannelData", &pEvent);
-    for (unsigned int i = 0; i < moTree->GetEntries(); ++i) {
-
-      moTree->GetEntry(i);
-      for (const auto& channel : event.getChannels()) {
-        mChargeHistogram->Fill(channel.QTCAmpl);
-      }
+  if (events) {
+    for (auto amplitude : events->getQTCAmplitudes()) {
+      mChargeHistogram->Fill(amplitude);
     }
   }
 }
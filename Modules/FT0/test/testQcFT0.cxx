@@ -15,6 +15,10 @@
 ///
 
 #include "QualityControl/TaskFactory.h"
+#include "FT0/EventColumns.h"
+#include <DataFormatsFT0/ChannelData.h>
+#include <CommonDataFormat/InteractionRecord.h>
+#include <vector>
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -27,4 +31,36 @@ namespace o2::quality_control_modules::ft0
 
 BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
 
+BOOST_AUTO_TEST_CASE(event_columns)
+{
+  std::vector<o2::ft0::ChannelData> channels(3);
+  for (size_t i = 0; i < channels.size(); i++) {
+    channels[i].ChId = i;
+    channels[i].QTCAmpl = 10 * i;
+  }
+
+  EventColumns first("Events");
+  first.addEvent(1, 100, 5, gsl::span<const o2::ft0::ChannelData>(channels.data(), 2));
+  first.addEvent(2, 200, 5, gsl::span<const o2::ft0::ChannelData>(channels.data() + 2, 1));
+  BOOST_CHECK_EQUAL(first.getNEvents(), 2);
+  BOOST_CHECK_EQUAL(first.getNChannels(), 3);
+  BOOST_CHECK_EQUAL(first.getChannelOffsets()[2], 3);
+  BOOST_CHECK_EQUAL(first.getQTCAmplitudes()[2], 20);
+
+  EventColumns second("Events");
+  second.addEvent(3, 300, 6, channels);
+  first.merge(&second);
+  BOOST_CHECK_EQUAL(first.getNEvents(), 3);
+  BOOST_CHECK_EQUAL(first.getNChannels(), 6);
+  BOOST_CHECK_EQUAL(first.getChannelOffsets().size(), 4);
+  BOOST_CHECK_EQUAL(first.getChannelOffsets()[3], 6);
+  BOOST_CHECK_EQUAL(first.getEventIDs()[2], 3);
+  BOOST_CHECK_EQUAL(first.getChannelIDs()[3], 0);
+  BOOST_CHECK_EQUAL(first.getTimestamp(2), o2::InteractionRecord::bc2ns(300, 6));
+
+  first.Clear();
+  BOOST_CHECK_EQUAL(first.getNEvents(), 0);
+  BOOST_CHECK_EQUAL(first.getChannelOffsets().size(), 1);
+}
+
 } // namespace o2::quality_control_modules::ft0
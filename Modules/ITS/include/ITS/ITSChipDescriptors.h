@@ -0,0 +1,89 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ITSChipDescriptors.h
+///
+
+#ifndef QC_MODULE_ITS_ITSCHIPDESCRIPTORS_H
+#define QC_MODULE_ITS_ITSCHIPDESCRIPTORS_H
+
+#include "Common/ChipDescriptorTable.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace o2::its
+{
+class GeometryTGeo;
+}
+
+namespace o2::quality_control_modules::its
+{
+
+/// \brief Position of an ITS chip, as decoded from its global chip ID.
+struct alignas(16) ITSChipDescriptor {
+  int8_t layer = -1;
+  int8_t stave = 0;       // stave in the layer
+  int8_t halfStave = 0;   // always 0 in the IB
+  int8_t module = 0;      // HIC in the half stave
+  int8_t hic = 0;         // HIC in the stave, always 0 in the IB
+  int8_t chip = 0;        // chip in the HIC
+  int8_t lane = 0;        // lane in the stave, the chip itself in the IB
+  uint8_t chipInStave = 0;
+  int16_t staveIndex = 0; // stave in the whole detector
+};
+
+using ITSChipDescriptorTable = o2::quality_control_modules::common::ChipDescriptorTable<ITSChipDescriptor>;
+
+/// \brief Decodes the position of the chip with the given global ID with the geometry.
+///
+/// The geometry is a template parameter so that the decoding can be tested without loading the ITS geometry, any type
+/// with the chip ID accessors of o2::its::GeometryTGeo can be used.
+template <typename Geometry>
+void fillITSChipDescriptor(const Geometry& geometry, size_t chipID, ITSChipDescriptor& descriptor)
+{
+  constexpr int NLayerIB = 3;
+
+  descriptor = ITSChipDescriptor{};
+  int lay = 0, sta = 0, ssta = 0, mod = 0, chip = 0;
+  if (!geometry.getChipId(static_cast<int>(chipID), lay, sta, ssta, mod, chip)) {
+    return;
+  }
+  int chipInStave = geometry.getChipIdInStave(static_cast<int>(chipID));
+
+  descriptor.layer = lay;
+  descriptor.stave = sta;
+  descriptor.chipInStave = chipInStave;
+  descriptor.staveIndex = sta;
+  for (int layer = 0; layer < lay; layer++) {
+    descriptor.staveIndex += geometry.getNumberOfStaves(layer);
+  }
+  if (lay < NLayerIB) {
+    descriptor.chip = chipInStave;
+    descriptor.lane = chipInStave;
+  } else {
+    descriptor.halfStave = ssta;
+    descriptor.module = mod;
+    descriptor.hic = mod + ssta * geometry.getNumberOfModules(lay);
+    descriptor.chip = chip;
+    descriptor.lane = chipInStave / (geometry.getNumberOfChipsPerModule(lay) / geometry.getNumberOfChipRowsPerModule(lay));
+  }
+}
+
+/// \brief Returns the table of all the ITS chips, shared by all the tasks of the process.
+///
+/// The table is built with the given geometry by the first caller, the geometry must be loaded beforehand.
+std::shared_ptr<const ITSChipDescriptorTable> getITSChipDescriptors(const o2::its::GeometryTGeo& geometry);
+
+} // namespace o2::quality_control_modules::its
+
+#endif // QC_MODULE_ITS_ITSCHIPDESCRIPTORS_H
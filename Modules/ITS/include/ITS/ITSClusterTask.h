@@ -25,6 +25,7 @@
 #include <DataFormatsITSMFT/TopologyDictionary.h>
 #include <ITSBase/GeometryTGeo.h>
 #include <TH2Poly.h>
+#include <vector>
 class TH1D;
 class TH2D;
 
@@ -56,6 +57,28 @@ class ITSClusterTask : public TaskInterface
   void getJsonParameters();
   void createAllHistos();
   void updateOccMonitorPlots();
+  void buildChipLocations();
+  size_t addDenseHistogram(TH1* histogram, int nBins);
+  void mergeThreadCounters();
+
+  /// Position of a sensor in the histograms and the offsets of its dense counters, decoded once from the sensor ID.
+  struct ChipLocation {
+    int layer = -1; // -1 if the layer is disabled
+    int stave = 0;
+    int chip = 0; // the chip in the stave for IB, the HIC in the stave for OB
+    size_t occupancy = 0;
+    size_t size = 0;
+    size_t sizeMonitor = 0;
+    size_t sizeStave = 0; // only OB
+    size_t topology = 0;
+    size_t grouped = 0;
+  };
+  /// A histogram filled through the dense counters, the last counter is the overflow.
+  struct DenseHistogram {
+    TH1* histogram;
+    size_t offset;
+    int nBins;
+  };
 
   static constexpr int NLayer = 7;
   static constexpr int NLayerIB = 3;
@@ -95,6 +118,16 @@ class ITSClusterTask : public TaskInterface
   Int_t mClusterOccupancyOB[7][48][14];
   Int_t mClusterOccupancyOBmonitor[7][48][14];
 
+  static constexpr int NClusterSizeBins = 100;
+  static constexpr int NTopologyBins = 300;
+  std::vector<ChipLocation> mChipLocations; // indexed by the sensor ID
+  std::vector<DenseHistogram> mDenseHistograms;
+  size_t mLayerSize[NLayer] = {}; // offsets of the layer summaries in the dense counters
+  size_t mLayerTopology[NLayer] = {};
+  size_t mLayerGrouped[NLayer] = {};
+  size_t mNDenseCounters = 0;
+  std::vector<std::vector<uint32_t>> mThreadCounters; // one set of dense counters per thread, merged once per TF
+
   const int mOccUpdateFrequency = 100000;
   int mNThreads = 1;
   int mNRofs = 0;
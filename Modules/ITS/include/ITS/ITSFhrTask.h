@@ -19,6 +19,7 @@
 #define QC_MODULE_ITS_ITSFHRTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "ITS/ITSChipDescriptors.h"
 #include <ITSMFTReconstruction/ChipMappingITS.h>
 #include <ITSMFTReconstruction/PixelData.h>
 #include <ITSBase/GeometryTGeo.h>
@@ -175,6 +176,7 @@ class ITSFhrTask final : public TaskInterface
 
   // Geometry decoder
   o2::its::GeometryTGeo* mGeom;
+  std::shared_ptr<const ITSChipDescriptorTable> mChipDescriptors;
   std::string mGeomPath;
 };
 } // namespace o2::quality_control_modules::its
@@ -0,0 +1,30 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ITSChipDescriptors.cxx
+///
+
+#include "ITS/ITSChipDescriptors.h"
+
+#include <ITSBase/GeometryTGeo.h>
+
+namespace o2::quality_control_modules::its
+{
+
+std::shared_ptr<const ITSChipDescriptorTable> getITSChipDescriptors(const o2::its::GeometryTGeo& geometry)
+{
+  return ITSChipDescriptorTable::getShared("ITS", geometry.getNumberOfChips(), [&geometry](size_t chipID, ITSChipDescriptor& descriptor) {
+    fillITSChipDescriptor(geometry, chipID, descriptor);
+  });
+}
+
+} // namespace o2::quality_control_modules::its
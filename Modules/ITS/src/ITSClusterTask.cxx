@@ -16,6 +16,7 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include "ITS/ITSClusterTask.h"
+#include "ITS/ITSChipDescriptors.h"
 
 #include <sstream>
 #include <TCanvas.h>
@@ -31,6 +32,9 @@
 #include "CCDB/CCDBTimeStampUtils.h"
 #include <Framework/InputRecord.h>
 #include <THnSparse.h>
+#include <algorithm>
+#include <map>
+#include <tuple>
 
 #ifdef WITH_OPENMP
 #include <omp.h>
@@ -107,6 +111,7 @@ void ITSClusterTask::initialize(o2::framework::InitContext& /*ctx*/)
   mGeom = o2::its::GeometryTGeo::Instance();
 
   createAllHistos();
+  buildChipLocations();
 
   mGeneralOccupancy = new TH2Poly();
   mGeneralOccupancy->SetTitle("General Occupancy (max clusters /event/chip);mm;mm");
@@ -157,97 +162,93 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
   int difference;
   start = std::chrono::high_resolution_clock::now();
 
-  ILOG(Info, Support) << "START DOING QC General" << ENDM;
+  ILOG_RATE_LIMITED(Info, Support, 10) << "START DOING QC General" << ENDM;
   auto clusArr = ctx.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("compclus");
   auto clusRofArr = ctx.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clustersrof");
   auto clusPatternArr = ctx.inputs().get<gsl::span<unsigned char>>("patterns");
-  auto pattIt = clusPatternArr.begin();
   int dictSize = mDict->getSize();
+  const int nROFs = clusRofArr.size();
+
+  auto hasPattern = [&](int patternID) {
+    return patternID == o2::itsmft::CompCluster::InvalidPatternID || mDict->isGroup(patternID);
+  };
+
+  // The patterns of all the clusters are stored one after another, thus we first find where the patterns of each ROF
+  // start (an exclusive prefix sum of their sizes, which are given by the row and column spans), so that the ROFs
+  // can be processed in parallel in any order.
+  std::vector<size_t> patternOffsets(nROFs);
+  size_t patternOffset = 0;
+  for (int iROF = 0; iROF < nROFs; iROF++) {
+    patternOffsets[iROF] = patternOffset;
+    const auto& ROF = clusRofArr[iROF];
+    for (int icl = ROF.getFirstEntry(); icl < ROF.getFirstEntry() + ROF.getNEntries(); icl++) {
+      if (hasPattern(clusArr[icl].getPatternID()) && patternOffset + 2 <= clusPatternArr.size()) {
+        int nPixelsInBox = clusPatternArr[patternOffset] * clusPatternArr[patternOffset + 1];
+        patternOffset += 2 + (nPixelsInBox + 7) / 8;
+      }
+    }
+  }
 
-  int iPattern = 0;
-  int ChipIDprev = -1;
+  std::vector<int> nClustersForBunchCrossing(nROFs, 0);
+
+  // Filling the dense counters of each thread by open_mp, they are merged into the histograms afterwards.
 #ifdef WITH_OPENMP
   omp_set_num_threads(mNThreads);
 #pragma omp parallel for schedule(dynamic)
 #endif
-  // Filling cluster histogram for each ROF by open_mp
-
-  for (unsigned int iROF = 0; iROF < clusRofArr.size(); iROF++) {
-
+  for (int iROF = 0; iROF < nROFs; iROF++) {
+#ifdef WITH_OPENMP
+    auto& counters = mThreadCounters[omp_get_thread_num()];
+#else
+    auto& counters = mThreadCounters[0];
+#endif
     const auto& ROF = clusRofArr[iROF];
-    const auto bcdata = ROF.getBCData();
-    int nClustersForBunchCrossing = 0;
+    auto pattIt = clusPatternArr.begin() + patternOffsets[iROF];
     for (int icl = ROF.getFirstEntry(); icl < ROF.getFirstEntry() + ROF.getNEntries(); icl++) {
 
       auto& cluster = clusArr[icl];
-      auto ChipID = cluster.getSensorID();
       int ClusterID = cluster.getPatternID(); // used for normal (frequent) cluster shapes
-      int lay, sta, ssta, mod, chip;
-
-      if (ChipID != ChipIDprev) {
-        mGeom->getChipId(ChipID, lay, sta, ssta, mod, chip);
-        mod = mod + (ssta * (mNHicPerStave[lay] / 2));
-      }
       int npix = -1;
-      int isGrouped = -1;
-      if (ClusterID != o2::itsmft::CompCluster::InvalidPatternID && !mDict->isGroup(ClusterID)) { // Normal (frequent) cluster shapes
+      bool isGrouped = hasPattern(ClusterID);
+      if (!isGrouped) { // Normal (frequent) cluster shapes
         npix = mDict->getNpixels(ClusterID);
-        isGrouped = 0;
       } else {
         o2::itsmft::ClusterPattern patt(pattIt);
         npix = patt.getNPixels();
-        isGrouped = 1;
       }
 
       if (npix > 2)
-        nClustersForBunchCrossing++;
-
-      if (lay < 3) {
-
-        mClusterOccupancyIB[lay][sta][chip]++;
-        mClusterOccupancyIBmonitor[lay][sta][chip]++;
-        if (ClusterID < dictSize) {
+        nClustersForBunchCrossing[iROF]++;
 
-          // Double_t ClusterSizeFill[3] = {1.*sta, 1.*chip,1.* mDict.getNpixels(ClusterID)};
-          // sClustersSize[lay]->Fill(ClusterSizeFill, 1.);
-
-          hClusterTopologySummaryIB[lay][sta][chip]->Fill(ClusterID);
-          hClusterSizeSummaryIB[lay][sta][chip]->Fill(npix);
-
-          hClusterSizeLayerSummary[lay]->Fill(npix);
-          hClusterTopologyLayerSummary[lay]->Fill(ClusterID);
-
-          hClusterSizeMonitorIB[lay][sta][chip]->Fill(npix);
-          if (isGrouped) {
-            hGroupedClusterSizeSummaryIB[lay][sta][chip]->Fill(npix);
-            hGroupedClusterSizeLayerSummary[lay]->Fill(npix);
-          }
+      const auto& location = mChipLocations[cluster.getSensorID()];
+      if (location.layer < 0) {
+        continue;
+      }
+      counters[location.occupancy]++;
+      if (ClusterID < dictSize) {
+        const int sizeBin = std::min(npix, NClusterSizeBins);
+        const int topologyBin = std::min(ClusterID, NTopologyBins);
+        counters[location.size + sizeBin]++;
+        counters[location.sizeMonitor + sizeBin]++;
+        counters[location.topology + topologyBin]++;
+        counters[mLayerSize[location.layer] + sizeBin]++;
+        counters[mLayerTopology[location.layer] + topologyBin]++;
+        if (location.layer >= NLayerIB) {
+          counters[location.sizeStave + sizeBin]++;
         }
-      } else {
-
-        mClusterOccupancyOB[lay][sta][mod]++;
-        mClusterOccupancyOBmonitor[lay][sta][mod]++;
-        if (ClusterID < dictSize) {
-          // Double_t ClusterSizeFill[3] = {1.*sta, 1.*mod, 1.*mDict.getNpixels(ClusterID)};
-          // sClustersSize[lay]->Fill(ClusterSizeFill, 1.);
-
-          hClusterSizeOB[lay][sta][mod]->Fill(npix);
-          hClusterSizeMonitorOB[lay][sta][mod]->Fill(npix);
-
-          hClusterTopologySummaryOB[lay][sta]->Fill(ClusterID);
-          hClusterSizeSummaryOB[lay][sta]->Fill(npix);
-          hClusterSizeLayerSummary[lay]->Fill(npix);
-          hClusterTopologyLayerSummary[lay]->Fill(ClusterID);
-          if (isGrouped) {
-            hGroupedClusterSizeSummaryOB[lay][sta]->Fill(npix);
-            hGroupedClusterSizeLayerSummary[lay]->Fill(npix);
-          }
+        if (isGrouped) {
+          counters[location.grouped + sizeBin]++;
+          counters[mLayerGrouped[location.layer] + sizeBin]++;
         }
       }
     }
-    hClusterVsBunchCrossing->Fill(bcdata.bc, nClustersForBunchCrossing); // we count only the number of clusters, not their sizes
   }
 
+  for (int iROF = 0; iROF < nROFs; iROF++) {
+    hClusterVsBunchCrossing->Fill(clusRofArr[iROF].getBCData().bc, nClustersForBunchCrossing[iROF]); // we count only the number of clusters, not their sizes
+  }
+  mergeThreadCounters();
+
   mNRofs += clusRofArr.size();        // USED to calculate occupancy for the whole run
   mNRofsMonitor += clusRofArr.size(); // Occupancy in the last N ROFs
 
@@ -311,6 +312,142 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
   ILOG(Info, Support) << "Time in QC Cluster Task:  " << difference << ENDM;
 }
 
+void ITSClusterTask::buildChipLocations()
+{
+  mDenseHistograms.clear();
+  mNDenseCounters = 0;
+  for (int iLayer = 0; iLayer < NLayer; iLayer++) {
+    if (!mEnableLayers[iLayer])
+      continue;
+    mLayerSize[iLayer] = addDenseHistogram(hClusterSizeLayerSummary[iLayer], NClusterSizeBins);
+    mLayerTopology[iLayer] = addDenseHistogram(hClusterTopologyLayerSummary[iLayer], NTopologyBins);
+    mLayerGrouped[iLayer] = addDenseHistogram(hGroupedClusterSizeLayerSummary[iLayer], NClusterSizeBins);
+  }
+
+  // stave-level histograms are shared by all the chips of an OB stave
+  std::vector<std::vector<size_t>> staveSize(NLayer), staveTopology(NLayer), staveGrouped(NLayer);
+  for (int iLayer = NLayerIB; iLayer < NLayer; iLayer++) {
+    if (!mEnableLayers[iLayer])
+      continue;
+    for (int iStave = 0; iStave < mNStaves[iLayer]; iStave++) {
+      staveSize[iLayer].push_back(addDenseHistogram(hClusterSizeSummaryOB[iLayer][iStave], NClusterSizeBins));
+      staveTopology[iLayer].push_back(addDenseHistogram(hClusterTopologySummaryOB[iLayer][iStave], NTopologyBins));
+      staveGrouped[iLayer].push_back(addDenseHistogram(hGroupedClusterSizeSummaryOB[iLayer][iStave], NClusterSizeBins));
+    }
+  }
+
+  // one occupancy counter and one set of histograms per IB chip or OB HIC
+  std::map<std::tuple<int, int, int>, ChipLocation> locations;
+  auto descriptors = getITSChipDescriptors(*mGeom);
+  mChipLocations.assign(descriptors->size(), ChipLocation{});
+  for (size_t chipID = 0; chipID < descriptors->size(); chipID++) {
+    const auto& descriptor = (*descriptors)[chipID];
+    int lay = descriptor.layer, sta = descriptor.stave, mod = descriptor.hic, chip = descriptor.chip;
+    if (!mEnableLayers[lay])
+      continue;
+    int index = lay < NLayerIB ? chip : mod;
+
+    auto [it, inserted] = locations.try_emplace({ lay, sta, index });
+    auto& location = it->second;
+    if (inserted) {
+      location.layer = lay;
+      location.stave = sta;
+      location.chip = index;
+      location.occupancy = mNDenseCounters++;
+      if (lay < NLayerIB) {
+        location.size = addDenseHistogram(hClusterSizeSummaryIB[lay][sta][chip], NClusterSizeBins);
+        location.sizeMonitor = addDenseHistogram(hClusterSizeMonitorIB[lay][sta][chip], NClusterSizeBins);
+        location.topology = addDenseHistogram(hClusterTopologySummaryIB[lay][sta][chip], NTopologyBins);
+        location.grouped = addDenseHistogram(hGroupedClusterSizeSummaryIB[lay][sta][chip], NClusterSizeBins);
+      } else {
+        location.size = addDenseHistogram(hClusterSizeOB[lay][sta][mod], NClusterSizeBins);
+        location.sizeMonitor = addDenseHistogram(hClusterSizeMonitorOB[lay][sta][mod], NClusterSizeBins);
+        location.sizeStave = staveSize[lay][sta];
+        location.topology = staveTopology[lay][sta];
+        location.grouped = staveGrouped[lay][sta];
+      }
+    }
+    mChipLocations[chipID] = location;
+  }
+
+#ifdef WITH_OPENMP
+  mThreadCounters.assign(mNThreads, std::vector<uint32_t>(mNDenseCounters, 0));
+#else
+  mThreadCounters.assign(1, std::vector<uint32_t>(mNDenseCounters, 0));
+#endif
+  ILOG(Info, Support) << "Using " << mNDenseCounters << " dense counters per thread for " << mDenseHistograms.size() << " histograms" << ENDM;
+}
+
+size_t ITSClusterTask::addDenseHistogram(TH1* histogram, int nBins)
+{
+  if (histogram->GetNbinsX() != nBins) {
+    throw std::runtime_error(std::string("Unexpected number of bins in ") + histogram->GetName());
+  }
+  size_t offset = mNDenseCounters;
+  mDenseHistograms.push_back({ histogram, offset, nBins });
+  mNDenseCounters += nBins + 1;
+  return offset;
+}
+
+void ITSClusterTask::mergeThreadCounters()
+{
+  // reduce all the thread counters into the first one
+  auto& total = mThreadCounters[0];
+  if (mThreadCounters.size() > 1) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_t i = 0; i < mNDenseCounters; i++) {
+      for (size_t thread = 1; thread < mThreadCounters.size(); thread++) {
+        total[i] += mThreadCounters[thread][i];
+        mThreadCounters[thread][i] = 0;
+      }
+    }
+  }
+
+  // occupancies
+  for (const auto& location : mChipLocations) {
+    if (location.layer < 0 || total[location.occupancy] == 0) {
+      continue;
+    }
+    if (location.layer < NLayerIB) {
+      mClusterOccupancyIB[location.layer][location.stave][location.chip] += total[location.occupancy];
+      mClusterOccupancyIBmonitor[location.layer][location.stave][location.chip] += total[location.occupancy];
+    } else {
+      mClusterOccupancyOB[location.layer][location.stave][location.chip] += total[location.occupancy];
+      mClusterOccupancyOBmonitor[location.layer][location.stave][location.chip] += total[location.occupancy];
+    }
+    // several sensors share the same location, the counter must be added only once
+    total[location.occupancy] = 0;
+  }
+
+  // histograms. The statistics are updated as TH1::Fill would do with the integer values, overflows are not included.
+  for (const auto& dense : mDenseHistograms) {
+    const uint32_t* counts = total.data() + dense.offset;
+    double stats[4];
+    dense.histogram->GetStats(stats);
+    uint64_t entries = 0;
+    for (int value = 0; value <= dense.nBins; value++) {
+      if (counts[value] == 0) {
+        continue;
+      }
+      dense.histogram->AddBinContent(value + 1, counts[value]);
+      entries += counts[value];
+      if (value < dense.nBins) {
+        stats[0] += counts[value];
+        stats[1] += counts[value];
+        stats[2] += 1. * counts[value] * value;
+        stats[3] += 1. * counts[value] * value * value;
+      }
+    }
+    if (entries > 0) {
+      dense.histogram->PutStats(stats);
+      dense.histogram->SetEntries(dense.histogram->GetEntries() + entries);
+    }
+  }
+  std::fill(total.begin(), total.end(), 0);
+}
+
 void ITSClusterTask::updateOccMonitorPlots()
 {
 
@@ -563,7 +700,7 @@ void ITSClusterTask::getStavePoint(int layer, int stave, double* px, double* py)
 
 void ITSClusterTask::getJsonParameters()
 {
-  mNThreads = stoi(mCustomParameters.find("nThreads")->second);
+  mNThreads = std::max(1, stoi(mCustomParameters.find("nThreads")->second));
   nBCbins = stoi(mCustomParameters.find("nBCbins")->second);
   mGeomPath = mCustomParameters["geomPath"];
 
@@ -95,6 +95,7 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
   getParameters();
   o2::base::GeometryManager::loadGeometry(mGeomPath.c_str());
   mGeom = o2::its::GeometryTGeo::Instance();
+  mChipDescriptors = getITSChipDescriptors(*mGeom);
   int numOfChips = mGeom->getNumberOfChips();
 
   mGeneralOccupancy = new TH2Poly();
@@ -567,54 +568,25 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
 
   // get the position of all chips in this layer
   for (int ichip = ChipBoundary[lay]; ichip < ChipBoundary[lay + 1]; ichip++) {
-    int stave = 0, chip = 0;
+    const auto& descriptor = (*mChipDescriptors)[ichip];
     auto glo = mGeom->getMatrixL2G(ichip)(loc);
-    if (lay < NLayerIB) {
-      stave = ichip / 9 - StaveBoundary[lay];
-      chip = ichip % 9;
-      mChipEta[stave][chip] = glo.eta();
-      mChipPhi[stave][chip] = glo.phi();
-    } else {
-      stave = (ichip - ChipBoundary[lay]) / (14 * nHicPerStave[lay]);
-      chip = (ichip - ChipBoundary[lay]) % (14 * nHicPerStave[lay]);
-      mChipEta[stave][chip] = glo.eta();
-      mChipPhi[stave][chip] = glo.phi();
-    }
+    mChipEta[descriptor.stave][descriptor.chipInStave] = glo.eta();
+    mChipPhi[descriptor.stave][descriptor.chipInStave] = glo.phi();
   }
 
   while ((mChipDataBuffer = mDecoder->getNextChipData(mChipsBuffer))) {
     if (mChipDataBuffer) {
-      int stave = 0, chip = 0;
-      int hic = 0;
-      int lane = 0;
+      // all the pixels belong to the same chip, so that its position is decoded once
+      const auto& descriptor = (*mChipDescriptors)[mChipDataBuffer->getChipID()];
       const auto& pixels = mChipDataBuffer->getData();
+      mHitnumberLane[descriptor.stave][descriptor.lane] += pixels.size();
+      mChipStat[descriptor.stave][descriptor.chipInStave] += pixels.size();
+      auto& digits = digVec[descriptor.stave][descriptor.hic];
       for (auto& pixel : pixels) {
-        if (lay < NLayerIB) {
-          stave = mChipDataBuffer->getChipID() / 9 - StaveBoundary[lay];
-          chip = mChipDataBuffer->getChipID() % 9;
-          hic = 0;
-          mHitnumberLane[stave][chip]++;
-          mChipStat[stave][chip]++;
-        } else {
-          stave = (mChipDataBuffer->getChipID() - ChipBoundary[lay]) / (14 * nHicPerStave[lay]);
-          int chipIdLocal = (mChipDataBuffer->getChipID() - ChipBoundary[lay]) % (14 * nHicPerStave[lay]);
-          chip = chipIdLocal % 14;
-          hic = (chipIdLocal % (14 * nHicPerStave[lay])) / 14;
-
-          lane = (chipIdLocal % (14 * nHicPerStave[lay])) / (14 / 2);
-          mHitnumberLane[stave][lane]++;
-          mChipStat[stave][chipIdLocal]++;
-        }
-        digVec[stave][hic].emplace_back(mChipDataBuffer->getChipID(), pixel.getRow(), pixel.getCol());
+        digits.emplace_back(mChipDataBuffer->getChipID(), pixel.getRow(), pixel.getCol());
       }
-      if (lay < NLayerIB) {
-        if (pixels.size() > (unsigned int)mHitCutForCheck) {
-          mChipStaveEventHitCheck[lay]->Fill(chip, stave);
-        }
-      } else {
-        if (pixels.size() > (unsigned int)mHitCutForCheck) {
-          mChipStaveEventHitCheck[lay]->Fill(lane, stave);
-        }
+      if (pixels.size() > (unsigned int)mHitCutForCheck) {
+        mChipStaveEventHitCheck[lay]->Fill(descriptor.lane, descriptor.stave);
       }
     }
   }
@@ -641,13 +613,12 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     int istave = activeStaves[i];
     if (lay < NLayerIB) {
       for (auto& digit : digVec[istave][0]) {
-        mHitPixelID_InStave[istave][0][digit.getChipIndex() % 9][1000 * digit.getColumn() + digit.getRow()]++;
+        mHitPixelID_InStave[istave][0][(*mChipDescriptors)[digit.getChipIndex()].chip][1000 * digit.getColumn() + digit.getRow()]++;
       }
     } else {
       for (int ihic = 0; ihic < nHicPerStave[lay]; ihic++) {
         for (auto& digit : digVec[istave][ihic]) {
-          int chip = ((digit.getChipIndex() - ChipBoundary[lay]) % (14 * nHicPerStave[lay])) % 14;
-          mHitPixelID_InStave[istave][ihic][chip][1000 * digit.getColumn() + digit.getRow()]++;
+          mHitPixelID_InStave[istave][ihic][(*mChipDescriptors)[digit.getChipIndex()].chip][1000 * digit.getColumn() + digit.getRow()]++;
         }
       }
     }
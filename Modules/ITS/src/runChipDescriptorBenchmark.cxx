@@ -0,0 +1,146 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   runChipDescriptorBenchmark.cxx
+///
+/// \brief Compares the decoding of the ITS chip IDs with the shared descriptor table against the arithmetic which the
+/// tasks used to do for each hit.
+///
+
+#include "ITS/ITSChipDescriptors.h"
+
+#include <DetectorsBase/GeometryManager.h>
+#include <ITSBase/GeometryTGeo.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::its;
+
+namespace
+{
+constexpr int NLayer = 7;
+constexpr int NLayerIB = 3;
+constexpr int nHicPerStave[NLayer] = { 1, 1, 1, 8, 8, 14, 14 };
+constexpr int ChipBoundary[NLayer + 1] = { 0, 108, 252, 432, 3120, 6480, 14712, 24120 };
+constexpr int StaveBoundary[NLayer + 1] = { 0, 12, 28, 48, 72, 102, 144, 192 };
+
+// the decoding as done in ITSFhrTask::monitorData, one layer at a time
+uint64_t decodeArithmetic(const std::vector<uint16_t>& chipIDs, int lay)
+{
+  uint64_t checksum = 0;
+  for (auto chipID : chipIDs) {
+    int stave = 0, chip = 0, hic = 0, lane = 0;
+    if (lay < NLayerIB) {
+      stave = chipID / 9 - StaveBoundary[lay];
+      chip = chipID % 9;
+      lane = chip;
+    } else {
+      stave = (chipID - ChipBoundary[lay]) / (14 * nHicPerStave[lay]);
+      int chipIdLocal = (chipID - ChipBoundary[lay]) % (14 * nHicPerStave[lay]);
+      chip = chipIdLocal % 14;
+      hic = (chipIdLocal % (14 * nHicPerStave[lay])) / 14;
+      lane = (chipIdLocal % (14 * nHicPerStave[lay])) / (14 / 2);
+    }
+    checksum += stave + chip + hic + lane;
+  }
+  return checksum;
+}
+
+uint64_t decodeTable(const std::vector<uint16_t>& chipIDs, const ITSChipDescriptorTable& table)
+{
+  uint64_t checksum = 0;
+  for (auto chipID : chipIDs) {
+    const auto& descriptor = table[chipID];
+    checksum += descriptor.stave + descriptor.chip + descriptor.hic + descriptor.lane;
+  }
+  return checksum;
+}
+
+template <typename Function>
+double measure(size_t repetitions, size_t lookups, uint64_t& checksum, Function&& function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repetitions; i++) {
+    checksum += function();
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return elapsed / (repetitions * lookups);
+}
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                         //
+      ("help,h", "Help screen")                                                                                //
+      ("lookups", bpo::value<size_t>()->default_value(1000000), "Number of chip IDs decoded per repetition")   //
+      ("repetitions", bpo::value<size_t>()->default_value(100), "Number of repetitions for each layer")        //
+      ("seed", bpo::value<uint32_t>()->default_value(0), "Seed of the random chip IDs")                        //
+      ("geomPath", bpo::value<std::string>()->default_value(""), "Path of the geometry file, as in the ITS tasks");
+
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    auto lookups = vm["lookups"].as<size_t>();
+    auto repetitions = vm["repetitions"].as<size_t>();
+    std::default_random_engine generator(vm["seed"].as<uint32_t>());
+
+    o2::base::GeometryManager::loadGeometry(vm["geomPath"].as<std::string>().c_str());
+    auto geometry = o2::its::GeometryTGeo::Instance();
+
+    auto buildStart = std::chrono::steady_clock::now();
+    auto table = getITSChipDescriptors(*geometry);
+    auto buildTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - buildStart).count();
+    std::cout << "# table of " << table->size() << " chips (" << table->size() * sizeof(ITSChipDescriptor) / 1024
+              << " kB) built in " << buildTime << " us\n";
+
+    std::cout << "layer,arithmetic_ns,table_ns,speedup\n";
+    uint64_t checksumArithmetic = 0, checksumTable = 0;
+    for (int lay = 0; lay < NLayer; lay++) {
+      // random chips of one layer, as the tasks decode the data of one layer at a time
+      std::uniform_int_distribution<uint16_t> distribution(ChipBoundary[lay], ChipBoundary[lay + 1] - 1);
+      std::vector<uint16_t> chipIDs(lookups);
+      for (auto& chipID : chipIDs) {
+        chipID = distribution(generator);
+      }
+
+      auto arithmetic = measure(repetitions, lookups, checksumArithmetic, [&]() { return decodeArithmetic(chipIDs, lay); });
+      auto lookup = measure(repetitions, lookups, checksumTable, [&]() { return decodeTable(chipIDs, *table); });
+      std::cout << lay << "," << arithmetic << "," << lookup << "," << arithmetic / lookup << "\n";
+    }
+
+    if (checksumArithmetic != checksumTable) {
+      std::cerr << "The decoded positions differ: " << checksumArithmetic << " vs " << checksumTable << std::endl;
+      return 1;
+    }
+  } catch (const bpo::error& ex) {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  } catch (...) {
+    std::cerr << boost::current_exception_diagnostic_information(true) << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
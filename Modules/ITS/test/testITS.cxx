@@ -15,6 +15,7 @@
 ///
 
 #include "QualityControl/TaskFactory.h"
+#include "ITS/ITSChipDescriptors.h"
 
 #define BOOST_TEST_MODULE Publisher test
 #define BOOST_TEST_MAIN
@@ -31,6 +32,116 @@ namespace itstaskraw
 
 BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
 
+namespace
+{
+// the chip ID accessors of o2::its::GeometryTGeo, for the ITS layout, so that the test does not need the geometry file
+struct ITSLayout {
+  static constexpr int NLayer = 7;
+  static constexpr int NLayerIB = 3;
+  static constexpr int nStaves[NLayer] = { 12, 16, 20, 24, 30, 42, 48 };
+  static constexpr int nHalfStaves[NLayer] = { 0, 0, 0, 2, 2, 2, 2 };
+  static constexpr int nModules[NLayer] = { 0, 0, 0, 4, 4, 7, 7 };
+  static constexpr int nChipsPerModule[NLayer] = { 9, 9, 9, 14, 14, 14, 14 };
+  static constexpr int nChipRowsPerModule[NLayer] = { 1, 1, 1, 2, 2, 2, 2 };
+
+  int getNumberOfStaves(int lay) const { return nStaves[lay]; }
+  int getNumberOfModules(int lay) const { return nModules[lay]; }
+  int getNumberOfChipsPerModule(int lay) const { return nChipsPerModule[lay]; }
+  int getNumberOfChipRowsPerModule(int lay) const { return nChipRowsPerModule[lay]; }
+  int getNumberOfChipsPerStave(int lay) const { return lay < NLayerIB ? nChipsPerModule[lay] : nChipsPerModule[lay] * nModules[lay] * nHalfStaves[lay]; }
+  int getNumberOfChips() const
+  {
+    int chips = 0;
+    for (int lay = 0; lay < NLayer; lay++) {
+      chips += nStaves[lay] * getNumberOfChipsPerStave(lay);
+    }
+    return chips;
+  }
+  int getChipIdInStave(int index) const
+  {
+    int lay = 0;
+    while (index >= nStaves[lay] * getNumberOfChipsPerStave(lay)) {
+      index -= nStaves[lay] * getNumberOfChipsPerStave(lay);
+      lay++;
+    }
+    return index % getNumberOfChipsPerStave(lay);
+  }
+  bool getChipId(int index, int& lay, int& sta, int& ssta, int& mod, int& chip) const
+  {
+    if (index < 0 || index >= getNumberOfChips()) {
+      return false;
+    }
+    lay = 0;
+    while (index >= nStaves[lay] * getNumberOfChipsPerStave(lay)) {
+      index -= nStaves[lay] * getNumberOfChipsPerStave(lay);
+      lay++;
+    }
+    sta = index / getNumberOfChipsPerStave(lay);
+    int chipInStave = index % getNumberOfChipsPerStave(lay);
+    if (lay < NLayerIB) {
+      ssta = -1;
+      mod = -1;
+      chip = chipInStave;
+    } else {
+      int chipsPerHalfStave = nChipsPerModule[lay] * nModules[lay];
+      ssta = chipInStave / chipsPerHalfStave;
+      mod = (chipInStave % chipsPerHalfStave) / nChipsPerModule[lay];
+      chip = chipInStave % nChipsPerModule[lay];
+    }
+    return true;
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(chip_descriptors)
+{
+  using namespace o2::quality_control_modules::its;
+  ITSLayout layout;
+  auto builder = [&layout](size_t chipID, ITSChipDescriptor& descriptor) { fillITSChipDescriptor(layout, chipID, descriptor); };
+  auto table = ITSChipDescriptorTable::getShared("testITS", layout.getNumberOfChips(), builder);
+  BOOST_REQUIRE_EQUAL(table->size(), 24120);
+  BOOST_CHECK_EQUAL(table.get(), ITSChipDescriptorTable::getShared("testITS", layout.getNumberOfChips(), builder).get());
+
+  // last chip of the first IB stave
+  const auto& ib = (*table)[8];
+  BOOST_CHECK_EQUAL(ib.layer, 0);
+  BOOST_CHECK_EQUAL(ib.stave, 0);
+  BOOST_CHECK_EQUAL(ib.halfStave, 0);
+  BOOST_CHECK_EQUAL(ib.hic, 0);
+  BOOST_CHECK_EQUAL(ib.chip, 8);
+  BOOST_CHECK_EQUAL(ib.lane, 8);
+  // first chip of the second stave of layer 2
+  const auto& ib2 = (*table)[261];
+  BOOST_CHECK_EQUAL(ib2.layer, 2);
+  BOOST_CHECK_EQUAL(ib2.stave, 1);
+  BOOST_CHECK_EQUAL(ib2.chip, 0);
+  BOOST_CHECK_EQUAL(ib2.staveIndex, 29);
+
+  // layer 3: 8 HICs of 14 chips per stave, the second half stave starts with the 5th HIC
+  const auto& ob = (*table)[432 + 112 + 4 * 14 + 9];
+  BOOST_CHECK_EQUAL(ob.layer, 3);
+  BOOST_CHECK_EQUAL(ob.stave, 1);
+  BOOST_CHECK_EQUAL(ob.halfStave, 1);
+  BOOST_CHECK_EQUAL(ob.module, 0);
+  BOOST_CHECK_EQUAL(ob.hic, 4);
+  BOOST_CHECK_EQUAL(ob.chip, 9);
+  BOOST_CHECK_EQUAL(ob.lane, 9);
+  BOOST_CHECK_EQUAL(ob.chipInStave, 65);
+  BOOST_CHECK_EQUAL(ob.staveIndex, 49);
+
+  const auto& last = (*table)[24119];
+  BOOST_CHECK_EQUAL(last.layer, 6);
+  BOOST_CHECK_EQUAL(last.stave, 47);
+  BOOST_CHECK_EQUAL(last.hic, 13);
+  BOOST_CHECK_EQUAL(last.lane, 27);
+  BOOST_CHECK_EQUAL(last.staveIndex, 191);
+
+  // chips out of the geometry are left with the default descriptor
+  ITSChipDescriptor outside;
+  fillITSChipDescriptor(layout, 24120, outside);
+  BOOST_CHECK_EQUAL(outside.layer, -1);
+}
+
 } // namespace itstaskraw
 } // namespace quality_control_modules
 } // namespace o2
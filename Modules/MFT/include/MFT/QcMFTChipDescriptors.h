@@ -0,0 +1,52 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   QcMFTChipDescriptors.h
+///
+
+#ifndef QC_MFT_CHIP_DESCRIPTORS_H
+#define QC_MFT_CHIP_DESCRIPTORS_H
+
+#include "Common/ChipDescriptorTable.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace o2::quality_control_modules::mft
+{
+
+/// \brief Position of an MFT chip and its bins in the summary histograms, as given by ChipMappingMFT.
+struct alignas(32) QcMFTChipDescriptor {
+  int8_t half = 0;
+  int8_t disk = 0;
+  int8_t layer = 0;
+  int8_t face = 0;
+  int8_t zone = 0;
+  int8_t sensor = 0;       // local chip SW ID
+  int8_t transID = 0;      // cable
+  int8_t chipInLadder = 0; // position of the chip in the ladder
+  int8_t ladder = 0;       // ladder ID in QcMFTUtilTables, used in the names of the objects
+  int16_t module = 0;      // module ID in ChipMappingMFT, i.e. the global ladder index
+  int16_t summaryBinX = 0; // disk * 2 + face
+  int16_t summaryBinY = 0; // zone + half * 4
+  float x = 0;             // position in the chip occupancy maps
+  float y = 0;
+};
+
+using QcMFTChipDescriptorTable = o2::quality_control_modules::common::ChipDescriptorTable<QcMFTChipDescriptor>;
+
+/// \brief Returns the table of all the MFT chips, shared by all the tasks of the process.
+std::shared_ptr<const QcMFTChipDescriptorTable> getMFTChipDescriptors();
+
+} // namespace o2::quality_control_modules::mft
+
+#endif // QC_MFT_CHIP_DESCRIPTORS_H
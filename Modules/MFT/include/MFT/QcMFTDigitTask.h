@@ -28,6 +28,7 @@
 #include <ITSMFTReconstruction/ChipMappingMFT.h>
 // Quality Control
 #include "QualityControl/TaskInterface.h"
+#include "MFT/QcMFTChipDescriptors.h"
 
 using namespace o2::quality_control::core;
 
@@ -72,16 +73,7 @@ class QcMFTDigitTask final : public TaskInterface
   int mOccupancyMapIndexOfChips[936] = { 0 };
   int mVectorIndexOfOccupancyMaps[20] = { 0 };
 
-  int mHalf[936] = { 0 };
-  int mDisk[936] = { 0 };
-  int mFace[936] = { 0 };
-  int mZone[936] = { 0 };
-  int mSensor[936] = { 0 };
-  int mTransID[936] = { 0 };
-  int mLayer[936] = { 0 };
-  int mLadder[936] = { 0 };
-  float mX[936] = { 0 };
-  float mY[936] = { 0 };
+  std::shared_ptr<const QcMFTChipDescriptorTable> mChipDescriptors; // all the chip information used per digit
 
   std::unique_ptr<TH1F> mMergerTest = nullptr;
   std::unique_ptr<TH1F> mDigitChipOccupancy = nullptr;
@@ -92,13 +84,6 @@ class QcMFTDigitTask final : public TaskInterface
   std::vector<std::unique_ptr<TH2F>> mDigitPixelOccupancyMap;
 
   // new ladder vs double column histrograms
-  int mChipLadder[936] = { 0 };
-  int mChipPositionInLadder[936] = { 0 };
-  int mChipsInLadder[280] = { 0 };
-  int mHalfLadder[280] = { 0 };
-  int mDiskLadder[280] = { 0 };
-  int mFaceLadder[280] = { 0 };
-  int mZoneLadder[280] = { 0 };
   std::vector<std::unique_ptr<TH2F>> mDigitLadderDoubleColumnOccupancyMap;
 
   //  functions
@@ -109,7 +94,6 @@ class QcMFTDigitTask final : public TaskInterface
   void getNameOfChipOccupancyMap(TString& folderName, TString& histogramName, int iOccupancyMapIndex);
   void getNameOfPixelOccupancyMap(TString& folderName, TString& histogramName, int iChipIndex);
   void resetArrays(int* array1, int* array2, int* array3);
-  void getChipMapData();
 };
 
 } // namespace o2::quality_control_modules::mft
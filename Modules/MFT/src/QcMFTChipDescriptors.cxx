@@ -0,0 +1,54 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   QcMFTChipDescriptors.cxx
+///
+
+// O2
+#include <ITSMFTReconstruction/ChipMappingMFT.h>
+// Quality Control
+#include "MFT/QcMFTChipDescriptors.h"
+#include "MFT/QcMFTUtilTables.h"
+
+namespace o2::quality_control_modules::mft
+{
+
+std::shared_ptr<const QcMFTChipDescriptorTable> getMFTChipDescriptors()
+{
+  // the mappings are only instantiated when the table has to be built
+  std::unique_ptr<o2::itsmft::ChipMappingMFT> mapMFT;
+  std::unique_ptr<QcMFTUtilTables> tables;
+
+  return QcMFTChipDescriptorTable::getShared("MFT", o2::itsmft::ChipMappingMFT::NChips, [&](size_t chipID, QcMFTChipDescriptor& descriptor) {
+    if (!mapMFT) {
+      mapMFT = std::make_unique<o2::itsmft::ChipMappingMFT>();
+      tables = std::make_unique<QcMFTUtilTables>();
+    }
+    const auto& data = mapMFT->getChipMappingData()[chipID];
+    descriptor.half = data.half;
+    descriptor.disk = data.disk;
+    descriptor.layer = data.layer;
+    descriptor.face = data.layer % 2;
+    descriptor.zone = data.zone;
+    descriptor.sensor = data.localChipSWID;
+    descriptor.transID = data.cable;
+    descriptor.chipInLadder = data.chipOnModule;
+    descriptor.ladder = tables->mLadder[chipID];
+    descriptor.module = data.module;
+    descriptor.summaryBinX = descriptor.disk * 2 + descriptor.face;
+    descriptor.summaryBinY = descriptor.zone + descriptor.half * 4;
+    descriptor.x = tables->mX[chipID];
+    descriptor.y = tables->mY[chipID];
+  });
+}
+
+} // namespace o2::quality_control_modules::mft
@@ -31,6 +31,7 @@
 #include "MFT/QcMFTDigitTask.h"
 #include "MFT/QcMFTUtilTables.h"
 // C++
+#include <algorithm>
 #include <fstream>
 
 namespace o2::quality_control_modules::mft
@@ -57,7 +58,7 @@ void QcMFTDigitTask::initialize(o2::framework::InitContext& /*ctx*/)
     mNoiseScan = stoi(param->second);
   }
 
-  getChipMapData();
+  mChipDescriptors = getMFTChipDescriptors();
 
   //  reset arrays of vector and chip IDs
   resetArrays(mVectorIndexOfChips, mOccupancyMapIndexOfChips, mVectorIndexOfOccupancyMaps);
@@ -118,13 +119,24 @@ void QcMFTDigitTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   // --Ladder occupancy maps
   //==============================================
+  // the first chip of each ladder gives its position, the number of chips comes from the last one
+  const QcMFTChipDescriptor* firstChipInLadder[280] = { nullptr };
+  int chipsInLadder[280] = { 0 };
+  for (size_t iChip = 0; iChip < mChipDescriptors->size(); iChip++) {
+    const auto& chip = (*mChipDescriptors)[iChip];
+    if (firstChipInLadder[chip.module] == nullptr) {
+      firstChipInLadder[chip.module] = &chip;
+    }
+    chipsInLadder[chip.module] = std::max(chipsInLadder[chip.module], chip.chipInLadder + 1);
+  }
   for (int i = 0; i < 280; i++) { // there are 280 ladders
+    const auto& chip = *firstChipInLadder[i];
     auto ladderHistogram = std::make_unique<TH2F>(
-      Form("LadderMaps/h%d-d%d-f%d-z%d-l%d", mHalfLadder[i], mDiskLadder[i], mFaceLadder[i], mZoneLadder[i], i),
-      Form("Digit Occupancy h%d-d%d-f%d-z%d-l%d; Double column; Chip", mHalfLadder[i], mDiskLadder[i], mFaceLadder[i], mZoneLadder[i], i),
+      Form("LadderMaps/h%d-d%d-f%d-z%d-l%d", chip.half, chip.disk, chip.face, chip.zone, i),
+      Form("Digit Occupancy h%d-d%d-f%d-z%d-l%d; Double column; Chip", chip.half, chip.disk, chip.face, chip.zone, i),
       512, -0.5, 511.5, // double columns per chip
-      mChipsInLadder[i], -0.5, mChipsInLadder[i] - 0.5);
-    for (int iBin = 0; iBin < mChipsInLadder[i]; iBin++)
+      chipsInLadder[i], -0.5, chipsInLadder[i] - 0.5);
+    for (int iBin = 0; iBin < chipsInLadder[i]; iBin++)
       ladderHistogram->GetYaxis()->SetBinLabel(iBin + 1, Form("%d", iBin));
     ladderHistogram->SetStats(0);
     ladderHistogram->SetOption("colz");
@@ -224,18 +236,17 @@ void QcMFTDigitTask::monitorData(o2::framework::ProcessingContext& ctx)
   for (auto& oneDigit : digits) {
 
     int chipIndex = oneDigit.getChipIndex();
+    const auto& chip = (*mChipDescriptors)[chipIndex];
 
     // fill ladder histogram
-    mDigitLadderDoubleColumnOccupancyMap[mChipLadder[chipIndex]]->Fill(oneDigit.getColumn() >> 1, mChipPositionInLadder[chipIndex]);
+    mDigitLadderDoubleColumnOccupancyMap[chip.module]->Fill(oneDigit.getColumn() >> 1, chip.chipInLadder);
 
     int vectorIndex = getVectorIndexPixelOccupancyMap(chipIndex);
     if (vectorIndex < 0) // if the chip is not from wanted FLP, the array will give -1
       continue;
 
     // fill info into the summary histo
-    int xBin = mDisk[chipIndex] * 2 + mFace[chipIndex];
-    int yBin = mZone[chipIndex] + mHalf[chipIndex] * 4;
-    mDigitOccupancySummary->Fill(xBin, yBin);
+    mDigitOccupancySummary->Fill(chip.summaryBinX, chip.summaryBinY);
 
     // fill pixel hit maps
     if (mNoiseScan == 1)
@@ -250,7 +261,7 @@ void QcMFTDigitTask::monitorData(o2::framework::ProcessingContext& ctx)
     int vectorOccupancyMapIndex = getVectorIndexChipOccupancyMap(chipIndex);
     if (vectorOccupancyMapIndex < 0)
       continue;
-    mDigitChipOccupancyMap[vectorOccupancyMapIndex]->Fill(mX[chipIndex], mY[chipIndex]);
+    mDigitChipOccupancyMap[vectorOccupancyMapIndex]->Fill(chip.x, chip.y);
   }
 }
 
@@ -304,42 +315,12 @@ void QcMFTDigitTask::getNameOfChipOccupancyMap(TString& folderName, TString& his
 
 void QcMFTDigitTask::getNameOfPixelOccupancyMap(TString& folderName, TString& histogramName, int iChipIndex)
 {
+  const auto& chip = (*mChipDescriptors)[iChipIndex];
   folderName = Form("PixelOccupancyMaps/Half_%d/Disk_%d/Face_%d/mDigitPixelOccupancyMap-z%d-l%d-s%d-tr%d",
-                    mHalf[iChipIndex], mDisk[iChipIndex], mFace[iChipIndex], mZone[iChipIndex],
-                    mLadder[iChipIndex], mSensor[iChipIndex], mTransID[iChipIndex]);
+                    chip.half, chip.disk, chip.face, chip.zone, chip.ladder, chip.sensor, chip.transID);
 
   histogramName = Form("Pixel Map h%d-d%d-f%d-z%d-l%d-s%d-tr%d",
-                       mHalf[iChipIndex], mDisk[iChipIndex], mFace[iChipIndex], mZone[iChipIndex],
-                       mLadder[iChipIndex], mSensor[iChipIndex], mTransID[iChipIndex]);
-}
-
-void QcMFTDigitTask::getChipMapData()
-{
-  const o2::itsmft::ChipMappingMFT mapMFT;
-  auto chipMapData = mapMFT.getChipMappingData();
-  QcMFTUtilTables MFTTable;
-
-  for (int i = 0; i < 936; i++) {
-    mHalf[i] = chipMapData[i].half;
-    mDisk[i] = chipMapData[i].disk;
-    mLayer[i] = chipMapData[i].layer;
-    mFace[i] = mLayer[i] % 2;
-    mZone[i] = chipMapData[i].zone;
-    mSensor[i] = chipMapData[i].localChipSWID;
-    mTransID[i] = chipMapData[i].cable;
-    mLadder[i] = MFTTable.mLadder[i];
-    mX[i] = MFTTable.mX[i];
-    mY[i] = MFTTable.mY[i];
-    // info needed for ladder histograms
-    mChipLadder[i] = chipMapData[i].module;
-    mChipPositionInLadder[i] = chipMapData[i].chipOnModule;
-    if (mChipsInLadder[mChipLadder[i]] < (mChipPositionInLadder[i] + 1))
-      mChipsInLadder[mChipLadder[i]]++;
-    mHalfLadder[mChipLadder[i]] = mHalf[i];
-    mDiskLadder[mChipLadder[i]] = mDisk[i];
-    mFaceLadder[mChipLadder[i]] = mFace[i];
-    mZoneLadder[mChipLadder[i]] = mZone[i];
-  }
+                       chip.half, chip.disk, chip.face, chip.zone, chip.ladder, chip.sensor, chip.transID);
 }
 
 int QcMFTDigitTask::getVectorIndexChipOccupancyMap(int chipIndex)
@@ -400,7 +381,8 @@ int QcMFTDigitTask::getChipIndexPixelOccupancyMap(int vectorIndex)
   //  (opposite matching)
   mVectorIndexOfChips[chipIndex] = vectorIndex;
   //  fill the array of hit map ID for corresponding chipIndex
-  mOccupancyMapIndexOfChips[chipIndex] = mLayer[chipIndex] + mHalf[chipIndex] * numberOfOccupancyMaps / 2;
+  const auto& chip = (*mChipDescriptors)[chipIndex];
+  mOccupancyMapIndexOfChips[chipIndex] = chip.layer + chip.half * numberOfOccupancyMaps / 2;
 
   return chipIndex;
 }
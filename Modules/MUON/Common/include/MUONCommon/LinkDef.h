@@ -5,5 +5,7 @@
 
 #pragma link C++ class o2::quality_control_modules::muon::MergeableTH1Ratio + ;
 #pragma link C++ class o2::quality_control_modules::muon::MergeableTH2Ratio + ;
+#pragma link C++ enum o2::quality_control_modules::muon::MergeableTH1Ratio::DenominatorMode;
+#pragma link C++ enum o2::quality_control_modules::muon::MergeableTH2Ratio::DenominatorMode;
 
 #endif
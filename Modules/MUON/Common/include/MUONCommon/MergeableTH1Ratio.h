@@ -31,12 +31,23 @@ namespace o2::quality_control_modules::muon
 class MergeableTH1Ratio : public TH1F, public o2::mergers::MergeInterface
 {
  public:
+  /// \brief How the denominator of the ratio is stored
+  ///
+  /// Histogram keeps one denominator per bin, Scalar a single value for all bins, e.g. the number of processed TFs.
+  /// In the latter case no denominator histogram is filled nor shipped, and getDen() returns nullptr.
+  enum class DenominatorMode : int {
+    Histogram = 0,
+    Scalar = 1
+  };
+
   MergeableTH1Ratio() = default;
 
   MergeableTH1Ratio(MergeableTH1Ratio const& copymerge);
 
   MergeableTH1Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, double scaling = 1.);
 
+  MergeableTH1Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, DenominatorMode denominatorMode, double scaling = 1.);
+
   MergeableTH1Ratio(const char* name, const char* title, double scaling = 1.);
 
   ~MergeableTH1Ratio();
@@ -48,11 +59,28 @@ class MergeableTH1Ratio : public TH1F, public o2::mergers::MergeInterface
     return mHistoNum;
   }
 
+  /// \brief Returns the denominator histogram, or nullptr if the denominator is scalar
   TH1D* getDen() const
   {
     return mHistoDen;
   }
 
+  DenominatorMode getDenominatorMode() const
+  {
+    return mDenominatorMode;
+  }
+
+  /// \brief Adds a weight to the scalar denominator (DenominatorMode::Scalar)
+  void fillDen(double weight = 1.)
+  {
+    mScalarDen += weight;
+  }
+
+  double getScalarDen() const
+  {
+    return mScalarDen;
+  }
+
   double getScalingFactor() const
   {
     return mScalingFactor;
@@ -65,8 +93,10 @@ class MergeableTH1Ratio : public TH1F, public o2::mergers::MergeInterface
   TH1D* mHistoDen{ nullptr };
   std::string mTreatMeAs = "TH1F";
   double mScalingFactor = 1.;
+  DenominatorMode mDenominatorMode = DenominatorMode::Histogram;
+  double mScalarDen = 0.;
 
-  ClassDefOverride(MergeableTH1Ratio, 1);
+  ClassDefOverride(MergeableTH1Ratio, 2);
 };
 
 } // namespace o2::quality_control_modules::muon
@@ -19,6 +19,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <vector>
 #include <TObject.h>
 #include <TH2.h>
 #include <TList.h>
@@ -31,12 +32,26 @@ namespace o2::quality_control_modules::muon
 class MergeableTH2Ratio : public TH2F, public o2::mergers::MergeInterface
 {
  public:
+  /// \brief How the denominator of the ratio is stored
+  ///
+  /// Histogram keeps one denominator per bin. The other modes are meant for denominators which are uniform, like the
+  /// number of processed TFs: Scalar keeps a single value for all bins, PerXBin one value per column and PerYBin one
+  /// value per row. They avoid filling and shipping a full denominator histogram, getDen() returns nullptr for them.
+  enum class DenominatorMode : int {
+    Histogram = 0,
+    Scalar = 1,
+    PerXBin = 2,
+    PerYBin = 3
+  };
+
   MergeableTH2Ratio() = default;
 
   MergeableTH2Ratio(MergeableTH2Ratio const& copymerge);
 
   MergeableTH2Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, double scaling = 1., bool showZeroBins = false);
 
+  MergeableTH2Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, DenominatorMode denominatorMode, double scaling = 1., bool showZeroBins = false);
+
   MergeableTH2Ratio(const char* name, const char* title, double scaling = 1., bool showZeroBins = false);
 
   ~MergeableTH2Ratio();
@@ -48,11 +63,41 @@ class MergeableTH2Ratio : public TH2F, public o2::mergers::MergeInterface
     return mHistoNum;
   }
 
+  /// \brief Returns the denominator histogram, or nullptr if the denominator is not stored per bin
   TH2F* getDen() const
   {
     return mHistoDen;
   }
 
+  DenominatorMode getDenominatorMode() const
+  {
+    return mDenominatorMode;
+  }
+
+  /// \brief Adds a weight to the scalar denominator (DenominatorMode::Scalar)
+  void fillDen(double weight = 1.)
+  {
+    mScalarDen += weight;
+  }
+
+  /// \brief Adds a weight to the denominator of one column or row (DenominatorMode::PerXBin or PerYBin)
+  ///
+  /// The bin is numbered as in ROOT, 0 and nbins+1 being the underflow and overflow.
+  void fillDen(int bin, double weight = 1.)
+  {
+    mAxisDen.at(bin) += weight;
+  }
+
+  double getScalarDen() const
+  {
+    return mScalarDen;
+  }
+
+  const std::vector<double>& getAxisDen() const
+  {
+    return mAxisDen;
+  }
+
   double getScalingFactor() const
   {
     return mScalingFactor;
@@ -68,13 +113,18 @@ class MergeableTH2Ratio : public TH2F, public o2::mergers::MergeInterface
   void beautify();
 
  private:
+  double getDenBinContent(int binx, int biny) const;
+
   TH2F* mHistoNum{ nullptr };
   TH2F* mHistoDen{ nullptr };
   std::string mTreatMeAs{ "TH2F" };
   double mScalingFactor{ 1. };
   bool mShowZeroBins{ false };
+  DenominatorMode mDenominatorMode{ DenominatorMode::Histogram };
+  double mScalarDen{ 0. };
+  std::vector<double> mAxisDen;
 
-  ClassDefOverride(MergeableTH2Ratio, 1);
+  ClassDefOverride(MergeableTH2Ratio, 2);
 };
 
 } // namespace o2::quality_control_modules::muon
@@ -15,6 +15,7 @@
 /// \author Piotr Konopka, piotr.jan.konopka@cern.ch, Sebastien Perrin, Andrea Ferrero
 
 #include "MUONCommon/MergeableTH1Ratio.h"
+#include "QualityControl/QcInfoLogger.h"
 
 using namespace std;
 namespace o2::quality_control_modules::muon
@@ -24,16 +25,22 @@ MergeableTH1Ratio::MergeableTH1Ratio(MergeableTH1Ratio const& copymerge)
   : TH1F(copymerge.GetName(), copymerge.GetTitle(),
          copymerge.getNum()->GetXaxis()->GetNbins(), copymerge.getNum()->GetXaxis()->GetXmin(), copymerge.getNum()->GetXaxis()->GetXmax()),
     o2::mergers::MergeInterface(),
-    mScalingFactor(copymerge.getScalingFactor())
+    mScalingFactor(copymerge.getScalingFactor()),
+    mDenominatorMode(copymerge.getDenominatorMode()),
+    mScalarDen(copymerge.getScalarDen())
 {
   Bool_t bStatus = TH1::AddDirectoryStatus();
   TH1::AddDirectory(kFALSE);
   mHistoNum = (TH1D*)copymerge.getNum()->Clone();
-  mHistoDen = (TH1D*)copymerge.getDen()->Clone();
+  if (copymerge.getDen()) {
+    mHistoDen = (TH1D*)copymerge.getDen()->Clone();
+  }
   TH1::AddDirectory(bStatus);
 
   mHistoNum->Sumw2();
-  mHistoDen->Sumw2();
+  if (mHistoDen) {
+    mHistoDen->Sumw2();
+  }
 }
 
 MergeableTH1Ratio::MergeableTH1Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, double scaling)
@@ -53,6 +60,25 @@ MergeableTH1Ratio::MergeableTH1Ratio(const char* name, const char* title, int nb
   update();
 }
 
+MergeableTH1Ratio::MergeableTH1Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, DenominatorMode denominatorMode, double scaling)
+  : TH1F(name, title, nbinsx, xmin, xmax),
+    o2::mergers::MergeInterface(),
+    mScalingFactor(scaling),
+    mDenominatorMode(denominatorMode)
+{
+  Bool_t bStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+  mHistoNum = new TH1D("num", "num", nbinsx, xmin, xmax);
+  mHistoNum->Sumw2();
+  if (mDenominatorMode == DenominatorMode::Histogram) {
+    mHistoDen = new TH1D("den", "den", nbinsx, xmin, xmax);
+    mHistoDen->Sumw2();
+  }
+  TH1::AddDirectory(bStatus);
+
+  update();
+}
+
 MergeableTH1Ratio::MergeableTH1Ratio(const char* name, const char* title, double scaling)
   : TH1F(name, title, 10, 0, 10),
     o2::mergers::MergeInterface(),
@@ -83,8 +109,18 @@ MergeableTH1Ratio::~MergeableTH1Ratio()
 
 void MergeableTH1Ratio::merge(MergeInterface* const other)
 {
-  mHistoNum->Add(dynamic_cast<const MergeableTH1Ratio* const>(other)->getNum());
-  mHistoDen->Add(dynamic_cast<const MergeableTH1Ratio* const>(other)->getDen());
+  auto otherRatio = dynamic_cast<const MergeableTH1Ratio* const>(other);
+  if (otherRatio->getDenominatorMode() != mDenominatorMode) {
+    ILOG(Error, Support) << "Cannot merge '" << GetName() << "', the denominators are stored differently in both objects" << ENDM;
+    return;
+  }
+
+  mHistoNum->Add(otherRatio->getNum());
+  if (mDenominatorMode == DenominatorMode::Scalar) {
+    mScalarDen += otherRatio->getScalarDen();
+  } else {
+    mHistoDen->Add(otherRatio->getDen());
+  }
   update();
 }
 
@@ -97,18 +133,28 @@ void MergeableTH1Ratio::update()
   GetXaxis()->Set(mHistoNum->GetXaxis()->GetNbins(), mHistoNum->GetXaxis()->GetXmin(), mHistoNum->GetXaxis()->GetXmax());
   SetBinsLength();
 
-  // Compute the ratio with a temporary TH1D, then copy the bin contents and errors
-  TH1D* hRatio = (TH1D*)mHistoNum->Clone();
-  hRatio->Divide(mHistoDen);
-
-  for (int i = 1; i <= GetXaxis()->GetNbins(); i++) {
-    SetBinContent(i, hRatio->GetBinContent(i));
-    SetBinError(i, hRatio->GetBinError(i));
+  if (mDenominatorMode == DenominatorMode::Scalar) {
+    // the denominator is a plain count, only the numerator contributes to the errors
+    if (mScalarDen != 0) {
+      for (int i = 1; i <= GetXaxis()->GetNbins(); i++) {
+        SetBinContent(i, mHistoNum->GetBinContent(i) / mScalarDen);
+        SetBinError(i, mHistoNum->GetBinError(i) / mScalarDen);
+      }
+    }
+  } else {
+    // Compute the ratio with a temporary TH1D, then copy the bin contents and errors
+    TH1D* hRatio = (TH1D*)mHistoNum->Clone();
+    hRatio->Divide(mHistoDen);
+
+    for (int i = 1; i <= GetXaxis()->GetNbins(); i++) {
+      SetBinContent(i, hRatio->GetBinContent(i));
+      SetBinError(i, hRatio->GetBinError(i));
+    }
+
+    delete hRatio;
   }
   SetNameTitle(name, title);
 
-  delete hRatio;
-
   // scale plot if needed
   if (mScalingFactor != 1.) {
     Scale(mScalingFactor);
@@ -15,6 +15,7 @@
 /// \author Piotr Konopka, piotr.jan.konopka@cern.ch, Sebastien Perrin, Andrea Ferrero
 
 #include "MUONCommon/MergeableTH2Ratio.h"
+#include "QualityControl/QcInfoLogger.h"
 
 using namespace std;
 namespace o2::quality_control_modules::muon
@@ -26,12 +27,17 @@ MergeableTH2Ratio::MergeableTH2Ratio(MergeableTH2Ratio const& copymerge)
          copymerge.getNum()->GetYaxis()->GetNbins(), copymerge.getNum()->GetYaxis()->GetXmin(), copymerge.getNum()->GetYaxis()->GetXmax()),
     o2::mergers::MergeInterface(),
     mScalingFactor(copymerge.getScalingFactor()),
-    mShowZeroBins(copymerge.getShowZeroBins())
+    mShowZeroBins(copymerge.getShowZeroBins()),
+    mDenominatorMode(copymerge.getDenominatorMode()),
+    mScalarDen(copymerge.getScalarDen()),
+    mAxisDen(copymerge.getAxisDen())
 {
   Bool_t bStatus = TH1::AddDirectoryStatus();
   TH1::AddDirectory(kFALSE);
   mHistoNum = (TH2F*)copymerge.getNum()->Clone();
-  mHistoDen = (TH2F*)copymerge.getDen()->Clone();
+  if (copymerge.getDen()) {
+    mHistoDen = (TH2F*)copymerge.getDen()->Clone();
+  }
   TH1::AddDirectory(bStatus);
 }
 
@@ -49,6 +55,33 @@ MergeableTH2Ratio::MergeableTH2Ratio(const char* name, const char* title, int nb
   update();
 }
 
+MergeableTH2Ratio::MergeableTH2Ratio(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, DenominatorMode denominatorMode, double scaling, bool showZeroBins)
+  : TH2F(name, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax),
+    o2::mergers::MergeInterface(),
+    mScalingFactor(scaling),
+    mShowZeroBins(showZeroBins),
+    mDenominatorMode(denominatorMode)
+{
+  Bool_t bStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+  mHistoNum = new TH2F("num", "num", nbinsx, xmin, xmax, nbinsy, ymin, ymax);
+  switch (mDenominatorMode) {
+    case DenominatorMode::Histogram:
+      mHistoDen = new TH2F("den", "den", nbinsx, xmin, xmax, nbinsy, ymin, ymax);
+      break;
+    case DenominatorMode::PerXBin:
+      mAxisDen.assign(nbinsx + 2, 0.);
+      break;
+    case DenominatorMode::PerYBin:
+      mAxisDen.assign(nbinsy + 2, 0.);
+      break;
+    case DenominatorMode::Scalar:
+      break;
+  }
+  TH1::AddDirectory(bStatus);
+  update();
+}
+
 MergeableTH2Ratio::MergeableTH2Ratio(const char* name, const char* title, double scaling, bool showZeroBins)
   : TH2F(name, title, 10, 0, 10, 10, 0, 10),
     o2::mergers::MergeInterface(),
@@ -76,11 +109,44 @@ MergeableTH2Ratio::~MergeableTH2Ratio()
 
 void MergeableTH2Ratio::merge(MergeInterface* const other)
 {
-  mHistoNum->Add(dynamic_cast<const MergeableTH2Ratio* const>(other)->getNum());
-  mHistoDen->Add(dynamic_cast<const MergeableTH2Ratio* const>(other)->getDen());
+  auto otherRatio = dynamic_cast<const MergeableTH2Ratio* const>(other);
+  if (otherRatio->getDenominatorMode() != mDenominatorMode || otherRatio->getAxisDen().size() != mAxisDen.size()) {
+    ILOG(Error, Support) << "Cannot merge '" << GetName() << "', the denominators are stored differently in both objects" << ENDM;
+    return;
+  }
+
+  mHistoNum->Add(otherRatio->getNum());
+  switch (mDenominatorMode) {
+    case DenominatorMode::Histogram:
+      mHistoDen->Add(otherRatio->getDen());
+      break;
+    case DenominatorMode::Scalar:
+      mScalarDen += otherRatio->getScalarDen();
+      break;
+    case DenominatorMode::PerXBin:
+    case DenominatorMode::PerYBin:
+      for (size_t bin = 0; bin < mAxisDen.size(); bin++) {
+        mAxisDen[bin] += otherRatio->getAxisDen()[bin];
+      }
+      break;
+  }
   update();
 }
 
+double MergeableTH2Ratio::getDenBinContent(int binx, int biny) const
+{
+  switch (mDenominatorMode) {
+    case DenominatorMode::Scalar:
+      return mScalarDen;
+    case DenominatorMode::PerXBin:
+      return mAxisDen[binx];
+    case DenominatorMode::PerYBin:
+      return mAxisDen[biny];
+    default:
+      return mHistoDen->GetBinContent(binx, biny);
+  }
+}
+
 void MergeableTH2Ratio::update()
 {
   static constexpr double sOrbitLengthInNanoseconds = 3564 * 25;
@@ -96,7 +162,22 @@ void MergeableTH2Ratio::update()
   GetYaxis()->Set(mHistoNum->GetYaxis()->GetNbins(), mHistoNum->GetYaxis()->GetXmin(), mHistoNum->GetYaxis()->GetXmax());
   SetBinsLength();
 
-  Divide(mHistoNum, mHistoDen);
+  if (mDenominatorMode == DenominatorMode::Histogram) {
+    Divide(mHistoNum, mHistoDen);
+  } else {
+    // the denominator is a plain count, only the numerator contributes to the errors
+    for (int binx = 0; binx <= mHistoNum->GetXaxis()->GetNbins() + 1; binx++) {
+      for (int biny = 0; biny <= mHistoNum->GetYaxis()->GetNbins() + 1; biny++) {
+        double den = getDenBinContent(binx, biny);
+        if (den == 0) {
+          continue;
+        }
+        SetBinContent(binx, biny, mHistoNum->GetBinContent(binx, biny) / den);
+        SetBinError(binx, biny, mHistoNum->GetBinError(binx, biny) / den);
+      }
+    }
+    SetEntries(mHistoNum->GetEntries());
+  }
   SetNameTitle(name, title);
 
   // convertion to KHz units
@@ -113,7 +194,7 @@ void MergeableTH2Ratio::update()
     // plotted in white
     for (int binx = 1; binx <= mHistoNum->GetXaxis()->GetNbins(); binx++) {
       for (int biny = 1; biny <= mHistoNum->GetYaxis()->GetNbins(); biny++) {
-        if (mHistoNum->GetBinContent(binx, biny) == 0 && mHistoDen->GetBinContent(binx, biny) != 0) {
+        if (mHistoNum->GetBinContent(binx, biny) == 0 && getDenBinContent(binx, biny) != 0) {
           SetBinContent(binx, biny, 0.000001);
           SetBinError(binx, biny, 1);
         }
@@ -0,0 +1,330 @@
+// Copyright 2019-2022 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testMergeableRatio.cxx
+///
+
+#include "MUONCommon/MergeableTH1Ratio.h"
+#include "MUONCommon/MergeableTH2Ratio.h"
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TObjArray.h>
+#include <TStreamerElement.h>
+#include <TStreamerInfo.h>
+#include <TStreamerInfoActions.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE MergeableRatio test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control_modules::muon;
+
+namespace
+{
+/// Streams the ratio with the layout of the version 1 of its class, which did not have the given members, and reads it
+/// back with the current class, as ROOT does with the objects stored by the version 1.
+template <typename Ratio>
+std::unique_ptr<Ratio> writeAndReadAsVersion1(Ratio& ratio, const std::vector<std::string>& newMembers)
+{
+  TClass* cl = Ratio::Class();
+  auto version1 = static_cast<TStreamerInfo*>(cl->GetStreamerInfos()->At(1));
+  if (version1 == nullptr) {
+    auto current = static_cast<TStreamerInfo*>(cl->GetStreamerInfo());
+    version1 = new TStreamerInfo(cl);
+    version1->SetClassVersion(1);
+    for (int i = 0; i < current->GetElements()->GetEntriesFast(); i++) {
+      auto element = static_cast<TStreamerElement*>(current->GetElements()->At(i));
+      if (std::find(newMembers.begin(), newMembers.end(), element->GetName()) == newMembers.end()) {
+        version1->GetElements()->Add(element->Clone());
+      }
+    }
+    cl->RegisterStreamerInfo(version1);
+    version1->BuildOld();
+  }
+
+  TBufferFile buffer(TBuffer::kWrite);
+  UInt_t start = buffer.Length();
+  buffer << UInt_t(0); // the byte count, set once the object is written
+  buffer << Version_t(1);
+  buffer.ApplySequence(*version1->GetWriteObjectWiseActions(), &ratio);
+  buffer.SetByteCount(start, kTRUE);
+
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  auto read = std::make_unique<Ratio>();
+  read->Streamer(buffer);
+  return read;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_th1_ratio_histogram_denominator)
+{
+  MergeableTH1Ratio ratio("ratio", "ratio", 4, 0, 4);
+  BOOST_CHECK(ratio.getDenominatorMode() == MergeableTH1Ratio::DenominatorMode::Histogram);
+  BOOST_REQUIRE(ratio.getDen() != nullptr);
+  ratio.getNum()->Fill(0.5, 2);
+  ratio.getDen()->Fill(0.5, 4);
+  ratio.getNum()->Fill(1.5, 3);
+  ratio.getDen()->Fill(1.5, 3);
+  ratio.update();
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2), 1.0, 1e-6);
+  BOOST_CHECK_EQUAL(ratio.GetBinContent(3), 0);
+
+  MergeableTH1Ratio other("ratio", "ratio", 4, 0, 4);
+  other.getNum()->Fill(0.5, 6);
+  other.getDen()->Fill(0.5, 4);
+  other.getNum()->Fill(2.5, 1);
+  other.getDen()->Fill(2.5, 4);
+  other.update();
+
+  ratio.merge(&other);
+  BOOST_CHECK_CLOSE(ratio.getDen()->GetBinContent(1), 8, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1), 1.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2), 1.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(3), 0.25, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_th1_ratio_scalar_denominator)
+{
+  MergeableTH1Ratio ratio("ratio", "ratio", 4, 0, 4, MergeableTH1Ratio::DenominatorMode::Scalar);
+  BOOST_CHECK(ratio.getDenominatorMode() == MergeableTH1Ratio::DenominatorMode::Scalar);
+  BOOST_CHECK(ratio.getDen() == nullptr);
+
+  // without any denominator, the ratio stays empty
+  ratio.getNum()->Fill(0.5, 4);
+  ratio.update();
+  BOOST_CHECK_EQUAL(ratio.GetBinContent(1), 0);
+
+  ratio.getNum()->Fill(1.5);
+  ratio.fillDen(2);
+  ratio.update();
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1), 2.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinError(1), 2.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2), 0.5, 1e-6);
+
+  MergeableTH1Ratio other("ratio", "ratio", 4, 0, 4, MergeableTH1Ratio::DenominatorMode::Scalar);
+  other.getNum()->Fill(0.5, 2);
+  other.fillDen();
+  other.fillDen();
+  other.update();
+
+  ratio.merge(&other);
+  BOOST_CHECK_CLOSE(ratio.getScalarDen(), 4, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1), 1.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2), 0.25, 1e-6);
+
+  // the denominators stored differently cannot be merged, the object is left as it was
+  MergeableTH1Ratio histogramRatio("ratio", "ratio", 4, 0, 4);
+  histogramRatio.getNum()->Fill(0.5, 10);
+  histogramRatio.getDen()->Fill(0.5, 1);
+  ratio.merge(&histogramRatio);
+  BOOST_CHECK_CLOSE(ratio.getScalarDen(), 4, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1), 1.5, 1e-6);
+
+  MergeableTH1Ratio copy(ratio);
+  BOOST_CHECK(copy.getDenominatorMode() == MergeableTH1Ratio::DenominatorMode::Scalar);
+  BOOST_CHECK(copy.getDen() == nullptr);
+  BOOST_CHECK_CLOSE(copy.getScalarDen(), 4, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_th1_ratio_version_1)
+{
+  MergeableTH1Ratio ratio("ratio", "ratio", 4, 0, 4);
+  ratio.getNum()->Fill(0.5, 3);
+  ratio.getDen()->Fill(0.5, 4);
+  // not stored by the version 1, it should not be read back
+  ratio.fillDen(5);
+  ratio.update();
+
+  auto read = writeAndReadAsVersion1(ratio, { "mDenominatorMode", "mScalarDen" });
+  BOOST_CHECK_EQUAL(std::string(read->GetName()), "ratio");
+  BOOST_CHECK(read->getDenominatorMode() == MergeableTH1Ratio::DenominatorMode::Histogram);
+  BOOST_CHECK_EQUAL(read->getScalarDen(), 0);
+  BOOST_REQUIRE(read->getDen() != nullptr);
+  BOOST_CHECK_CLOSE(read->getDen()->GetBinContent(1), 4, 1e-6);
+  BOOST_CHECK_CLOSE(read->GetBinContent(1), 0.75, 1e-6);
+
+  // an object of the version 1 merges with the current ones
+  MergeableTH1Ratio other("ratio", "ratio", 4, 0, 4);
+  other.getNum()->Fill(0.5, 1);
+  other.getDen()->Fill(0.5, 4);
+  read->merge(&other);
+  BOOST_CHECK_CLOSE(read->GetBinContent(1), 0.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_th2_ratio_histogram_denominator)
+{
+  MergeableTH2Ratio ratio("ratio", "ratio", 3, 0, 3, 2, 0, 2);
+  BOOST_CHECK(ratio.getDenominatorMode() == MergeableTH2Ratio::DenominatorMode::Histogram);
+  BOOST_REQUIRE(ratio.getDen() != nullptr);
+  ratio.getNum()->Fill(0.5, 0.5, 3);
+  ratio.getDen()->Fill(0.5, 0.5, 6);
+  ratio.getNum()->Fill(2.5, 1.5, 2);
+  ratio.getDen()->Fill(2.5, 1.5, 2);
+  ratio.update();
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(3, 2), 1.0, 1e-6);
+  BOOST_CHECK_EQUAL(ratio.GetBinContent(2, 1), 0);
+
+  MergeableTH2Ratio other("ratio", "ratio", 3, 0, 3, 2, 0, 2);
+  other.getNum()->Fill(0.5, 0.5, 1);
+  other.getDen()->Fill(0.5, 0.5, 2);
+  other.update();
+
+  ratio.merge(&other);
+  BOOST_CHECK_CLOSE(ratio.getDen()->GetBinContent(1, 1), 8, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(3, 2), 1.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_th2_ratio_scalar_denominator)
+{
+  MergeableTH2Ratio ratio("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::Scalar);
+  BOOST_CHECK(ratio.getDen() == nullptr);
+  BOOST_CHECK(ratio.getAxisDen().empty());
+  BOOST_CHECK_THROW(ratio.fillDen(1, 1.), std::out_of_range);
+
+  ratio.getNum()->Fill(0.5, 0.5, 4);
+  ratio.getNum()->Fill(1.5, 1.5, 1);
+  ratio.fillDen(2.);
+  ratio.update();
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 2.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2, 2), 0.5, 1e-6);
+  BOOST_CHECK_EQUAL(ratio.GetEntries(), 2);
+
+  MergeableTH2Ratio other("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::Scalar);
+  other.getNum()->Fill(0.5, 0.5, 2);
+  other.fillDen(2.);
+  other.update();
+
+  ratio.merge(&other);
+  BOOST_CHECK_CLOSE(ratio.getScalarDen(), 4, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 1.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2, 2), 0.25, 1e-6);
+
+  // the denominators stored differently cannot be merged, the object is left as it was
+  MergeableTH2Ratio histogramRatio("ratio", "ratio", 3, 0, 3, 2, 0, 2);
+  histogramRatio.getNum()->Fill(0.5, 0.5, 10);
+  histogramRatio.getDen()->Fill(0.5, 0.5, 1);
+  ratio.merge(&histogramRatio);
+  BOOST_CHECK_CLOSE(ratio.getScalarDen(), 4, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 1.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_th2_ratio_per_x_bin_denominator)
+{
+  MergeableTH2Ratio ratio("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::PerXBin);
+  BOOST_CHECK(ratio.getDen() == nullptr);
+  // the underflow and overflow columns have their own denominators
+  BOOST_REQUIRE_EQUAL(ratio.getAxisDen().size(), 5);
+  BOOST_CHECK_THROW(ratio.fillDen(5), std::out_of_range);
+
+  ratio.getNum()->Fill(0.5, 0.5, 2);
+  ratio.getNum()->Fill(0.5, 1.5, 4);
+  ratio.getNum()->Fill(1.5, 0.5, 1);
+  ratio.getNum()->Fill(2.5, 0.5, 1);
+  ratio.fillDen(1, 4);
+  ratio.fillDen(2, 2);
+  ratio.update();
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 2), 1.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2, 1), 0.5, 1e-6);
+  // no denominator for the third column
+  BOOST_CHECK_EQUAL(ratio.GetBinContent(3, 1), 0);
+
+  MergeableTH2Ratio other("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::PerXBin);
+  other.getNum()->Fill(0.5, 0.5, 6);
+  other.fillDen(1, 4);
+  other.update();
+
+  ratio.merge(&other);
+  BOOST_CHECK_CLOSE(ratio.getAxisDen()[1], 8, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 1.0, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 2), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(2, 1), 0.5, 1e-6);
+
+  // the denominators of objects with other binnings cannot be merged
+  MergeableTH2Ratio otherBinning("ratio", "ratio", 4, 0, 4, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::PerXBin);
+  otherBinning.fillDen(1, 100);
+  ratio.merge(&otherBinning);
+  BOOST_CHECK_CLOSE(ratio.getAxisDen()[1], 8, 1e-6);
+
+  MergeableTH2Ratio copy(ratio);
+  BOOST_CHECK(copy.getDenominatorMode() == MergeableTH2Ratio::DenominatorMode::PerXBin);
+  BOOST_CHECK(copy.getAxisDen() == ratio.getAxisDen());
+}
+
+BOOST_AUTO_TEST_CASE(test_th2_ratio_per_y_bin_denominator)
+{
+  MergeableTH2Ratio ratio("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::PerYBin);
+  BOOST_CHECK(ratio.getDen() == nullptr);
+  BOOST_REQUIRE_EQUAL(ratio.getAxisDen().size(), 4);
+
+  ratio.getNum()->Fill(0.5, 0.5, 1);
+  ratio.getNum()->Fill(2.5, 1.5, 2);
+  ratio.fillDen(1, 2);
+  ratio.fillDen(2, 4);
+  ratio.update();
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(3, 2), 0.5, 1e-6);
+
+  MergeableTH2Ratio other("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::PerYBin);
+  other.getNum()->Fill(2.5, 1.5, 6);
+  other.fillDen(2, 4);
+  other.update();
+
+  ratio.merge(&other);
+  BOOST_CHECK_CLOSE(ratio.getAxisDen()[2], 8, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(3, 2), 1.0, 1e-6);
+
+  // a ratio with a denominator per column is not merged into one with a denominator per row
+  MergeableTH2Ratio perXBin("ratio", "ratio", 3, 0, 3, 2, 0, 2, MergeableTH2Ratio::DenominatorMode::PerXBin);
+  perXBin.getNum()->Fill(0.5, 0.5, 10);
+  perXBin.fillDen(1, 1);
+  ratio.merge(&perXBin);
+  BOOST_CHECK_CLOSE(ratio.GetBinContent(1, 1), 0.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_th2_ratio_version_1)
+{
+  MergeableTH2Ratio ratio("ratio", "ratio", 3, 0, 3, 2, 0, 2);
+  ratio.getNum()->Fill(1.5, 0.5, 3);
+  ratio.getDen()->Fill(1.5, 0.5, 4);
+  // not stored by the version 1, it should not be read back
+  ratio.fillDen(5.);
+  ratio.update();
+
+  auto read = writeAndReadAsVersion1(ratio, { "mDenominatorMode", "mScalarDen", "mAxisDen" });
+  BOOST_CHECK_EQUAL(std::string(read->GetName()), "ratio");
+  BOOST_CHECK(read->getDenominatorMode() == MergeableTH2Ratio::DenominatorMode::Histogram);
+  BOOST_CHECK_EQUAL(read->getScalarDen(), 0);
+  BOOST_CHECK(read->getAxisDen().empty());
+  BOOST_REQUIRE(read->getDen() != nullptr);
+  BOOST_CHECK_CLOSE(read->getDen()->GetBinContent(2, 1), 4, 1e-6);
+  BOOST_CHECK_CLOSE(read->GetBinContent(2, 1), 0.75, 1e-6);
+
+  // an object of the version 1 merges with the current ones
+  MergeableTH2Ratio other("ratio", "ratio", 3, 0, 3, 2, 0, 2);
+  other.getNum()->Fill(1.5, 0.5, 1);
+  other.getDen()->Fill(1.5, 0.5, 4);
+  read->merge(&other);
+  BOOST_CHECK_CLOSE(read->GetBinContent(2, 1), 0.5, 1e-6);
+}
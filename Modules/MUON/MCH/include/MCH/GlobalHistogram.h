@@ -19,7 +19,9 @@
 #ifndef QC_MODULE_MUONCHAMBERS_GLOBALHISTOGRAM_H
 #define QC_MODULE_MUONCHAMBERS_GLOBALHISTOGRAM_H
 
+#include <cstdint>
 #include <map>
+#include <vector>
 #include <TH2.h>
 
 namespace o2
@@ -42,6 +44,8 @@ class DetectorHistogram
   ~DetectorHistogram();
 
   void Fill(double padX, double padY, double padSizeX, double padSizeY, double val = 1);
+  /// \brief Same as Fill(), but the range of bins covered by the pad is only computed for the first digit of each pad
+  void FillPad(int padId, double padX, double padY, double padSizeX, double padSizeY, double val = 1);
   void Set(double padX, double padY, double padSizeX, double padSizeY, double val);
 
   int getNbinsX();
@@ -54,8 +58,19 @@ class DetectorHistogram
   TH2F* getHist() { return mHist.first; }
 
  private:
+  // inclusive range of bins covered by a pad, kept small as one is cached for each pad
+  struct BinRange {
+    int16_t xMin{ 0 };
+    int16_t xMax{ -1 }; // negative until the range is computed
+    int16_t yMin{ 0 };
+    int16_t yMax{ -1 };
+  };
+
   void init();
   void addContour();
+  void cacheAxes();
+  BinRange getBinRange(double padX, double padY, double padSizeX, double padSizeY) const;
+  void fillBinRange(const BinRange& range, double val);
 
   int mDeId{ 0 };
   int mCathode{ 0 };
@@ -71,6 +86,15 @@ class DetectorHistogram
 
   float mHistWidth{ 0 };
   float mHistHeight{ 0 };
+
+  // copy of the axes of the histogram, so that the bins are found without TAxis::FindBin
+  int mNbinsX{ 0 };
+  int mNbinsY{ 0 };
+  double mAxisXmin{ 0 };
+  double mAxisXmax{ 0 };
+  double mAxisYmin{ 0 };
+  double mAxisYmax{ 0 };
+  std::vector<BinRange> mPadBinRanges; // indexed by the pad ID
 };
 
 class GlobalHistogram
@@ -94,6 +118,17 @@ class GlobalHistogram
   TH2F* getHist() { return mHist.first; }
 
  private:
+  // position of a detection element in the global histogram and its extent for each cathode
+  struct DeGeometry {
+    float x0[2];
+    float y0[2];
+    float xMin[2];
+    float xMax[2];
+    float yMin[2];
+    float yMax[2];
+  };
+
+  const DeGeometry& getDeGeometry(int de);
   void initST345();
   void initST12();
   void getDeCenter(int de, float& xB0, float& yB0, float& xNB0, float& yNB0);
@@ -106,6 +141,7 @@ class GlobalHistogram
   TString mTitle;
   int mId;
   std::pair<TH2F*, bool> mHist;
+  std::map<int, DeGeometry> mDeGeometry; // computed once per detection element, the segmentation does not change
 };
 
 } // namespace muonchambers
@@ -82,7 +82,7 @@ void DecodingErrorsTask::initialize(o2::framework::InitContext& /*ic*/)
   mSolar2Fee = createSolar2FeeLinkMapper<ElectronicMapperGenerated>();
 
   // Number of decoding errors, grouped by chamber ID and normalized to the number of processed TF
-  mHistogramErrorsPerChamber = std::make_shared<MergeableTH2Ratio>("DecodingErrorsPerChamber", "Chamber Number vs. Error Type", getErrorCodesSize(), 0, getErrorCodesSize(), 10, 1, 11);
+  mHistogramErrorsPerChamber = std::make_shared<MergeableTH2Ratio>("DecodingErrorsPerChamber", "Chamber Number vs. Error Type", getErrorCodesSize(), 0, getErrorCodesSize(), 10, 1, 11, MergeableTH2Ratio::DenominatorMode::Scalar);
   setXAxisLabels(mHistogramErrorsPerChamber.get());
   setYAxisLabels(mHistogramErrorsPerChamber.get());
   mHistogramErrorsPerChamber->SetOption("colz");
@@ -92,7 +92,7 @@ void DecodingErrorsTask::initialize(o2::framework::InitContext& /*ic*/)
   }
 
   // Number of decoding errors, grouped by FEE ID and normalized to the number of processed TF
-  mHistogramErrorsPerFeeId = std::make_shared<MergeableTH2Ratio>("DecodingErrorsPerFeeId", "FEE ID vs. Error Type", getErrorCodesSize(), 0, getErrorCodesSize(), 64, 0, 64);
+  mHistogramErrorsPerFeeId = std::make_shared<MergeableTH2Ratio>("DecodingErrorsPerFeeId", "FEE ID vs. Error Type", getErrorCodesSize(), 0, getErrorCodesSize(), 64, 0, 64, MergeableTH2Ratio::DenominatorMode::Scalar);
   setXAxisLabels(mHistogramErrorsPerFeeId.get());
   mHistogramErrorsPerFeeId->SetOption("colz");
   mAllHistograms.push_back(mHistogramErrorsPerFeeId.get());
@@ -235,7 +235,6 @@ void DecodingErrorsTask::plotError(int solarId, int dsAddr, int chip, uint32_t e
 
 void DecodingErrorsTask::monitorData(o2::framework::ProcessingContext& ctx)
 {
-  static int nTF = 0;
   for (auto&& input : ctx.inputs()) {
     if (input.spec->binding == "readout") {
       decodeReadout(input);
@@ -248,22 +247,9 @@ void DecodingErrorsTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
-  // Count the number of processed TF and set the denominators of the error histograms accordingly
-  nTF += 1;
-
-  auto hTF = mHistogramErrorsPerChamber->getDen();
-  for (int ybin = 0; ybin <= hTF->GetYaxis()->GetNbins(); ybin++) {
-    for (int xbin = 0; xbin <= hTF->GetXaxis()->GetNbins(); xbin++) {
-      hTF->SetBinContent(xbin, ybin, nTF);
-    }
-  }
-
-  hTF = mHistogramErrorsPerFeeId->getDen();
-  for (int ybin = 0; ybin <= hTF->GetYaxis()->GetNbins(); ybin++) {
-    for (int xbin = 0; xbin <= hTF->GetXaxis()->GetNbins(); xbin++) {
-      hTF->SetBinContent(xbin, ybin, nTF);
-    }
-  }
+  // Count the number of processed TF, which is the denominator of all the bins of the error histograms
+  mHistogramErrorsPerChamber->fillDen();
+  mHistogramErrorsPerFeeId->fillDen();
 }
 
 void DecodingErrorsTask::writeHistos()
@@ -16,6 +16,7 @@
 /// \author Andrea Ferrero
 ///
 
+#include <algorithm>
 #include <iostream>
 #include <TLine.h>
 #include <TList.h>
@@ -275,6 +276,7 @@ DetectorHistogram::DetectorHistogram(TString name, TString title, int deId, int
   : mName(name), mTitle(title), mDeId(deId), mCathode(cathode), mFlipX(getDetectorFlipX(deId)), mFlipY(getDetectorFlipY(deId)), mShiftX(getDetectorShiftX(deId)), mShiftY(getDetectorShiftY(deId))
 {
   mHist = std::make_pair(new TH2F(name, title, getNbinsX(), getXmin(), getXmax(), getNbinsY(), getYmin(), getYmax()), true);
+  cacheAxes();
   addContour();
   mHist.first->SetOption("colz");
 }
@@ -366,6 +368,18 @@ void DetectorHistogram::init()
   mHist.first->GetXaxis()->Set(getNbinsX(), getXmin(), getXmax());
   mHist.first->GetYaxis()->Set(getNbinsY(), getYmin(), getYmax());
   mHist.first->SetBinsLength();
+  cacheAxes();
+}
+
+void DetectorHistogram::cacheAxes()
+{
+  mNbinsX = mHist.first->GetXaxis()->GetNbins();
+  mNbinsY = mHist.first->GetYaxis()->GetNbins();
+  mAxisXmin = mHist.first->GetXaxis()->GetXmin();
+  mAxisXmax = mHist.first->GetXaxis()->GetXmax();
+  mAxisYmin = mHist.first->GetYaxis()->GetXmin();
+  mAxisYmax = mHist.first->GetYaxis()->GetXmax();
+  mPadBinRanges.clear();
 }
 
 void DetectorHistogram::addContour()
@@ -402,12 +416,20 @@ void DetectorHistogram::addContour()
   }
 }
 
-void DetectorHistogram::Fill(double padX, double padY, double padSizeX, double padSizeY, double val)
+// same as TAxis::FindBin for a fixed bin width axis which cannot be extended
+static int findBin(double x, double min, double max, int nBins)
 {
-  if (!mHist.first) {
-    return;
+  if (x < min) {
+    return 0;
   }
+  if (!(x < max)) {
+    return nBins + 1;
+  }
+  return 1 + static_cast<int>(nBins * (x - min) / (max - min));
+}
 
+DetectorHistogram::BinRange DetectorHistogram::getBinRange(double padX, double padY, double padSizeX, double padSizeY) const
+{
   padX += mShiftX;
   padY += mShiftY;
 
@@ -418,41 +440,108 @@ void DetectorHistogram::Fill(double padX, double padY, double padSizeX, double p
     padY *= -1.0;
   }
 
-  int binx_min = mHist.first->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-  int binx_max = mHist.first->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-  int biny_min = mHist.first->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-  int biny_max = mHist.first->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-  for (int by = biny_min; by <= biny_max; by++) {
-    float y = mHist.first->GetYaxis()->GetBinCenter(by);
-    for (int bx = binx_min; bx <= binx_max; bx++) {
-      float x = mHist.first->GetXaxis()->GetBinCenter(bx);
-      mHist.first->Fill(x, y, val);
+  BinRange range;
+  range.xMin = findBin(padX - padSizeX / 2 + 0.1, mAxisXmin, mAxisXmax, mNbinsX);
+  range.xMax = findBin(padX + padSizeX / 2 - 0.1, mAxisXmin, mAxisXmax, mNbinsX);
+  range.yMin = findBin(padY - padSizeY / 2 + 0.1, mAxisYmin, mAxisYmax, mNbinsY);
+  range.yMax = findBin(padY + padSizeY / 2 - 0.1, mAxisYmin, mAxisYmax, mNbinsY);
+  return range;
+}
+
+void DetectorHistogram::fillBinRange(const BinRange& range, double val)
+{
+  if (range.xMin > range.xMax || range.yMin > range.yMax) {
+    return;
+  }
+
+  auto hist = mHist.first;
+
+  // the statistics are updated as TH2::Fill at each bin center would do, under- and overflows do not contribute.
+  // They are retrieved before touching the contents, in case GetStats() has to recompute them from the bins.
+  double stats[TH1::kNstat];
+  hist->GetStats(stats);
+  double entries = hist->GetEntries() + (range.xMax - range.xMin + 1) * (range.yMax - range.yMin + 1);
+
+  const double binWidthX = (mAxisXmax - mAxisXmin) / mNbinsX;
+  const double binWidthY = (mAxisYmax - mAxisYmin) / mNbinsY;
+  double sumX = 0, sumX2 = 0, sumY = 0, sumY2 = 0;
+  int nX = 0, nY = 0;
+  for (int bx = std::max(range.xMin, 1); bx <= std::min(range.xMax, mNbinsX); bx++, nX++) {
+    double x = mAxisXmin + (bx - 0.5) * binWidthX;
+    sumX += x;
+    sumX2 += x * x;
+  }
+  for (int by = std::max(range.yMin, 1); by <= std::min(range.yMax, mNbinsY); by++, nY++) {
+    double y = mAxisYmin + (by - 0.5) * binWidthY;
+    sumY += y;
+    sumY2 += y * y;
+  }
+
+  // increment the contents in place, row by row
+  float* contents = hist->GetArray();
+  double* sumw2 = hist->GetSumw2N() > 0 ? hist->GetSumw2()->GetArray() : nullptr;
+  const int stride = mNbinsX + 2;
+  for (int by = range.yMin; by <= range.yMax; by++) {
+    int bin = by * stride + range.xMin;
+    for (int bx = range.xMin; bx <= range.xMax; bx++, bin++) {
+      contents[bin] += val;
+      if (sumw2) {
+        sumw2[bin] += val * val;
+      }
     }
   }
+
+  if (nX > 0 && nY > 0) {
+    stats[0] += val * nX * nY;
+    stats[1] += val * val * nX * nY;
+    stats[2] += val * nY * sumX;
+    stats[3] += val * nY * sumX2;
+    stats[4] += val * nX * sumY;
+    stats[5] += val * nX * sumY2;
+    stats[6] += val * sumX * sumY;
+  }
+  hist->PutStats(stats);
+  hist->SetEntries(entries);
 }
 
-void DetectorHistogram::Set(double padX, double padY, double padSizeX, double padSizeY, double val)
+void DetectorHistogram::Fill(double padX, double padY, double padSizeX, double padSizeY, double val)
 {
   if (!mHist.first) {
     return;
   }
 
-  padX += mShiftX;
-  padY += mShiftY;
+  fillBinRange(getBinRange(padX, padY, padSizeX, padSizeY), val);
+}
 
-  if (mFlipX) {
-    padX *= -1.0;
+void DetectorHistogram::FillPad(int padId, double padX, double padY, double padSizeX, double padSizeY, double val)
+{
+  if (!mHist.first) {
+    return;
   }
-  if (mFlipY) {
-    padY *= -1.0;
+  if (padId < 0) {
+    Fill(padX, padY, padSizeX, padSizeY, val);
+    return;
+  }
+
+  if (padId >= static_cast<int>(mPadBinRanges.size())) {
+    mPadBinRanges.resize(padId + 1);
   }
+  auto& range = mPadBinRanges[padId];
+  if (range.xMax < 0) {
+    range = getBinRange(padX, padY, padSizeX, padSizeY);
+  }
+  fillBinRange(range, val);
+}
 
-  int binx_min = mHist.first->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-  int binx_max = mHist.first->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-  int biny_min = mHist.first->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-  int biny_max = mHist.first->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-  for (int by = biny_min; by <= biny_max; by++) {
-    for (int bx = binx_min; bx <= binx_max; bx++) {
+void DetectorHistogram::Set(double padX, double padY, double padSizeX, double padSizeY, double val)
+{
+  if (!mHist.first) {
+    return;
+  }
+
+  auto range = getBinRange(padX, padY, padSizeX, padSizeY);
+  for (int by = range.yMin; by <= range.yMax; by++) {
+    for (int bx = range.xMin; bx <= range.xMax; bx++) {
       mHist.first->SetBinContent(bx, by, val);
     }
   }
@@ -756,15 +845,6 @@ void GlobalHistogram::getDeCenterST12(int de, float& xB0, float& yB0, float& xNB
     xB0 += getNHistPerChamberX(mId) * deWidth * 2;
     xNB0 += getNHistPerChamberX(mId) * deWidth * 2;
   }
-
-  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-  if ((&segment) == nullptr) {
-    return;
-  }
-  const o2::mch::mapping::CathodeSegmentation& csegment = segment.bending();
-  o2::mch::contour::Contour<double> envelop = o2::mch::mapping::getEnvelop(csegment);
-  std::vector<o2::mch::contour::Vertex<double>> vertices = envelop.getVertices();
-  o2::mch::contour::BBox<double> bbox = o2::mch::mapping::getBBox(csegment);
 }
 
 void GlobalHistogram::getDeCenterST3(int de, float& xB0, float& yB0, float& xNB0, float& yNB0)
@@ -835,8 +915,6 @@ void GlobalHistogram::getDeCenterST3(int de, float& xB0, float& yB0, float& xNB0
     return;
   }
   const o2::mch::mapping::CathodeSegmentation& csegment = segment.bending();
-  o2::mch::contour::Contour<double> envelop = o2::mch::mapping::getEnvelop(csegment);
-  std::vector<o2::mch::contour::Vertex<double>> vertices = envelop.getVertices();
   o2::mch::contour::BBox<double> bbox = o2::mch::mapping::getBBox(csegment);
 
   double xmax = bbox.xmax();
@@ -944,8 +1022,6 @@ void GlobalHistogram::getDeCenterST4(int de, float& xB0, float& yB0, float& xNB0
     return;
   }
   const o2::mch::mapping::CathodeSegmentation& csegment = segment.bending();
-  o2::mch::contour::Contour<double> envelop = o2::mch::mapping::getEnvelop(csegment);
-  std::vector<o2::mch::contour::Vertex<double>> vertices = envelop.getVertices();
   o2::mch::contour::BBox<double> bbox = o2::mch::mapping::getBBox(csegment);
 
   double xmax = bbox.xmax();
@@ -978,6 +1054,47 @@ void GlobalHistogram::getDeCenterST5(int de, float& xB0, float& yB0, float& xNB0
   xNB0 += getNHistPerChamberX(mId) * 2 * deWidth;
 }
 
+const GlobalHistogram::DeGeometry& GlobalHistogram::getDeGeometry(int de)
+{
+  auto cached = mDeGeometry.find(de);
+  if (cached != mDeGeometry.end()) {
+    return cached->second;
+  }
+
+  DeGeometry geometry;
+  float xB0, yB0, xNB0, yNB0;
+  getDeCenter(de, xB0, yB0, xNB0, yNB0);
+  geometry.x0[0] = xB0;
+  geometry.x0[1] = xNB0;
+  geometry.y0[0] = yB0;
+  geometry.y0[1] = yNB0;
+
+  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+  o2::mch::contour::BBox<double> bbox[2] = { o2::mch::mapping::getBBox(segment.bending()),
+                                            o2::mch::mapping::getBBox(segment.nonBending()) };
+
+  bool flipX = getDetectorFlipX(de);
+  bool flipY = getDetectorFlipY(de);
+  float shiftX = getDetectorShiftX(de);
+  float shiftY = getDetectorShiftY(de);
+
+  for (int i = 0; i < 2; i++) {
+    if (mId == 0) {
+      geometry.xMin[i] = flipX ? geometry.x0[i] - 1.0 * (bbox[i].width() + shiftX) : geometry.x0[i] + shiftX;
+      geometry.xMax[i] = flipX ? geometry.x0[i] - shiftX : (geometry.x0[i] + bbox[i].width() + shiftX);
+      geometry.yMin[i] = flipY ? geometry.y0[i] - 1.0 * (bbox[i].height() + shiftY) : geometry.y0[i] + shiftY;
+      geometry.yMax[i] = flipY ? geometry.y0[i] - shiftY : (geometry.y0[i] + bbox[i].height() + shiftY);
+    } else {
+      geometry.xMin[i] = static_cast<float>(geometry.x0[i] - bbox[i].width() / 2);
+      geometry.xMax[i] = static_cast<float>(geometry.x0[i] + bbox[i].width() / 2);
+      geometry.yMin[i] = static_cast<float>(geometry.y0[i] + bbox[i].ymin());
+      geometry.yMax[i] = static_cast<float>(geometry.y0[i] + bbox[i].ymax());
+    }
+  }
+
+  return mDeGeometry.emplace(de, geometry).first->second;
+}
+
 void GlobalHistogram::add(std::map<int, std::shared_ptr<DetectorHistogram>>& histB, std::map<int, std::shared_ptr<DetectorHistogram>>& histNB)
 {
   set(histB, histNB, false);
@@ -1021,41 +1138,13 @@ void GlobalHistogram::set(std::map<int, std::shared_ptr<DetectorHistogram>>& his
 
     TH2F* hist[2] = { hB->getHist(), hNB->getHist() };
 
-    float xB0, yB0, xNB0, yNB0;
-    getDeCenter(de, xB0, yB0, xNB0, yNB0);
-
-    float x0[2] = { xB0, xNB0 };
-    float y0[2] = { yB0, yNB0 };
-
-    const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-    const o2::mch::mapping::CathodeSegmentation& csegmentB = segment.bending();
-    o2::mch::contour::BBox<double> bboxB = o2::mch::mapping::getBBox(csegmentB);
-    o2::mch::contour::Contour<double> envelopB = o2::mch::mapping::getEnvelop(csegmentB);
-
-    const o2::mch::mapping::CathodeSegmentation& csegmentNB = segment.nonBending();
-    o2::mch::contour::BBox<double> bboxNB = o2::mch::mapping::getBBox(csegmentNB);
-    o2::mch::contour::Contour<double> envelopNB = o2::mch::mapping::getEnvelop(csegmentNB);
-
-    float xMin[2] = { static_cast<float>(xB0 - bboxB.width() / 2), static_cast<float>(xNB0 - bboxNB.width() / 2) };
-    float xMax[2] = { static_cast<float>(xB0 + bboxB.width() / 2), static_cast<float>(xNB0 + bboxNB.width() / 2) };
-    float yMin[2] = { static_cast<float>(yB0 + bboxB.ymin()), static_cast<float>(yNB0 + bboxNB.ymin()) };
-    float yMax[2] = { static_cast<float>(yB0 + bboxB.ymax()), static_cast<float>(yNB0 + bboxNB.ymax()) };
-
-    if (mId == 0) {
-      bool flipX = getDetectorFlipX(de);
-      bool flipY = getDetectorFlipY(de);
-      float shiftX = getDetectorShiftX(de);
-      float shiftY = getDetectorShiftY(de);
-      xMin[0] = flipX ? xB0 - 1.0 * (bboxB.width() + shiftX) : xB0 + shiftX;
-      xMin[1] = flipX ? xNB0 - 1.0 * (bboxNB.width() + shiftX) : xNB0 + shiftX;
-      xMax[0] = flipX ? xB0 - shiftX : (xB0 + bboxB.width() + shiftX);
-      xMax[1] = flipX ? xNB0 - shiftX : (xNB0 + bboxNB.width() + shiftX);
-
-      yMin[0] = flipY ? yB0 - 1.0 * (bboxB.height() + shiftY) : yB0 + shiftY;
-      yMin[1] = flipY ? yNB0 - 1.0 * (bboxNB.height() + shiftY) : yNB0 + shiftY;
-      yMax[0] = flipY ? yB0 - shiftY : (yB0 + bboxB.height() + shiftY);
-      yMax[1] = flipY ? yNB0 - shiftY : (yNB0 + bboxNB.height() + shiftY);
-    }
+    const auto& geometry = getDeGeometry(de);
+    const float* x0 = geometry.x0;
+    const float* y0 = geometry.y0;
+    const float* xMin = geometry.xMin;
+    const float* xMax = geometry.xMax;
+    const float* yMin = geometry.yMin;
+    const float* yMax = geometry.yMax;
 
     float binWidthX = getHist()->GetXaxis()->GetBinWidth(1);
     float binWidthY = getHist()->GetYaxis()->GetBinWidth(1);
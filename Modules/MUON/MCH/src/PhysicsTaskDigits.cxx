@@ -288,7 +288,7 @@ void PhysicsTaskDigits::plotDigit(const o2::mch::Digit& digit)
   // Fill X Y 2D hits histogram with fired pads distribution
   auto hNhits = mHistogramNhitsDE[cathode].find(deId);
   if ((hNhits != mHistogramNhitsDE[cathode].end()) && (hNhits->second != NULL)) {
-    hNhits->second->Fill(padX, padY, padSizeX, padSizeY);
+    hNhits->second->FillPad(padId, padX, padY, padSizeX, padSizeY);
   }
 
   // orbit relative to start of TF (or so it is expected)
@@ -154,8 +154,8 @@ class RawQcTask final : public TaskInterface
   std::array<TH1F*, kNhist1D> mHist1D = { nullptr }; ///< Array of 1D histograms
   std::array<TH2F*, kNhist2D> mHist2D = { nullptr }; ///< Array of 2D histograms
 
-  bool mInitBadMap = true;                           //! BadMap had to be initialized
-  const o2::phos::BadChannelsMap* mBadMap = nullptr; //! Bad map for comparison
+  bool mInitBadMap = true;                                 //! BadMap had to be initialized
+  std::shared_ptr<const o2::phos::BadChannelsMap> mBadMap; //! Bad map for comparison
   std::unique_ptr<TSpectrum> mSpSearcher;
   std::vector<TH1S> mSpectra;
 };
@@ -87,6 +87,9 @@ void RawQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   }
 
   InitHistograms();
+
+  // retrieved at the start of each activity, before the first data needs it
+  declareCondition<o2::phos::BadChannelsMap>("PHS/Calib/BadMap");
 }
 
 void RawQcTask::InitHistograms()
@@ -209,7 +212,8 @@ void RawQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     int ibin = mHist2D[kErrorNumber]->Fill(float(e.getFEC()), float(e.getDDL()));
     int cont = mHist2D[kErrorType]->GetBinContent(ibin);
     cont |= (1 << e.getError());
-    ILOG(Info, Support) << "[" << int(e.getFEC()) << "," << int(e.getDDL()) << "ERROR:" << cont << " e.getErr=" << int(e.getError()) << AliceO2::InfoLogger::InfoLogger::endm;
+    // the errors are all counted in the histograms, logging them can be sparser
+    ILOG_RATE_LIMITED(Info, Support, 1) << "[" << int(e.getFEC()) << "," << int(e.getDDL()) << "ERROR:" << cont << " e.getErr=" << int(e.getError()) << AliceO2::InfoLogger::InfoLogger::endm;
     mHist2D[kErrorType]->SetBinContent(ibin, cont);
   }
   // Bad Map
@@ -217,9 +221,7 @@ void RawQcTask::monitorData(o2::framework::ProcessingContext& ctx)
   if (mInitBadMap) {
     mInitBadMap = false;
     ILOG(Info, Support) << "Getting bad map" << AliceO2::InfoLogger::InfoLogger::endm;
-    loadCcdb();
-    std::map<std::string, std::string> metadata;
-    mBadMap = retrieveConditionAny<o2::phos::BadChannelsMap>("PHS/Calib/BadMap", metadata);
+    mBadMap = retrieveCachedCondition<o2::phos::BadChannelsMap>("PHS/Calib/BadMap");
     if (!mBadMap) {
       ILOG(Error, Support) << "Can not get bad map" << AliceO2::InfoLogger::InfoLogger::endm;
       mHist1D[kBadMapSummary]->Reset();
@@ -34,6 +34,7 @@ class SkeletonCheck : public o2::quality_control::checker::CheckInterface
 
   // Override interface
   void configure() override;
+  Quality checkView(const MonitorObjectsView& moView) override;
   Quality check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap) override;
   void beautify(std::shared_ptr<MonitorObject> mo, Quality checkResult = Quality::Null) override;
   std::string getAcceptedType() override;
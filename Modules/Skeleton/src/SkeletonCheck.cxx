@@ -32,10 +32,16 @@ namespace o2::quality_control_modules::skeleton
 void SkeletonCheck::configure() {}
 
 Quality SkeletonCheck::check(std::map<std::string, std::shared_ptr<MonitorObject>>* moMap)
+{
+  // the objects are checked in checkView()
+  return checkWithView(moMap);
+}
+
+Quality SkeletonCheck::checkView(const MonitorObjectsView& moView)
 {
   Quality result = Quality::Null;
 
-  for (auto& [moName, mo] : *moMap) {
+  for (auto& [moName, mo] : moView) {
 
     (void)moName;
     if (mo->getName() == "example") {
@@ -19,7 +19,9 @@
 
 #include "QualityControl/TaskInterface.h"
 #include <array>
+#include <vector>
 #include "DataFormatsTRD/NoiseCalibration.h"
+#include "DataFormatsTRD/Constants.h"
 
 class TH1F;
 class TH1D;
@@ -55,6 +57,11 @@ class PulseHeight final : public TaskInterface
   void retrieveCCDBSettings();
 
  private:
+  static size_t getPadIndex(int detector, int row, int column)
+  {
+    return (static_cast<size_t>(detector) * o2::trd::constants::NROWC1 + row) * o2::trd::constants::NCOLUMN + column;
+  }
+
   std::shared_ptr<TH1F> mPulseHeight = nullptr;
   std::shared_ptr<TH1F> mPulseHeightScaled = nullptr;
   std::shared_ptr<TH2F> mTotalPulseHeight2D = nullptr;
@@ -72,6 +79,11 @@ class PulseHeight final : public TaskInterface
   o2::trd::NoiseStatusMCM* mNoiseMap = nullptr;
   std::shared_ptr<TProfile> mPulseHeightpro = nullptr;
   std::shared_ptr<TProfile2D> mPulseHeightperchamber = nullptr;
+  uint16_t mADCSumThreshold = 400;
+  // digit index + 1 of each pad which has a digit above threshold in the current trigger, 0 if none
+  std::vector<uint32_t> mPadDigits;
+  // pads set in mPadDigits, so that only those are cleared after each trigger
+  std::vector<size_t> mTouchedPads;
 };
 
 } // namespace o2::quality_control_modules::trd
@@ -27,7 +27,6 @@
 #include <Framework/InputRecord.h>
 #include <Framework/InputRecordWalker.h>
 #include <gsl/span>
-#include <map>
 #include <tuple>
 #include "DataFormatsTRD/Digit.h"
 #include "DataFormatsTRD/Tracklet64.h"
@@ -143,6 +142,14 @@ void PulseHeight::initialize(o2::framework::InitContext& /*ctx*/)
     mPulseHeightPeakRegion.second = 5.0;
     ILOG(Info, Support) << "configure() : using default pulseheightupper = " << mPulseHeightPeakRegion.second << ENDM;
   }
+  if (auto param = mCustomParameters.find("adcsumthreshold"); param != mCustomParameters.end()) {
+    mADCSumThreshold = stoi(param->second);
+    ILOG(Info, Support) << "configure() : using adcsumthreshold = " << mADCSumThreshold << ENDM;
+  } else {
+    ILOG(Info, Support) << "configure() : using default adcsumthreshold = " << mADCSumThreshold << ENDM;
+  }
+  mPadDigits.assign(o2::trd::constants::MAXCHAMBER * o2::trd::constants::NROWC1 * o2::trd::constants::NCOLUMN, 0);
+  mTouchedPads.reserve(mPadDigits.size());
   buildHistograms();
   retrieveCCDBSettings();
 }
@@ -157,7 +164,7 @@ void PulseHeight::startOfCycle()
   ILOG(Info, Support) << "startOfCycle" << ENDM;
 }
 
-bool pulseheightdigitindexcompare(unsigned int A, unsigned int B, const std::vector<o2::trd::Digit>& originalDigits)
+bool pulseheightdigitindexcompare(unsigned int A, unsigned int B, const gsl::span<const o2::trd::Digit>& originalDigits)
 {
   // sort into ROC:padrow
   const o2::trd::Digit *a, *b;
@@ -186,140 +193,68 @@ void PulseHeight::monitorData(o2::framework::ProcessingContext& ctx)
   auto digits = ctx.inputs().get<gsl::span<o2::trd::Digit>>("digits");
   auto tracklets = ctx.inputs().get<gsl::span<o2::trd::Tracklet64>>("tracklets");
   auto triggerrecords = ctx.inputs().get<gsl::span<o2::trd::TriggerRecord>>("triggers");
-  uint16_t tbsum[540][16][144];
-  std::map<std::tuple<int, int, int>, o2::trd::ArrayADC> dataMap;
   uint64_t digitcount = 0;
-  std::vector<int> digitIndex;
   auto start = std::chrono::steady_clock::now();
   int triggercount = 0;
   for (auto& trigger : triggerrecords) {
-    uint64_t numtracklets = trigger.getNumberOfTracklets();
-    uint64_t numdigits = trigger.getNumberOfDigits();
-
-    int tbmax = 0;
-    int tbhi = 0;
-    int tblo = 0;
-
-    int det = 0;
-    int row = 0;
-    int pad = 0;
-    int channel = 0;
-
-    memset(tbsum, 0, sizeof(tbsum));
-    dataMap.clear();
+    // register the digits above threshold in the pad grid, remembering which pads we touch
     for (int i = trigger.getFirstDigit(); i < trigger.getFirstDigit() + trigger.getNumberOfDigits(); ++i) {
-
-      // digit comes in sorted by hcid.
-      // resort them by chamber,row, pad, this then removes the need for the map.
-      //
-      //  loop over det, pad, row?
-      channel = digits[i].getChannel();
+      int channel = digits[i].getChannel();
       if (channel == 0 || channel == 1 || channel == 20) {
         continue;
       }
-
-      auto adcs = digits[i].getADC();
-      det = digits[i].getDetector();
-      row = digits[i].getPadRow();
-      pad = digits[i].getPadCol();
-      int supermod = det / 30;
-
-      tbsum[det][row][pad] = digits[i].getADCsum();
-
-      if (tbsum[det][row][pad] >= 400) {
-        dataMap.insert(std::make_pair(std::make_tuple(det, row, pad), adcs));
-      } else {
-        tbsum[det][row][pad] = 0;
+      if (digits[i].getADCsum() < mADCSumThreshold) {
+        continue;
+      }
+      // if a pad appears twice, the first digit is kept, as std::map::insert did
+      auto padIndex = getPadIndex(digits[i].getDetector(), digits[i].getPadRow(), digits[i].getPadCol());
+      if (mPadDigits[padIndex] == 0) {
+        mPadDigits[padIndex] = i + 1;
+        mTouchedPads.push_back(padIndex);
       }
     } // end digitcont
 
-    // std::cout << "start updating..... trigger:" << triggercount++ << " with " << trigger.getNumberOfDigits() << " digits " << std::endl;
-    for (int d = 0; d < 540; d++) {
-      int sector = d / 30;
-      for (int r = 0; r < 16; r++) {
-        for (int c = 2; c < 142; c++) {
-          if (d == 50 && tbsum[d][r][c] > 0) {
-            // std::cout << "updating on detector 50 " << d << " " << r << " " << c-1 << "("<<tbsum[d][r][c-1]<<") -- " << d << " " << r << " " << c << "("<<tbsum[d][r][c]<<") -- " << d << " " << r << " " << c+1 <<"("<< tbsum[d][r][c+1]<< ")" << std::endl;
-          }
-          if (tbsum[d][r][c] > tbsum[d][r][c - 1] && tbsum[d][r][c] > tbsum[d][r][c + 1]) {
-            if (tbsum[d][r][c - 1] > tbsum[d][r][c + 1]) {
-              tbmax = tbsum[d][r][c];
-              tbhi = tbsum[d][r][c - 1];
-              tblo = tbsum[d][r][c + 1];
-              auto adcMax = dataMap.find(std::make_tuple(d, r, c));
-              auto adcHi = dataMap.find(std::make_tuple(d, r, c - 1));
-              auto adcLo = dataMap.find(std::make_tuple(d, r, c + 1));
-
-              if (dataMap.find(std::make_tuple(d, r, c - 2)) == dataMap.end()) {
-                if (tblo > 400) {
-                  int phVal = 0;
-                  // std::cout << "updatea " << d << " " << r << " " << c-1 << "("<<tbsum[d][r][c-1]<<") -- " << d << " " << r << " " << c << "("<<tbsum[d][r][c]<<") -- " << d << " " << r << " " << c+1 <<"("<< tbsum[d][r][c+1]<< ")" << std::endl;
-                  for (int tb = 0; tb < 30; tb++) {
-                    phVal = ((adcMax->second)[tb] + (adcHi->second)[tb] + (adcLo->second)[tb]);
-                    // TODO do we have a corresponding tracklet?
-                    mPulseHeight->Fill(tb, phVal);
-                    mPulseHeightpro->Fill(tb, phVal);
-                    mTotalPulseHeight2D->Fill(tb, phVal);
-                    mPulseHeight2DperSM[sector]->Fill(tb, phVal);
-                    mPulseHeightperchamber->Fill(tb, d, phVal);
-                  }
-                }
-              } else {
-                auto adcHiNeighbour = dataMap.find(std::make_tuple(d, r, c - 2));
-                if (tblo > 400) {
-                  // std::cout << "updateb " << d << " " << r << " " << c-1 << "("<<tbsum[d][r][c-1]<<") -- " << d << " " << r << " " << c << "("<<tbsum[d][r][c]<<") -- " << d << " " << r << " " << c+1 <<"("<< tbsum[d][r][c+1]<< ")" << std::endl;
-                  int phVal = 0;
-                  for (int tb = 0; tb < 30; tb++) {
-                    phVal = ((adcMax->second)[tb] + (adcHi->second)[tb] + (adcLo->second)[tb]);
-                    mPulseHeight->Fill(tb, phVal);
-                    mPulseHeightpro->Fill(tb, phVal);
-                    mTotalPulseHeight2D->Fill(tb, phVal);
-                    mPulseHeight2DperSM[sector]->Fill(tb, phVal);
-                    mPulseHeightperchamber->Fill(tb, d, phVal);
-                  }
-                }
-              }
-            } else {
-              tbmax = tbsum[d][r][c];
-              tbhi = tbsum[d][r][c + 1];
-              tblo = tbsum[d][r][c - 1];
-              auto adcMax = dataMap.find(std::make_tuple(d, r, c));
-              auto adcHi = dataMap.find(std::make_tuple(d, r, c + 1));
-              auto adcLo = dataMap.find(std::make_tuple(d, r, c - 1));
-              if (dataMap.find(std::make_tuple(d, r, c + 2)) == dataMap.end()) {
-
-                if (tblo > 400) {
-                  int phVal = 0;
-                  for (int tb = 0; tb < 30; tb++) {
-                    phVal = ((adcMax->second)[tb] + (adcHi->second)[tb] + (adcLo->second)[tb]);
-                    mPulseHeight->Fill(tb, phVal);
-                    mPulseHeightpro->Fill(tb, phVal);
-                    mTotalPulseHeight2D->Fill(tb, phVal);
-                    mPulseHeight2DperSM[sector]->Fill(tb, phVal);
-                    mPulseHeightperchamber->Fill(tb, d, phVal);
-                  }
-                }
-              } else {
-                auto adcHiNeighbour = dataMap.find(std::make_tuple(d, r, c + 2));
-                if (tblo > 400) {
-                  int phVal = 0;
-                  for (int tb = 0; tb < 30; tb++) {
-                    phVal = ((adcMax->second)[tb] + (adcHi->second)[tb] + (adcLo->second)[tb]);
-                    mPulseHeight->Fill(tb, phVal);
-                    mPulseHeightpro->Fill(tb, phVal);
-                    mTotalPulseHeight2D->Fill(tb, phVal);
-                    mPulseHeight2DperSM[sector]->Fill(tb, phVal);
-                    mPulseHeightperchamber->Fill(tb, d, phVal);
-                  }
-                }
-              }
-            } // end else
-          }   // end if (tbsum[d][r][c]>tbsum[d][r][c-1] && tbsum[d][r][c]>tbsum[d][r][c+1])
-        }     // end for c
-      }       // end for r
-    }         // end for d
-    // std::cout << "finishedupdating....." << std::endl;
-    dataMap.clear();
+    // look for the local maxima only around the digits above threshold
+    for (auto padIndex : mTouchedPads) {
+      int c = padIndex % o2::trd::constants::NCOLUMN;
+      if (c < 2 || c > o2::trd::constants::NCOLUMN - 3) {
+        continue;
+      }
+      auto left = mPadDigits[padIndex - 1];
+      auto right = mPadDigits[padIndex + 1];
+      if (left == 0 || right == 0) {
+        continue; // both neighbours must be above threshold
+      }
+      const auto& digitMax = digits[mPadDigits[padIndex] - 1];
+      const auto& digitLeft = digits[left - 1];
+      const auto& digitRight = digits[right - 1];
+      uint16_t tbmax = digitMax.getADCsum();
+      uint16_t tbleft = digitLeft.getADCsum();
+      uint16_t tbright = digitRight.getADCsum();
+      uint16_t tblo = std::min(tbleft, tbright);
+      if (tbmax > tbleft && tbmax > tbright && tblo > mADCSumThreshold) {
+        int d = digitMax.getDetector();
+        int sector = d / 30;
+        const auto& adcMax = digitMax.getADC();
+        const auto& adcLeft = digitLeft.getADC();
+        const auto& adcRight = digitRight.getADC();
+        for (int tb = 0; tb < 30; tb++) {
+          int phVal = adcMax[tb] + adcLeft[tb] + adcRight[tb];
+          // TODO do we have a corresponding tracklet?
+          mPulseHeight->Fill(tb, phVal);
+          mPulseHeightpro->Fill(tb, phVal);
+          mTotalPulseHeight2D->Fill(tb, phVal);
+          mPulseHeight2DperSM[sector]->Fill(tb, phVal);
+          mPulseHeightperchamber->Fill(tb, d, phVal);
+        }
+      }
+    }
+
+    // clear only what this trigger has touched
+    for (auto padIndex : mTouchedPads) {
+      mPadDigits[padIndex] = 0;
+    }
+    mTouchedPads.clear();
   } // end trigger event
 
   auto end = std::chrono::steady_clock::now();
@@ -328,7 +263,7 @@ void PulseHeight::monitorData(o2::framework::ProcessingContext& ctx)
   triggercount = 0;
   // alternate formulation:
   auto start1 = std::chrono::steady_clock::now();
-  std::vector<o2::trd::Digit> digitv(digits.begin(), digits.end());
+  gsl::span<const o2::trd::Digit> digitv(digits.data(), digits.size());
   std::vector<unsigned int> digitsIndex(digitv.size());
   std::iota(digitsIndex.begin(), digitsIndex.end(), 0);
 
@@ -345,8 +280,6 @@ void PulseHeight::monitorData(o2::framework::ProcessingContext& ctx)
     int pad = 0;
     int channel = 0;
 
-    memset(tbsum, 0, sizeof(tbsum));
-
     if (digitv.size() == 0)
       continue;
 
@@ -354,7 +287,7 @@ void PulseHeight::monitorData(o2::framework::ProcessingContext& ctx)
       continue; // bail if we have no digits in this trigger
     // now sort digits to det,row,pad
     std::sort(std::begin(digitsIndex) + trigger.getFirstDigit(), std::begin(digitsIndex) + trigger.getFirstDigit() + trigger.getNumberOfDigits(),
-              [&digitv](unsigned int i, unsigned int j) { return pulseheightdigitindexcompare(i, j, digitv); });
+              [digitv](unsigned int i, unsigned int j) { return pulseheightdigitindexcompare(i, j, digitv); });
     // std::cout << " staring updating second ... for trigger:" << triggercount++ << " with " << trigger.getNumberOfDigits() << " digits" << std::endl;
     for (int currentdigit = trigger.getFirstDigit() + 1; currentdigit < trigger.getFirstDigit() + trigger.getNumberOfDigits() - 1; ++currentdigit) { // -1 and +1 as we are looking for consecutive digits pre and post the current one indexed.
       int detector = digits[digitsIndex[currentdigit]].getDetector();
@@ -425,7 +358,7 @@ void PulseHeight::monitorData(o2::framework::ProcessingContext& ctx)
               }
             }
           } // end else
-        }   // end if (tbsum[d][r][c]>tbsum[d][r][c-1] && tbsum[d][r][c]>tbsum[d][r][c+1])
+        }   // end if (sumb > suma && sumb > sumc)
       }     // end for c
     }       // end for r
     // std::cout << " finished updating second ... " << std::endl;